@@ -4,11 +4,13 @@
 #include <mutable/catalog/Schema.hpp>
 #include <mutable/IR/CNF.hpp>
 #include <mutable/IR/QueryGraph.hpp>
+#include <mutable/storage/DataLayout.hpp>
 #include <mutable/storage/Store.hpp>
 #include <mutable/util/enum_ops.hpp>
 #include <mutable/util/macro.hpp>
 #include <functional>
 #include <iostream>
+#include <optional>
 #include <unordered_map>
 #include <utility>
 #include <variant>
@@ -198,21 +200,47 @@ struct M_EXPORT Consumer : virtual Operator
     }
 };
 
+/** Hands the produced `Tuple`s to a user-provided callback, either tuple-at-a-time or batch-wise. */
 struct M_EXPORT CallbackOperator : Consumer
 {
     using callback_type = std::function<void(const Schema &, const Tuple&)>;
 
+    /** A read-only view of a batch of result tuples in memory.  Only the attributes of `schema`, i.e. the attributes of
+     * the operator's schema without constants and duplicates, are materialized.  The `i`-th attribute of `schema` is
+     * laid out by the leaf with index `i` in `layout`, the NULL bitmap by the leaf with index `schema.num_entries()`.
+     * The view is only valid during the invocation of the callback. */
+    struct batch_type
+    {
+        const Schema &schema; ///< the schema of the materialized attributes
+        const storage::DataLayout &layout; ///< the layout of the tuples; has no child iff `schema` is empty
+        const void *data; ///< the address of the first tuple; `nullptr` iff `schema` is empty
+        std::size_t num_tuples; ///< the number of tuples in the batch
+        const Tuple &constants; ///< the operator's schema with all constant attributes set, all others `NULL`
+    };
+    using batch_callback_type = std::function<void(const Schema&, const batch_type&)>;
+
     private:
     callback_type callback_;
+    batch_callback_type batch_callback_;
 
     public:
     CallbackOperator(callback_type callback) : callback_(std::move(callback)) { }
+    /** Creates a `CallbackOperator` that hands the produced `Tuple`s batch-wise to \p batch_callback, avoiding to
+     * materialize a `Tuple` per result.  A backend may deliver the batches directly from its own memory, e.g. the
+     * `WasmEngine` delivers each window of the result set, see `--result-set-window-size`, as soon as it is filled.
+     * If no window size is given, the `WasmEngine` streams the result set in windows of
+     * `--streaming-result-set-window-size` tuples.  To consume the batches later, they can be spilled to a file, see
+     * `SpilledResultSet`. */
+    CallbackOperator(batch_callback_type batch_callback) : batch_callback_(std::move(batch_callback)) { }
 
     /** Creates and returns a copy of this single operator node, i.e. only copies this operator without adding any
      * inherited member fields like the parent or children nodes in the returned copy. */
-    CallbackOperator clone_node() const { return CallbackOperator(callback_); }
+    CallbackOperator clone_node() const {
+        return batch_callback_ ? CallbackOperator(batch_callback_) : CallbackOperator(callback_);
+    }
 
     const auto & callback() const { return callback_; }
+    const auto & batch_callback() const { return batch_callback_; }
 
     void accept(OperatorVisitor &v) override;
     void accept(ConstOperatorVisitor &v) const override;
@@ -253,11 +281,14 @@ struct M_EXPORT ScanOperator : Producer
     private:
     const Store &store_;
     ThreadSafePooledString alias_;
+    ///> the start time of the transaction whose snapshot of a multi-versioned table is scanned, if any
+    std::optional<int64_t> snapshot_;
 
     public:
-    ScanOperator(const Store &store, ThreadSafePooledString alias)
+    ScanOperator(const Store &store, ThreadSafePooledString alias, std::optional<int64_t> snapshot = std::nullopt)
         : store_(store)
         , alias_(std::move(alias))
+        , snapshot_(snapshot)
     {
         auto &S = schema();
         for (auto &e : store.table().schema())
@@ -266,11 +297,18 @@ struct M_EXPORT ScanOperator : Producer
 
     /** Creates and returns a copy of this single operator node, i.e. only copies this operator without adding any
      * inherited member fields like the parent or children nodes in the returned copy. */
-    ScanOperator clone_node() const { return ScanOperator(store_, alias_); }
+    ScanOperator clone_node() const { return ScanOperator(store_, alias_, snapshot_); }
 
     const Store & store() const { return store_; }
     const ThreadSafePooledString & alias() const { return alias_; }
 
+    /** Returns `true` iff this scan reads a snapshot of a multi-versioned table, i.e. produces only the versions of
+     * rows that are visible to the transaction with start time `snapshot()`, see `is_visible()`.  The visibility is
+     * checked by the scan itself, hence the timestamp attributes need not be part of the scan's schema. */
+    bool has_snapshot() const { return snapshot_.has_value(); }
+    /** Returns the start time of the transaction whose snapshot is scanned. */
+    int64_t snapshot() const { M_insist(has_snapshot()); return *snapshot_; }
+
     void accept(OperatorVisitor &v) override;
     void accept(ConstOperatorVisitor &v) const override;
 };
@@ -7,6 +7,8 @@
 #include <mutable/storage/DataLayoutFactory.hpp>
 #include <mutable/util/macro.hpp>
 #include <mutable/util/memory.hpp>
+#include <mutex>
+#include <optional>
 #include <unordered_map>
 
 
@@ -41,6 +43,9 @@ struct WasmEngine
         memory::AddressSpace vm; ///<  WebAssembly module instance's virtual address space aka.\ *linear memory*
         uint32_t heap = 0; ///< beginning of the heap, encoded as offset from the beginning of the virtual address space
         std::vector<std::reference_wrapper<const idx::IndexBase>> indexes; ///< the indexes used in the query
+        ///> for every scan directly below a filter, whether the scan can skip each zone of the scanned table, see
+        ///> `ZoneMap::skippable_zones()`
+        std::vector<std::pair<const ScanOperator*, std::vector<bool>>> skippable_zones;
 
         WasmContext(uint32_t id, const MatchBase &plan, config_t configuration, std::size_t size);
 
@@ -51,6 +56,11 @@ struct WasmEngine
          * `TRAP_GUARD_PAGES`.  */
         uint32_t map_table(const Table &table);
 
+        /** Maps the first \p bytes of \p mem at the current start of `heap` and advances `heap` past the mapped region.
+         * Returns the address (in linear memory) of the mapped memory.  Installs a guard page after the mapping.
+         * Acknowledges `TRAP_GUARD_PAGES`. */
+        uint32_t map_memory(const memory::Memory &mem, std::size_t bytes);
+
         /** Installs a guard page at the current `heap` and increments `heap` to the next page.  Acknowledges
          * `TRAP_GUARD_PAGES`. */
         void install_guard_page();
@@ -60,11 +70,22 @@ struct WasmEngine
             indexes.emplace_back(index);
             return indexes.size() - 1;
         }
+
+        /** Returns the position of the skippable zones of scan \p scan in `skippable_zones` as id, if any. */
+        std::optional<std::size_t> find_skippable_zones(const ScanOperator &scan) const {
+            for (std::size_t i = 0; i != skippable_zones.size(); ++i) {
+                if (skippable_zones[i].first == &scan)
+                    return i;
+            }
+            return std::nullopt;
+        }
     };
 
     private:
     ///> maps unique IDs to `WasmContext` instances
     static inline std::unordered_map<unsigned, std::unique_ptr<WasmContext>> contexts_;
+    ///> protects `contexts_`, since concurrent queries create, look up, and dispose their contexts simultaneously
+    static inline std::mutex contexts_mutex_;
 
     public:
     /** Creates a new `WasmContext` for ID `id` with `size` bytes of virtual address space. */
@@ -74,6 +95,7 @@ struct WasmEngine
                                                     std::size_t size = WASM_MAX_MEMORY)
     {
         auto wasm_context = std::make_unique<WasmContext>(id, plan, configuration, size);
+        std::lock_guard<std::mutex> lock(contexts_mutex_);
         auto [it, inserted] = contexts_.emplace(id, std::move(wasm_context));
         M_insist(inserted, "WasmContext with that ID already exists");
         return *it->second;
@@ -86,6 +108,7 @@ struct WasmEngine
                                WasmContext::config_t configuration = WasmContext::config_t(0x0),
                                std::size_t size = WASM_MAX_MEMORY)
     {
+        std::lock_guard<std::mutex> lock(contexts_mutex_);
         auto [it, inserted] = contexts_.try_emplace(id, lazy_construct(
             [&](){ return std::make_unique<WasmContext>(id, plan, configuration, size); }
         ));
@@ -94,9 +117,14 @@ struct WasmEngine
 
     /** Disposes the `WasmContext` with ID `id`. */
     static void Dispose_Wasm_Context(unsigned id) {
-        auto res = contexts_.erase(id);
-        (void) res;
-        M_insist(res == 1, "There is no context with the given ID to erase");
+        std::unique_ptr<WasmContext> ctx; // destroyed after releasing the lock
+        {
+            std::lock_guard<std::mutex> lock(contexts_mutex_);
+            auto it = contexts_.find(id);
+            M_insist(it != contexts_.end(), "There is no context with the given ID to erase");
+            ctx = std::move(it->second);
+            contexts_.erase(it);
+        }
     }
 
     /** Disposes the `WasmContext` `ctx`. */
@@ -104,13 +132,17 @@ struct WasmEngine
 
     /** Returns a reference to the `WasmContext` with ID `id`. */
     static WasmContext & Get_Wasm_Context_By_ID(unsigned id) {
+        std::lock_guard<std::mutex> lock(contexts_mutex_);
         auto it = contexts_.find(id);
         M_insist(it != contexts_.end(), "There is no context with the given ID");
         return *it->second;
     }
 
     /** Tests if the `WasmContext` with ID `id` exists. */
-    static bool Has_Wasm_Context(unsigned id) { return contexts_.find(id) != contexts_.end(); }
+    static bool Has_Wasm_Context(unsigned id) {
+        std::lock_guard<std::mutex> lock(contexts_mutex_);
+        return contexts_.find(id) != contexts_.end();
+    }
 
     WasmEngine() = default;
     virtual ~WasmEngine() { }
@@ -205,6 +205,9 @@ struct ComponentSet
 
 namespace m {
 
+/*----- forward declarations -----------------------------------------------------------------------------------------*/
+struct GarbageCollector;
+
 /*======================================================================================================================
  * Catalog
  *====================================================================================================================*/
@@ -225,6 +228,9 @@ struct M_EXPORT Catalog
     Database *database_in_use_ = nullptr; ///< the currently used database
     std::unordered_map<ThreadSafePooledString, Function*> standard_functions_; ///< functions defined by the SQL standard
     Timer timer_; ///< a global timer
+    static thread_local Timer *thread_timer_; ///< a timer replacing the global timer on the current thread, if set
+    ///> the background collector of dead versions of rows, if enabled; destroyed first, before any `Database`
+    std::unique_ptr<GarbageCollector> garbage_collector_;
 
     private:
     Catalog();
@@ -260,10 +266,17 @@ struct M_EXPORT Catalog
     /** Returns a reference to the `StringPool`. */
     const ThreadSafeStringPool & get_pool() const { return pool_; }
 
-    /** Returns the global `Timer` instance. */
-    Timer & timer() { return timer_; }
-    /** Returns the global `Timer` instance. */
-    const Timer & timer() const { return timer_; }
+    /** Returns the global `Timer` instance or, if set, the `Timer` of the current thread, see `thread_timer()`. */
+    Timer & timer() { return thread_timer_ ? *thread_timer_ : timer_; }
+    /** Returns the global `Timer` instance or, if set, the `Timer` of the current thread, see `thread_timer()`. */
+    const Timer & timer() const { return thread_timer_ ? *thread_timer_ : timer_; }
+    /** Makes `timer()` return \p timer on the current thread, e.g. to record the measurements of concurrently executed
+     * queries separately.  Passing `nullptr` restores the global `Timer`. */
+    void thread_timer(Timer *timer) { thread_timer_ = timer; }
+
+    /** Replaces the background `GarbageCollector` by \p garbage_collector, which may be `nullptr` to disable garbage
+     * collection.  The previous collector is stopped first. */
+    void garbage_collector(std::unique_ptr<GarbageCollector> garbage_collector);
 
     /** Returns a reference to the `memory::Allocator`. */
     memory::Allocator & allocator() { return *allocator_; }
@@ -93,8 +93,60 @@ struct learn_spns : DatabaseInstruction
     void execute(Diagnostic &diag) override;
 };
 
+/** Write a snapshot of the database that is currently in use to the file given as argument, see
+ * `m::write_snapshot()`. */
+struct save_snapshot : DatabaseInstruction
+{
+    save_snapshot(std::vector<std::string> args) : DatabaseInstruction(std::move(args)) { }
+
+    void accept(DatabaseCommandVisitor &v) override;
+    void accept(ConstDatabaseCommandVisitor &v) const override;
+
+    void execute(Diagnostic &diag) override;
+};
+
+/** Restore a database from the snapshot file given as argument and use it, see `m::read_snapshot()`. */
+struct load_snapshot : DatabaseInstruction
+{
+    load_snapshot(std::vector<std::string> args) : DatabaseInstruction(std::move(args)) { }
+
+    void accept(DatabaseCommandVisitor &v) override;
+    void accept(ConstDatabaseCommandVisitor &v) const override;
+
+    void execute(Diagnostic &diag) override;
+};
+
+/** Compress the tables given as arguments, or all tables of the database that is currently in use if no table is given,
+ * see `m::compress_table()`. */
+struct compress : DatabaseInstruction
+{
+    compress(std::vector<std::string> args) : DatabaseInstruction(std::move(args)) { }
+
+    void accept(DatabaseCommandVisitor &v) override;
+    void accept(ConstDatabaseCommandVisitor &v) const override;
+
+    void execute(Diagnostic &diag) override;
+};
+
+/** Remove the versions of rows that are invisible to all active and future transactions from the given
+ * multi-versioned tables, or from all multi-versioned tables of the database that is currently in use if no table is
+ * given, see `m::collect_garbage()`. */
+struct vacuum : DatabaseInstruction
+{
+    vacuum(std::vector<std::string> args) : DatabaseInstruction(std::move(args)) { }
+
+    void accept(DatabaseCommandVisitor &v) override;
+    void accept(ConstDatabaseCommandVisitor &v) const override;
+
+    void execute(Diagnostic &diag) override;
+};
+
 #define M_DATABASE_INSTRUCTION_LIST(X) \
-    X(learn_spns)
+    X(learn_spns) \
+    X(save_snapshot) \
+    X(load_snapshot) \
+    X(compress) \
+    X(vacuum)
 
 
 /*======================================================================================================================
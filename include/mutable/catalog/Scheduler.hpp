@@ -5,6 +5,9 @@
 #include <mutable/util/Diagnostic.hpp>
 #include <compare>
 #include <future>
+#include <mutex>
+#include <optional>
+#include <set>
 
 
 namespace m {
@@ -22,14 +25,25 @@ struct M_EXPORT Scheduler
 
         ///> Stores the next available Transaction ID, stored atomically to prevent race conditions
         static std::atomic<uint64_t> next_id_;
+        ///> guards `active_start_times_`
+        static std::mutex active_mutex_;
+        ///> the start times of all active transactions, i.e. of all transactions that have a start time and still exist
+        static std::multiset<int64_t> active_start_times_;
 
         public:
         Transaction() : id_(next_id_.fetch_add(1, std::memory_order_relaxed)) { }
+        Transaction(const Transaction&) = delete;
+        ~Transaction();
 
         ///> sets the start time of the Transaction. Should only be set once and only to a positive number.
-        void start_time(int64_t time) { M_insist(start_time_ == -1 and time >= 0); start_time_ = time; };
+        void start_time(int64_t time);
         int64_t start_time() const { return start_time_; };
 
+        /** Returns the start time of the oldest active transaction, or `std::nullopt` if no transaction is active.
+         * Versions of rows of multi-versioned tables that were deleted at or before this time are invisible to all
+         * active and future transactions, see `collect_garbage()`. */
+        static std::optional<int64_t> Oldest_Active_Start_Time();
+
         auto operator==(const Transaction &other) const { return id_ == other.id_; };
         auto operator<=>(const Transaction &other) const { return id_ <=> other.id_; };
     };
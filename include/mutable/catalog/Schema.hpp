@@ -7,6 +7,7 @@
 #include <iterator>
 #include <list>
 #include <memory>
+#include <mutex>
 #include <mutable/catalog/CardinalityEstimator.hpp>
 #include <mutable/catalog/Type.hpp>
 #include <mutable/mutable-config.hpp>
@@ -895,6 +896,7 @@ struct M_EXPORT Database
     std::unordered_map<ThreadSafePooledString, Function*> functions_; ///< functions defined in this database
     std::unique_ptr<CardinalityEstimator> cardinality_estimator_; ///< the `CardinalityEstimator` of this `Database`
     std::list<index_entry_type> indexes_; ///< the indexes of this database
+    mutable std::mutex merge_mutex_; ///< guards merging pending index entries by concurrent queries
 
     private:
     Database(ThreadSafePooledString name);
@@ -991,6 +993,12 @@ struct M_EXPORT Database
             if (it->name == index_name) return true;
         return false;
     }
+    /** Returns `true` iff there is a valid index on any attribute of `Table` \p table_name. */
+    bool has_indexes(const ThreadSafePooledString &table_name) const {
+        for (auto &entry : indexes_)
+            if (entry.is_valid and entry.table.name() == table_name) return true;
+        return false;
+    }
     /** Returns `true` iff there is a valid index using \p method on \p attribute_name of \p table_name.  Throws
      * `m::invalid_argument` if a `Table` with the given \p table_name does not exist.  Throws `m::invalid_argument` if
      * an `Attribute` with \p attribute_name does not exist in `Table` \p table_name. */
@@ -1011,16 +1019,19 @@ struct M_EXPORT Database
         }
         return false;
     }
-    /** Returns the index with the given \p index_name.  Throws `m::invalid_argument` an index with the given \p
-     * index_name does not exist. */
+    /** Returns the index with the given \p index_name.  Pending entries of the index are merged first, see
+     * `idx::IndexBase::merge()`.  Throws `m::invalid_argument` an index with the given \p index_name does not exist. */
     const idx::IndexBase & get_index(const ThreadSafePooledString &index_name) const {
         for (auto &entry : indexes_) {
-            if (entry.name == index_name)
+            if (entry.name == index_name) {
+                merge_pending(*entry.index);
                 return *entry.index;
+            }
         }
         throw m::invalid_argument("Index of that name does not exist.");
     }
-    /** Returns a valid index using \p method on \p attribute_name of \p table_name iff one exists.  Throws
+    /** Returns a valid index using \p method on \p attribute_name of \p table_name iff one exists.  Pending entries
+     * of the index are merged first, see `idx::IndexBase::merge()`.  Throws
      * `m::invalid_argument` if such an index does not exist.  Throws `m::invalid_argument` if a `Table` with the given
      * \p table_name does not exist. Throws `m::invalid_argument` if an `Attribute` with \p attribute_name does not
      * exist in `Table` \p table_name. */
@@ -1036,11 +1047,34 @@ struct M_EXPORT Database
             if (entry.is_valid and entry.table.name() == table_name and entry.attribute.name == attribute_name and
                 entry.index->method() == method)
             {
+                merge_pending(*entry.index);
                 return *entry.index;
             }
         }
         throw m::invalid_argument("Index of that method on that attribute of that table does not exist.");
     }
+
+    private:
+    /** Merges the pending entries of \p index, if any.  Concurrent queries may only read the same index, hence merging
+     * is serialized. */
+    void merge_pending(idx::IndexBase &index) const {
+        std::lock_guard<std::mutex> lock(merge_mutex_);
+        if (index.has_pending()) index.merge();
+    }
+
+    public:
+    /** Adds the row \p tuple with \p tuple_id, that was just appended to `Table` \p table_name, to all valid indexes
+     * on attributes of the table.  Indexes may keep the new entries pending until they are used to answer queries,
+     * see `idx::IndexBase::insert()`.  Throws `m::invalid_argument` if a `Table` with the given \p table_name does not
+     * exist. */
+    void insert_into_indexes(const ThreadSafePooledString &table_name, const Tuple &tuple, std::size_t tuple_id) {
+        if (not has_table(table_name))
+            throw m::invalid_argument("Table with that name does not exist.");
+        for (auto &entry : indexes_) {
+            if (entry.is_valid and entry.table.name() == table_name)
+                entry.index->insert(tuple, entry.attribute.id, tuple_id);
+        }
+    }
     /** Invalidates all indexes on attributes of `Table` \p table_name s.t. they are no longer used to answer queries.
      * Throws `m_invalid_argument` if a `Table` with the given \p table_name does not exist. */
     void invalidate_indexes(const ThreadSafePooledString &table_name) {
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <mutable/catalog/Schema.hpp>
+#include <mutable/IR/Operator.hpp>
+#include <mutable/mutable-config.hpp>
+
+
+/*======================================================================================================================
+ * The Apache Arrow C data interface, see https://arrow.apache.org/docs/format/CDataInterface.html.  The definitions are
+ * ABI-stable and guarded such that they can coexist with the definitions of the Arrow libraries.
+ *====================================================================================================================*/
+
+extern "C" {
+
+#ifndef ARROW_C_DATA_INTERFACE
+#define ARROW_C_DATA_INTERFACE
+
+#define ARROW_FLAG_DICTIONARY_ORDERED 1
+#define ARROW_FLAG_NULLABLE 2
+#define ARROW_FLAG_MAP_KEYS_SORTED 4
+
+struct ArrowSchema
+{
+    const char *format;
+    const char *name;
+    const char *metadata;
+    int64_t flags;
+    int64_t n_children;
+    struct ArrowSchema **children;
+    struct ArrowSchema *dictionary;
+    void (*release)(struct ArrowSchema*);
+    void *private_data;
+};
+
+struct ArrowArray
+{
+    int64_t length;
+    int64_t null_count;
+    int64_t offset;
+    int64_t n_buffers;
+    int64_t n_children;
+    const void **buffers;
+    struct ArrowArray **children;
+    struct ArrowArray *dictionary;
+    void (*release)(struct ArrowArray*);
+    void *private_data;
+};
+
+#endif
+
+}
+
+
+namespace m {
+
+/** A `CallbackOperator` that exports the result set as Apache Arrow record batches via the Arrow C data interface.
+ *
+ * Every record batch is exported as an `ArrowArray` of type struct with one child per entry of the operator's schema,
+ * together with the matching `ArrowSchema`.  Types are mapped as follows:
+ *
+ *  | mu*t*able      | Arrow                          |
+ *  |----------------|--------------------------------|
+ *  | BOOL           | `b`   (boolean)                |
+ *  | INT(N)         | `c`, `s`, `i`, `l`             |
+ *  | FLOAT, DOUBLE  | `f`, `g`                       |
+ *  | DECIMAL(p, s)  | `d:p,s` (decimal128)           |
+ *  | CHAR(N)        | `u`   (utf8)                   |
+ *  | DATE           | `tdD` (date32)                 |
+ *  | DATETIME       | `tss:` (timestamp in seconds)  |
+ *  | NULL           | `n`   (null)                   |
+ *
+ * Fixed-width attributes of types whose representation matches Arrow's, i.e. integers, floating-point numbers, and
+ * datetimes, are *handed off* instead of being converted: if the `DataLayout` of the result set stores an attribute
+ * contiguously, as do the PAX blocks of `PAXLayoutFactory`, the exported values buffer points directly into the result
+ * set.  Hence, the result set is exported as one record batch per block of such a layout and as a single record batch
+ * per window otherwise.  The validity bitmaps are derived from the NULL bitmap of the layout, which is stored per
+ * tuple; they are omitted entirely if a column contains no `NULL`.
+ *
+ * The callback may take ownership of the exported `ArrowSchema` and `ArrowArray` by *moving* them, as e.g.
+ * `arrow::ImportRecordBatch()` does; structures that are not released when the callback returns are released by the
+ * exporter.  Buffers handed off from the result set are only valid during the invocation of the callback, consumers
+ * that retain a record batch beyond that must copy it. */
+struct M_EXPORT ArrowExportOperator : CallbackOperator
+{
+    using record_batch_callback_type = std::function<void(ArrowSchema*, ArrowArray*)>;
+
+    ArrowExportOperator(record_batch_callback_type callback);
+
+    /** Exports the tuples of \p batch, produced by a `CallbackOperator` with `Schema` \p schema, as one or more record
+     * batches and passes them to \p callback. */
+    static void export_batch(const Schema &schema, const batch_type &batch,
+                             const record_batch_callback_type &callback);
+};
+
+}
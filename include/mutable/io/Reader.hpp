@@ -1,5 +1,6 @@
 #pragma once
 
+#include <filesystem>
 #include <iostream>
 #include <mutable/catalog/Scheduler.hpp>
 #include <mutable/catalog/Schema.hpp>
@@ -55,6 +56,10 @@ struct M_EXPORT DSVReader : Reader, ConstTypeVisitor
         bool skip_header = false;
         ///> the maximum number of rows to read from the file (may exceed actual number of rows)
         std::size_t num_rows = std::numeric_limits<decltype(num_rows)>::max();
+        ///> the number of threads to parse a memory-mapped file with; `0` to use one thread per hardware thread
+        std::size_t num_threads = 0;
+        ///> the minimal size in bytes of the chunks a memory-mapped file is split into to be parsed in parallel
+        std::size_t chunk_size = 1UL << 20;
 
         /** Creates a `Config` for CSV files, with `delimiter`, `escape`, and `quote` set accordingly to RFC 4180 (see
          * https://www.rfc-editor.org/rfc/rfc4180 ). */
@@ -72,16 +77,30 @@ struct M_EXPORT DSVReader : Reader, ConstTypeVisitor
 
     Position pos;
     char c;
-    std::istream *in = nullptr;
+    std::istream *in = nullptr; ///< the input stream, if reading from a stream
+    const char *mem = nullptr; ///< the next character to read, if reading from memory
+    const char *mem_end = nullptr; ///< the end of the input, if reading from memory
     std::vector<char> buf;
     Tuple tup; ///< intermediate tuple to store values of a row
     std::size_t col_idx;
+    const Attribute *ts_begin = nullptr; ///< the hidden attribute `$ts_begin`, if reading within a transaction
+    const Attribute *ts_end = nullptr; ///< the hidden attribute `$ts_end`, if reading within a transaction
 
     public:
     DSVReader(const Table &table, Config cfg, Diagnostic &diag, Scheduler::Transaction *transaction = nullptr);
 
     void operator()(std::istream &in, const char *name) override;
 
+    /** Reads the \p size bytes of DSV input at \p data.  The input is split into chunks at row boundaries, which are
+     * parsed by `Config::num_threads` threads in parallel, each writing its rows directly into the store of the table.
+     * Messages refer to the input by \p name. */
+    void read_memory(const char *data, std::size_t size, const char *name);
+
+    /** Reads the DSV file at \p path.  A regular file is memory-mapped and read with `read_memory()`, any other file,
+     * e.g. a pipe, is read as a stream.  Messages refer to the file by \p name, or by \p path if \p name is `nullptr`.
+     * Returns `false`, with `errno` set accordingly, iff the file cannot be opened. */
+    bool read_file(const std::filesystem::path &path, const char *name = nullptr);
+
     const Config & config() const { return cfg_; }
     size_t num_rows() const { return cfg_.num_rows; }
     size_t delimiter() const { return cfg_.delimiter; }
@@ -113,9 +132,21 @@ struct M_EXPORT DSVReader : Reader, ConstTypeVisitor
             default:
                 pos.column++;
         }
-        return c = in->get();
+        if (in)
+            return c = in->get();
+        return c = mem != mem_end ? *mem++ : EOF;
     };
 
+    /** Returns `false` iff the end of the input was reached. */
+    bool good() const { return in ? in->good() : mem != mem_end or c != EOF; }
+
+    /** Starts reading the input named \p name, preceded by \p line lines, by reading its first character. */
+    void begin_input(const char *name, unsigned line = 0) {
+        c = '\n';
+        pos = Position(name, line, 0);
+        step();
+    }
+
     void push() { buf.push_back(c); step(); }
 
     bool accept(char chr) { if (c == chr) { step(); return true; } return false; }
@@ -130,6 +161,15 @@ struct M_EXPORT DSVReader : Reader, ConstTypeVisitor
     }
     void discard_row() { while (c != EOF and c != '\n') { step(); } }
 
+    /** Reads the header of the input, if any, and returns the attributes of the columns, in order.  The attribute of a
+     * column that does not belong to the table is `nullptr`. */
+    std::vector<const Attribute*> read_header();
+    /** Reads the next row of the input into `tup`, setting the timestamps if reading within a transaction.  Returns
+     * `false` iff the row is malformed and must be dropped. */
+    bool read_row(const std::vector<const Attribute*> &columns);
+    /** Reads rows of the input, up to `Config::num_rows`, and appends them to the store of the table. */
+    void read_rows(const std::vector<const Attribute*> &columns);
+
     int64_t read_unsigned_int();
 };
 
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <cstdint>
+#include <mutable/catalog/Schema.hpp>
+#include <mutable/IR/Operator.hpp>
+#include <mutable/IR/Tuple.hpp>
+#include <mutable/mutable-config.hpp>
+#include <mutable/storage/DataLayout.hpp>
+#include <optional>
+#include <vector>
+
+
+namespace m {
+
+/** A result set that is *spilled* to a temporary file instead of being kept in memory.
+ *
+ * The batches of result tuples handed to a batch callback of a `CallbackOperator`, see `batch_callback()`, are written
+ * to the file verbatim, i.e. in the `DataLayout` they were produced in.  Hence, spilling neither materializes a `Tuple`
+ * per result nor converts the data.  Afterwards, `for_each_batch()` maps the batches back one at a time.  Since the
+ * file is only paged in on access, arbitrarily large result sets are consumed with memory bounded by the size of a
+ * single batch.  Together with a window of the result set, see `--result-set-window-size`, queries whose results
+ * exceed main memory can thus be materialized and consumed later.
+ *
+ * The file is unlinked upon creation and hence removed as soon as the `SpilledResultSet` is destroyed. */
+struct M_EXPORT SpilledResultSet
+{
+    private:
+    /** A batch of result tuples in the spill file. */
+    struct batch_t
+    {
+        std::size_t offset; ///< the offset of the batch in the file; page aligned
+        std::size_t size; ///< the size of the batch in bytes
+        std::size_t num_tuples; ///< the number of tuples in the batch
+    };
+
+    int fd_ = -1; ///< file descriptor of the spill file
+    std::size_t file_size_ = 0; ///< the size of the spill file in bytes
+    std::optional<Schema> operator_schema_; ///< the schema of the `CallbackOperator`, set by the first batch
+    std::optional<Schema> schema_; ///< the schema of the materialized attributes, set by the first batch
+    storage::DataLayout layout_; ///< the layout of the tuples, copied from the first batch
+    Tuple constants_; ///< the constants of the operator's schema, copied from the first batch
+    std::vector<batch_t> batches_; ///< all spilled batches, in order
+    std::size_t num_tuples_ = 0; ///< the total number of spilled tuples
+
+    public:
+    /** Creates a `SpilledResultSet` with a temporary file in \p directory.  If \p directory is `nullptr`, the directory
+     * given by the environment variable `TMPDIR` or, if unset, `/tmp` is used.  Throws `m::runtime_error` if the file
+     * cannot be created. */
+    explicit SpilledResultSet(const char *directory = nullptr);
+    ~SpilledResultSet();
+    SpilledResultSet(const SpilledResultSet&) = delete;
+    SpilledResultSet & operator=(const SpilledResultSet&) = delete;
+
+    /** Returns the number of spilled tuples. */
+    std::size_t num_tuples() const { return num_tuples_; }
+    /** Returns the number of spilled batches. */
+    std::size_t num_batches() const { return batches_.size(); }
+    /** Returns the size of the spill file in bytes. */
+    std::size_t size_in_bytes() const { return file_size_; }
+
+    /** Appends the tuples of \p batch, produced by a `CallbackOperator` with `Schema` \p schema, to the spill file.  All
+     * batches must be produced by the same operator and in the same `DataLayout`.  Throws `m::runtime_error` if writing
+     * the file fails. */
+    void append(const Schema &schema, const CallbackOperator::batch_type &batch);
+
+    /** Returns a batch callback for a `CallbackOperator` that appends every batch to this `SpilledResultSet`. */
+    CallbackOperator::batch_callback_type batch_callback() {
+        return [this](const Schema &schema, const CallbackOperator::batch_type &batch) { append(schema, batch); };
+    }
+
+    /** Maps the spilled batches back one at a time, in the order they were appended, and hands them to \p callback
+     * exactly like they were handed to the batch callback.  Each batch is only valid during the invocation of
+     * \p callback.  Throws `m::runtime_error` if mapping the file fails. */
+    void for_each_batch(const CallbackOperator::batch_callback_type &callback) const;
+};
+
+}
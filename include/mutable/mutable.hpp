@@ -10,6 +10,7 @@
 #include <mutable/catalog/DatabaseCommand.hpp>
 #include <mutable/catalog/Schema.hpp>
 #include <mutable/catalog/Type.hpp>
+#include <mutable/io/ArrowExport.hpp>
 #include <mutable/IR/CNF.hpp>
 #include <mutable/IR/Operator.hpp>
 #include <mutable/IR/Optimizer.hpp>
@@ -20,8 +21,11 @@
 #include <mutable/lex/Token.hpp>
 #include <mutable/lex/TokenType.hpp>
 #include <mutable/parse/AST.hpp>
+#include <mutable/storage/Compression.hpp>
 #include <mutable/storage/DataLayout.hpp>
+#include <mutable/storage/Snapshot.hpp>
 #include <mutable/storage/Store.hpp>
+#include <mutable/storage/ZoneMap.hpp>
 #include <mutable/util/ADT.hpp>
 #include <mutable/util/ArgParser.hpp>
 #include <mutable/util/Diagnostic.hpp>
@@ -35,6 +39,9 @@
 #include <mutable/util/Position.hpp>
 #include <mutable/util/Timer.hpp>
 #include <mutable/version.hpp>
+#include <type_traits>
+#include <variant>
+#include <vector>
 
 
 namespace m {
@@ -86,6 +93,71 @@ void M_EXPORT execute_query(Diagnostic &diag, const ast::SelectStmt &stmt, std::
 void M_EXPORT execute_query(Diagnostic &diag, const ast::SelectStmt &stmt, std::unique_ptr<Consumer> consumer,
                             const Backend &backend);
 
+/** Optimizes and executes the given `SelectStmt`.  The result set is exported as Apache Arrow record batches, which are
+ * passed to \p callback, see `ArrowExportOperator`.  The `Backend` is automatically created. */
+void M_EXPORT execute_query_to_arrow(Diagnostic &diag, const ast::SelectStmt &stmt,
+                                     ArrowExportOperator::record_batch_callback_type callback);
+
+/** A `SelectStmt` that is parsed, semantically analyzed, optimized, and covered by a physical plan exactly once, by
+ * `prepare()`, and that can then be executed repeatedly, by `execute()`.  The statement may contain *parameters*,
+ * written as `?`, whose values are bound anew for every execution.  The type of a parameter is inferred from the other
+ * operand of the binary expression the parameter occurs in, e.g. in `WHERE a = ?` the parameter is of type `INT(8)`
+ * if `a` is an integer. */
+struct M_EXPORT PreparedStatement
+{
+    /** The value of a parameter.  Integers are bound to integral and floating-point parameters, floating-point numbers
+     * to floating-point parameters.  Strings are bound to parameters of character sequence type and, in the formats
+     * `YYYY-MM-DD` and `YYYY-MM-DD HH:MM:SS`, to parameters of type `DATE` and `DATETIME`, respectively.  Binding
+     * `NULL` is not supported. */
+    using parameter_type = std::variant<bool, int64_t, double, std::string>;
+
+    private:
+    /* The members are declared in the order of their dependencies: each plan refers to its predecessors. */
+    std::unique_ptr<ast::Stmt> stmt_; ///< the analyzed statement
+    std::vector<ast::Parameter*> parameters_; ///< the parameters of `stmt_`, in order of occurrence
+    std::unique_ptr<Consumer> logical_plan_; ///< the optimized logical plan
+    std::unique_ptr<MatchBase> physical_plan_; ///< the physical plan covering `logical_plan_`
+
+    public:
+    PreparedStatement(std::unique_ptr<ast::Stmt> stmt, std::vector<ast::Parameter*> parameters,
+                      std::unique_ptr<Consumer> logical_plan, std::unique_ptr<MatchBase> physical_plan);
+
+    const ast::SelectStmt & statement() const { return as<const ast::SelectStmt>(*stmt_); }
+    std::size_t num_parameters() const { return parameters_.size(); }
+    const ast::Parameter & parameter(std::size_t idx) const { return *parameters_.at(idx); }
+    const Consumer & logical_plan() const { return *logical_plan_; }
+    const MatchBase & physical_plan() const { return *physical_plan_; }
+
+    /** Binds \p params to the parameters of this statement, in order of occurrence.  Reports an error to \p diag and
+     * throws `m::invalid_argument` if the number of values does not match the number of parameters or if a value
+     * cannot be bound to the respective parameter. */
+    void bind(Diagnostic &diag, const std::vector<parameter_type> &params);
+
+    /** Discards the execution state that the `Backend` associated with the operators of the logical plan, such that
+     * the next execution starts afresh with the current parameter values. */
+    void reset() const;
+};
+
+/** Uses lexer, parser, semantic analysis, and the optimizer to prepare the `SelectStmt` in \p sql for repeated
+ * execution.  Result tuples of every execution are passed to the given \p consumer.  The `Backend` is automatically
+ * created. */
+std::unique_ptr<PreparedStatement> M_EXPORT prepare(Diagnostic &diag, const std::string &sql,
+                                                    std::unique_ptr<Consumer> consumer);
+
+/** Binds \p params to the parameters of \p stmt and executes it.  The `Backend` is automatically created. */
+void M_EXPORT execute(Diagnostic &diag, PreparedStatement &stmt,
+                      const std::vector<PreparedStatement::parameter_type> &params);
+
+/** Binds \p params to the parameters of \p stmt and executes it.  The `Backend` is automatically created. */
+template<typename... Params>
+requires (std::is_constructible_v<PreparedStatement::parameter_type, Params&&> and ...)
+void execute(Diagnostic &diag, PreparedStatement &stmt, Params&&... params)
+{
+    execute(diag, stmt, std::vector<PreparedStatement::parameter_type>{
+        PreparedStatement::parameter_type(std::forward<Params>(params))...
+    });
+}
+
 /**
  * Loads a CSV file into a `Table`.
  *
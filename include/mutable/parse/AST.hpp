@@ -235,6 +235,33 @@ struct M_EXPORT Constant : Expr
     bool is_datetime() const { return tok.type == TK_DATE_TIME; }
 };
 
+/** A parameter of a prepared statement, written as `?`.  A `Parameter` is a `Constant` whose value is not known at
+ * parse time but bound to the `Parameter` before each execution of the statement.  Its type is inferred by `Sema` from
+ * the context the parameter is used in.  The token of a `Parameter` is unique within its statement, e.g. `?1`, such
+ * that distinct parameters are never considered equal. */
+struct M_EXPORT Parameter : Constant
+{
+    private:
+    unsigned index_; ///< the 0-based position of this parameter in its statement
+    Token value_; ///< the constant bound to this parameter, or an artificial token if unbound
+
+    public:
+    Parameter(Token tok, unsigned index)
+        : Constant(std::move(tok))
+        , index_(index)
+        , value_(Token::CreateArtificial())
+    { }
+
+    unsigned index() const { return index_; }
+
+    bool is_bound() const { return value_.type != TK_EOF; }
+    /** Returns the constant bound to this parameter. */
+    const Token & value() const { M_insist(is_bound(), "parameter is not bound"); return value_; }
+    /** Binds the constant \p value to this parameter. */
+    void bind(Token value) { value_ = std::move(value); }
+    void unbind() { value_ = Token::CreateArtificial(); }
+};
+
 /** A postfix expression. */
 struct M_EXPORT PostfixExpr : Expr
 {
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstddef>
+#include <mutable/mutable-config.hpp>
+
+
+namespace m {
+
+/*----- forward declarations -----------------------------------------------------------------------------------------*/
+struct Table;
+
+namespace compression {
+
+constexpr std::size_t MAX_DICTIONARY_SIZE = 1UL << 16; ///< the maximum number of entries of a dictionary
+
+}
+
+/** Compresses the rows of table \p table with lightweight encodings, see `storage::DataLayout::encoding_t`.  For every
+ * column, the encoding is chosen by the values currently stored in the column:
+ *
+ * - integral columns, i.e. integers, decimals, dates, and datetimes, are *frame-of-reference* encoded with the smallest
+ *   value of the column as reference and *bit-packed* to the smallest number of whole bytes covering the range of the
+ *   values
+ * - character sequence columns with at most `compression::MAX_DICTIONARY_SIZE` distinct values are *dictionary* encoded
+ *
+ * A column is encoded only if its codes are narrower than its values.  The encoded rows are written into a new `Store`
+ * created by the current store factory, see `Catalog::create_store()`, and laid out by a `DataLayout` of the current
+ * data layout factory, see `Catalog::data_layout()`, whose leaves are sized by the codes.  Scans decode the values on
+ * the fly.  Rows must not be appended to a compressed table, see `decompress_table()`.  Compressing an empty or an
+ * already compressed table has no effect.
+ *
+ * @return `true` iff any column of \p table was encoded
+ */
+bool M_EXPORT compress_table(Table &table);
+
+/** Decompresses the rows of the table \p table, i.e. decodes the rows of a table compressed by `compress_table()` and
+ * writes them into a new `Store` laid out by a `DataLayout` of the current data layout factory.  Decompressing a table
+ * that is not compressed has no effect. */
+void M_EXPORT decompress_table(Table &table);
+
+}
@@ -7,6 +7,7 @@
 #include <mutable/util/exception.hpp>
 #include <mutable/util/macro.hpp>
 #include <mutable/util/Visitor.hpp>
+#include <string>
 #include <vector>
 
 
@@ -67,8 +68,46 @@ struct M_EXPORT DataLayout
         virtual void accept(ConstDataLayoutVisitor &v) const = 0;
     };
 
+    /** A lightweight encoding of the values of a `Leaf`.  An encoded `Leaf` does not store the values of its `Type`
+     * but unsigned integral *codes* of `stored_type`, from which the values are decoded on access:
+     *
+     * - *frame-of-reference*: the value is `reference + code`; since the codes are narrower than the values, this
+     *   also *bit-packs* the values to the smallest number of whole bytes required by the range of the values
+     * - *dictionary*: the value is the `code`-th entry of `dictionary`, where each entry has `entry_size` bytes and is
+     *   laid out exactly like a value of the `Leaf`'s `CharacterSequence` type
+     *
+     * The offset and stride of an encoded `Leaf` refer to its codes, i.e. they are computed by the size of
+     * `stored_type`. */
+    struct M_EXPORT encoding_t
+    {
+        enum kind_t { E_None, E_FrameOfReference, E_Dictionary };
+
+        ///> the kind of this encoding
+        kind_t kind = E_None;
+        ///> the integral `Type` of the codes; the codes are interpreted as unsigned
+        const m::Type *stored_type = nullptr;
+        ///> the smallest value of a frame-of-reference encoded `Leaf`
+        int64_t reference = 0;
+        ///> the entries of a dictionary encoded `Leaf`, laid out consecutively
+        std::shared_ptr<const std::string> dictionary;
+        ///> the size in bytes of a single entry of `dictionary`
+        std::size_t entry_size = 0;
+
+        ///> returns `true` iff this is not `E_None`
+        operator bool() const { return kind != E_None; }
+
+        ///> returns the number of entries of `dictionary`
+        std::size_t num_entries() const { return dictionary ? dictionary->size() / entry_size : 0; }
+        ///> returns the address of the \p code -th entry of `dictionary`
+        const char * entry(std::size_t code) const {
+            M_insist(code < num_entries(), "code out of bounds");
+            return dictionary->data() + code * entry_size;
+        }
+    };
+
     /** The `Leaf` represents exactly one attribue.  It holds the `Type` of the `Attribute` together with a unique
-     * index.  With the unique index it is possible to associate the `Attribute` to this `Leaf`. */
+     * index.  With the unique index it is possible to associate the `Attribute` to this `Leaf`.  Optionally, the
+     * values of the `Leaf` are encoded, see `encoding_t`. */
     struct M_EXPORT Leaf : Node
     {
         friend struct DataLayout;
@@ -79,14 +118,23 @@ struct M_EXPORT DataLayout
         const m::Type *type_;
         ///> an index that must be unique within the entire `DataLayout`
         size_type idx_;
+        ///> the encoding of the values of this `Leaf`
+        encoding_t encoding_;
 
-        Leaf(const m::Type *type, size_type idx) : type_(type), idx_(idx) { }
+        Leaf(const m::Type *type, size_type idx, encoding_t encoding)
+            : type_(type), idx_(idx), encoding_(std::move(encoding))
+        { }
 
         public:
         /** Returns the `Type` of this `Leaf`. */
         const m::Type * type() const { return type_; }
         /** Returns the index assigned to this `Leaf`.  Must be unique within the entire `DataLayout`. */
         size_type index() const { return idx_; }
+        /** Returns the encoding of this `Leaf`. */
+        const encoding_t & encoding() const { return encoding_; }
+        /** Returns the `Type` of the data physically stored for this `Leaf`, i.e. the `Type` of the codes if this `Leaf`
+         * is encoded and its `Type` otherwise. */
+        const m::Type * stored_type() const { return encoding_ ? encoding_.stored_type : type_; }
 
         size_type num_tuples() const override { return 1; }
 
@@ -156,7 +204,13 @@ struct M_EXPORT DataLayout
 
         /** Creates a `Leaf` and adds it as a child to this `INode`.  The created `Leaf` will have the given, relative
          * \p offset_in_bits and \p stride_in_bits within this `INode`. */
-        Leaf & add_leaf(const m::Type *type, size_type idx, uint64_t offset_in_bits, uint64_t stride_in_bits);
+        Leaf & add_leaf(const m::Type *type, size_type idx, uint64_t offset_in_bits, uint64_t stride_in_bits) {
+            return add_leaf(type, idx, offset_in_bits, stride_in_bits, encoding_t());
+        }
+        /** Creates a `Leaf` and adds it as a child to this `INode`.  The created `Leaf` will have the given, relative
+         * \p offset_in_bits and \p stride_in_bits within this `INode` and the given \p encoding. */
+        Leaf & add_leaf(const m::Type *type, size_type idx, uint64_t offset_in_bits, uint64_t stride_in_bits,
+                        encoding_t encoding);
         /** Creates an `INode` and adds it as a child to this `INode`.  The created `INode` represents \p num_tuples
          * many tuples and will have the given, relative \p offset_in_bits and \p stride_in_bits. */
         INode & add_inode(size_type num_tuples, uint64_t offset_in_bits, uint64_t stride_in_bits);
@@ -215,12 +269,21 @@ struct M_EXPORT DataLayout
 
     /** Creates a `Leaf` and adds it as a child to this `DataLayout`'s internal `INode`.  The created `Leaf` will have
      * the given, relative \p offset_in_bits and \p stride_in_bits within the internal `INode`. */
-    Leaf & add_leaf(const m::Type *type, size_type idx, uint64_t stride_in_bits);
+    Leaf & add_leaf(const m::Type *type, size_type idx, uint64_t stride_in_bits) {
+        return add_leaf(type, idx, stride_in_bits, encoding_t());
+    }
+    /** Creates a `Leaf` and adds it as a child to this `DataLayout`'s internal `INode`.  The created `Leaf` will have
+     * the given, relative \p offset_in_bits and \p stride_in_bits within the internal `INode` and the given
+     * \p encoding. */
+    Leaf & add_leaf(const m::Type *type, size_type idx, uint64_t stride_in_bits, encoding_t encoding);
     /** Creates an `INode` and adds it as a child to this `DataLayout`'s internal `INode`.  The created `INode`
      * represents \p num_tuples many tuples and will have the given, relative \p offset_in_bits and \p stride_in_bits.
      */
     INode & add_inode(size_type num_tuples, uint64_t stride_in_bits);
 
+    ///> returns `true` iff any `Leaf` of this `DataLayout` is encoded
+    bool is_encoded() const;
+
     void accept(ConstDataLayoutVisitor &v) const;
     void for_sibling_leaves(callback_leaves_t callback) const;
 
@@ -1,12 +1,17 @@
 #pragma once
 
 #include <algorithm>
+#include <bit>
 #include <cmath>
 #include <cstring>
+#include <functional>
 #include <iostream>
+#include <iterator>
+#include <limits>
 #include <mutable/util/concepts.hpp>
 #include <mutable/util/exception.hpp>
 #include <mutable/util/macro.hpp>
+#include <mutable/util/memory.hpp>
 #include <utility>
 #include <vector>
 
@@ -16,11 +21,12 @@ namespace m {
 // Forward declarations
 struct Table;
 struct Schema;
+struct Tuple;
 
 namespace idx {
 
 /** An enum class that lists all supported index methods. */
-enum class IndexMethod { Array, Rmi };
+enum class IndexMethod { Array, Rmi, BPlusTree, Hash };
 
 /** The base class for indexes. */
 struct IndexBase
@@ -34,17 +40,38 @@ struct IndexBase
 
     /** Bulkloads the index by executing a query on \p table using \p key_schema. */
     virtual void bulkload(const Table &table, const Schema &key_schema) = 0;
+    /** Adds the key at index \p idx of \p tuple, unless it is `NULL`, with \p tuple_id to the index.  Used to
+     * maintain the index incrementally when rows are appended to its table.  The entry may be kept pending until the
+     * next call to `merge()`. */
+    virtual void insert(const Tuple &tuple, std::size_t idx, std::size_t tuple_id) = 0;
+    /** Returns `true` iff entries added by `insert()` are pending, i.e. not yet visible to lookups. */
+    virtual bool has_pending() const { return false; }
+    /** Merges all pending entries into the index s.t. they are visible to lookups. */
+    virtual void merge() { }
     /* Returns the number of entries in the index. */
     virtual std::size_t num_entries() const = 0;
     /** Returns the `IndexMethod` of the index. */
     virtual IndexMethod method() const = 0;
 
+    /** Returns the memory containing the index if generated code may access the index directly, e.g. after mapping the
+     * memory into a WebAssembly module, and `nullptr` otherwise. */
+    virtual const memory::Memory * exposed_memory() const { return nullptr; }
+    /** Returns the number of bytes at the beginning of `exposed_memory()` that are occupied by the index. */
+    virtual std::size_t exposed_memory_size() const { return 0; }
+
     virtual void dump(std::ostream &out) const = 0;
     virtual void dump() const = 0;
 
     protected:
     /** Constructs a query string to select all attributes in \p schema from \p table. */
     static std::string build_query(const Table &table, const Schema &schema);
+
+    /** Executes a query on \p table to retrieve the key contained in \p key_schema and calls \p add with every key
+     * that is not `NULL` and its `tuple_id`.  Throws `m::invalid_argument` if \p key_schema contains more than one
+     * entry or \p Key and the attribute type of the entry in \p key_schema do not match. */
+    template<typename Key>
+    static void scan_keys(const Table &table, const Schema &key_schema,
+                          const std::function<void(Key, std::size_t)> &add);
 };
 
 /** A simple index based on a sorted array that maps keys to their `tuple_id`. */
@@ -59,6 +86,7 @@ struct ArrayIndex : IndexBase
 
     protected:
     container_type data_; ///< A vector holding the index entries consisting of pairs of key and value
+    container_type delta_; ///< entries inserted into the finalized index, pending to be merged into `data_`
     bool finalized_; ///< flag to signalize whether index is finalized, i.e. array is sorted
 
     /** Custom comparator class to handle the special case of \tparam key_type being `const char*`. */
@@ -85,8 +113,16 @@ struct ArrayIndex : IndexBase
      * more than one entry or `key_type` and the attribute type of the entry in \p key_schema do not match. */
     void bulkload(const Table &table, const Schema &key_schema) override;
 
-    /** Returns the number of entries in the index. */
-    std::size_t num_entries() const override { return data_.size(); }
+    /** Adds the key at index \p idx of \p tuple, unless it is `NULL`, with \p tuple_id to the index.  If the index is
+     * finalized, the entry is buffered in a delta and kept pending until `merge()`, s.t. the sorted array is not
+     * rebuilt on every insertion. */
+    void insert(const Tuple &tuple, std::size_t idx, std::size_t tuple_id) override;
+    bool has_pending() const override { return not delta_.empty(); }
+    /** Sorts the pending entries and merges them into the sorted array. */
+    void merge() override;
+
+    /** Returns the number of entries in the index, including pending entries. */
+    std::size_t num_entries() const override { return data_.size() + delta_.size(); }
 
     /** Returns the `IndexMethod` of the index. */
     IndexMethod method() const override { return IndexMethod::Array; }
@@ -216,6 +252,9 @@ struct RecursiveModelIndex : ArrayIndex<Key>
     /** Sorts the underlying vector, builds the linear models, and flags the index as finalized. */
     void finalize() override;
 
+    /** Merges the pending entries into the sorted array and retrains the linear models. */
+    void merge() override;
+
     /** Returns an iterator pointing to the first entry of the vector such that `entry.key` < \p key is `false`, i.e.
      * that is greater than or equal to \p key, or `end()` if no such element is found.  Throws `m::exception` if the
      * index is not finalized. */
@@ -232,13 +271,36 @@ struct RecursiveModelIndex : ArrayIndex<Key>
         return upper_bound_exponential_search(base_type::begin() + predict(key), key);
     }
 
+    ///> the number of keys whose lookups are interleaved by `lower_bound_batch()` and `upper_bound_batch()`
+    static constexpr std::size_t BATCH_SIZE = 16;
+
+    /** Computes `lower_bound()` of each of the \p num_keys keys at \p keys and writes the results to \p out.  Keys are
+     * looked up in batches of `BATCH_SIZE`: first, the models are evaluated for all keys of a batch using SIMD, then the
+     * predicted entries are prefetched, and only then the predictions are corrected by exponential search.  Thereby,
+     * the cache misses of the lookups of a batch overlap.  Throws `m::exception` if the index is not finalized. */
+    void lower_bound_batch(const key_type *keys, std::size_t num_keys, const_iterator *out) const;
+
+    /** Computes `upper_bound()` of each of the \p num_keys keys at \p keys and writes the results to \p out, see
+     * `lower_bound_batch()`.  Throws `m::exception` if the index is not finalized. */
+    void upper_bound_batch(const key_type *keys, std::size_t num_keys, const_iterator *out) const;
+
     void dump(std::ostream &out) const override { out << "RecursiveModelIndex<" << typeid(key_type).name() << '>' << std::endl; }
     void dump() const override { dump(std::cerr); }
 
     private:
+    /** Builds the linear models on the sorted underlying vector. */
+    void train();
+
+    /** Computes `upper_bound()` if \tparam IsUpper and `lower_bound()` otherwise of each of the \p num_keys keys at
+     * \p keys in batches and writes the results to \p out. */
+    template<bool IsUpper>
+    void bound_batch(const key_type *keys, std::size_t num_keys, const_iterator *out) const;
+
     std::size_t predict(const key_type key) const {
         auto segment_id = std::clamp<double>(models_[0](key), 0, models_.size() - 2);
-        auto pred = std::clamp<double>(models_[segment_id + 1](key), 0, base_type::data_.size());
+        /* Clamp to the last entry, s.t. the prediction can be dereferenced by the exponential search. */
+        auto pred = std::clamp<double>(models_[segment_id + 1](key), 0,
+                                       std::max<std::size_t>(base_type::data_.size(), 1) - 1);
         return static_cast<std::size_t>(pred);
     }
     const_iterator lower_bound_exponential_search(const_iterator pred, const key_type value) const {
@@ -291,6 +353,360 @@ struct RecursiveModelIndex : ArrayIndex<Key>
     }
 };
 
+/** A B+-tree that maps keys to their `tuple_id`.  Every node occupies exactly one cache line.  All nodes are allocated
+ * from a single, page-aligned `memory::Memory` and reference each other by their position therein, s.t. the tree can be
+ * mapped into the linear memory of a WebAssembly module and be traversed by generated code.  In contrast to
+ * `ArrayIndex`, entries can be added at any time and the index is always usable, i.e. it needs not be finalized.
+ *
+ * A node starts with a `header_t`, followed by the keys at offset `KEYS_OFFSET`.  Leaves store the `tuple_id`s of
+ * their keys at offset `VALUES_OFFSET` and link to their right sibling.  Inner nodes with *n* keys store *n + 1*
+ * children at offset `CHILDREN_OFFSET`; all keys in the subtree of child *i* are less than or equal to key *i*, which is
+ * less than or equal to all keys in the subtree of child *i + 1*.  Node 0 is never used s.t. 0 can denote the absence
+ * of a node. */
+template<arithmetic Key>
+struct BPlusTreeIndex : IndexBase
+{
+    using key_type = Key;
+    using value_type = uint32_t;
+    using entry_type = std::pair<key_type, value_type>;
+    using node_id_type = uint32_t;
+
+    /** The header of every node. */
+    struct header_t
+    {
+        uint16_t num_keys; ///< the number of keys in the node
+        uint16_t is_leaf; ///< whether the node is a leaf
+        node_id_type next; ///< for leaves, the right sibling or 0 if there is none; unused for inner nodes
+    };
+
+    ///> the size of a node in bytes, i.e. one cache line
+    static constexpr std::size_t NODE_SIZE = 64;
+    ///> the memory reserved for the nodes; as the tree is mapped into the linear memory of WebAssembly modules, it is
+    ///> limited to a fraction of their 4 GiB address space
+    static constexpr std::size_t ALLOCATION_SIZE = 1UL << 30; ///< 1 GiB
+    ///> the offset of the keys within a node
+    static constexpr std::size_t KEYS_OFFSET = sizeof(header_t);
+    static_assert(sizeof(value_type) == 4 and sizeof(node_id_type) == 4, "offsets are aligned to 4 bytes");
+    ///> the maximum number of keys of a leaf
+    static constexpr std::size_t LEAF_CAPACITY = []() {
+        std::size_t n = 0;
+        while (((KEYS_OFFSET + (n + 1) * sizeof(key_type) + 3UL) & ~3UL) +
+               (n + 1) * sizeof(value_type) <= NODE_SIZE)
+            ++n;
+        return n;
+    }();
+    ///> the maximum number of keys of an inner node
+    static constexpr std::size_t INNER_CAPACITY = []() {
+        std::size_t n = 0;
+        while (((KEYS_OFFSET + (n + 1) * sizeof(key_type) + 3UL) & ~3UL) +
+               (n + 2) * sizeof(node_id_type) <= NODE_SIZE)
+            ++n;
+        return n;
+    }();
+    ///> the offset of the `tuple_id`s within a leaf
+    static constexpr std::size_t VALUES_OFFSET =
+        ((KEYS_OFFSET + LEAF_CAPACITY * sizeof(key_type) + 3UL) & ~3UL);
+    ///> the offset of the children within an inner node
+    static constexpr std::size_t CHILDREN_OFFSET =
+        ((KEYS_OFFSET + INNER_CAPACITY * sizeof(key_type) + 3UL) & ~3UL);
+    ///> the leftmost leaf, which is never moved by splits
+    static constexpr node_id_type FIRST_LEAF = 1;
+
+    static_assert(sizeof(header_t) == 8);
+    static_assert(KEYS_OFFSET % alignof(key_type) == 0);
+    static_assert(LEAF_CAPACITY >= 2 and INNER_CAPACITY >= 2, "nodes must be able to split");
+
+    /** An iterator over the entries of the index in ascending order of their keys. */
+    struct const_iterator
+    {
+        using value_type = entry_type;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const entry_type*;
+        using reference = const entry_type&;
+        using iterator_category = std::forward_iterator_tag;
+
+        private:
+        const BPlusTreeIndex *index_ = nullptr;
+        node_id_type leaf_ = 0; ///< the current leaf or 0 if past the end
+        std::size_t pos_ = 0; ///< the position within the current leaf
+        entry_type entry_; ///< the current entry
+
+        public:
+        const_iterator() = default;
+        const_iterator(const BPlusTreeIndex &index, node_id_type leaf, std::size_t pos)
+            : index_(&index), leaf_(leaf), pos_(pos)
+        {
+            advance_to_entry();
+        }
+
+        bool operator==(const const_iterator &other) const { return leaf_ == other.leaf_ and pos_ == other.pos_; }
+        bool operator!=(const const_iterator &other) const { return not operator==(other); }
+
+        const_iterator & operator++() { ++pos_; advance_to_entry(); return *this; }
+        const_iterator operator++(int) { const_iterator old = *this; operator++(); return old; }
+
+        reference operator*() const { M_insist(leaf_, "iterator past the end"); return entry_; }
+        pointer operator->() const { return &operator*(); }
+
+        private:
+        /** Moves to the next leaf as long as the current leaf has no entry at the current position. */
+        void advance_to_entry() {
+            while (leaf_ and pos_ == index_->header(leaf_).num_keys) {
+                leaf_ = index_->header(leaf_).next;
+                pos_ = 0;
+            }
+            if (leaf_)
+                entry_ = { index_->keys(leaf_)[pos_], index_->values(leaf_)[pos_] };
+        }
+    };
+
+    private:
+    memory::LinearAllocator allocator_; ///< the allocator of the node memory
+    memory::Memory nodes_; ///< the memory containing all nodes
+    std::size_t num_nodes_ = 0; ///< the number of allocated nodes, including node 0
+    node_id_type root_ = 0; ///< the root node
+    std::size_t height_ = 0; ///< the number of levels of the tree, i.e. 1 if the root is a leaf
+    std::size_t num_entries_ = 0; ///< the number of entries
+
+    public:
+    BPlusTreeIndex();
+
+    /** Bulkloads the index from \p table on the key contained in \p key_schema by executing a query.  If the index is
+     * empty, the entries are sorted and packed densely into the leaves, and the inner nodes are built bottom-up.
+     * Otherwise, the entries are added one after another.  Throws `m::invalid_argument` if \p key_schema contains more
+     * than one entry or `key_type` and the attribute type of the entry in \p key_schema do not match. */
+    void bulkload(const Table &table, const Schema &key_schema) override;
+
+    /** Adds the key at index \p idx of \p tuple, unless it is `NULL`, with \p tuple_id directly to the tree, see
+     * `add()`. */
+    void insert(const Tuple &tuple, std::size_t idx, std::size_t tuple_id) override;
+
+    /** Returns the number of entries in the index. */
+    std::size_t num_entries() const override { return num_entries_; }
+
+    /** Returns the `IndexMethod` of the index. */
+    IndexMethod method() const override { return IndexMethod::BPlusTree; }
+
+    /** Adds a single pair of \p key and \p value to the index.  Splits full nodes on the path from the root to the leaf
+     * the entry is added to.  Entries with equal keys are kept in the order they were added.  Throws
+     * `m::runtime_error` if the node memory is exhausted. */
+    void add(const key_type key, const std::size_t value);
+
+    /** Returns an iterator pointing to the first entry whose key is greater than or equal to \p key, or `end()` if no
+     * such entry exists. */
+    const_iterator lower_bound(const key_type key) const { return seek<false>(key); }
+
+    /** Returns an iterator pointing to the first entry whose key is strictly greater than \p key, or `end()` if no such
+     * entry exists. */
+    const_iterator upper_bound(const key_type key) const { return seek<true>(key); }
+
+    /** Returns an iterator pointing to the first entry of the index. */
+    const_iterator begin()  const { return const_iterator(*this, FIRST_LEAF, 0); }
+    const_iterator cbegin() const { return begin(); }
+    /** Returns an interator pointing to the first element following the last entry of the index. */
+    const_iterator end()  const { return const_iterator(); }
+    const_iterator cend() const { return end(); }
+
+    /** Returns the root node. */
+    node_id_type root() const { return root_; }
+    /** Returns the number of levels of the tree, i.e. 1 if the root is a leaf. */
+    std::size_t height() const { return height_; }
+    /** Returns the number of allocated nodes, including the unused node 0. */
+    std::size_t num_nodes() const { return num_nodes_; }
+
+    /** Returns the memory containing all nodes.  Node *i* is located at byte offset *i* × `NODE_SIZE`. */
+    const memory::Memory * exposed_memory() const override { return &nodes_; }
+    /** Returns the number of bytes of `exposed_memory()` occupied by allocated nodes. */
+    std::size_t exposed_memory_size() const override { return num_nodes_ * NODE_SIZE; }
+
+    /** Returns the header of node \p node. */
+    const header_t & header(node_id_type node) const { return *reinterpret_cast<const header_t*>(address(node)); }
+    /** Returns the keys of node \p node. */
+    const key_type * keys(node_id_type node) const {
+        return reinterpret_cast<const key_type*>(address(node) + KEYS_OFFSET);
+    }
+    /** Returns the `tuple_id`s of leaf \p leaf. */
+    const value_type * values(node_id_type leaf) const {
+        M_insist(header(leaf).is_leaf, "only leaves have values");
+        return reinterpret_cast<const value_type*>(address(leaf) + VALUES_OFFSET);
+    }
+    /** Returns the children of inner node \p node. */
+    const node_id_type * children(node_id_type node) const {
+        M_insist(not header(node).is_leaf, "only inner nodes have children");
+        return reinterpret_cast<const node_id_type*>(address(node) + CHILDREN_OFFSET);
+    }
+
+    void dump(std::ostream &out) const override {
+        out << "BPlusTreeIndex<" << typeid(key_type).name() << "> with " << num_entries_ << " entries in "
+            << num_nodes_ - 1 << " nodes of height " << height_ << std::endl;
+    }
+    void dump() const override { dump(std::cerr); }
+
+    private:
+    const uint8_t * address(node_id_type node) const {
+        M_insist(node != 0 and node < num_nodes_, "invalid node");
+        return nodes_.as<const uint8_t*>() + node * NODE_SIZE;
+    }
+    uint8_t * address(node_id_type node) {
+        return const_cast<uint8_t*>(static_cast<const BPlusTreeIndex*>(this)->address(node));
+    }
+    header_t & header(node_id_type node) { return *reinterpret_cast<header_t*>(address(node)); }
+    key_type * keys(node_id_type node) { return reinterpret_cast<key_type*>(address(node) + KEYS_OFFSET); }
+    value_type * values(node_id_type leaf) { return reinterpret_cast<value_type*>(address(leaf) + VALUES_OFFSET); }
+    node_id_type * children(node_id_type node) {
+        return reinterpret_cast<node_id_type*>(address(node) + CHILDREN_OFFSET);
+    }
+
+    /** Allocates a fresh, empty node. */
+    node_id_type allocate_node(bool is_leaf);
+
+    /** Returns the position of the first key of node \p node that is greater than (if \tparam Strict) or greater than
+     * or equal to (otherwise) \p key, or the number of keys of the node if no such key exists. */
+    template<bool Strict>
+    std::size_t find_in_node(node_id_type node, const key_type key) const {
+        const auto k = keys(node);
+        const std::size_t n = header(node).num_keys;
+        std::size_t i = 0;
+        while (i != n and (Strict ? not (key < k[i]) : k[i] < key))
+            ++i;
+        return i;
+    }
+
+    /** Returns an iterator pointing to the first entry whose key is greater than (if \tparam Strict) or greater than or
+     * equal to (otherwise) \p key. */
+    template<bool Strict>
+    const_iterator seek(const key_type key) const {
+        node_id_type node = root_;
+        for (std::size_t level = 1; level != height_; ++level)
+            node = children(node)[find_in_node<Strict>(node, key)];
+        return const_iterator(*this, node, find_in_node<Strict>(node, key));
+    }
+};
+
+/** A hash table that maps keys to their `tuple_id`, for point lookups by equality.  The table uses open addressing
+ * with linear probing and stores its slots consecutively in a single, page-aligned `memory::Memory`, s.t. the table can
+ * be mapped into the linear memory of a WebAssembly module and be probed by generated code.  Entries can be added at
+ * any time; the table doubles its capacity whenever the load factor would exceed `MAX_LOAD_FACTOR`.
+ *
+ * The capacity is always a power of two.  The first slot probed for a key is given by the `SLOT_BITS` most significant
+ * bits of the product of `hash()` of the key and `HASH_FACTOR` (Fibonacci hashing), where `SLOT_BITS` is the binary
+ * logarithm of the capacity.  A slot is empty iff its value is `EMPTY`.  Generated code probing the table must compute
+ * the first slot in exactly the same way. */
+template<arithmetic Key>
+struct HashIndex : IndexBase
+{
+    using key_type = Key;
+    using value_type = uint32_t;
+    using entry_type = std::pair<key_type, value_type>;
+
+    /** A slot of the hash table. */
+    struct slot_t
+    {
+        key_type key;
+        value_type value; ///< the `tuple_id` or `EMPTY` if the slot is empty
+    };
+
+    ///> the value of empty slots; hence, `tuple_id`s must be less than `EMPTY`
+    static constexpr value_type EMPTY = std::numeric_limits<value_type>::max();
+    ///> the factor to multiply hashes with to spread them over the most significant bits
+    static constexpr uint64_t HASH_FACTOR = 0x9e3779b97f4a7c15UL;
+    ///> the maximum ratio of entries to slots
+    static constexpr double MAX_LOAD_FACTOR = .5;
+    ///> the capacity of an empty index
+    static constexpr std::size_t INITIAL_CAPACITY = 16;
+    ///> the memory reserved for the slots; as the table is mapped into the linear memory of WebAssembly modules, it is
+    ///> limited to a fraction of their 4 GiB address space
+    static constexpr std::size_t ALLOCATION_SIZE = 1UL << 30; ///< 1 GiB
+
+    private:
+    memory::LinearAllocator allocator_; ///< the allocator of the slot memory
+    memory::Memory slots_; ///< the memory containing all slots
+    std::size_t log2_capacity_ = 0; ///< the binary logarithm of the number of slots
+    std::size_t num_entries_ = 0; ///< the number of entries
+
+    public:
+    HashIndex();
+
+    /** Bulkloads the index from \p table on the key contained in \p key_schema by executing a query and adding one
+     * entry after another.  Throws `m::invalid_argument` if \p key_schema contains more than one entry or `key_type`
+     * and the attribute type of the entry in \p key_schema do not match. */
+    void bulkload(const Table &table, const Schema &key_schema) override;
+
+    /** Adds the key at index \p idx of \p tuple, unless it is `NULL`, with \p tuple_id directly to the hash table, see
+     * `add()`. */
+    void insert(const Tuple &tuple, std::size_t idx, std::size_t tuple_id) override;
+
+    /** Returns the number of entries in the index. */
+    std::size_t num_entries() const override { return num_entries_; }
+
+    /** Returns the `IndexMethod` of the index. */
+    IndexMethod method() const override { return IndexMethod::Hash; }
+
+    /** Adds a single pair of \p key and \p value to the index.  Entries with equal keys are all kept.  Throws
+     * `m::runtime_error` if the slot memory is exhausted. */
+    void add(const key_type key, const std::size_t value);
+
+    /** Grows the capacity of the index s.t. \p num_entries entries can be held without exceeding the maximum load
+     * factor.  Throws `m::runtime_error` if the slot memory is exhausted. */
+    void reserve(std::size_t num_entries);
+
+    /** Calls \p fn with the `tuple_id` of every entry whose key equals \p key. */
+    template<typename Fn>
+    requires std::invocable<Fn, value_type>
+    void for_each_in_equal_range(const key_type key, Fn &&fn) const {
+        const auto mask = capacity() - 1;
+        for (auto s = first_slot(key); slots()[s].value != EMPTY; s = (s + 1) & mask) {
+            if (slots()[s].key == key)
+                fn(slots()[s].value);
+        }
+    }
+
+    /** Returns the number of entries whose key equals \p key. */
+    std::size_t count(const key_type key) const {
+        std::size_t n = 0;
+        for_each_in_equal_range(key, [&n](value_type) { ++n; });
+        return n;
+    }
+
+    /** Returns the number of slots. */
+    std::size_t capacity() const { return 1UL << log2_capacity_; }
+    /** Returns the binary logarithm of the number of slots. */
+    std::size_t log2_capacity() const { return log2_capacity_; }
+    /** Returns the slots. */
+    const slot_t * slots() const { return slots_.as<const slot_t*>(); }
+
+    /** Returns the hash of \p key.  Integers are zero-extended from their unsigned representation and floating-point
+     * numbers are reinterpreted as integers of the same size after normalizing negative zero to positive zero. */
+    static uint64_t hash(const key_type key) {
+        if constexpr (std::floating_point<key_type>) {
+            using bits_type = std::conditional_t<sizeof(key_type) == 4, uint32_t, uint64_t>;
+            return std::bit_cast<bits_type>(key_type(key + key_type(0)));
+        } else {
+            return std::make_unsigned_t<key_type>(key);
+        }
+    }
+
+    /** Returns the first slot to probe for \p key. */
+    std::size_t first_slot(const key_type key) const { return (hash(key) * HASH_FACTOR) >> (64 - log2_capacity_); }
+
+    /** Returns the memory containing all slots.  Slot *i* is located at byte offset *i* × `sizeof(slot_t)`. */
+    const memory::Memory * exposed_memory() const override { return &slots_; }
+    /** Returns the number of bytes of `exposed_memory()` occupied by slots. */
+    std::size_t exposed_memory_size() const override { return capacity() * sizeof(slot_t); }
+
+    void dump(std::ostream &out) const override {
+        out << "HashIndex<" << typeid(key_type).name() << "> with " << num_entries_ << " entries in " << capacity()
+            << " slots" << std::endl;
+    }
+    void dump() const override { dump(std::cerr); }
+
+    private:
+    slot_t * slots() { return slots_.as<slot_t*>(); }
+
+    /** Rehashes all entries into a table of 2^\p log2_capacity slots. */
+    void rehash(std::size_t log2_capacity);
+};
+
 #define M_INDEX_LIST_TEMPLATED(X) \
     X(m::idx::ArrayIndex<bool>) \
     X(m::idx::ArrayIndex<int8_t>) \
@@ -305,7 +721,19 @@ struct RecursiveModelIndex : ArrayIndex<Key>
     X(m::idx::RecursiveModelIndex<int32_t>) \
     X(m::idx::RecursiveModelIndex<int64_t>) \
     X(m::idx::RecursiveModelIndex<float>) \
-    X(m::idx::RecursiveModelIndex<double>)
+    X(m::idx::RecursiveModelIndex<double>) \
+    X(m::idx::BPlusTreeIndex<int8_t>) \
+    X(m::idx::BPlusTreeIndex<int16_t>) \
+    X(m::idx::BPlusTreeIndex<int32_t>) \
+    X(m::idx::BPlusTreeIndex<int64_t>) \
+    X(m::idx::BPlusTreeIndex<float>) \
+    X(m::idx::BPlusTreeIndex<double>) \
+    X(m::idx::HashIndex<int8_t>) \
+    X(m::idx::HashIndex<int16_t>) \
+    X(m::idx::HashIndex<int32_t>) \
+    X(m::idx::HashIndex<int64_t>) \
+    X(m::idx::HashIndex<float>) \
+    X(m::idx::HashIndex<double>)
 
 }
 
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <mutable/mutable-config.hpp>
+
+
+namespace m {
+
+/*----- forward declarations -----------------------------------------------------------------------------------------*/
+struct Database;
+
+/** A *snapshot* is an on-disk image of a `Database`.  It consists of binary metadata, i.e. the schema of every table,
+ * its constraints, and its `storage::DataLayout` including the encodings of its leaves, and of the raw memory of every
+ * table's `Store`, exactly as described by the table's `DataLayout`.  The memory of each table is stored at a
+ * page-aligned offset in the snapshot file, such that it can be `mmap`ped straight back into a `Store` on load.  Hence,
+ * loading a snapshot does not parse any rows and its cost is proportional to the size of the metadata rather than to
+ * the size of the data.
+ *
+ * A snapshot file is laid out as follows:
+ *
+ *     | header | data of table 0 | ... | data of table n-1 | metadata |
+ *
+ * where the data of each table starts at a multiple of `SNAPSHOT_ALIGNMENT`. */
+namespace snapshot {
+
+constexpr uint64_t SNAPSHOT_MAGIC = 0x0050414e5354554dUL; ///< identifies a snapshot file; the string "MUTSNAP"
+constexpr uint32_t SNAPSHOT_VERSION = 2; ///< the version of the snapshot format
+constexpr std::size_t SNAPSHOT_ALIGNMENT = 1UL << 16; ///< 64 KiB; alignment of table data within a snapshot file
+
+}
+
+/** Writes a snapshot of the database \p db to the file at \p path.  An existing file is overwritten.  Throws
+ * `m::runtime_error` if the file cannot be written. */
+void M_EXPORT write_snapshot(const Database &db, const std::filesystem::path &path);
+
+/** Reads the snapshot at \p path and adds the contained database to the `Catalog`.  Tables are created by the current
+ * table factory of the `Catalog` and their stores by the current store factory, see `Catalog::create_store()`.  The
+ * memory of the stores is mapped from the snapshot file; the mapped memory is private and read-only, i.e. the snapshot
+ * file remains unaltered and rows restored from the snapshot must not be updated in place.  Rows can be appended as
+ * usual.  Throws `m::runtime_error` if the file cannot be read and `m::invalid_argument` if the file is not a valid
+ * snapshot, if a database of the same name already exists, or if the snapshot does not fit the current factories.
+ *
+ * @return the restored database
+ */
+Database & M_EXPORT read_snapshot(const std::filesystem::path &path);
+
+}
@@ -3,10 +3,13 @@
 #include <iostream>
 #include <memory>
 #include <mutable/mutable-config.hpp>
+#include <mutable/storage/ZoneMap.hpp>
 #include <mutable/util/macro.hpp>
 #include <mutable/util/memory.hpp>
+#include <mutex>
 #include <string>
 #include <unordered_map>
+#include <utility>
 
 
 namespace m {
@@ -22,6 +25,9 @@ struct M_EXPORT Store
 {
     private:
     const Table &table_; ///< the table defining this store's schema
+    mutable std::unique_ptr<ZoneMap> zone_map_; ///< the zone map of this store, created on first use
+    ///> serializes creating and updating `zone_map_`, since concurrent queries may read the store simultaneously
+    mutable std::mutex zone_map_mutex_;
 
     protected:
     Store(const Table &table) : table_(table) {}
@@ -29,7 +35,7 @@ struct M_EXPORT Store
     public:
     Store(const Store &) = delete;
 
-    Store(Store &&) = default;
+    Store(Store &&other) : table_(other.table_), zone_map_(std::move(other.zone_map_)) { }
 
     virtual ~Store() {}
 
@@ -37,6 +43,8 @@ struct M_EXPORT Store
 
     /** Returns the memory corresponding to the `Linearization`'s root node. */
     virtual const memory::Memory & memory() const = 0;
+    /** Returns the memory corresponding to the `Linearization`'s root node. */
+    memory::Memory & memory() { return const_cast<memory::Memory&>(std::as_const(*this).memory()); }
 
     /** Return the number of rows in this store. */
     virtual std::size_t num_rows() const = 0;
@@ -47,6 +55,19 @@ struct M_EXPORT Store
     /** Drop the most recently appended row. */
     virtual void drop() = 0;
 
+    /** Sets the number of rows in this store to \p n, without initializing appended rows.  Used when the contents of
+     * the store's memory are provided otherwise, e.g. by a snapshot. */
+    virtual void set_num_rows(std::size_t n);
+
+    /** Returns the `ZoneMap` of this store.  The zone map is created on first use and brought up to date with the rows
+     * of this store, e.g. after rows were appended, on every call.  Thread-safe for concurrent readers of the store. */
+    const ZoneMap & zone_map() const;
+    /** Discards the `ZoneMap` of this store, e.g. after rows were modified in place, s.t. it is rebuilt on next use. */
+    void invalidate_zone_map() {
+        std::lock_guard<std::mutex> lock(zone_map_mutex_);
+        zone_map_.reset();
+    }
+
     virtual void dump(std::ostream &out) const = 0;
     void dump() const;
 };
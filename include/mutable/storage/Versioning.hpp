@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutable/mutable-config.hpp>
+#include <optional>
+
+
+namespace m {
+
+/*----- forward declarations -----------------------------------------------------------------------------------------*/
+struct Table;
+struct Tuple;
+
+/** The indices of the hidden timestamp attributes `$ts_begin` and `$ts_end` of a multi-versioned table in the table's
+ * `Schema`, see `MultiVersioningTable`.  Every row of a multi-versioned table is a *version* of a logical row:
+ * `$ts_begin` is the start time of the transaction that created the version and `$ts_end` is the start time of the
+ * transaction that deleted the version, or -1 if the version was not deleted. */
+struct timestamp_attributes_t
+{
+    std::size_t begin; ///< the index of `$ts_begin`
+    std::size_t end; ///< the index of `$ts_end`
+};
+
+/** Returns the indices of the timestamp attributes of \p table, or `std::nullopt` if \p table is not multi-versioned. */
+std::optional<timestamp_attributes_t> M_EXPORT get_timestamp_attributes(const Table &table);
+
+/** Returns `true` iff the version of a row with the timestamps \p ts_begin and \p ts_end is visible in the snapshot of
+ * the transaction with start time \p snapshot, i.e. iff the version was created but not deleted at or before \p
+ * snapshot. */
+inline bool is_visible(int64_t ts_begin, int64_t ts_end, int64_t snapshot)
+{
+    return ts_begin <= snapshot and (ts_end == -1 or ts_end > snapshot);
+}
+
+/** Loads every row of table \p table, in order, as tuple of the table's `Schema` and invokes \p callback on it.  If
+ * \p callback returns `true`, the tuple, which \p callback may have modified, is written back to the row in place.
+ * Rows must not be appended to \p table by \p callback.  A compressed table is decompressed first, see
+ * `decompress_table()`, and rows mapped from a snapshot file are copied first, see `memory::Memory::unmap_file()`.
+ * Since modified rows may no longer agree with the zone map and the indexes of \p table, the zone map is discarded and
+ * the caller must invalidate the indexes, if necessary.
+ *
+ * @return the number of modified rows
+ */
+std::size_t M_EXPORT update_rows(Table &table, const std::function<bool(Tuple&)> &callback);
+
+/** Removes all rows of table \p table for which \p predicate holds.  The remaining rows keep their order and are
+ * compacted in place to the front of the table's `Store`.  A compressed table is decompressed and rows mapped from a
+ * snapshot file are copied first, see `update_rows()`.  Since the IDs of the remaining rows change, the zone map of \p table is discarded and the
+ * caller must invalidate the indexes of \p table.
+ *
+ * @return the number of removed rows
+ */
+std::size_t M_EXPORT remove_rows(Table &table, const std::function<bool(Tuple&)> &predicate);
+
+/** Removes all versions of rows of the multi-versioned table \p table that are invisible to every transaction with a
+ * start time of at least \p horizon, i.e. all versions that were deleted at or before \p horizon, see `remove_rows()`.
+ * \p horizon must not exceed the start time of any active transaction, see
+ * `Scheduler::Transaction::Oldest_Active_Start_Time()`.
+ *
+ * @return the number of removed versions
+ */
+std::size_t M_EXPORT collect_garbage(Table &table, int64_t horizon);
+
+}
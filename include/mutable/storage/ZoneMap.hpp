@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstdint>
+#include <mutable/IR/Tuple.hpp>
+#include <mutable/mutable-config.hpp>
+#include <vector>
+
+
+namespace m {
+
+/*----- forward declarations -----------------------------------------------------------------------------------------*/
+struct Schema;
+struct Store;
+
+namespace cnf { struct CNF; }
+
+/** A `ZoneMap` holds small materialized aggregates of the rows of a `Store`.  The rows are divided into *zones* of
+ * `ZONE_SIZE` consecutive rows.  For every zone and every attribute of numeric, date, or datetime type, the zone map
+ * holds the smallest and the largest value as well as the number of `NULL` values of the attribute within the zone.
+ * A scan with a filter directly on top may consult the zone map to skip entire zones in which no row can satisfy the
+ * filter, see `can_skip()`. */
+struct M_EXPORT ZoneMap
+{
+    ///> the number of rows per zone; a multiple of the number of tuples loaded at once by any backend
+    static constexpr std::size_t ZONE_SIZE = 1UL << 10;
+
+    /** The aggregates of a single attribute within a single zone. */
+    struct summary_t
+    {
+        ///> the smallest and the largest value that is not `NULL`; only valid if `num_values` is not 0
+        Value min, max;
+        uint32_t num_values = 0; ///< the number of values that are not `NULL`
+        uint32_t num_nulls = 0; ///< the number of `NULL` values
+    };
+
+    private:
+    std::vector<bool> is_summarized_; ///< for every attribute, whether the attribute is summarized
+    std::vector<summary_t> summaries_; ///< the summaries of all attributes of zone 0, followed by zone 1, etc.
+    std::size_t num_rows_ = 0; ///< the number of rows covered by this zone map
+
+    public:
+    /** Returns the number of rows covered by this zone map. */
+    std::size_t num_rows() const { return num_rows_; }
+    /** Returns the number of zones of this zone map.  The last zone may contain less than `ZONE_SIZE` rows. */
+    std::size_t num_zones() const { return (num_rows_ + ZONE_SIZE - 1) / ZONE_SIZE; }
+    /** Returns the number of attributes of the table of this zone map. */
+    std::size_t num_attributes() const { return is_summarized_.size(); }
+
+    /** Returns `true` iff the attribute at index \p attr of the table is summarized by this zone map. */
+    bool is_summarized(std::size_t attr) const { return attr < is_summarized_.size() and is_summarized_[attr]; }
+
+    /** Returns the summary of the attribute at index \p attr of the table within zone \p zone. */
+    const summary_t & summary(std::size_t zone, std::size_t attr) const {
+        M_insist(zone < num_zones(), "zone out of bounds");
+        M_insist(is_summarized(attr), "attribute is not summarized");
+        return summaries_[zone * num_attributes() + attr];
+    }
+
+    /** Brings this zone map up to date with the rows of \p store.  Zones that are already completely covered are not
+     * summarized again, i.e. after appending rows only the last zone and the new zones are summarized. */
+    void update(const Store &store);
+
+    /** Returns `true` iff no row within zone \p zone can satisfy the filter \p filter.  The designators of \p filter
+     * are resolved in \p schema, the schema of the table under the alias used by the filter.  Only predicates comparing
+     * a summarized attribute to a constant are considered; a zone is skipped iff any clause of \p filter contains only
+     * such predicates and none of them can be satisfied within the zone. */
+    bool can_skip(std::size_t zone, const cnf::CNF &filter, const Schema &schema) const;
+
+    /** Returns for every zone whether it can be skipped, see `can_skip()`. */
+    std::vector<bool> skippable_zones(const cnf::CNF &filter, const Schema &schema) const;
+};
+
+}
@@ -185,6 +185,31 @@ exit:
         for_each_CSG_undirected(super, super, std::move(callback));
     }
 
+    /** Enumerate the *connected subgraphs* (CSGs) of the graph induced by vertex super set `super` as long as `callback`
+     * returns `true`.  Returns `true` iff all CSGs were enumerated.  Requires that this matrix is symmetric. */
+    bool for_each_CSG_undirected_while(SmallBitset super, std::function<bool(SmallBitset)> callback) const
+    {
+        std::deque<std::pair<SmallBitset, SmallBitset>> Q;
+        for (auto it = super.begin(); it != super.end(); ++it) {
+            const SmallBitset I = it.as_set();
+            Q.emplace_back(I, super & ~I.mask_to_lo()); // exclude larger sources
+
+            while (not Q.empty()) {
+                auto [S, X_old] = Q.front();
+                Q.pop_front();
+
+                if (not callback(S))
+                    return false;
+
+                const SmallBitset N = (neighbors(S) & super) - X_old;
+                const SmallBitset X_new = X_old | N;
+                for (SmallBitset n = least_subset(N); bool(n); n = next_subset(n, N)) // enumerate 2^{neighbors of S}
+                    Q.emplace_back(S | n, X_new);
+            }
+        }
+        return true;
+    }
+
     /** Enumerate all pairs of *connected subgraphs* (CSGs) that are connected by at least one edge.  Requires that this
      * matrix is symmetric. */
     void for_each_CSG_pair_undirected(SmallBitset super, std::function<void(SmallBitset, SmallBitset)> callback) const {
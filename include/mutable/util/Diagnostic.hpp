@@ -4,6 +4,7 @@
 #include <cstdarg>
 #include <cstdio>
 #include <mutable/util/Position.hpp>
+#include <string_view>
 
 
 namespace m {
@@ -49,6 +50,17 @@ struct Diagnostic
     /** Resets the error counter. */
     void clear() { num_errors_ = 0; }
 
+    /** Returns whether messages are colored. */
+    bool color() const { return color_; }
+
+    /** Emits the messages \p out and \p err, which were collected by another `Diagnostic`, e.g. of a worker thread, and
+     * accounts for the \p num_errors errors among them. */
+    void forward(std::string_view out, std::string_view err, unsigned num_errors) {
+        out_ << out;
+        err_ << err;
+        num_errors_ += num_errors;
+    }
+
     std::ostream & out() const { return out_; }
     std::ostream & err() {
         ++num_errors_;
@@ -1,6 +1,9 @@
 #pragma once
 
+#include <array>
+#include <bit>
 #include <functional>
+#include <iterator>
 #include <mutable/util/fn.hpp>
 #include <mutable/util/macro.hpp>
 #include <mutable/util/OptField.hpp>
@@ -16,9 +19,108 @@ namespace m {
 template<typename T, typename Pool, bool CanBeNone = false>
 struct Pooled;
 
-/** The `PODPool` implements an implicitly garbage-collected set of *pooled* (or *internalized*) POD struct entities. */
+namespace detail {
+
+/** The hash table of a pool, split into \tparam NumShards *shards*.  Every shard is a hash table of type \tparam Table
+ * of its own.  If \tparam ThreadSafe, every shard is guarded by its own `reader_writer_mutex`.  An entity is stored in
+ * the shard selected by the entity's hash.  Hence, concurrent accesses to entities of different shards do not contend
+ * for the same lock. */
+template<typename Table, bool ThreadSafe, std::size_t NumShards>
+struct sharded_table
+{
+    static_assert(std::has_single_bit(NumShards), "the number of shards must be a power of 2");
+
+    struct alignas(64) shard_type
+    {
+        Table table;
+        mutable OptField<ThreadSafe, reader_writer_mutex> mutex;
+    };
+
+    /** Iterates over the entries of all shards, shard by shard. */
+    struct const_iterator
+    {
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = typename Table::value_type;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const value_type*;
+        using reference = const value_type&;
+
+        private:
+        const shard_type *shard_; ///< the shard of the current entry
+        const shard_type *end_; ///< past-the-end of the shards
+        typename Table::const_iterator it_; ///< the current entry in `shard_`
+
+        public:
+        const_iterator(const shard_type *shard, const shard_type *end) : shard_(shard), end_(end) {
+            if (shard_ != end_) {
+                it_ = shard_->table.cbegin();
+                skip_empty_shards();
+            }
+        }
+
+        reference operator*() const { return *it_; }
+        pointer operator->() const { return &*it_; }
+
+        const_iterator & operator++() { ++it_; skip_empty_shards(); return *this; }
+        const_iterator operator++(int) { const_iterator clone = *this; operator++(); return clone; }
+
+        bool operator==(const const_iterator &other) const {
+            return this->shard_ == other.shard_ and (this->shard_ == this->end_ or this->it_ == other.it_);
+        }
+        bool operator!=(const const_iterator &other) const { return not operator==(other); }
+
+        private:
+        /** Advances to the first entry of the next non-empty shard if the current shard has no more entries. */
+        void skip_empty_shards() {
+            while (it_ == shard_->table.cend()) {
+                if (++shard_ == end_) return;
+                it_ = shard_->table.cbegin();
+            }
+        }
+    };
+
+    private:
+    std::array<shard_type, NumShards> shards_;
+
+    public:
+    sharded_table() = default;
+    sharded_table(std::size_t initial_capacity) {
+        for (auto &shard : shards_)
+            shard.table.rehash((initial_capacity + NumShards - 1) / NumShards);
+    }
+
+    /** Returns the shard of an entity with the hash \p hash. */
+    shard_type & operator()(uint64_t hash) {
+        if constexpr (NumShards == 1) {
+            return shards_[0];
+        } else {
+            /* Select the shard by the high bits of the scrambled hash, s.t. the selection of the shard is independent
+             * of the selection of the bucket within the shard's table. */
+            return shards_[(hash * 0x9e3779b97f4a7c15UL) >> (64 - std::countr_zero(NumShards))];
+        }
+    }
+
+    std::array<shard_type, NumShards> & shards() { return shards_; }
+
+    /** Returns the number of entries in all shards.  Not synchronized with concurrent insertions. */
+    std::size_t size() const {
+        std::size_t n = 0;
+        for (auto &shard : shards_)
+            n += shard.table.size();
+        return n;
+    }
+
+    const_iterator begin() const { return const_iterator(shards_.data(), shards_.data() + NumShards); }
+    const_iterator end() const { return const_iterator(shards_.data() + NumShards, shards_.data() + NumShards); }
+};
+
+}
+
+/** The `PODPool` implements an implicitly garbage-collected set of *pooled* (or *internalized*) POD struct entities.
+ * If \tparam ThreadSafe, the entities are distributed over \tparam NumShards independently locked hash tables, see
+ * `detail::sharded_table`. */
 template<typename T, typename Hash = std::hash<T>, typename KeyEqual = std::equal_to<T>, typename Copy = std::identity,
-         bool ThreadSafe = false>
+         bool ThreadSafe = false, std::size_t NumShards = ThreadSafe ? 64 : 1>
 struct PODPool
 {
     using counter_type = std::conditional_t<ThreadSafe, std::atomic<uint32_t>, uint32_t>;
@@ -34,14 +136,13 @@ struct PODPool
     friend struct Pooled;
 
     static constexpr bool is_thread_safe = ThreadSafe;
+    static constexpr std::size_t num_shards = NumShards;
 
     private:
-    table_type table_;
-
-    alignas(64) mutable OptField<ThreadSafe, reader_writer_mutex> table_mutex_;
+    detail::sharded_table<table_type, ThreadSafe, NumShards> table_;
 
     public:
-    using const_iterator = table_type::const_iterator;
+    using const_iterator = typename detail::sharded_table<table_type, ThreadSafe, NumShards>::const_iterator;
 
     public:
     PODPool() = default;
@@ -56,8 +157,8 @@ struct PODPool
     /** Returns the number of elements in the pool. */
     std::size_t size() const { return table_.size(); }
 
-    const_iterator begin() { return table_.cbegin(); }
-    const_iterator end() { return table_.cend(); }
+    const_iterator begin() { return table_.begin(); }
+    const_iterator end() { return table_.end(); }
     const_iterator cbegin() const { return table_.begin(); }
     const_iterator cend() const { return table_.end(); }
 
@@ -75,8 +176,10 @@ struct PODPool
     bool erase(const Pooled<T, PODPool, CanBeNone> &pooled);
 };
 
-/** A pool implements an implicitly garbage-collected set of instances of a class hierarchy. */
-template<typename T, typename Hash = std::hash<T>, typename KeyEqual = std::equal_to<T>, bool ThreadSafe = false>
+/** A pool implements an implicitly garbage-collected set of instances of a class hierarchy.  If \tparam ThreadSafe, the
+ * instances are distributed over \tparam NumShards independently locked hash tables, see `detail::sharded_table`. */
+template<typename T, typename Hash = std::hash<T>, typename KeyEqual = std::equal_to<T>, bool ThreadSafe = false,
+         std::size_t NumShards = ThreadSafe ? 64 : 1>
 struct Pool
 {
     struct dereference_hash
@@ -111,14 +214,13 @@ struct Pool
     friend struct Pooled;
 
     static constexpr bool is_thread_safe = ThreadSafe;
+    static constexpr std::size_t num_shards = NumShards;
 
     private:
-    table_type table_;
-
-    alignas(64) mutable OptField<ThreadSafe, reader_writer_mutex> table_mutex_;
+    detail::sharded_table<table_type, ThreadSafe, NumShards> table_;
 
     public:
-    using const_iterator = table_type::const_iterator;
+    using const_iterator = typename detail::sharded_table<table_type, ThreadSafe, NumShards>::const_iterator;
 
     public:
     Pool() = default;
@@ -126,9 +228,11 @@ struct Pool
     ~Pool() {
 #ifndef NDEBUG
         /* Manually delete all entries and make sure we don't have any dangling references. */
-        while (not table_.empty()) {
-            typename table_type::node_type nh = table_.extract(table_.begin());
-            M_insist(nh.mapped() == 0, "deleting would create a dangling reference to pooled object");
+        for (auto &shard : table_.shards()) {
+            while (not shard.table.empty()) {
+                typename table_type::node_type nh = shard.table.extract(shard.table.begin());
+                M_insist(nh.mapped() == 0, "deleting would create a dangling reference to pooled object");
+            }
         }
 #endif
     }
@@ -136,8 +240,8 @@ struct Pool
     /** Returns the number of elements in the pool. */
     std::size_t size() const { return table_.size(); }
 
-    const_iterator begin() { return table_.cbegin(); }
-    const_iterator end() { return table_.cend(); }
+    const_iterator begin() { return table_.begin(); }
+    const_iterator end() { return table_.end(); }
     const_iterator cbegin() const { return table_.begin(); }
     const_iterator cend() const { return table_.end(); }
 
@@ -328,101 +432,107 @@ struct Pooled
     void dump() const { dump(std::cerr); }
 };
 
-template<typename T, typename Hash, typename KeyEqual, typename Copy, bool ThreadSafe>
+template<typename T, typename Hash, typename KeyEqual, typename Copy, bool ThreadSafe, std::size_t NumShards>
 template<typename U>
-PODPool<T, Hash, KeyEqual, Copy, ThreadSafe>::proxy_type PODPool<T, Hash, KeyEqual, Copy, ThreadSafe>::operator()(U &&u)
+PODPool<T, Hash, KeyEqual, Copy, ThreadSafe, NumShards>::proxy_type
+PODPool<T, Hash, KeyEqual, Copy, ThreadSafe, NumShards>::operator()(U &&u)
 {
+    auto &shard = table_(Hash{}(u));
     if constexpr (ThreadSafe) {
-        reader_writer_lock lock{table_mutex_};
+        reader_writer_lock lock{shard.mutex};
         typename table_type::iterator it;
         do {
             lock.lock_read();
-            it = table_.find(u);
-            if (it != table_.end())
+            it = shard.table.find(u);
+            if (it != shard.table.end())
                 return proxy_type{this, &*it};
         } while (not lock.upgrade());
         M_insist(lock.owns_write_lock());
-        it = table_.emplace_hint(it, Copy{}(std::forward<U>(u)), 0); // perfect forwarding
+        it = shard.table.emplace_hint(it, Copy{}(std::forward<U>(u)), 0); // perfect forwarding
         return proxy_type{this, &*it};
     } else {
-        auto it = table_.find(u);
-        if (it == table_.end())
-            it = table_.emplace_hint(it, Copy{}(std::forward<U>(u)), 0); // perfect forwarding
+        auto it = shard.table.find(u);
+        if (it == shard.table.end())
+            it = shard.table.emplace_hint(it, Copy{}(std::forward<U>(u)), 0); // perfect forwarding
         return proxy_type{this, &*it};
     }
 }
 
-template<typename T, typename Hash, typename KeyEqual, typename Copy, bool ThreadSafe>
+template<typename T, typename Hash, typename KeyEqual, typename Copy, bool ThreadSafe, std::size_t NumShards>
 template<bool CanBeNone>
-bool PODPool<T, Hash, KeyEqual, Copy, ThreadSafe>::erase(const Pooled<T, PODPool, CanBeNone> &pooled)
+bool PODPool<T, Hash, KeyEqual, Copy, ThreadSafe, NumShards>::erase(const Pooled<T, PODPool, CanBeNone> &pooled)
 {
     M_insist(pooled.ref_, "cannot erase w/o valid reference");
+    auto &shard = table_(Hash{}(pooled.ref_->first));
     if constexpr (ThreadSafe) {
-        write_lock lock{table_mutex_};
+        write_lock lock{shard.mutex};
         if (pooled.ref_->second != 0) return false;  // entity was concurrently pooled
-        table_.erase(pooled.ref_->first);
+        shard.table.erase(pooled.ref_->first);
         return true;
     } else {
         M_insist(pooled.ref_->second == 0, "reference count must be 0 to erase");
-        table_.erase(pooled.ref_->first);
+        shard.table.erase(pooled.ref_->first);
         return true;
     }
 }
 
-template<typename T, typename Hash, typename KeyEqual, typename Copy, bool ThreadSafe>
+template<typename T, typename Hash, typename KeyEqual, typename Copy, bool ThreadSafe, std::size_t NumShards>
 template<bool CanBeNone>
-const T & PODPool<T, Hash, KeyEqual, Copy, ThreadSafe>::Get(const Pooled<T, PODPool, CanBeNone> &pooled)
+const T & PODPool<T, Hash, KeyEqual, Copy, ThreadSafe, NumShards>::Get(const Pooled<T, PODPool, CanBeNone> &pooled)
 {
     M_insist(pooled.ref_);
     return pooled.ref_->first;
 }
 
-template<typename T, typename Hash, typename KeyEqual, bool ThreadSafe>
+template<typename T, typename Hash, typename KeyEqual, bool ThreadSafe, std::size_t NumShards>
 template<typename U>
 requires std::derived_from<U, T>
-Pool<T, Hash, KeyEqual, ThreadSafe>::proxy_type<U> Pool<T, Hash, KeyEqual, ThreadSafe>::operator()(U &&u)
+Pool<T, Hash, KeyEqual, ThreadSafe, NumShards>::proxy_type<U>
+Pool<T, Hash, KeyEqual, ThreadSafe, NumShards>::operator()(U &&u)
 {
+    auto &shard = table_(Hash{}(u));
     if constexpr (ThreadSafe) {
-        reader_writer_lock lock{table_mutex_};
+        reader_writer_lock lock{shard.mutex};
         typename table_type::iterator it;
         do {
             lock.lock_read();
-            it = table_.find(&u);
-            if (it != table_.end())
+            it = shard.table.find(&u);
+            if (it != shard.table.end())
                 return proxy_type<U>{this, &*it};
         } while (not lock.upgrade());
         M_insist(lock.owns_write_lock());
-        it = table_.emplace_hint(it, as<T>(std::make_unique<U>(std::forward<U>(u))), 0); // perfect forwarding
+        it = shard.table.emplace_hint(it, as<T>(std::make_unique<U>(std::forward<U>(u))), 0); // perfect forwarding
         return proxy_type<U>{this, &*it};
     } else {
-        auto it = table_.find(&u);
-        if (it == table_.end())
-            it = table_.emplace_hint(it, as<T>(std::make_unique<U>(std::forward<U>(u))), 0); // perfect forwarding
+        auto it = shard.table.find(&u);
+        if (it == shard.table.end())
+            it = shard.table.emplace_hint(it, as<T>(std::make_unique<U>(std::forward<U>(u))), 0); // perfect forwarding
         return proxy_type<U>{this, &*it};
     }
 }
 
-template<typename T, typename Hash, typename KeyEqual, bool ThreadSafe>
+template<typename T, typename Hash, typename KeyEqual, bool ThreadSafe, std::size_t NumShards>
 template<typename U, bool CanBeNone>
-bool Pool<T, Hash, KeyEqual, ThreadSafe>::erase(const Pooled<U, Pool, CanBeNone> &pooled)
+bool Pool<T, Hash, KeyEqual, ThreadSafe, NumShards>::erase(const Pooled<U, Pool, CanBeNone> &pooled)
 {
     M_insist(pooled.ref_, "cannot erase w/o valid reference");
+    auto &shard = table_(Hash{}(*pooled.ref_->first));
     if constexpr (ThreadSafe) {
-        write_lock lock{table_mutex_};  // acquire write lock
+        write_lock lock{shard.mutex};  // acquire write lock
         if (pooled.ref_->second != 0) return false;  // entity was concurrently pooled
-        table_.erase(pooled.ref_->first);
+        shard.table.erase(pooled.ref_->first);
         return true;
     } else {
         M_insist(pooled.ref_->second == 0, "reference count must be 0 to erase");
-        table_.erase(pooled.ref_->first);
+        shard.table.erase(pooled.ref_->first);
         return true;
     }
 }
 
-template<typename T, typename Hash, typename KeyEqual, bool ThreadSafe>
+template<typename T, typename Hash, typename KeyEqual, bool ThreadSafe, std::size_t NumShards>
 template<typename U, bool CanBeNone>
 requires std::derived_from<U, T>
-const U & Pool<T, Hash, KeyEqual, ThreadSafe>::Get(const Pooled<U, Pool, CanBeNone> &pooled)
+const U & Pool<T, Hash, KeyEqual, ThreadSafe, NumShards>::Get(const Pooled<U, Pool, CanBeNone> &pooled)
 {
     M_insist(pooled.ref_);
     return as<U>(*pooled.ref_->first);  // additional dereference because of `std::unique_ptr` indirection
@@ -442,11 +552,11 @@ struct StrClone
 namespace detail {
 
 /** Explicit specialization of PODPool for strings (const char *). */
-template<bool ThreadSafe = false>
-struct _StringPool : PODPool<const char*, StrHash, StrEqual, StrClone, ThreadSafe>
+template<bool ThreadSafe = false, std::size_t NumShards = ThreadSafe ? 64 : 1>
+struct _StringPool : PODPool<const char*, StrHash, StrEqual, StrClone, ThreadSafe, NumShards>
 {
     private:
-    using super = PODPool<const char*, StrHash, StrEqual, StrClone, ThreadSafe>;
+    using super = PODPool<const char*, StrHash, StrEqual, StrClone, ThreadSafe, NumShards>;
 
     public:
     _StringPool() = default;
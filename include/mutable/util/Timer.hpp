@@ -4,6 +4,7 @@
 #include <mutable/util/macro.hpp>
 #include <algorithm>
 #include <chrono>
+#include <cstdint>
 #include <ctime>
 #include <string>
 #include <utility>
@@ -94,6 +95,8 @@ struct Timer
 
     private:
     std::vector<Measurement> measurements_;
+    ///> named event counters, in order of their creation
+    std::vector<std::pair<std::string, uint64_t>> counters_;
 
     public:
     auto begin() const { return measurements_.cbegin(); }
@@ -115,8 +118,28 @@ struct Timer
         return *it;
     }
 
-    /** Erase all `Measurement`s from this `Timer`. */
-    void clear() { measurements_.clear(); }
+    /** Returns all counters of this `Timer`, in order of their creation. */
+    const std::vector<std::pair<std::string, uint64_t>> & counters() const { return counters_; }
+
+    /** Returns the value of the counter with the name `name`. */
+    uint64_t counter(const std::string &name) const {
+        auto it = std::find_if(counters_.begin(), counters_.end(), [&](auto &elem) { return elem.first == name; });
+        if (it == counters_.end())
+            throw m::out_of_range("a counter with that name does not exist");
+        return it->second;
+    }
+
+    /** Increments the counter with the name `name` by `n`.  Creates the counter, if it does not exist yet. */
+    void increment(const std::string &name, uint64_t n = 1) {
+        auto it = std::find_if(counters_.begin(), counters_.end(), [&](auto &elem) { return elem.first == name; });
+        if (it == counters_.end())
+            counters_.emplace_back(name, n);
+        else
+            it->second += n;
+    }
+
+    /** Erase all `Measurement`s and counters from this `Timer`. */
+    void clear() { measurements_.clear(); counters_.clear(); }
 
     private:
     /** Start a new `Measurement` with the name `name`.  Returns the ID assigned to that `Measurement`. */
@@ -151,12 +174,33 @@ struct Timer
     /** Creates a new `TimingProcess` with the given `name`. */
     TimingProcess create_timing(std::string name) { return TimingProcess(*this, /* ID= */ start(name)); }
 
+    /** Records a finished `Measurement` with the name `name` from `begin` to `end`, e.g. of an event that took place
+     * on another thread.  Overwrites an existing, finished measurement with the same name. */
+    void add(std::string name, time_point begin, time_point end) {
+        M_insist(begin != time_point() and begin <= end, "invalid measurement");
+        auto it = std::find_if(measurements_.begin(), measurements_.end(),
+                               [&](auto &elem) { return elem.name == name; });
+        if (it != measurements_.end()) {
+            if (it->is_active())
+                throw m::invalid_argument("a measurement with that name is already in progress");
+            it->begin = begin;
+            it->end = end;
+        } else {
+            measurements_.emplace_back(std::move(name), begin, end);
+        }
+    }
+
     M_LCOV_EXCL_START
     /** Print all finished and in-process timings of `timer` to `out`. */
     friend std::ostream & operator<<(std::ostream &out, const Timer &timer) {
         out << "Timer measurements:\n";
         for (auto &M : timer)
             out << "  " << M << '\n';
+        if (not timer.counters_.empty()) {
+            out << "Timer counters:\n";
+            for (auto &[name, value] : timer.counters_)
+                out << "  " << name << ": " << value << '\n';
+        }
 
         return out;
     }
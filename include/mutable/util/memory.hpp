@@ -5,6 +5,7 @@
 #include <cstdint>
 #include <iostream>
 #include <memory>
+#include <mutex>
 
 
 namespace m {
@@ -13,6 +14,26 @@ namespace memory {
 
 struct Memory;
 
+/** Describes where the memory of a `memory::Allocator` is placed in physical memory. */
+struct M_EXPORT Placement
+{
+    /** Which kind of huge pages to back the memory with. */
+    enum huge_pages_t
+    {
+        HP_None,        ///< use regular pages
+        HP_Transparent, ///< advise the kernel to use transparent huge pages, see `madvise(MADV_HUGEPAGE)`
+        HP_Explicit,    ///< use explicit huge pages from the huge page pool, see `memfd_create(MFD_HUGETLB)`
+    };
+
+    huge_pages_t huge_pages = HP_None; ///< the kind of huge pages to use
+    int numa_node = -1; ///< the NUMA node to bind the memory to, or -1 to not bind the memory to a node
+    bool numa_interleave = false; ///< whether to interleave the memory page-wise across all NUMA nodes
+
+    /** Returns the `Placement` used by all allocators that are created without an explicit placement.  Changes only
+     * affect allocators created afterwards. */
+    static Placement & Default();
+};
+
 /** This is the common interface for all memory allocators that support *rewiring*.  */
 struct M_EXPORT Allocator
 {
@@ -20,13 +41,27 @@ struct M_EXPORT Allocator
 
     private:
     int fd_; ///< file descriptor of the underlying memory file
+    Placement placement_; ///< the placement of the allocated memory
 
     public:
-    Allocator();
+    Allocator() : Allocator(Placement::Default()) { }
+    explicit Allocator(const Placement &placement);
     virtual ~Allocator();
 
     /** Return the file descriptor of the underlying memory file. */
     int fd() const { return fd_; }
+    /** Returns the placement of the memory of this allocator. */
+    const Placement & placement() const { return placement_; }
+    /** Sets the placement of memory allocated or mapped by this allocator from now on.  Explicit huge pages require a
+     * dedicated memory file and can therefore neither be enabled nor disabled after construction. */
+    void placement(const Placement &placement) {
+        M_insist((placement.huge_pages == Placement::HP_Explicit) == (placement_.huge_pages == Placement::HP_Explicit),
+                 "explicit huge pages cannot be changed after construction");
+        placement_ = placement;
+    }
+    /** Returns the size in bytes of the pages backing the memory of this allocator.  Offsets and sizes of allocations
+     * and mappings must be whole multiples of this size. */
+    std::size_t page_size() const;
 
     /** Creates a new memory object with `size` bytes of freshly allocated memory. */
     virtual Memory allocate(std::size_t size) = 0;
@@ -37,6 +72,9 @@ struct M_EXPORT Allocator
 
     /** Helper method to inherit the friend ability to construct a `Memory` object. */
     Memory create_memory(void *addr, std::size_t size, std::size_t offset);
+
+    /** Applies the placement of this allocator to the \p size bytes of memory mapped at \p addr. */
+    void place(void *addr, std::size_t size) const;
 };
 
 /** This class represents a reserved address space in virtual memory.  It can be used to map the contents of
@@ -83,6 +121,9 @@ struct M_EXPORT Memory
     void *addr_ = nullptr; ///< pointer to the virtual address space where this allocation is mapped to
     std::size_t size_ = 0; ///< the size of this allocation
     std::size_t offset_ = 0; ///< the offset of this allocation within its allocator
+    int file_fd_ = -1; ///< file descriptor of the file mapped over the beginning of this allocation, if any
+    std::size_t file_offset_ = 0; ///< the offset of the mapped range within the file
+    std::size_t file_size_ = 0; ///< the size in bytes of the mapped range of the file
 
     Memory(Allocator &allocator, void *addr, std::size_t size, std::size_t offset);
 
@@ -93,11 +134,14 @@ struct M_EXPORT Memory
         swap(first.addr_,      second.addr_);
         swap(first.size_,      second.size_);
         swap(first.offset_,    second.offset_);
+        swap(first.file_fd_,     second.file_fd_);
+        swap(first.file_offset_, second.file_offset_);
+        swap(first.file_size_,   second.file_size_);
     }
 
     Memory() { }
     Memory(void *addr, std::size_t size) : addr_(addr), size_(size) { }
-    ~Memory() { if (allocator_) allocator().deallocate(std::move(*this)); }
+    ~Memory();
     Memory(const Memory&) = delete;
     Memory(Memory &&other) { swap(*this, other); }
 
@@ -111,6 +155,9 @@ struct M_EXPORT Memory
     std::size_t size() const { return size_; }
     /** Returns the offset in bytes of this allocation within its allocator. */
     std::size_t offset() const { return offset_; }
+    /** Returns the size in bytes of the file range that is mapped over the beginning of this allocation, see
+     * `map_file()`. */
+    std::size_t file_size() const { return file_size_; }
 
     /** Returns a pointer to the beginning of the virtual address space where this allocation is mapped to, converted to
      * type `T`. */
@@ -124,6 +171,19 @@ struct M_EXPORT Memory
     /** Map `size` bytes starting at `offset_src` into the address space of `vm` at offset `offset_dst`.  */
     void map(std::size_t size, std::size_t offset_src, const AddressSpace &vm, std::size_t offset_dst) const;
 
+    /** Maps `size` bytes of the file \p fd, starting at `file_offset`, over the beginning of this allocation, without
+     * reading the file.  The mapped range is *read-only* and private to this process, i.e. it is neither affected by
+     * later changes to the file nor written back.  Subsequent calls to `map()` map the respective range of the file
+     * instead of the underlying memory file of the allocator.  `file_offset` must be page aligned and `size` must be
+     * aligned to the pages of the allocator, e.g. to huge pages, since the mapping splits the mapping of the
+     * allocation.  The mapped range must be replaced by `unmap_file()` before it is written. */
+    void map_file(int fd, std::size_t file_offset, std::size_t size);
+
+    /** Replaces the file range mapped over the beginning of this allocation by `map_file()` with a copy in the
+     * underlying memory file of the allocator, s.t. the range can be written and subsequent calls to `map()` map the
+     * written data.  Does nothing if no file is mapped. */
+    void unmap_file();
+
     void dump(std::ostream &out) const;
     void dump() const;
 };
@@ -142,9 +202,11 @@ struct M_EXPORT LinearAllocator : Allocator
 
     ///> stack of allocations; allocations can be marked deallocated for later reclaiming
     std::vector<std::size_t> allocations_;
+    std::mutex mutex_; ///< guards allocations and deallocations of concurrently executed queries
 
     public:
     LinearAllocator() { }
+    explicit LinearAllocator(const Placement &placement) : Allocator(placement) { }
     ~LinearAllocator() { }
 
     Memory allocate(std::size_t size) override;
@@ -1,11 +1,13 @@
 #include <mutable/IR/Optimizer.hpp>
 
 #include <algorithm>
+#include <limits>
 #include <mutable/catalog/Catalog.hpp>
 #include <mutable/IR/Operator.hpp>
 #include <mutable/Options.hpp>
 #include <mutable/parse/AST.hpp>
 #include <mutable/storage/Store.hpp>
+#include <mutable/storage/Versioning.hpp>
 #include <numeric>
 #include <vector>
 
@@ -223,7 +225,14 @@ std::unique_ptr<Producer*[]> Optimizer::optimize_source_plans(const QueryGraph &
             PT[s].cost = 0;
             PT[s].model = CE.estimate_scan(G, s);
             auto &store = bt->table().store();
-            auto source = std::make_unique<ScanOperator>(store, bt->name().assert_not_none());
+            /* Multi-versioned tables are scanned in the snapshot of the query's transaction.  Without a transaction,
+             * only the current versions are visible. */
+            std::optional<int64_t> snapshot;
+            if (get_timestamp_attributes(bt->table())) {
+                auto t = G.transaction();
+                snapshot = t and t->start_time() != -1 ? t->start_time() : std::numeric_limits<int64_t>::max();
+            }
+            auto source = std::make_unique<ScanOperator>(store, bt->name().assert_not_none(), snapshot);
 
             /* Set operator information. */
             auto source_info = std::make_unique<OperatorInformation>();
@@ -1,6 +1,10 @@
 #include <mutable/IR/PlanEnumerator.hpp>
 
 #include <algorithm>
+#include <atomic>
+#include <barrier>
+#include <chrono>
+#include <cstdlib>
 #include <cstring>
 #include <execution>
 #include <functional>
@@ -9,13 +13,16 @@
 #include <memory>
 #include <mutable/catalog/Catalog.hpp>
 #include <mutable/catalog/CostFunction.hpp>
+#include <mutable/Options.hpp>
 #include <mutable/util/ADT.hpp>
 #include <mutable/util/fn.hpp>
 #include <mutable/util/list_allocator.hpp>
 #include <mutable/util/malloc_allocator.hpp>
 #include <queue>
 #include <set>
+#include <thread>
 #include <type_traits>
+#include <vector>
 #ifdef __BMI2__
 #include <x86intrin.h>
 #endif
@@ -287,6 +294,94 @@ void DPccp::operator()(enumerate_tag, PlanTable &PT, const QueryGraph &G, const
 }
 
 
+/*======================================================================================================================
+ * DPccpParallel
+ *====================================================================================================================*/
+
+/** Computes the join order using dynamic programming over the connected subgraphs (CSGs) of the query graph, thereby
+ * solving all CSGs of equal size concurrently.  The optimal plan of a CSG only depends on the optimal plans of smaller
+ * CSGs.  Hence, the CSGs are solved level by level in ascending order of their size, and the CSGs of a level are
+ * distributed over a team of threads.  A thread enumerates the connected subgraph complement pairs (CCPs) of its CSGs
+ * with `MinCutAGaT` and only updates the plan table entries of its CSGs.  The entries of all CSGs are created upfront,
+ * s.t. the plan table is not restructured while it is accessed concurrently. */
+struct DPccpParallel final : PlanEnumeratorCRTP<DPccpParallel>
+{
+    using base_type = PlanEnumeratorCRTP<DPccpParallel>;
+    using base_type::operator();
+
+    ///> the number of CSGs a thread claims at once
+    static constexpr std::size_t CHUNK_SIZE = 16;
+    ///> the minimal number of CSGs of a query graph to solve them concurrently
+    static constexpr std::size_t MIN_NUM_CSGS_PARALLEL = 1UL << 10;
+
+    private:
+    std::size_t num_threads_ = 0; ///< the number of threads; 0 means one per hardware thread
+
+    public:
+    std::size_t num_threads() const {
+        return num_threads_ ? num_threads_ : std::max(1U, std::thread::hardware_concurrency());
+    }
+    void num_threads(std::size_t n) { num_threads_ = n; }
+
+    template<typename PlanTable>
+    void operator()(enumerate_tag, PlanTable &PT, const QueryGraph &G, const CostFunction &CF) const {
+        const std::size_t n = G.num_sources();
+        if (n <= 1) return;
+        const AdjacencyMatrix &M = G.adjacency_matrix();
+        auto &CE = Catalog::Get().get_database_in_use().cardinality_estimator();
+
+        /*----- Collect the CSGs of at least two relations by their size and create their plan table entries. -----*/
+        std::vector<std::vector<Subproblem>> levels(n + 1);
+        std::size_t num_CSGs = 0;
+        M.for_each_CSG_undirected(Subproblem::All(n), [&](Subproblem S) {
+            if (S.is_singleton()) return;
+            levels[S.size()].emplace_back(S);
+            (void) PT[S]; // create entry
+            ++num_CSGs;
+        });
+
+        /*----- Solve the CSGs of `level`.  Threads claim chunks of CSGs by incrementing `next`. -----*/
+        std::vector<std::atomic<std::size_t>> next(n + 1);
+        auto solve = [&](const std::vector<Subproblem> &level, std::atomic<std::size_t> &next) {
+            cnf::CNF condition; // TODO use join condition
+            auto handle_ccp = [&](const Subproblem left, const Subproblem right) {
+                PT.update(G, CE, CF, left, right, condition);
+            };
+            for (;;) {
+                const std::size_t begin = next.fetch_add(CHUNK_SIZE, std::memory_order_relaxed);
+                if (begin >= level.size()) return;
+                const std::size_t end = std::min(begin + CHUNK_SIZE, level.size());
+                for (std::size_t i = begin; i != end; ++i)
+                    MinCutAGaT{}.partition(M, handle_ccp, level[i]);
+            }
+        };
+
+        const std::size_t num_workers = num_CSGs < MIN_NUM_CSGS_PARALLEL ? 1 : num_threads();
+        if (num_workers == 1) {
+            for (std::size_t s = 2; s <= n; ++s)
+                solve(levels[s], next[s]);
+            return;
+        }
+
+        /*----- Solve the levels concurrently, separated by a barrier. -----*/
+        std::barrier sync(num_workers);
+        auto work = [&]() {
+            for (std::size_t s = 2; s <= n; ++s) {
+                solve(levels[s], next[s]);
+                sync.arrive_and_wait(); // all CSGs of size `s` must be solved before solving larger CSGs
+            }
+        };
+        std::vector<std::thread> threads;
+        threads.reserve(num_workers - 1);
+        for (std::size_t i = 1; i != num_workers; ++i)
+            threads.emplace_back(work);
+        work();
+        for (auto &thread : threads)
+            thread.join();
+    }
+};
+
+
 /*======================================================================================================================
  * IK/KBZ
  *====================================================================================================================*/
@@ -722,8 +817,107 @@ void TDGOO::operator()(enumerate_tag, PlanTable &PT, const QueryGraph &G, const
 }
 
 
+/*======================================================================================================================
+ * Adaptive
+ *====================================================================================================================*/
+
+/** Chooses the plan enumeration method by the shape and size of the query graph and an optimization time budget.
+ *
+ * 1. If the query graph has at most `MAX_NUM_CSGS` connected subgraphs (CSGs), the optimal plan is computed by dynamic
+ *    programming over the CSGs, solving CSGs in ascending order of their size.  If the time budget is exceeded, the
+ *    enumeration is aborted and the plan is completed with `GOO`, which reuses the optimal plans of all CSGs solved so
+ *    far.
+ * 2. Otherwise, if the query graph has at most `MAX_NUM_RELATIONS_HEURISTIC` relations and the time budget is not yet
+ *    exceeded, the configured heuristic plan enumerator is used, by default `LinearizedDP`.  E.g. `HeuristicSearch`
+ *    with a beam search, as configured by its own options.
+ * 3. Otherwise, if the query graph is acyclic, `IKKBZ` is used, otherwise `GOO`.
+ *
+ * See Thomas Neumann and Bernhard Radke. "Adaptive Optimization of Very Large Join Queries." */
+struct Adaptive final : PlanEnumeratorCRTP<Adaptive>
+{
+    using base_type = PlanEnumeratorCRTP<Adaptive>;
+    using base_type::operator();
+
+    ///> the maximal number of CSGs of a query graph to compute the optimal plan
+    static constexpr std::size_t MAX_NUM_CSGS = 1UL << 16;
+    ///> the maximal number of relations of a query graph to use the heuristic plan enumerator
+    static constexpr std::size_t MAX_NUM_RELATIONS_HEURISTIC = 100;
+
+    private:
+    std::chrono::milliseconds budget_ = std::chrono::milliseconds(100); ///< the optimization time budget
+    const char *heuristic_ = "LinearizedDP"; ///< the name of the heuristic plan enumerator
+
+    public:
+    std::chrono::milliseconds budget() const { return budget_; }
+    void budget(std::chrono::milliseconds budget) { budget_ = budget; }
+    const char * heuristic() const { return heuristic_; }
+    void heuristic(const char *name) { M_insist(not streq(name, "Adaptive")); heuristic_ = name; }
+
+    template<typename PlanTable>
+    void operator()(enumerate_tag, PlanTable &PT, const QueryGraph &G, const CostFunction &CF) const {
+        using clock = std::chrono::steady_clock;
+        const auto deadline = clock::now() + budget_;
+
+        const std::size_t n = G.num_sources();
+        if (n <= 1) return;
+        const AdjacencyMatrix &M = G.adjacency_matrix();
+        auto &CE = Catalog::Get().get_database_in_use().cardinality_estimator();
+        const Subproblem All = Subproblem::All(n);
+
+        /*----- Collect the CSGs of at least two relations by their size, unless there are too many. -----*/
+        std::vector<std::vector<Subproblem>> levels(n + 1);
+        std::size_t num_CSGs = 0;
+        const bool is_small = M.for_each_CSG_undirected_while(All, [&](Subproblem S) {
+            if (not S.is_singleton())
+                levels[S.size()].emplace_back(S);
+            return ++num_CSGs <= MAX_NUM_CSGS;
+        });
+
+        if (is_small) {
+            /*----- Solve the CSGs level by level, as long as the time budget permits. -----*/
+            cnf::CNF condition; // TODO use join condition
+            auto handle_ccp = [&](const Subproblem left, const Subproblem right) {
+                PT.update(G, CE, CF, left, right, condition);
+            };
+            for (std::size_t s = 2; s <= n; ++s) {
+                for (const Subproblem S : levels[s]) {
+                    if (clock::now() > deadline)
+                        goto exceeded_budget;
+                    MinCutAGaT{}.partition(M, handle_ccp, S);
+                }
+            }
+            return;
+exceeded_budget:
+            if (not Options::Get().quiet)
+                std::cerr << "WARNING: exceeded the optimization time budget of " << budget_.count()
+                          << " ms, completing the plan greedily" << std::endl;
+            GOO{}(enumerate_tag{}, PT, G, CF);
+            return;
+        }
+
+        if (n <= MAX_NUM_RELATIONS_HEURISTIC and clock::now() < deadline) {
+            auto &C = Catalog::Get();
+            C.plan_enumerator(C.pool(heuristic_))(G, CF, PT);
+            return;
+        }
+
+        /*----- Choose a greedy plan enumerator by the topology of the query graph. -----*/
+        std::size_t num_edges = 0;
+        for (std::size_t i = 0; i != n; ++i)
+            num_edges += M.neighbors(Subproblem::Singleton(i)).size();
+        num_edges /= 2;
+        if (num_edges == n - 1) // acyclic, since the query graph is connected
+            IKKBZ{}(enumerate_tag{}, PT, G, CF);
+        else
+            GOO{}(enumerate_tag{}, PT, G, CF);
+    }
+};
+
+
 #define LIST_PE(X) \
+    X(Adaptive,     "chooses the plan enumerator by the shape and size of the query graph and the optimization time budget") \
     X(DPccp,        "enumerates connected subgraph complement pairs") \
+    X(DPccpParallel, "enumerates connected subgraph complement pairs of equally sized subproblems concurrently") \
     X(DPsize,       "size-based subproblem enumeration") \
     X(DPsizeOpt,    "optimized DPsize: does not enumerate symmetric subproblems") \
     X(DPsizeSub,    "DPsize with enumeration of subset complement pairs") \
@@ -751,4 +945,43 @@ static void register_plan_enumerators()
     C.register_plan_enumerator(C.pool(#NAME), std::make_unique<NAME>(), DESCRIPTION);
 LIST_PE(REGISTER)
 #undef REGISTER
+    C.arg_parser().add<std::size_t>(
+        /* group=       */ "Catalog",
+        /* short=       */ nullptr,
+        /* long=        */ "--plan-enumerator-threads",
+        /* description= */ "set the number of threads of the DPccpParallel plan enumerator (0 means one per hardware "
+                           "thread)",
+        /* callback=    */ [&C](std::size_t n){
+            as<DPccpParallel>(C.plan_enumerator(C.pool("DPccpParallel"))).num_threads(n);
+        }
+    );
+    C.arg_parser().add<std::size_t>(
+        /* group=       */ "Catalog",
+        /* short=       */ nullptr,
+        /* long=        */ "--adaptive-budget",
+        /* description= */ "set the optimization time budget in milliseconds of the Adaptive plan enumerator",
+        /* callback=    */ [&C](std::size_t ms){
+            as<Adaptive>(C.plan_enumerator(C.pool("Adaptive"))).budget(std::chrono::milliseconds(ms));
+        }
+    );
+    C.arg_parser().add<const char*>(
+        /* group=       */ "Catalog",
+        /* short=       */ nullptr,
+        /* long=        */ "--adaptive-heuristic",
+        /* description= */ "set the plan enumerator used by the Adaptive plan enumerator for query graphs too large for "
+                           "exhaustive enumeration (defaults to LinearizedDP)",
+        /* callback=    */ [&C](const char *name){
+            if (streq(name, "Adaptive")) {
+                std::cerr << "The Adaptive plan enumerator cannot use itself as heuristic.\n";
+                std::exit(EXIT_FAILURE);
+            }
+            try {
+                M_DISCARD C.plan_enumerator(C.pool(name));
+            } catch (std::invalid_argument) {
+                std::cerr << "There is no plan enumerator with the name \"" << name << "\".\n";
+                std::exit(EXIT_FAILURE);
+            }
+            as<Adaptive>(C.plan_enumerator(C.pool("Adaptive"))).heuristic(name);
+        }
+    );
 }
@@ -0,0 +1,298 @@
+#include "backend/FlatHashTable.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <mutable/util/fn.hpp>
+
+
+using namespace m;
+
+
+namespace {
+
+/** Rounds `n` up to the next multiple of 8. */
+constexpr std::size_t align8(std::size_t n) { return (n + 7UL) & ~7UL; }
+
+/** The maximum load factor of the slot array.  Since slots are only 8 bytes, we can afford a moderate load factor to
+ * keep probe sequences short. */
+constexpr std::size_t MAX_LOAD_NUMERATOR = 7;
+constexpr std::size_t MAX_LOAD_DENOMINATOR = 10;
+
+}
+
+
+FlatHashTable::FlatHashTable(std::vector<const Type*> key_types, const std::vector<const Type*> &payload_types,
+                             size_type initial_capacity)
+    : types_(std::move(key_types))
+    , num_key_attrs_(types_.size())
+{
+    types_.insert(types_.end(), payload_types.begin(), payload_types.end());
+    const std::size_t num_payload_attrs = types_.size() - num_key_attrs_;
+
+    /* Compute the fixed-width row layout. */
+    const std::size_t key_null_offset = sizeof(header_type);
+    std::size_t offset = key_null_offset + (num_key_attrs_ + 63UL) / 64UL * sizeof(uint64_t);
+    if (num_key_attrs_ == 0)
+        key_end_ = offset;
+    for (std::size_t i = 0; i != types_.size(); ++i) {
+        std::size_t null_offset, null_bit;
+        if (i < num_key_attrs_) {
+            null_offset = key_null_offset;
+            null_bit = i;
+        } else {
+            if (i == num_key_attrs_) { // payload starts at a word boundary, key words are hashed and compared entirely
+                offset = align8(offset);
+                M_insist(offset == key_end_);
+                offset += (num_payload_attrs + 63UL) / 64UL * sizeof(uint64_t); // payload NULL bitmap
+                payload_null_end_ = offset;
+            }
+            null_offset = key_end_;
+            null_bit = i - num_key_attrs_;
+        }
+        null_offset += null_bit / 64UL * sizeof(uint64_t);
+        const uint64_t null_mask = 1UL << (null_bit % 64UL);
+
+        auto ty = types_[i];
+        if (auto cs = cast<const CharacterSequence>(ty)) {
+            key_has_chars_ = key_has_chars_ or i < num_key_attrs_;
+            attrs_.push_back({ attribute_type::K_Char, uint32_t(offset), uint32_t(cs->length), uint32_t(null_offset),
+                               null_mask });
+            offset += cs->length + 1; // inline string with terminating NUL byte
+        } else {
+            offset = align8(offset);
+            auto kind = ty->is_boolean() ? attribute_type::K_Bool
+                      : ty->is_float()   ? attribute_type::K_Float
+                      : ty->is_double()  ? attribute_type::K_Double
+                                         : attribute_type::K_Int; // integral, decimal, date, and datetime
+            attrs_.push_back({ kind, uint32_t(offset), 0, uint32_t(null_offset), null_mask });
+            offset += sizeof(uint64_t);
+        }
+        if (i + 1 == num_key_attrs_)
+            key_end_ = align8(offset);
+    }
+    if (num_payload_attrs == 0)
+        payload_null_end_ = key_end_;
+    row_size_ = align8(offset);
+    key_buffer_.resize(row_size_ / sizeof(uint64_t));
+
+    /* Allocate the slot array. */
+    capacity_ = ceil_to_pow_2(std::max<size_type>(16, initial_capacity * MAX_LOAD_DENOMINATOR / MAX_LOAD_NUMERATOR));
+    slots_ = static_cast<slot_type*>(calloc(capacity_, sizeof(slot_type)));
+}
+
+void FlatHashTable::reserve(size_type n)
+{
+    arena_.reserve(n * row_size_ / sizeof(uint64_t));
+    const size_type required = ceil_to_pow_2(n * MAX_LOAD_DENOMINATOR / MAX_LOAD_NUMERATOR + 1);
+    if (required > capacity_)
+        rehash(required);
+}
+
+void FlatHashTable::clear()
+{
+    arena_.clear();
+    num_rows_ = 0;
+    num_keys_ = 0;
+    std::fill_n(slots_, capacity_, slot_type());
+}
+
+FlatHashTable::size_type FlatHashTable::append_row()
+{
+    M_insist(num_rows_ < std::numeric_limits<uint32_t>::max(), "too many rows");
+    arena_.resize(arena_.size() + row_size_ / sizeof(uint64_t)); // zero-initializes the new row
+    return num_rows_++;
+}
+
+uint64_t FlatHashTable::normalize_key(const Tuple &key)
+{
+    uint8_t *row = reinterpret_cast<uint8_t*>(key_buffer_.data());
+    /* Primitive attributes overwrite their entire word, only character sequences may leave bytes untouched.  Avoid the
+     * `memset()` otherwise: its wide stores stall the subsequent narrow loads of the key words. */
+    if (key_has_chars_)
+        std::fill(key_buffer_.begin() + sizeof(header_type) / sizeof(uint64_t),
+                  key_buffer_.begin() + key_end_ / sizeof(uint64_t), 0UL);
+    for (std::size_t i = 0; i != num_key_attrs_; ++i)
+        store_attr(row, i, key, i);
+
+    /* Hash all key words, including the key NULL bitmap. */
+    uint64_t hash = 0;
+    for (auto p = key_buffer_.data() + sizeof(header_type) / sizeof(uint64_t),
+              end = key_buffer_.data() + key_end_ / sizeof(uint64_t); p != end; ++p)
+    {
+        hash ^= *p;
+        hash *= 0x9e3779b97f4a7c15UL;
+    }
+    return murmur3_64(hash);
+}
+
+FlatHashTable::slot_type * FlatHashTable::lookup(uint64_t hash)
+{
+    const uint32_t tag = uint32_t(hash);
+    const uint8_t *key = reinterpret_cast<const uint8_t*>(key_buffer_.data());
+    const size_type mask = capacity_ - 1UL;
+
+    for (size_type idx = tag & mask; ; idx = (idx + 1UL) & mask) { // linear probing
+        slot_type *slot = slots_ + idx;
+        if (slot->row == 0)
+            return slot; // empty slot
+        if (slot->tag != tag)
+            continue;
+        const uint8_t *row = row_ptr(slot->row - 1);
+        if (equal_keys(reinterpret_cast<const uint64_t*>(row), reinterpret_cast<const uint64_t*>(key)))
+            return slot; // key found
+    }
+}
+
+void FlatHashTable::grow_if_necessary()
+{
+    if ((num_keys_ + 1UL) * MAX_LOAD_DENOMINATOR > capacity_ * MAX_LOAD_NUMERATOR)
+        rehash(2UL * capacity_);
+}
+
+void FlatHashTable::rehash(size_type new_capacity)
+{
+    M_insist(new_capacity <= (1UL << 32), "tags must suffice to compute slot indices");
+    auto new_slots = static_cast<slot_type*>(calloc(new_capacity, sizeof(slot_type)));
+    const size_type mask = new_capacity - 1UL;
+    for (auto p = slots_, end = slots_ + capacity_; p != end; ++p) {
+        if (p->row == 0) continue;
+        size_type idx = p->tag & mask;
+        while (new_slots[idx].row != 0)
+            idx = (idx + 1UL) & mask;
+        new_slots[idx] = *p;
+    }
+    free(slots_);
+    slots_ = new_slots;
+    capacity_ = new_capacity;
+}
+
+FlatHashTable::size_type FlatHashTable::insert_with_duplicates(const Tuple &key, const Tuple &payload)
+{
+    grow_if_necessary();
+    const uint64_t hash = normalize_key(key);
+    slot_type *slot = lookup(hash);
+
+    const size_type row = append_row();
+    uint8_t *ptr = row_ptr(row);
+    std::memcpy(ptr, key_buffer_.data(), key_end_);
+    auto &hdr = header(row);
+    null_payload(ptr); // payload is NULL until stored
+    for (std::size_t i = num_key_attrs_; i != types_.size(); ++i)
+        store_attr(ptr, i, payload, i - num_key_attrs_);
+
+    if (slot->row == 0) {
+        slot->tag = uint32_t(hash);
+        ++num_keys_;
+    } else {
+        hdr.next = slot->row; // prepend to the chain of rows with equal key
+    }
+    slot->row = row + 1;
+    return row;
+}
+
+std::pair<FlatHashTable::size_type, bool> FlatHashTable::find_or_insert(const Tuple &key)
+{
+    grow_if_necessary();
+    const uint64_t hash = normalize_key(key);
+    slot_type *slot = lookup(hash);
+    if (slot->row != 0)
+        return { slot->row - 1, false };
+
+    const size_type row = append_row();
+    std::memcpy(row_ptr(row), key_buffer_.data(), key_end_);
+    null_payload(row_ptr(row)); // payload is NULL
+    slot->tag = uint32_t(hash);
+    slot->row = row + 1;
+    ++num_keys_;
+    return { row, true };
+}
+
+void FlatHashTable::store_attr(uint8_t *row, std::size_t attr, const Tuple &tup, std::size_t tup_idx) const
+{
+    const auto &A = attrs_[attr];
+    uint8_t *dst = row + A.offset;
+    uint64_t &null_word = *reinterpret_cast<uint64_t*>(row + A.null_offset);
+
+    if (tup.is_null(tup_idx)) {
+        null_word |= A.null_mask;
+        if (A.kind == attribute_type::K_Char)
+            std::memset(dst, 0, A.length + 1); // keep unused bytes 0
+        else
+            *reinterpret_cast<uint64_t*>(dst) = 0;
+        return;
+    }
+    null_word &= ~A.null_mask;
+
+    /* Normalize to a zero-extended 8-byte word, independent of the in-memory representation of `Value`. */
+    const Value &val = tup[tup_idx];
+    switch (A.kind) {
+        case attribute_type::K_Int: {
+            const int64_t i = val.as_i();
+            std::memcpy(dst, &i, sizeof(i));
+            break;
+        }
+        case attribute_type::K_Float: {
+            float f = val.as_f();
+            if (attr < num_key_attrs_ and f == 0.f) f = 0.f; // -0.0 and +0.0 are equal keys, unify their bits
+            uint64_t w = 0;
+            std::memcpy(&w, &f, sizeof(f));
+            std::memcpy(dst, &w, sizeof(w));
+            break;
+        }
+        case attribute_type::K_Double: {
+            double d = val.as_d();
+            if (attr < num_key_attrs_ and d == 0.) d = 0.; // -0.0 and +0.0 are equal keys, unify their bits
+            std::memcpy(dst, &d, sizeof(d));
+            break;
+        }
+        case attribute_type::K_Bool:
+            *reinterpret_cast<uint64_t*>(dst) = val.as_b();
+            break;
+        case attribute_type::K_Char: {
+            /* `strncpy()` pads with NUL bytes, hence equal strings have equal normalized representations. */
+            char *str = reinterpret_cast<char*>(dst);
+            strncpy(str, reinterpret_cast<const char*>(val.as_p()), A.length);
+            str[A.length] = 0;
+            break;
+        }
+    }
+}
+
+void FlatHashTable::load_attr(size_type row, std::size_t attr, Tuple &tup, std::size_t tup_idx) const
+{
+    const uint8_t *ptr = row_ptr(row);
+    const auto &A = attrs_[attr];
+    if (*reinterpret_cast<const uint64_t*>(ptr + A.null_offset) & A.null_mask) {
+        tup.null(tup_idx);
+        return;
+    }
+
+    const uint8_t *src = ptr + A.offset;
+    switch (A.kind) {
+        case attribute_type::K_Int: {
+            int64_t i;
+            std::memcpy(&i, src, sizeof(i));
+            tup.set(tup_idx, i);
+            break;
+        }
+        case attribute_type::K_Float: {
+            float f;
+            std::memcpy(&f, src, sizeof(f));
+            tup.set(tup_idx, f);
+            break;
+        }
+        case attribute_type::K_Double: {
+            double d;
+            std::memcpy(&d, src, sizeof(d));
+            tup.set(tup_idx, d);
+            break;
+        }
+        case attribute_type::K_Bool:
+            tup.set(tup_idx, bool(*reinterpret_cast<const uint64_t*>(src)));
+            break;
+        case attribute_type::K_Char:
+            strcpy(reinterpret_cast<char*>(tup[tup_idx].as_p()), reinterpret_cast<const char*>(src));
+            tup.not_null(tup_idx);
+            break;
+    }
+}
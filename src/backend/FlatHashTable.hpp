@@ -0,0 +1,186 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <mutable/catalog/Type.hpp>
+#include <mutable/IR/Tuple.hpp>
+#include <mutable/util/macro.hpp>
+#include <utility>
+#include <vector>
+
+
+namespace m {
+
+/** A flat, open-addressing hash table used by the `Interpreter` for hash joins and hash-based grouping.
+ *
+ * Instead of storing heap-allocated `Tuple`s, every entry is *normalized* into a fixed-width row that is placed in a
+ * contiguous arena.  A row consists of a header, the key attributes, and the payload attributes, each preceded by the
+ * NULL bitmap of these attributes with one 8-byte word per 64 attributes:
+ *
+ *     | next : u32 | count : u32 | key NULL bitmap | key attributes ... | payload NULL bitmap | payload attrs ... |
+ *
+ * Attributes of a primitive type are normalized to one zero-extended 8-byte word each, character sequences of length N
+ * are stored inline with N + 1 bytes.  Unused bytes are always zero and negative zero keys are stored as positive
+ * zero, such that keys, including their NULL bitmap, can be compared with `memcmp()`.  The slot array only stores a
+ * 32-bit hash tag and a reference to a row.  Rows with equal keys are chained via the `next` field in the row header,
+ * hence every distinct key occupies exactly one slot.  Row references are row indices (plus one, to reserve zero for
+ * *empty*); they remain valid while the arena grows. */
+struct FlatHashTable
+{
+    using size_type = std::size_t;
+
+    private:
+    struct slot_type
+    {
+        uint32_t tag = 0; ///< the lower 32 bits of the key's hash
+        uint32_t row = 0; ///< index of the first row with this key plus one; `0` marks an empty slot
+    };
+
+    struct header_type
+    {
+        uint32_t next; ///< index of the next row with an equal key plus one; `0` marks the end of the chain
+        uint32_t count; ///< a per-row counter, e.g. the number of tuples in a group
+    };
+    static_assert(sizeof(header_type) % sizeof(uint64_t) == 0);
+
+    /** Describes how an attribute is normalized; precomputed to avoid inspecting `Type`s per access. */
+    struct attribute_type
+    {
+        enum kind_t : uint8_t { K_Int, K_Float, K_Double, K_Bool, K_Char } kind;
+        uint32_t offset; ///< the byte offset of the attribute within a row
+        uint32_t length; ///< the length of a character sequence; unused otherwise
+        uint32_t null_offset; ///< the byte offset of the word of the NULL bitmap holding the NULL bit of the attribute
+        uint64_t null_mask; ///< the NULL bit of the attribute within its word of the NULL bitmap; `1` represents `NULL`
+    };
+
+    std::vector<const Type*> types_; ///< the `Type`s of all attributes, key attributes first
+    std::size_t num_key_attrs_; ///< the number of key attributes
+    std::vector<attribute_type> attrs_; ///< the normalization of each attribute
+    std::size_t key_end_; ///< the byte offset of the end of the key attributes within a row, aligned to 8 bytes
+    std::size_t payload_null_end_; ///< the byte offset of the end of the payload NULL bitmap within a row
+    std::size_t row_size_; ///< the size of a row in bytes, a multiple of 8
+    bool key_has_chars_ = false; ///< whether any key attribute is a character sequence
+
+    std::vector<uint64_t> arena_; ///< the rows, stored contiguously
+    size_type num_rows_ = 0; ///< the number of rows in the arena
+    std::vector<uint64_t> key_buffer_; ///< a row used to normalize keys for lookups
+
+    slot_type *slots_ = nullptr; ///< the slot array
+    size_type capacity_ = 0; ///< the number of slots, a power of 2
+    size_type num_keys_ = 0; ///< the number of occupied slots, i.e. the number of distinct keys
+
+    public:
+    /** Creates a `FlatHashTable` for keys of `Type`s `key_types` and payloads of `Type`s `payload_types`, with room for
+     * at least `initial_capacity` distinct keys. */
+    FlatHashTable(std::vector<const Type*> key_types, const std::vector<const Type*> &payload_types,
+                  size_type initial_capacity = 1024);
+    ~FlatHashTable() { free(slots_); }
+
+    FlatHashTable(const FlatHashTable&) = delete;
+    FlatHashTable(FlatHashTable&&) = delete;
+
+    /** Returns the number of rows, i.e.\ the number of inserted entries including duplicates. */
+    size_type size() const { return num_rows_; }
+    /** Returns the number of distinct keys. */
+    size_type num_keys() const { return num_keys_; }
+    /** Returns the number of slots. */
+    size_type capacity() const { return capacity_; }
+    /** Returns the size of a normalized row in bytes. */
+    size_type row_size() const { return row_size_; }
+
+    /** Makes room for at least `n` rows with distinct keys without further resizing. */
+    void reserve(size_type n);
+
+    /** Removes all rows while retaining the allocated memory. */
+    void clear();
+
+    /** Inserts a new row with the key of `key` and the payload of `payload`, even if a row with an equal key already
+     * exists.  The first `num_key_attrs()` attributes of `key` form the key.  Returns the index of the new row. */
+    size_type insert_with_duplicates(const Tuple &key, const Tuple &payload);
+
+    /** Returns the index of the row with the key of `key` and `false`, if such a row exists.  Otherwise, inserts a new
+     * row with the key of `key`, a `NULL` payload, and a count of `0` and returns its index and `true`.  The first
+     * `num_key_attrs()` attributes of `key` form the key. */
+    std::pair<size_type, bool> find_or_insert(const Tuple &key);
+
+    /** Invokes `fn` with the index of every row whose key equals the key of `key`. */
+    template<typename Fn>
+    void for_each_in_equal_range(const Tuple &key, Fn &&fn) {
+        const uint64_t hash = normalize_key(key);
+        const slot_type *slot = lookup(hash);
+        if (slot->row == 0) return; // key not found
+        for (uint32_t r = slot->row; r; r = header(r - 1).next)
+            fn(size_type(r - 1));
+    }
+
+    /** Returns the counter of the row at index `row`. */
+    uint32_t & count(size_type row) { return header(row).count; }
+    /** Returns the counter of the row at index `row`. */
+    uint32_t count(size_type row) const { return const_cast<FlatHashTable*>(this)->count(row); }
+
+    /** Loads all attributes, key attributes first, of the row at index `row` into `tup`. */
+    void load(size_type row, Tuple &tup) const {
+        for (std::size_t i = 0; i != types_.size(); ++i)
+            load_attr(row, i, tup, i);
+    }
+
+    /** Loads the payload attributes of the row at index `row` into `tup`, starting at index `pos` of `tup`. */
+    void load_payload(size_type row, Tuple &tup, std::size_t pos = 0) const {
+        for (std::size_t i = num_key_attrs_; i != types_.size(); ++i)
+            load_attr(row, i, tup, pos + i - num_key_attrs_);
+    }
+
+    /** Stores the payload attributes of `tup`, starting at index `pos` of `tup`, into the row at index `row`. */
+    void store_payload(size_type row, const Tuple &tup, std::size_t pos = 0) {
+        for (std::size_t i = num_key_attrs_; i != types_.size(); ++i)
+            store_attr(row_ptr(row), i, tup, pos + i - num_key_attrs_);
+    }
+
+    std::size_t num_key_attrs() const { return num_key_attrs_; }
+    std::size_t num_payload_attrs() const { return types_.size() - num_key_attrs_; }
+
+    private:
+    uint8_t * row_ptr(size_type row) {
+        M_insist(row < num_rows_, "row index out of bounds");
+        return reinterpret_cast<uint8_t*>(arena_.data()) + row * row_size_;
+    }
+    const uint8_t * row_ptr(size_type row) const { return const_cast<FlatHashTable*>(this)->row_ptr(row); }
+    header_type & header(size_type row) { return *reinterpret_cast<header_type*>(row_ptr(row)); }
+
+    /** Compares the key words, including the key NULL bitmap, of the rows `first` and `second`.  Since keys are
+     * normalized and padded with zeros, they can be compared word by word. */
+    bool equal_keys(const uint64_t *first, const uint64_t *second) const {
+        for (std::size_t i = sizeof(header_type) / sizeof(uint64_t), end = key_end_ / sizeof(uint64_t); i != end; ++i) {
+            if (first[i] != second[i])
+                return false;
+        }
+        return true;
+    }
+
+    /** Appends a new, zero-initialized row to the arena and returns its index. */
+    size_type append_row();
+    /** Sets all payload attributes of the row at `row` to `NULL`. */
+    void null_payload(uint8_t *row) const {
+        std::memset(row + key_end_, 0xff, payload_null_end_ - key_end_);
+    }
+
+    /** Normalizes the key of `key` into `key_buffer_` and returns its hash. */
+    uint64_t normalize_key(const Tuple &key);
+
+    /** Returns the slot for the key in `key_buffer_` with hash `hash`; this is either the slot holding this key or the
+     * empty slot where this key would be inserted. */
+    slot_type * lookup(uint64_t hash);
+
+    /** Doubles the number of slots if inserting another key would exceed the maximum load factor. */
+    void grow_if_necessary();
+    /** Rehashes all keys into a slot array of `new_capacity` slots. */
+    void rehash(size_type new_capacity);
+
+    /** Stores attribute `tup_idx` of `tup` as attribute `attr` of the normalized row at `row`. */
+    void store_attr(uint8_t *row, std::size_t attr, const Tuple &tup, std::size_t tup_idx) const;
+    /** Loads attribute `attr` of the row at index `row` into `tup` at index `tup_idx`. */
+    void load_attr(size_type row, std::size_t attr, Tuple &tup, std::size_t tup_idx) const;
+};
+
+}
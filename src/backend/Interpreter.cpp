@@ -1,15 +1,22 @@
 #include "backend/Interpreter.hpp"
 
-#include "util/container/RefCountingHashMap.hpp"
+#include "backend/FlatHashTable.hpp"
 #include <algorithm>
 #include <cerrno>
 #include <cstdlib>
+#include <functional>
 #include <iterator>
+#include <memory>
 #include <mutable/catalog/Catalog.hpp>
 #include <mutable/Options.hpp>
 #include <mutable/parse/AST.hpp>
+#include <mutable/storage/DataLayoutFactory.hpp>
+#include <mutable/storage/Index.hpp>
+#include <mutable/storage/Versioning.hpp>
+#include <mutable/storage/ZoneMap.hpp>
 #include <mutable/util/fn.hpp>
 #include <numeric>
+#include <optional>
 #include <type_traits>
 
 
@@ -21,6 +28,36 @@ using namespace m::storage;
  * Helper function
  *====================================================================================================================*/
 
+/** Emits code to load the encoded value of the `Leaf` \p leaf from the address on top of the stack of \p SM and to
+ * decode it, leaving the decoded value on top of the stack. */
+static void emit_load_encoded(StackMachine &SM, const DataLayout::Leaf &leaf)
+{
+    auto &enc = leaf.encoding();
+    M_insist(bool(enc), "leaf is not encoded");
+
+    /* Load the code and zero-extend it, since codes are unsigned. */
+    SM.emit_Ld(enc.stored_type);
+    SM.add_and_emit_load(int64_t((1UL << enc.stored_type->size()) - 1UL));
+    SM.emit_And_i();
+
+    /* Decode the value. */
+    switch (enc.kind) {
+        case DataLayout::encoding_t::E_None:
+            M_unreachable("leaf is not encoded");
+        case DataLayout::encoding_t::E_FrameOfReference:
+            SM.add_and_emit_load(enc.reference);
+            SM.emit_Add_i();
+            break;
+        case DataLayout::encoding_t::E_Dictionary:
+            SM.add_and_emit_load(int64_t(enc.entry_size));
+            SM.emit_Mul_i();
+            SM.add_and_emit_load(const_cast<void*>(static_cast<const void*>(enc.dictionary->data())));
+            SM.emit_Add_p(); // address of the dictionary entry
+            SM.emit_Ld(leaf.type());
+            break;
+    }
+}
+
 /** Compile a `StackMachine` to load or store a tuple of `Schema` `tuple_schema` using a given memory address and a
  * given `DataLayout`.
  *
@@ -303,6 +340,8 @@ static StackMachine compile_data_layout(const Schema &tuple_schema, void *addres
                                 SM.emit_Pop();
                             } else {
                                 if constexpr (IsStore) {
+                                    M_insist(not child_leaf->encoding(), "cannot store to an encoded leaf");
+
                                     /* Load value to stack. */
                                     SM.emit_Ld_Tup(tuple_id, idx);
 
@@ -313,10 +352,13 @@ static StackMachine compile_data_layout(const Schema &tuple_schema, void *addres
                                         SM.emit_St(child_leaf->type());
                                 } else {
                                     /* Load value. */
-                                    if (child_leaf->type()->is_boolean())
+                                    if (child_leaf->encoding()) {
+                                        emit_load_encoded(SM, *child_leaf);
+                                    } else if (child_leaf->type()->is_boolean()) {
                                         SM.emit_Ld_b(0x1UL << bit_offset); // convert the fixed bit offset to a fixed mask
-                                    else
+                                    } else {
                                         SM.emit_Ld(child_leaf->type());
+                                    }
 
                                     if (attr_can_be_null)
                                         SM.emit_Sel();
@@ -553,6 +595,119 @@ StackMachine Interpreter::compile_store(const Schema &tuple_schema, void *addres
     return compile_data_layout<true>(tuple_schema, address, layout, layout_schema, row_id, tuple_id);
 }
 
+StackMachine Interpreter::compile_load_point_access(const Schema &tuple_schema, void *address,
+                                                    const storage::DataLayout &layout, const Schema &layout_schema,
+                                                    std::size_t tuple_id)
+{
+    StackMachine SM;
+    const auto row_id_idx = SM.add(int64_t(0)); // set by the caller to the ID of the row to load
+    M_insist(row_id_idx == POINT_ACCESS_ROW_ID_IDX);
+    const auto address_idx = SM.add(address);
+
+    /*----- Collect the path from the root to every leaf that must be loaded and to the NULL bitmap. -----*/
+    using path_t = std::vector<const DataLayout::INode::child_t*>;
+    const auto null_bitmap_idx = layout_schema.num_entries();
+    path_t null_bitmap_path;
+    std::vector<std::pair<path_t, std::size_t>> leaves; // the path to each leaf and the index of its attribute
+    auto collect_leaves = [&](const DataLayout::INode &node, path_t &path, auto &collect_leaves_ref) -> void {
+        for (auto &child : node) {
+            path.push_back(&child);
+            if (auto child_leaf = cast<const DataLayout::Leaf>(child.ptr.get())) {
+                if (child_leaf->index() == null_bitmap_idx) {
+                    M_insist(null_bitmap_path.empty(), "there must be at most one null bitmap in the linearization");
+                    null_bitmap_path = path;
+                } else if (auto it = tuple_schema.find(layout_schema[child_leaf->index()].id);
+                           it != tuple_schema.end())
+                {
+                    leaves.emplace_back(path, std::distance(tuple_schema.begin(), it));
+                }
+            } else {
+                collect_leaves_ref(as<const DataLayout::INode>(*child.ptr), path, collect_leaves_ref);
+            }
+            path.pop_back();
+        }
+    };
+    path_t path;
+    collect_leaves(static_cast<const DataLayout::INode&>(layout), path, collect_leaves);
+
+    /* Emits code to compute the offset in bits, relative to `address`, of the value of the row to load within the leaf
+     * at the end of `path`, plus `additional_bits`.  Within the `INode` of each level, the row is located in the
+     * linearization given by the ID of the row within this `INode` divided by the number of tuples of the child. */
+    auto emit_bit_offset = [&](const path_t &path, uint64_t additional_bits) {
+        SM.add_and_emit_load(int64_t(additional_bits));
+        for (std::size_t level = 0; level != path.size(); ++level) {
+            /* Compute the ID of the row within the `INode` of this level. */
+            SM.emit_Ld_Ctx(row_id_idx);
+            for (std::size_t i = 0; i != level; ++i) {
+                SM.add_and_emit_load(int64_t(path[i]->ptr->num_tuples()));
+                SM.emit_Mod_i();
+            }
+            if (level + 1 != path.size()) { // child is an `INode`, compute the ID of its linearization
+                SM.add_and_emit_load(int64_t(path[level]->ptr->num_tuples()));
+                SM.emit_Div_i();
+            }
+            SM.add_and_emit_load(int64_t(path[level]->stride_in_bits));
+            SM.emit_Mul_i();
+            SM.add_and_emit_load(int64_t(path[level]->offset_in_bits));
+            SM.emit_Add_i();
+            SM.emit_Add_i();
+        }
+    };
+
+    /* Emits code to load the bit at offset `additional_bits` of the value of the row to load within the leaf at the end
+     * of `path` as boolean. */
+    auto emit_Ld_bit = [&](const path_t &path, uint64_t additional_bits) {
+        /* Load the byte containing the bit. */
+        emit_bit_offset(path, additional_bits);
+        SM.emit_SARi_i(3);
+        SM.emit_Ld_Ctx(address_idx);
+        SM.emit_Add_p();
+        SM.emit_Ld_i8();
+
+        /* Compute the mask of the bit within the byte, apply it, and convert to bool. */
+        SM.add_and_emit_load(int64_t(1));
+        emit_bit_offset(path, additional_bits);
+        SM.add_and_emit_load(int64_t(0b111));
+        SM.emit_And_i();
+        SM.emit_ShL_i();
+        SM.emit_And_i();
+        SM.emit_NEZ_i();
+    };
+
+    /*----- Emit code to load every attribute. -----*/
+    for (auto &[leaf_path, idx] : leaves) {
+        auto &leaf = as<const DataLayout::Leaf>(*leaf_path.back()->ptr);
+        const bool attr_can_be_null = not null_bitmap_path.empty() and layout_schema[leaf.index()].nullable();
+
+        if (attr_can_be_null) {
+            emit_Ld_bit(null_bitmap_path, leaf.index()); // the NULL bit of the attribute
+            SM.emit_Push_Null(); // to select it later if NULL
+        }
+
+        if (leaf.type()->is_boolean()) {
+            emit_Ld_bit(leaf_path, 0);
+        } else {
+            emit_bit_offset(leaf_path, 0);
+            SM.emit_SARi_i(3);
+            SM.emit_Ld_Ctx(address_idx);
+            SM.emit_Add_p();
+            if (leaf.encoding())
+                emit_load_encoded(SM, leaf);
+            else
+                SM.emit_Ld(leaf.type());
+        }
+
+        if (attr_can_be_null)
+            SM.emit_Sel();
+
+        /* Store value in output tuple. */
+        SM.emit_St_Tup(tuple_id, idx, leaf.type());
+        SM.emit_Pop();
+    }
+
+    return SM;
+}
+
 /*======================================================================================================================
  * Declaration of operator data.
  *====================================================================================================================*/
@@ -582,10 +737,71 @@ struct NoOpData : OperatorData
     uint32_t num_rows = 0;
 };
 
+/** Collects the results of a `CallbackOperator` with a batch callback in a row layout and hands them batch-wise to the
+ * callback. */
+struct CallbackData : OperatorData
+{
+    static constexpr std::size_t BATCH_SIZE = 1024; ///< the maximum number of tuples per batch
+
+    const CallbackOperator &op;
+    Schema layout_schema; ///< the materialized attributes, i.e. the operator's schema w/o constants and duplicates
+    std::vector<std::size_t> indices; ///< the index in the operator's schema of each entry of `layout_schema`
+    storage::DataLayout layout;
+    std::unique_ptr<uint8_t[]> memory;
+    std::optional<StackMachine> store;
+    Tuple tup; ///< the tuple to store, in the order of `layout_schema`
+    std::optional<Tuple> constants; ///< the operator's schema with all constants set; computed from the first tuple
+    std::size_t num_tuples = 0; ///< the number of tuples in the current batch
+
+    CallbackData(const CallbackOperator &op)
+        : op(op)
+        , layout_schema(op.schema().deduplicate().drop_constants())
+        , tup(layout_schema)
+    {
+        for (auto &e : layout_schema)
+            indices.push_back(op.schema()[e.id].first);
+        if (layout_schema.num_entries() != 0) {
+            layout = storage::RowLayoutFactory().make(layout_schema, BATCH_SIZE);
+            memory = std::make_unique<uint8_t[]>(BATCH_SIZE * layout.stride_in_bits() / 8);
+        }
+    }
+
+    void append(const Tuple &t) {
+        if (not constants) {
+            constants.emplace(t.clone(op.schema()));
+            for (std::size_t i = 0; i != op.schema().num_entries(); ++i) {
+                if (not op.schema()[i].id.is_constant())
+                    constants->null(i);
+            }
+        }
+        if (layout_schema.num_entries() != 0) {
+            if (not store)
+                store.emplace(Interpreter::compile_store(layout_schema, memory.get(), layout, layout_schema));
+            for (std::size_t i = 0; i != indices.size(); ++i)
+                tup.set(i, t[indices[i]], t.is_null(indices[i]));
+            Tuple *args[] = { &tup };
+            (*store)(args);
+        }
+        if (++num_tuples == BATCH_SIZE)
+            flush();
+    }
+
+    /** Hands the current batch to the callback and starts a new batch. */
+    void flush() {
+        if (num_tuples == 0) return;
+        op.batch_callback()(op.schema(), CallbackOperator::batch_type{
+            layout_schema, layout, memory.get(), num_tuples, *constants
+        });
+        num_tuples = 0;
+        store.reset(); // the compiled store advances its addresses per tuple, hence recompile for the next batch
+    }
+};
+
 struct ProjectionData : OperatorData
 {
     Pipeline pipeline;
     std::optional<StackMachine> projections;
+    bool batchable = false; ///< whether `projections` can be evaluated in batch mode
     Tuple res;
 
     ProjectionData(const ProjectionOperator &op)
@@ -600,6 +816,7 @@ struct ProjectionData : OperatorData
             projections->emit(p.first.get(), 1);
             projections->emit_St_Tup(0, out_idx++, p.first.get().type());
         }
+        batchable = projections->is_batchable();
     }
 };
 
@@ -649,14 +866,15 @@ struct SimpleHashJoinData : JoinData
     std::vector<std::pair<const ast::Expr*, const ast::Expr*>> exprs;
     StackMachine build_key; ///< extracts the key of the build input
     StackMachine probe_key; ///< extracts the key of the probe input
-    RefCountingHashMap<Tuple, Tuple> ht; ///< hash table on build input
+    std::optional<FlatHashTable> ht; ///< hash table on build input
 
     Schema key_schema; ///< the `Schema` of the `key`
     Tuple key; ///< `Tuple` to hold the key
+    Tuple build_tuple; ///< `Tuple` to hold a build tuple loaded from `ht`
 
     SimpleHashJoinData(const JoinOperator &op)
         : JoinData(op)
-        , ht(1024)
+        , build_tuple(op.child(0)->schema())
     {
         auto &schema_lhs = op.child(0)->schema();
 #ifndef NDEBUG
@@ -700,8 +918,14 @@ struct SimpleHashJoinData : JoinData
             }
         }
 
-        /* Create the tuple holding a key. */
+        /* Create the tuple holding a key and the hash table. */
         key = Tuple(key_schema);
+        std::vector<const Type*> key_types, build_types;
+        for (auto &e : key_schema)
+            key_types.push_back(e.type);
+        for (auto &e : op.child(0)->schema())
+            build_types.push_back(e.type);
+        ht.emplace(std::move(key_types), build_types);
     }
 
     void load_build_key(const Schema &pipeline_schema) {
@@ -721,6 +945,121 @@ struct SimpleHashJoinData : JoinData
     }
 };
 
+/** Data of an index nested-loops join of two children.  One child, the *inner* child, is a `ScanOperator` whose table
+ * has a hash index on the attribute it is joined on.  Only the other, *outer* child is executed.  For every tuple of
+ * the outer child, the index is probed with the join key and every matching row is loaded from the store of the inner
+ * child by its `tuple_id`. */
+struct IndexNestedLoopsJoinData : JoinData
+{
+    ///> calls its second argument with the `tuple_id` of every indexed row whose key equals the first argument
+    using probe_type = std::function<void(const Value&, const std::function<void(uint32_t)>&)>;
+
+    const ScanOperator &inner; ///< the inner child
+    const ast::Expr &outer_key_expr; ///< the join key of the outer child
+    probe_type probe; ///< probes the hash index of the inner child
+    StackMachine outer_key; ///< extracts the key of the outer input
+    StackMachine load_inner; ///< loads a row of the inner child by its `tuple_id`
+    Tuple key; ///< `Tuple` to hold the key
+    Tuple inner_tuple; ///< `Tuple` to hold a row of the inner child
+
+    IndexNestedLoopsJoinData(const JoinOperator &op, const ScanOperator &inner, const ast::Designator &inner_key,
+                             const ast::Expr &outer_key_expr)
+        : JoinData(op)
+        , inner(inner)
+        , outer_key_expr(outer_key_expr)
+        , load_inner(Interpreter::compile_load_point_access(inner.schema(), inner.store().memory().addr(),
+                                                            inner.store().table().layout(),
+                                                            inner.store().table().schema()))
+        , key({ outer_key_expr.type() })
+        , inner_tuple(inner.schema())
+    {
+        auto &index = Catalog::Get().get_database_in_use().get_index(
+            inner.store().table().name(), inner_key.attr_name.text.assert_not_none(), idx::IndexMethod::Hash
+        );
+        auto make_probe = [&index]<typename Key>() -> probe_type {
+            auto &hash_index = as<const idx::HashIndex<Key>>(index);
+            return [&hash_index](const Value &key, const std::function<void(uint32_t)> &fn) {
+                if constexpr (std::floating_point<Key>)
+                    hash_index.for_each_in_equal_range(key.as<Key>(), fn);
+                else
+                    hash_index.for_each_in_equal_range(Key(key.as_i()), fn);
+            };
+        };
+        visit(overloaded {
+            [&](const Numeric &n) {
+                switch (n.kind) {
+                    case Numeric::N_Int:
+                    case Numeric::N_Decimal:
+                        switch (n.size()) {
+                            default: M_unreachable("invalid size");
+                            case  8: probe = make_probe.operator()<int8_t>();  break;
+                            case 16: probe = make_probe.operator()<int16_t>(); break;
+                            case 32: probe = make_probe.operator()<int32_t>(); break;
+                            case 64: probe = make_probe.operator()<int64_t>(); break;
+                        }
+                        break;
+                    case Numeric::N_Float:
+                        if (n.size() == 32)
+                            probe = make_probe.operator()<float>();
+                        else
+                            probe = make_probe.operator()<double>();
+                        break;
+                }
+            },
+            [&](const Date&) { probe = make_probe.operator()<int32_t>(); },
+            [&](const DateTime&) { probe = make_probe.operator()<int64_t>(); },
+            [](auto&&) { M_unreachable("invalid key type"); },
+        }, *inner_key.type());
+    }
+
+    /** Returns the index of the child of \p op that is the inner child of an index nested-loops join and sets \p
+     * inner_key and \p outer_key_expr to its join key and to the join key of the other child, respectively.  Returns
+     * `-1UL` if \p op cannot be performed as index nested-loops join, i.e. if it is not a join of two children by a
+     * single equality of which one side is an attribute of a child that is a `ScanOperator` and has a hash index. */
+    static std::size_t find_inner_child(const JoinOperator &op, const ast::Designator *&inner_key,
+                                        const ast::Expr *&outer_key_expr)
+    {
+        auto &pred = op.predicate();
+        if (op.children().size() != 2 or pred.size() != 1 or pred[0].size() != 1 or pred[0][0].negative())
+            return -1UL;
+        auto binary = cast<const ast::BinaryExpr>(&pred[0][0].expr());
+        if (not binary or binary->tok != TK_EQUAL or binary->lhs->type() != binary->rhs->type())
+            return -1UL;
+
+        auto &DB = Catalog::Get().get_database_in_use();
+        std::size_t inner_child = -1UL;
+        for (std::size_t child_idx = 0; child_idx != 2; ++child_idx) {
+            auto scan = cast<const ScanOperator>(op.child(child_idx));
+            if (not scan or scan->has_snapshot()) // indexes contain all versions of rows
+                continue;
+            for (auto [key, other] : { std::make_pair(binary->lhs.get(), binary->rhs.get()),
+                                       std::make_pair(binary->rhs.get(), binary->lhs.get()) })
+            {
+                auto designator = cast<const ast::Designator>(key);
+                if (not designator or not scan->schema().has(Schema::Identifier(*designator)))
+                    continue;
+                if (not DB.has_index(scan->store().table().name(), designator->attr_name.text.assert_not_none(),
+                                     idx::IndexMethod::Hash))
+                    continue;
+                /* Prefer the larger table as inner child, since it is not scanned. */
+                if (inner_child == -1UL or
+                    as<const ScanOperator>(op.child(inner_child))->store().num_rows() < scan->store().num_rows())
+                {
+                    inner_child = child_idx;
+                    inner_key = designator;
+                    outer_key_expr = other;
+                }
+            }
+        }
+        return inner_child;
+    }
+
+    void load_outer_key(const Schema &pipeline_schema) {
+        outer_key.emit(outer_key_expr, pipeline_schema, 1); // compile expr
+        outer_key.emit_St_Tup(0, 0, outer_key_expr.type()); // write result to index 0
+    }
+};
+
 struct LimitData : OperatorData
 {
     std::size_t num_tuples = 0;
@@ -803,49 +1142,28 @@ struct AggregationData : OperatorData
 
 struct HashBasedGroupingData : GroupingData
 {
-    /** Callable to compute the hash of the keys of a tuple. */
-    struct hasher
-    {
-        std::size_t key_size;
-
-        hasher(std::size_t key_size) : key_size(key_size) { }
-
-        uint64_t operator()(const Tuple &tup) const {
-            std::hash<Value> h;
-            uint64_t hash = 0xcbf29ce484222325;
-            for (std::size_t i = 0; i != key_size; ++i) {
-                hash ^= tup.is_null(i) ? 0 : h(tup[i]);
-                hash *= 1099511628211;
-            }
-            return hash;
-        }
-    };
-
-    /** Callable to compare two tuples by their keys. */
-    struct equals
-    {
-        std::size_t key_size;
-
-        equals(std::size_t key_size) : key_size(key_size) { }
-
-        uint64_t operator()(const Tuple &first, const Tuple &second) const {
-            for (std::size_t i = 0; i != key_size; ++i) {
-                if (first.is_null(i) != second.is_null(i)) return false;
-                if (not first.is_null(i))
-                    if (first.get(i) != second.get(i)) return false;
-            }
-            return true;
-        }
-    };
-
-    /** A map of `Tuple`s, where the key part is used for hashing and comparison.  The mapped to value holds the count
-     * of tuples that belong to this group. */
-    std::unordered_map<Tuple, unsigned, hasher, equals> groups;
+    /** A hash table of groups.  The key attributes of a row are the grouping keys, the payload attributes are the
+     * aggregates, and the row's count holds the number of tuples that belong to this group. */
+    FlatHashTable groups;
+    Tuple key; ///< `Tuple` to hold the key of the current tuple
+    Tuple group; ///< `Tuple` to hold the aggregates of the current group
 
     HashBasedGroupingData(const GroupingOperator &op)
         : GroupingData(op)
-        , groups(1024, hasher(op.group_by().size()), equals(op.group_by().size()))
+        , groups(types(op.schema(), 0, op.group_by().size()),
+                 types(op.schema(), op.group_by().size(), op.schema().num_entries()))
+        , key(op.schema())
+        , group(op.schema())
     { }
+
+    private:
+    /** Returns the `Type`s of the entries in the range [`begin`, `end`) of `S`. */
+    static std::vector<const Type*> types(const Schema &S, std::size_t begin, std::size_t end) {
+        std::vector<const Type*> types;
+        for (std::size_t i = begin; i != end; ++i)
+            types.push_back(S[i].type);
+        return types;
+    }
 };
 
 struct SortingData : OperatorData
@@ -859,7 +1177,9 @@ struct SortingData : OperatorData
 struct FilterData : OperatorData
 {
     StackMachine filter;
+    bool batchable; ///< whether `filter` can be evaluated in batch mode
     Tuple res;
+    std::array<Tuple, StackMachine::BATCH_SIZE> batch_res; ///< one result per slot of a block in batch mode
 
     FilterData(const FilterOperator &op, const Schema &pipeline_schema)
         : filter(pipeline_schema)
@@ -867,6 +1187,11 @@ struct FilterData : OperatorData
     {
         filter.emit(op.filter(), 1);
         filter.emit_St_Tup_b(0, 0);
+        batchable = filter.is_batchable();
+        if (batchable) {
+            for (auto &t : batch_res)
+                t = Tuple({ Type::Get_Boolean(Type::TY_Vector) });
+        }
     }
 };
 
@@ -902,36 +1227,78 @@ void Pipeline::operator()(const ScanOperator &op)
     auto &table = store.table();
     const auto num_rows = store.num_rows();
 
-    /* Compile StackMachine to load tuples from store. */
-    auto loader = Interpreter::compile_load(op.schema(), store.memory().addr(), table.layout(), table.schema());
-
-    const auto remainder = num_rows % block_.capacity();
-    std::size_t i = 0;
-    /* Fill entire vector. */
-    for (auto end = num_rows - remainder; i != end; i += block_.capacity()) {
-        block_.clear();
-        block_.fill();
-        for (std::size_t j = 0; j != block_.capacity(); ++j) {
-            Tuple *args[] = { &block_[j] };
-            loader(args);
-        }
-        op.parent()->accept(*this);
+    /* If a filter is directly on top of the scan, consult the zone map to skip zones in which no row can satisfy the
+     * filter. */
+    std::vector<bool> skippable_zones;
+    if (auto filter = cast<const FilterOperator>(op.parent())) {
+        skippable_zones = store.zone_map().skippable_zones(filter->filter(), table.schema(op.alias()));
+        Catalog::Get().timer().increment("Zones skipped by zone maps",
+                                          std::count(skippable_zones.begin(), skippable_zones.end(), true));
     }
-    if (i != num_rows) {
-        /* Fill last vector with remaining tuples. */
-        block_.clear();
-        block_.mask((1UL << remainder) - 1);
-        for (std::size_t j = 0; i != op.store().num_rows(); ++i, ++j) {
-            M_insist(j < block_.capacity());
-            Tuple *args[] = { &block_[j] };
-            loader(args);
+
+    /* If a snapshot is scanned, additionally load the timestamps of every row to drop the versions of rows that are
+     * invisible in the snapshot. */
+    Schema ts_schema;
+    if (op.has_snapshot()) {
+        const auto ts = get_timestamp_attributes(table);
+        M_insist(bool(ts), "only multi-versioned tables can be scanned in a snapshot");
+        const auto S = table.schema();
+        ts_schema.add(S[ts->begin].id, S[ts->begin].type, S[ts->begin].constraints);
+        ts_schema.add(S[ts->end].id, S[ts->end].type, S[ts->end].constraints);
+    }
+    Tuple ts_tup(ts_schema);
+    Tuple *ts_args[] = { &ts_tup };
+
+    /* Compile StackMachine to load tuples from store.  After skipping zones, a StackMachine loading the tuples from the
+     * first row of the next zone on is compiled. */
+    std::optional<StackMachine> loader, ts_loader;
+    static_assert(ZoneMap::ZONE_SIZE % decltype(block_)::capacity() == 0, "zones must consist of whole vectors");
+    for (std::size_t zone_begin = 0; zone_begin < num_rows; zone_begin += ZoneMap::ZONE_SIZE) {
+        if (not skippable_zones.empty() and skippable_zones[zone_begin / ZoneMap::ZONE_SIZE]) {
+            loader.reset();
+            ts_loader.reset();
+            continue; // skip entire zone
+        }
+        if (not loader) {
+            loader.emplace(Interpreter::compile_load(op.schema(), store.memory().addr(), table.layout(),
+                                                     table.schema(), zone_begin));
+            if (op.has_snapshot()) {
+                ts_loader.emplace(Interpreter::compile_load(ts_schema, store.memory().addr(), table.layout(),
+                                                            table.schema(), zone_begin));
+            }
+        }
+
+        const auto zone_end = std::min<std::size_t>(zone_begin + ZoneMap::ZONE_SIZE, num_rows);
+        for (std::size_t i = zone_begin; i < zone_end; i += block_.capacity()) {
+            const auto n = std::min<std::size_t>(block_.capacity(), zone_end - i);
+            block_.clear();
+            if (n == block_.capacity())
+                block_.fill(); // fill entire vector
+            else
+                block_.mask((1UL << n) - 1); // fill last vector with remaining tuples
+            for (std::size_t j = 0; j != n; ++j) {
+                Tuple *args[] = { &block_[j] };
+                (*loader)(args);
+                if (ts_loader) {
+                    (*ts_loader)(ts_args);
+                    if (not is_visible(ts_tup[0].as_i(), ts_tup[1].as_i(), op.snapshot()))
+                        block_.erase(j);
+                }
+            }
+            if (not block_.empty())
+                op.parent()->accept(*this);
         }
-        op.parent()->accept(*this);
     }
 }
 
 void Pipeline::operator()(const CallbackOperator &op)
 {
+    if (op.batch_callback()) {
+        auto data = as<CallbackData>(op.data());
+        for (auto &t : block_)
+            data->append(t);
+        return;
+    }
     for (auto &t : block_)
         op.callback()(op.schema(), t);
 }
@@ -958,10 +1325,21 @@ void Pipeline::operator()(const FilterOperator &op)
         op.data(new FilterData(op, this->schema()));
 
     auto data = as<FilterData>(op.data());
-    for (auto it = block_.begin(); it != block_.end(); ++it) {
-        Tuple *args[] = { &data->res, &*it };
-        data->filter(args);
-        if (data->res.is_null(0) or not data->res[0].as_b()) block_.erase(it);
+    if (data->batchable) {
+        uint8_t sel[decltype(block_)::capacity()];
+        const std::size_t num_sel = block_.selection(sel);
+        Tuple *args[] = { data->batch_res.data(), block_.data() };
+        data->filter(args, sel, num_sel);
+        for (std::size_t i = 0; i != num_sel; ++i) {
+            auto &res = data->batch_res[sel[i]];
+            if (res.is_null(0) or not res[0].as_b()) block_.erase(sel[i]);
+        }
+    } else {
+        for (auto it = block_.begin(); it != block_.end(); ++it) {
+            Tuple *args[] = { &data->res, &*it };
+            data->filter(args);
+            if (data->res.is_null(0) or not data->res[0].as_b()) block_.erase(it);
+        }
     }
     if (not block_.empty())
         op.parent()->accept(*this);
@@ -991,7 +1369,51 @@ satisfied:;
 
 void Pipeline::operator()(const JoinOperator &op)
 {
-    if (is<SimpleHashJoinData>(op.data())) {
+    if (is<IndexNestedLoopsJoinData>(op.data())) {
+        /* Perform index nested-loops join. */
+        auto data = as<IndexNestedLoopsJoinData>(op.data());
+        if (data->load_attrs.size() != 2) {
+            data->load_outer_key(this->schema());
+            data->emit_load_attrs(data->inner.schema());
+            data->emit_load_attrs(this->schema());
+        }
+        auto &pipeline = data->pipeline;
+        std::size_t i = 0;
+        for (auto &t : block_) {
+            Tuple *args[2] = { &data->key, &t };
+            data->outer_key(args);
+            if (data->key.is_null(0))
+                continue; // `NULL` equals no key
+            pipeline.block_.fill();
+            data->probe(data->key[0], [&](uint32_t tuple_id) {
+                if (i == pipeline.block_.capacity()) {
+                    pipeline.push(*op.parent());
+                    i = 0;
+                }
+
+                {
+                    data->load_inner.set(Interpreter::POINT_ACCESS_ROW_ID_IDX, int64_t(tuple_id));
+                    Tuple *load_args[1] = { &data->inner_tuple };
+                    data->load_inner(load_args); // load matching row of inner child
+                }
+                {
+                    Tuple *load_args[2] = { &pipeline.block_[i], &data->inner_tuple };
+                    data->load_attrs[0](load_args); // load inner attrs
+                }
+                {
+                    Tuple *load_args[2] = { &pipeline.block_[i], &t };
+                    data->load_attrs[1](load_args); // load outer attrs
+                }
+                ++i;
+            });
+        }
+
+        if (i != 0) {
+            M_insist(i <= pipeline.block_.capacity());
+            pipeline.block_.mask(i == pipeline.block_.capacity() ? -1UL : (1UL << i) - 1);
+            pipeline.push(*op.parent());
+        }
+    } else if (is<SimpleHashJoinData>(op.data())) {
         /* Perform simple hash join. */
         auto data = as<SimpleHashJoinData>(op.data());
         Tuple *args[2] = { &data->key, nullptr };
@@ -1006,14 +1428,15 @@ void Pipeline::operator()(const JoinOperator &op)
                 args[1] = &t;
                 data->probe_key(args);
                 pipeline.block_.fill();
-                data->ht.for_all(*args[0], [&](std::pair<const Tuple, Tuple> &v) {
+                data->ht->for_each_in_equal_range(*args[0], [&](std::size_t row) {
                     if (i == pipeline.block_.capacity()) {
                         pipeline.push(*op.parent());
                         i = 0;
                     }
 
                     {
-                        Tuple *load_args[2] = { &pipeline.block_[i], &v.second };
+                        data->ht->load_payload(row, data->build_tuple);
+                        Tuple *load_args[2] = { &pipeline.block_[i], &data->build_tuple };
                         data->load_attrs[0](load_args); // load build attrs
                     }
                     {
@@ -1034,11 +1457,10 @@ void Pipeline::operator()(const JoinOperator &op)
                 data->load_build_key(this->schema());
                 data->emit_load_attrs(this->schema());
             }
-            const auto &tuple_schema = op.child(0)->schema();
             for (auto &t : block_) {
                 args[1] = &t;
                 data->build_key(args);
-                data->ht.insert_with_duplicates(args[0]->clone(data->key_schema), t.clone(tuple_schema));
+                data->ht->insert_with_duplicates(*args[0], t);
             }
         }
     } else {
@@ -1148,10 +1570,17 @@ void Pipeline::operator()(const ProjectionOperator &op)
     pipeline.clear();
     pipeline.block_.mask(block_.mask());
 
-    for (auto it = block_.begin(); it != block_.end(); ++it) {
-        auto &out = pipeline.block_[it.index()];
-        Tuple *args[] = { &out, &*it };
-        (*data->projections)(args);
+    if (data->batchable) {
+        uint8_t sel[decltype(block_)::capacity()];
+        const std::size_t num_sel = block_.selection(sel);
+        Tuple *args[] = { pipeline.block_.data(), block_.data() };
+        (*data->projections)(args, sel, num_sel);
+    } else {
+        for (auto it = block_.begin(); it != block_.end(); ++it) {
+            auto &out = pipeline.block_[it.index()];
+            Tuple *args[] = { &out, &*it };
+            (*data->projections)(args);
+        }
     }
 
     pipeline.push(*op.parent());
@@ -1176,14 +1605,10 @@ void Pipeline::operator()(const LimitOperator &op)
 
 void Pipeline::operator()(const GroupingOperator &op)
 {
-    auto perform_aggregation = [&](decltype(HashBasedGroupingData::groups)::value_type &entry, Tuple &tuple,
-                                   GroupingData &data)
+    auto perform_aggregation = [&](Tuple &group, const unsigned nth_tuple, Tuple &tuple, GroupingData &data)
     {
         const std::size_t key_size = op.group_by().size();
 
-        Tuple &group = const_cast<Tuple&>(entry.first);
-        const unsigned nth_tuple = ++entry.second;
-
         /* Add this tuple to its group by computing the aggregates. */
         for (std::size_t i = 0, end = op.aggregates().size(); i != end; ++i) {
             auto &aggregate_arguments = data.args[i];
@@ -1286,19 +1711,17 @@ void Pipeline::operator()(const GroupingOperator &op)
     /* Find the group. */
     auto data = as<HashBasedGroupingData>(op.data());
     auto &groups = data->groups;
+    const std::size_t key_size = op.group_by().size();
 
-    Tuple key(op.schema());
     for (auto &tuple : block_) {
-        Tuple *args[] = { &key, &tuple };
+        Tuple *args[] = { &data->key, &tuple };
         data->compute_key(args);
-        auto it = groups.find(key);
-        if (it == groups.end()) {
-            /* Initialize the group's aggregate to NULL.  This will be overwritten by the neutral element w.r.t.
-             * the aggregation function. */
-            it = groups.emplace_hint(it, std::move(key), 0);
-            key = Tuple(op.schema());
-        }
-        perform_aggregation(*it, tuple, *data);
+        /* A new group's aggregates are initialized to NULL.  This will be overwritten by the neutral element w.r.t.
+         * the aggregation function. */
+        const auto row = groups.find_or_insert(data->key).first;
+        groups.load_payload(row, data->group, key_size);
+        perform_aggregation(data->group, ++groups.count(row), tuple, *data);
+        groups.store_payload(row, data->group, key_size);
     }
 }
 
@@ -1411,6 +1834,12 @@ void Pipeline::operator()(const SortingOperator &op)
 
 void Interpreter::operator()(const CallbackOperator &op)
 {
+    if (op.batch_callback()) {
+        op.data(new CallbackData(op));
+        op.child(0)->accept(*this);
+        as<CallbackData>(op.data())->flush();
+        return;
+    }
     op.child(0)->accept(*this);
 }
 
@@ -1447,14 +1876,23 @@ void Interpreter::operator()(const DisjunctiveFilterOperator &op)
 
 void Interpreter::operator()(const JoinOperator &op)
 {
-    if (op.predicate().is_equi()) {
+    const ast::Designator *inner_key = nullptr;
+    const ast::Expr *outer_key_expr = nullptr;
+    if (auto inner_child = IndexNestedLoopsJoinData::find_inner_child(op, inner_key, outer_key_expr);
+        inner_child != -1UL)
+    {
+        /* Perform index nested-loops join. */
+        auto &inner = as<const ScanOperator>(*op.child(inner_child));
+        op.data(new IndexNestedLoopsJoinData(op, inner, *inner_key, *outer_key_expr));
+        op.child(1 - inner_child)->accept(*this); // probe the index of the inner child with the outer child
+    } else if (op.predicate().is_equi()) {
         /* Perform simple hash join. */
         auto data = new SimpleHashJoinData(op);
         op.data(data);
         if (op.has_info())
-            data->ht.resize(op.info().estimated_cardinality);
+            data->ht->reserve(op.info().estimated_cardinality);
         op.child(0)->accept(*this); // build HT on LHS
-        if (data->ht.size() == 0) // no tuples produced
+        if (data->ht->size() == 0) // no tuples produced
             return;
         data->is_probe_phase = true;
         op.child(1)->accept(*this); // probe HT with RHS
@@ -1508,22 +1946,18 @@ void Interpreter::operator()(const GroupingOperator &op)
 
     const auto num_groups = data->groups.size();
     const auto remainder = num_groups % data->pipeline.block_.capacity();
-    auto it = data->groups.begin();
+    std::size_t row = 0;
     for (std::size_t i = 0; i != num_groups - remainder; i += data->pipeline.block_.capacity()) {
         data->pipeline.block_.clear();
         data->pipeline.block_.fill();
-        for (std::size_t j = 0; j != data->pipeline.block_.capacity(); ++j) {
-            auto node = data->groups.extract(it++);
-            swap(data->pipeline.block_[j], node.key());
-        }
+        for (std::size_t j = 0; j != data->pipeline.block_.capacity(); ++j)
+            data->groups.load(row++, data->pipeline.block_[j]);
         data->pipeline.push(parent);
     }
     data->pipeline.block_.clear();
     data->pipeline.block_.mask((1UL << remainder) - 1UL);
-    for (std::size_t i = 0; i != remainder; ++i) {
-        auto node = data->groups.extract(it++);
-        swap(data->pipeline.block_[i], node.key());
-    }
+    for (std::size_t i = 0; i != remainder; ++i)
+        data->groups.load(row++, data->pipeline.block_[i]);
     data->pipeline.push(parent);
 }
 
@@ -116,6 +116,15 @@ struct Block
     /** Returns the bit mask that identifies which tuples of this `Block` are alive. */
     void mask(uint64_t new_mask) { mask_ = new_mask; }
 
+    /** Writes the indices of all *alive* tuples, in ascending order, to the selection vector `sel` and returns their
+     * number.  `sel` must provide space for at least `capacity()` entries. */
+    std::size_t selection(uint8_t *sel) const {
+        std::size_t n = 0;
+        for (uint64_t m = mask_; m; m = m & (m - 1UL)) // clear lowest 1-bit
+            sel[n++] = __builtin_ctzl(m);
+        return n;
+    }
+
     private:
     /** Returns a bit vector with left-most `capacity()` many bits set to `1` and the others set to `0`.  */
     static constexpr uint64_t AllOnes() { return -1UL >> (8 * sizeof(mask_) - capacity()); }
@@ -183,6 +192,8 @@ struct Pipeline : ConstOperatorVisitor
 
     private:
     Block<64> block_;
+    static_assert(decltype(block_)::capacity() <= StackMachine::BATCH_SIZE,
+                  "blocks must fit into a single batch of the stack machine");
 
     public:
     Pipeline() { }
@@ -230,6 +241,9 @@ struct Interpreter : Backend, ConstOperatorVisitor
 
     static Value eval(const ast::Constant &c)
     {
+        if (auto param = cast<const ast::Parameter>(&c)) // evaluate the constant bound to the parameter
+            return eval(ast::Constant(param->value()));
+
         errno = 0;
         switch (c.tok.type) {
             default: M_unreachable("illegal token");
@@ -335,6 +349,25 @@ struct Interpreter : Backend, ConstOperatorVisitor
      */
     static StackMachine compile_store(const Schema &tuple_schema, void *address, const storage::DataLayout &layout,
                                       const Schema &layout_schema, std::size_t row_id = 0, std::size_t tuple_id = 0);
+
+    ///> the index in the context of a `StackMachine` compiled by `compile_load_point_access()` of the ID of the row to
+    ///> load
+    static constexpr std::size_t POINT_ACCESS_ROW_ID_IDX = 0;
+
+    /** Compile a `StackMachine` to load a tuple of `Schema` `tuple_schema` of an arbitrary row using a given memory
+     * address and a given `DataLayout`.  In contrast to `compile_load()`, which loads consecutive rows, the row to load
+     * is selected by setting the context of the `StackMachine` at index `POINT_ACCESS_ROW_ID_IDX` to its ID before
+     * each evaluation.
+     *
+     * @param tuple_schema  the `Schema` of the tuple to load, specifying the `Schema::Identifier`s to load
+     * @param address       the memory address of the `Store` we are loading from
+     * @param layout        the `DataLayout` of the `Table` we are loading from
+     * @param layout_schema the `Schema` of `layout`, specifying the `Schema::Identifier`s present in `layout`
+     * @param tuple_id      the ID of the tuple used for loading
+     */
+    static StackMachine compile_load_point_access(const Schema &tuple_schema, void *address,
+                                                  const storage::DataLayout &layout, const Schema &layout_schema,
+                                                  std::size_t tuple_id = 0);
 };
 
 }
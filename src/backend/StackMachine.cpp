@@ -1,6 +1,7 @@
 #include "backend/StackMachine.hpp"
 
 #include "backend/Interpreter.hpp"
+#include <algorithm>
 #include <ctime>
 #include <functional>
 #include <mutable/util/fn.hpp>
@@ -483,7 +484,8 @@ void StackMachineBuilder::operator()(Const<ast::BinaryExpr> &e)
         case TK_Like: {
             if (auto rhs = cast<const ast::Constant>(e.rhs.get())) {
                 (*this)(*e.lhs);
-                auto pattern = interpret(*rhs->tok.text);
+                auto param = cast<const ast::Parameter>(rhs); // a parameter's pattern is known once it is bound
+                auto pattern = interpret(*(param ? param->value() : rhs->tok).text);
                 auto it = regexes_.find(pattern);
                 if (it == regexes_.end())
                     it = StackMachineBuilder::regexes_.insert({pattern, pattern_to_regex(pattern.c_str(), true)}).first;
@@ -1544,6 +1546,479 @@ Stop:
     top_ = 0;
 }
 
+bool StackMachine::is_batchable() const
+{
+    for (std::size_t i = 0; i != ops.size(); ++i) {
+        switch (ops[i]) {
+            /* Opcodes with *two* operands. */
+            case Opcode::Ld_Tup:
+            case Opcode::St_Tup_Null:
+            case Opcode::St_Tup_i:
+            case Opcode::St_Tup_f:
+            case Opcode::St_Tup_d:
+            case Opcode::St_Tup_s:
+            case Opcode::St_Tup_b:
+                ++i;
+                /* fall through */
+
+            /* Opcodes with *one* operand. */
+            case Opcode::Ld_Ctx:
+            case Opcode::ShLi_i:
+            case Opcode::SARi_i:
+                ++i;
+                /* fall through */
+
+            /* Opcodes without operands. */
+            case Opcode::Pop:
+            case Opcode::Push_Null:
+            case Opcode::Dup:
+            case Opcode::Inc:
+            case Opcode::Dec:
+            case Opcode::Minus_i:
+            case Opcode::Minus_f:
+            case Opcode::Minus_d:
+            case Opcode::Add_i:
+            case Opcode::Add_f:
+            case Opcode::Add_d:
+            case Opcode::Sub_i:
+            case Opcode::Sub_f:
+            case Opcode::Sub_d:
+            case Opcode::Mul_i:
+            case Opcode::Mul_f:
+            case Opcode::Mul_d:
+            case Opcode::Div_i:
+            case Opcode::Div_f:
+            case Opcode::Div_d:
+            case Opcode::Mod_i:
+            case Opcode::Neg_i:
+            case Opcode::And_i:
+            case Opcode::Or_i:
+            case Opcode::Xor_i:
+            case Opcode::ShL_i:
+            case Opcode::Not_b:
+            case Opcode::And_b:
+            case Opcode::Or_b:
+            case Opcode::Is_Null:
+            case Opcode::EqZ_i:
+            case Opcode::NEZ_i:
+            case Opcode::Eq_i:
+            case Opcode::Eq_f:
+            case Opcode::Eq_d:
+            case Opcode::Eq_b:
+            case Opcode::Eq_s:
+            case Opcode::NE_i:
+            case Opcode::NE_f:
+            case Opcode::NE_d:
+            case Opcode::NE_b:
+            case Opcode::NE_s:
+            case Opcode::LT_i:
+            case Opcode::LT_f:
+            case Opcode::LT_d:
+            case Opcode::LT_s:
+            case Opcode::GT_i:
+            case Opcode::GT_f:
+            case Opcode::GT_d:
+            case Opcode::GT_s:
+            case Opcode::LE_i:
+            case Opcode::LE_f:
+            case Opcode::LE_d:
+            case Opcode::LE_s:
+            case Opcode::GE_i:
+            case Opcode::GE_f:
+            case Opcode::GE_d:
+            case Opcode::GE_s:
+            case Opcode::Cmp_i:
+            case Opcode::Cmp_f:
+            case Opcode::Cmp_d:
+            case Opcode::Cmp_b:
+            case Opcode::Cmp_s:
+            case Opcode::Like_const:
+            case Opcode::Like_expr:
+            case Opcode::Sel:
+            case Opcode::Cast_i_f:
+            case Opcode::Cast_i_d:
+            case Opcode::Cast_i_b:
+            case Opcode::Cast_f_i:
+            case Opcode::Cast_f_d:
+            case Opcode::Cast_d_i:
+            case Opcode::Cast_d_f:
+                break;
+
+            /* Opcodes that update the context, access memory, perform I/O, or stop conditionally. */
+            default:
+                return false;
+        }
+    }
+    return true;
+}
+
+void StackMachine::operator()(Tuple **tuples, const uint8_t *sel, std::size_t num_sel) const
+{
+    M_insist(num_sel <= BATCH_SIZE, "too many rows for a single batch");
+    M_insist(is_batchable(), "opcode sequence cannot be evaluated in batch mode");
+
+    if (not batch_values_) {
+        batch_values_ = new Value[required_stack_size() * BATCH_SIZE];
+        batch_null_bits_ = new bool[required_stack_size() * BATCH_SIZE]();
+    }
+    std::size_t top = 0; // number of vectors on the stack
+
+    /* The stack holds one vector of `BATCH_SIZE` values and NULL bits per slot.  The `i`-th entry of each vector
+     * belongs to the row `sel[i]`. */
+#define VALUES(SLOT) (batch_values_ + (SLOT) * BATCH_SIZE)
+#define NULLS(SLOT) (batch_null_bits_ + (SLOT) * BATCH_SIZE)
+#define FOR_EACH_ROW for (std::size_t i = 0; i != num_sel; ++i)
+
+#define UNARY(OP, TYPE) { \
+    M_insist(top >= 1); \
+    Value *vals = VALUES(top - 1); \
+    FOR_EACH_ROW { \
+        TYPE val = vals[i].as<TYPE>(); \
+        vals[i] = OP(val); \
+    } \
+} \
+break;
+
+#define BINARY(OP, TYPE) { \
+    M_insist(top >= 2); \
+    --top; \
+    Value *lhs = VALUES(top - 1), *rhs = VALUES(top); \
+    bool *lhs_null = NULLS(top - 1), *rhs_null = NULLS(top); \
+    FOR_EACH_ROW { \
+        lhs[i] = OP(lhs[i].as<TYPE>(), rhs[i].as<TYPE>()); \
+        lhs_null[i] = lhs_null[i] or rhs_null[i]; \
+    } \
+} \
+break;
+
+#define CMP(TYPE) { \
+    M_insist(top >= 2); \
+    --top; \
+    Value *lhs = VALUES(top - 1), *rhs = VALUES(top); \
+    bool *lhs_null = NULLS(top - 1), *rhs_null = NULLS(top); \
+    FOR_EACH_ROW { \
+        TYPE l = lhs[i].as<TYPE>(); \
+        TYPE r = rhs[i].as<TYPE>(); \
+        lhs[i] = int64_t(l >= r) - int64_t(l <= r); \
+        lhs_null[i] = lhs_null[i] or rhs_null[i]; \
+    } \
+} \
+break;
+
+    for (auto op = ops.cbegin(), end = ops.cend(); op != end; ) {
+        switch (*op++) {
+            /*----- Stack manipulation operations --------------------------------------------------------------------*/
+            case Opcode::Pop:
+                M_insist(top >= 1);
+                --top;
+                break;
+
+            case Opcode::Push_Null: {
+                M_insist(top < required_stack_size(), "index out of bounds");
+                Value *vals = VALUES(top);
+                bool *nulls = NULLS(top);
+                FOR_EACH_ROW { vals[i] = Value(); nulls[i] = true; }
+                ++top;
+                break;
+            }
+
+            case Opcode::Dup: {
+                M_insist(top >= 1);
+                M_insist(top < required_stack_size(), "index out of bounds");
+                std::copy_n(VALUES(top - 1), num_sel, VALUES(top));
+                std::copy_n(NULLS(top - 1), num_sel, NULLS(top));
+                ++top;
+                break;
+            }
+
+            /*----- Context access operations ------------------------------------------------------------------------*/
+            case Opcode::Ld_Ctx: {
+                std::size_t idx = std::size_t(*op++);
+                M_insist(idx < context_.size(), "index out of bounds");
+                M_insist(top < required_stack_size(), "index out of bounds");
+                std::fill_n(VALUES(top), num_sel, context_[idx]);
+                std::fill_n(NULLS(top), num_sel, false);
+                ++top;
+                break;
+            }
+
+            /*----- Tuple access operations --------------------------------------------------------------------------*/
+            case Opcode::Ld_Tup: {
+                std::size_t tuple_id = std::size_t(*op++);
+                std::size_t index = std::size_t(*op++);
+                M_insist(top < required_stack_size(), "index out of bounds");
+                Tuple *rows = tuples[tuple_id];
+                Value *vals = VALUES(top);
+                bool *nulls = NULLS(top);
+                FOR_EACH_ROW {
+                    auto &t = rows[sel[i]];
+                    vals[i] = t[index];
+                    nulls[i] = t.is_null(index);
+                }
+                ++top;
+                break;
+            }
+
+            case Opcode::St_Tup_Null: {
+                std::size_t tuple_id = std::size_t(*op++);
+                std::size_t index = std::size_t(*op++);
+                Tuple *rows = tuples[tuple_id];
+                FOR_EACH_ROW rows[sel[i]].null(index);
+                break;
+            }
+
+            case Opcode::St_Tup_b:
+            case Opcode::St_Tup_i:
+            case Opcode::St_Tup_f:
+            case Opcode::St_Tup_d: {
+                M_insist(top >= 1);
+                std::size_t tuple_id = std::size_t(*op++);
+                std::size_t index = std::size_t(*op++);
+                Tuple *rows = tuples[tuple_id];
+                const Value *vals = VALUES(top - 1);
+                const bool *nulls = NULLS(top - 1);
+                FOR_EACH_ROW rows[sel[i]].set(index, vals[i], nulls[i]);
+                break;
+            }
+
+            case Opcode::St_Tup_s: {
+                M_insist(top >= 2);
+                std::size_t tuple_id = std::size_t(*op++);
+                std::size_t index = std::size_t(*op++);
+                --top;
+                Tuple *rows = tuples[tuple_id];
+                const Value *lengths = VALUES(top);
+                const Value *vals = VALUES(top - 1);
+                const bool *nulls = NULLS(top - 1);
+                FOR_EACH_ROW {
+                    auto &t = rows[sel[i]];
+                    if (nulls[i]) {
+                        t.null(index);
+                    } else {
+                        t.not_null(index);
+                        std::size_t length = lengths[i].as_i();
+                        char *dst = reinterpret_cast<char*>(t[index].as_p());
+                        char *src = reinterpret_cast<char*>(vals[i].as_p());
+                        strncpy(dst, src, length);
+                        dst[length] = 0; // always add terminating NUL byte, no matter whether this is a CHAR or VARCHAR
+                    }
+                }
+                break;
+            }
+
+            /*----- Arithmetical operations --------------------------------------------------------------------------*/
+            case Opcode::Inc:     UNARY(++, int64_t);
+            case Opcode::Dec:     UNARY(--, int64_t);
+            case Opcode::Minus_i: UNARY(-, int64_t);
+            case Opcode::Minus_f: UNARY(-, float);
+            case Opcode::Minus_d: UNARY(-, double);
+
+            case Opcode::Add_i: BINARY(std::plus{}, int64_t);
+            case Opcode::Add_f: BINARY(std::plus{}, float);
+            case Opcode::Add_d: BINARY(std::plus{}, double);
+            case Opcode::Sub_i: BINARY(std::minus{}, int64_t);
+            case Opcode::Sub_f: BINARY(std::minus{}, float);
+            case Opcode::Sub_d: BINARY(std::minus{}, double);
+            case Opcode::Mul_i: BINARY(std::multiplies{}, int64_t);
+            case Opcode::Mul_f: BINARY(std::multiplies{}, float);
+            case Opcode::Mul_d: BINARY(std::multiplies{}, double);
+            case Opcode::Div_i: BINARY(std::divides{}, int64_t);
+            case Opcode::Div_f: BINARY(std::divides{}, float);
+            case Opcode::Div_d: BINARY(std::divides{}, double);
+            case Opcode::Mod_i: BINARY(std::modulus{}, int64_t);
+
+            /*----- Bitwise operations -------------------------------------------------------------------------------*/
+            case Opcode::Neg_i: UNARY(~, int64_t);
+            case Opcode::And_i: BINARY(std::bit_and{}, int64_t);
+            case Opcode::Or_i:  BINARY(std::bit_or{}, int64_t);
+            case Opcode::Xor_i: BINARY(std::bit_xor{}, int64_t);
+
+            case Opcode::ShL_i: {
+                M_insist(top >= 2);
+                --top;
+                Value *vals = VALUES(top - 1);
+                const Value *counts = VALUES(top);
+                FOR_EACH_ROW vals[i] = uint64_t(uint64_t(vals[i].as<int64_t>()) << uint64_t(counts[i].as<int64_t>()));
+                break;
+            }
+
+            case Opcode::ShLi_i: {
+                M_insist(top >= 1);
+                std::size_t count = std::size_t(*op++);
+                Value *vals = VALUES(top - 1);
+                FOR_EACH_ROW vals[i] = uint64_t(uint64_t(vals[i].as<int64_t>()) << count);
+                break;
+            }
+
+            case Opcode::SARi_i: {
+                M_insist(top >= 1);
+                std::size_t count = std::size_t(*op++);
+                Value *vals = VALUES(top - 1);
+                FOR_EACH_ROW vals[i] = int64_t(vals[i].as<int64_t>() >> count); // signed for arithmetical shift
+                break;
+            }
+
+            /*----- Logical operations -------------------------------------------------------------------------------*/
+            case Opcode::Not_b: UNARY(not, bool);
+
+            case Opcode::And_b: {
+                M_insist(top >= 2);
+                --top;
+                Value *lhs = VALUES(top - 1), *rhs = VALUES(top);
+                bool *lhs_null = NULLS(top - 1), *rhs_null = NULLS(top);
+                FOR_EACH_ROW {
+                    const bool l = lhs[i].as_b(), r = rhs[i].as_b();
+                    lhs[i] = l and r;
+                    lhs_null[i] = (l or lhs_null[i]) and (r or rhs_null[i]) and (lhs_null[i] or rhs_null[i]);
+                }
+                break;
+            }
+
+            case Opcode::Or_b: {
+                M_insist(top >= 2);
+                --top;
+                Value *lhs = VALUES(top - 1), *rhs = VALUES(top);
+                bool *lhs_null = NULLS(top - 1), *rhs_null = NULLS(top);
+                FOR_EACH_ROW {
+                    const bool l = lhs[i].as_b(), r = rhs[i].as_b();
+                    lhs[i] = l or r;
+                    lhs_null[i] = (not l or lhs_null[i]) and (not r or rhs_null[i]) and (lhs_null[i] or rhs_null[i]);
+                }
+                break;
+            }
+
+            /*----- Comparison operations ----------------------------------------------------------------------------*/
+            case Opcode::Is_Null: {
+                M_insist(top >= 1);
+                Value *vals = VALUES(top - 1);
+                bool *nulls = NULLS(top - 1);
+                FOR_EACH_ROW { vals[i] = bool(nulls[i]); nulls[i] = false; }
+                break;
+            }
+
+            case Opcode::EqZ_i: {
+                M_insist(top >= 1);
+                Value *vals = VALUES(top - 1);
+                FOR_EACH_ROW vals[i] = vals[i].as<int64_t>() == 0;
+                break;
+            }
+
+            case Opcode::NEZ_i: {
+                M_insist(top >= 1);
+                Value *vals = VALUES(top - 1);
+                FOR_EACH_ROW vals[i] = vals[i].as<int64_t>() != 0;
+                break;
+            }
+
+            case Opcode::Eq_i: BINARY(std::equal_to{}, int64_t);
+            case Opcode::Eq_f: BINARY(std::equal_to{}, float);
+            case Opcode::Eq_d: BINARY(std::equal_to{}, double);
+            case Opcode::Eq_b: BINARY(std::equal_to{}, bool);
+            case Opcode::Eq_s: BINARY(streq, char*);
+
+            case Opcode::NE_i: BINARY(std::not_equal_to{}, int64_t);
+            case Opcode::NE_f: BINARY(std::not_equal_to{}, float);
+            case Opcode::NE_d: BINARY(std::not_equal_to{}, double);
+            case Opcode::NE_b: BINARY(std::not_equal_to{}, bool);
+            case Opcode::NE_s: BINARY(not streq, char*);
+
+            case Opcode::LT_i: BINARY(std::less{}, int64_t);
+            case Opcode::LT_f: BINARY(std::less{}, float);
+            case Opcode::LT_d: BINARY(std::less{}, double);
+            case Opcode::LT_s: BINARY(0 > strcmp, char*);
+
+            case Opcode::GT_i: BINARY(std::greater{}, int64_t);
+            case Opcode::GT_f: BINARY(std::greater{}, float);
+            case Opcode::GT_d: BINARY(std::greater{}, double);
+            case Opcode::GT_s: BINARY(0 < strcmp, char*);
+
+            case Opcode::LE_i: BINARY(std::less_equal{}, int64_t);
+            case Opcode::LE_f: BINARY(std::less_equal{}, float);
+            case Opcode::LE_d: BINARY(std::less_equal{}, double);
+            case Opcode::LE_s: BINARY(0 >= strcmp, char*);
+
+            case Opcode::GE_i: BINARY(std::greater_equal{}, int64_t);
+            case Opcode::GE_f: BINARY(std::greater_equal{}, float);
+            case Opcode::GE_d: BINARY(std::greater_equal{}, double);
+            case Opcode::GE_s: BINARY(0 <= strcmp, char*);
+
+            case Opcode::Cmp_i: CMP(int64_t);
+            case Opcode::Cmp_f: CMP(float);
+            case Opcode::Cmp_d: CMP(double);
+            case Opcode::Cmp_b: CMP(bool);
+            case Opcode::Cmp_s: BINARY(strcmp, char*);
+
+            case Opcode::Like_const: {
+                M_insist(top >= 2);
+                --top;
+                Value *vals = VALUES(top - 1);
+                const bool *nulls = NULLS(top - 1);
+                const Value *patterns = VALUES(top);
+                FOR_EACH_ROW {
+                    if (not nulls[i])
+                        vals[i] = std::regex_match(vals[i].as<char*>(), *patterns[i].as<std::regex*>());
+                }
+                break;
+            }
+
+            case Opcode::Like_expr: {
+                M_insist(top >= 2);
+                --top;
+                Value *vals = VALUES(top - 1);
+                bool *nulls = NULLS(top - 1);
+                const Value *patterns = VALUES(top);
+                const bool *pattern_nulls = NULLS(top);
+                FOR_EACH_ROW {
+                    if (pattern_nulls[i])
+                        nulls[i] = true;
+                    else if (not nulls[i])
+                        vals[i] = like(vals[i].as<char*>(), patterns[i].as<char*>());
+                }
+                break;
+            }
+
+            /*----- Selection operation ------------------------------------------------------------------------------*/
+            case Opcode::Sel: {
+                M_insist(top >= 3);
+                top -= 2;
+                Value *cond = VALUES(top - 1), *tru = VALUES(top), *fals = VALUES(top + 1);
+                bool *cond_null = NULLS(top - 1), *tru_null = NULLS(top), *fals_null = NULLS(top + 1);
+                FOR_EACH_ROW {
+                    if (cond_null[i]) {
+                        cond[i] = tru[i]; // pick any value
+                    } else if (cond[i].as_b()) {
+                        cond[i] = tru[i];
+                        cond_null[i] = tru_null[i];
+                    } else {
+                        cond[i] = fals[i];
+                        cond_null[i] = fals_null[i];
+                    }
+                }
+                break;
+            }
+
+            /*----- Type conversion ----------------------------------------------------------------------------------*/
+            case Opcode::Cast_i_f: UNARY((int64_t), float);
+            case Opcode::Cast_i_d: UNARY((int64_t), double);
+            case Opcode::Cast_i_b: UNARY((int64_t), bool);
+            case Opcode::Cast_f_i: UNARY((float), int64_t);
+            case Opcode::Cast_f_d: UNARY((float), double);
+            case Opcode::Cast_d_i: UNARY((double), int64_t);
+            case Opcode::Cast_d_f: UNARY((double), float);
+
+            default:
+                M_unreachable("opcode not supported in batch mode");
+        }
+    }
+
+#undef CMP
+#undef BINARY
+#undef UNARY
+#undef FOR_EACH_ROW
+#undef NULLS
+#undef VALUES
+}
+
 M_LCOV_EXCL_START
 void StackMachine::dump(std::ostream &out) const
 {
@@ -28,6 +28,7 @@ struct StackMachine
     friend struct StackMachineBuilder;
 
     static constexpr std::size_t SIZE_OF_MEMORY = 4 * 1024; // 4 KiB
+    static constexpr std::size_t BATCH_SIZE = 64; ///< maximum number of rows evaluated at once in batch mode
 
     enum class Opcode : uint8_t
     {
@@ -68,6 +69,8 @@ struct StackMachine
     mutable decltype(ops)::const_iterator op_; ///< the next operation to execute
     mutable std::size_t top_ = 0; ///< the top of the stack
     mutable uint8_t memory_[SIZE_OF_MEMORY]; ///< memory usable by the stack machine, e.g. to work on BLOBs
+    mutable Value *batch_values_ = nullptr; ///< array of value vectors used as a stack in batch mode
+    mutable bool *batch_null_bits_ = nullptr; ///< array of NULL bit vectors used as a stack in batch mode
 
     public:
     /** Create a `StackMachine` that does not accept input. */
@@ -93,6 +96,8 @@ struct StackMachine
     ~StackMachine() {
         delete[] values_;
         delete[] null_bits_;
+        delete[] batch_values_;
+        delete[] batch_null_bits_;
     }
 
     /** Returns the `Schema` of input `Tuple`s. */
@@ -217,6 +222,16 @@ struct StackMachine
      * for both input and output. */
     void operator()(Tuple **tuples) const;
 
+    /** Returns `true` iff the opcode sequence can be evaluated in batch mode, i.e.\ it neither updates the context,
+     * accesses memory, performs I/O, nor stops conditionally. */
+    bool is_batchable() const;
+
+    /** Evaluate this `StackMachine` in batch mode on `num_sel` rows at once.  Every `tuples[i]` points to an *array* of
+     * `Tuple`s and the selection vector `sel` contains the indices of the rows within these arrays to evaluate.
+     * Instead of dispatching every opcode once per row, every opcode is dispatched once and then applied to the
+     * entire vector of selected rows.  Requires `is_batchable()` and `num_sel <= BATCH_SIZE`. */
+    void operator()(Tuple **tuples, const uint8_t *sel, std::size_t num_sel) const;
+
     void dump(std::ostream &out) const;
     void dump() const;
 };
@@ -5,14 +5,19 @@
 #include "backend/WasmUtil.hpp"
 #include "mutable/util/macro.hpp"
 #include "storage/Store.hpp"
+#include <atomic>
 #include <chrono>
+#include <condition_variable>
 #include <cstdint>
 #include <cstdlib>
 #include <cstring>
 #include <ctime>
+#include <exception>
 #include <fstream>
 #include <fstream>
+#include <functional>
 #include <libplatform/libplatform.h>
+#include <list>
 #include <mutable/catalog/Catalog.hpp>
 #include <mutable/IR/PhysicalOptimizer.hpp>
 #include <mutable/IR/Tuple.hpp>
@@ -23,9 +28,15 @@
 #include <mutable/util/enum_ops.hpp>
 #include <mutable/util/memory.hpp>
 #include <mutable/util/Timer.hpp>
+#include <mutex>
+#include <optional>
+#include <regex>
+#include <shared_mutex>
 #include <sstream>
 #include <stdexcept>
 #include <string_view>
+#include <sys/mman.h>
+#include <thread>
 #include <unordered_set>
 
 // must be included after Binaryen due to conflicts, e.g. with `::wasm::Throw`
@@ -47,6 +58,8 @@ namespace options {
 int wasm_optimization_level = 0;
 /** Whether to execute Wasm adaptively. */
 bool wasm_adaptive = false;
+/** Whether to start executing single-pipeline queries on baseline code and switch to optimized code once available. */
+bool wasm_tiered = false;
 /** Whether compilation cache should be enabled. */
 bool wasm_compilation_cache = true;
 /** Whether to dump the generated WebAssembly code. */
@@ -55,10 +68,307 @@ bool wasm_dump = false;
 bool asm_dump = false;
 /** The port to use for the Chrome DevTools web socket. */
 uint16_t cdt_port = 0;
+/** The number of threads to execute a query with. */
+std::size_t wasm_threads = 1;
+/** The number of tuples per morsel for morsel-driven parallel execution. */
+std::size_t wasm_morsel_size = 1UL << 14;
+/** The maximum number of compiled plans to cache.  0 disables the cache. */
+std::size_t wasm_plan_cache_size = 0;
 
 }
 
 
+/*======================================================================================================================
+ * Morsel-driven parallel execution
+ *====================================================================================================================*/
+
+/** Hands out morsels, i.e. ranges of consecutive tuple IDs of the scanned table, to the threads executing a query. */
+struct MorselDispatcher
+{
+    private:
+    std::atomic_uint64_t next_ = 0; ///< the first tuple ID of the next morsel to hand out
+    uint32_t morsel_size_; ///< the number of tuples per morsel
+    std::atomic_bool yield_ = false; ///< whether to stop handing out morsels until `resume()` is called
+    std::atomic_bool has_yielded_ = false; ///< whether a morsel was withheld since the last call to `resume()`
+
+    public:
+    explicit MorselDispatcher(uint32_t morsel_size) : morsel_size_(morsel_size) { M_insist(morsel_size != 0); }
+
+    /** Returns the first tuple ID of the next morsel.  Once all morsels are handed out, or while the dispatcher
+     * yields, the returned tuple ID lies beyond the end of the table. */
+    uint32_t next() {
+        if (yield_.load(std::memory_order_acquire)) {
+            has_yielded_.store(true, std::memory_order_relaxed);
+            return std::numeric_limits<uint32_t>::max();
+        }
+        const uint64_t first = next_.fetch_add(morsel_size_, std::memory_order_relaxed);
+        return std::min<uint64_t>(first, std::numeric_limits<uint32_t>::max());
+    }
+
+    /** Stops handing out morsels, s.t. the executing instances finish after their current morsel. */
+    void yield() { yield_.store(true, std::memory_order_release); }
+    /** Resumes handing out morsels after `yield()`. */
+    void resume() {
+        has_yielded_.store(false, std::memory_order_relaxed);
+        yield_.store(false, std::memory_order_release);
+    }
+    /** Returns `true` iff a morsel was withheld because of `yield()`, i.e. iff not all morsels were processed. */
+    bool has_yielded() const { return has_yielded_.load(std::memory_order_relaxed); }
+};
+
+/** Exchanges the groups pre-aggregated by the threads executing a `wasm::HashBasedGrouping`.  Each instance publishes
+ * its spilled groups, radix-partitioned on the keys, and waits for all other instances.  Afterwards, the instances
+ * claim partitions one by one and copy the groups of a claimed partition from *all* instances into their own memory to
+ * merge them.  Finally, each instance waits for all other instances to finish, s.t. no published groups are freed while
+ * they may still be copied. */
+struct GroupingExchange
+{
+    private:
+    /** The partitions published by a single instance. */
+    struct partitions_type
+    {
+        const uint8_t *rows; ///< the address of the first row, i.e. group
+        const uint32_t *offsets; ///< the partition boundaries, i.e. partition `p` consists of rows [`offsets[p]`, `offsets[p+1]`[
+    };
+
+    std::size_t num_participants_; ///< the number of instances executing the grouping
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::size_t num_arrived_ = 0; ///< the number of instances waiting at the current barrier
+    std::size_t generation_ = 0; ///< the number of barriers passed so far
+    bool aborted_ = false; ///< whether an instance failed, s.t. the others must not wait for it
+    std::vector<partitions_type> partitions_; ///< the published partitions of each instance
+    uint32_t row_size_ = 0; ///< the size of a row in bytes
+    uint32_t num_partitions_ = 0; ///< the number of partitions per instance
+    std::atomic_uint32_t next_partition_ = 0; ///< the next partition to claim
+
+    /** Blocks until all participants arrived.  Throws if the exchange is aborted. */
+    void arrive_and_wait(std::unique_lock<std::mutex> &lock) {
+        if (++num_arrived_ == num_participants_) {
+            num_arrived_ = 0;
+            ++generation_;
+            cv_.notify_all();
+        } else {
+            const auto generation = generation_;
+            cv_.wait(lock, [&]() { return aborted_ or generation_ != generation; });
+        }
+        if (aborted_)
+            throw m::runtime_error("parallel grouping aborted since another thread failed");
+    }
+
+    public:
+    explicit GroupingExchange(std::size_t num_participants) : num_participants_(num_participants) {
+        M_insist(num_participants != 0);
+    }
+
+    /** Publishes the \p num_partitions partitions of rows of \p row_size bytes starting at \p rows, with partition
+     * boundaries \p offsets, and waits for all other participants to publish theirs. */
+    void publish(const uint8_t *rows, const uint32_t *offsets, uint32_t row_size, uint32_t num_partitions) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        M_insist(partitions_.empty() or (row_size_ == row_size and num_partitions_ == num_partitions),
+                 "all participants must publish the same partitioning");
+        row_size_ = row_size;
+        num_partitions_ = num_partitions;
+        partitions_.push_back({ rows, offsets });
+        arrive_and_wait(lock);
+    }
+
+    /** Claims the next partition.  Once all partitions are claimed, the returned partition is out of bounds. */
+    uint32_t next_partition() { return next_partition_.fetch_add(1, std::memory_order_relaxed); }
+
+    /** Returns the total number of rows in partition \p partition. */
+    uint32_t partition_size(uint32_t partition) const {
+        M_insist(partition < num_partitions_);
+        uint32_t size = 0;
+        for (auto &p : partitions_)
+            size += p.offsets[partition + 1] - p.offsets[partition];
+        return size;
+    }
+
+    /** Copies the rows of partition \p partition of all participants consecutively to \p dst. */
+    void fetch_partition(uint32_t partition, uint8_t *dst) const {
+        M_insist(partition < num_partitions_);
+        for (auto &p : partitions_) {
+            const std::size_t bytes = std::size_t(p.offsets[partition + 1] - p.offsets[partition]) * row_size_;
+            std::memcpy(dst, p.rows + std::size_t(p.offsets[partition]) * row_size_, bytes);
+            dst += bytes;
+        }
+    }
+
+    /** Waits for all other participants to finish merging. */
+    void finish() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        arrive_and_wait(lock);
+    }
+
+    /** Aborts the exchange, s.t. all waiting participants throw instead of waiting for a failed participant. */
+    void abort() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        aborted_ = true;
+        cv_.notify_all();
+    }
+};
+
+/** The state of a thread executing an instance of a compiled Wasm module.  Since both the `Module` and the mapping
+ * of IDs to `WasmContext`s are only available to the thread that compiled the query, and since a cached module was
+ * compiled by a `Module` that no longer exists, the V8 callback functions obtain them from here if set. */
+struct ExecutionState
+{
+    using messages_type = std::vector<std::tuple<const char*, unsigned, const char*>>;
+
+    WasmEngine::WasmContext *context = nullptr; ///< the `WasmContext` of the executed instance
+    const messages_type *messages = nullptr; ///< the messages of the runtime checks and exceptions of the module
+    MorselDispatcher *dispatcher = nullptr; ///< the dispatcher of the morsels to process
+    GroupingExchange *grouping_exchange = nullptr; ///< the exchange of pre-aggregated groups between the instances
+};
+
+thread_local ExecutionState execution_state;
+
+/** Installs an `ExecutionState` for the current thread for the lifetime of this object. */
+struct scoped_execution_state
+{
+    private:
+    ExecutionState old_;
+
+    public:
+    explicit scoped_execution_state(ExecutionState state) : old_(std::exchange(execution_state, state)) { }
+    scoped_execution_state(const scoped_execution_state&) = delete;
+    ~scoped_execution_state() { execution_state = old_; }
+};
+
+/** Returns the `WasmContext` of the instance executed by the current thread. */
+WasmEngine::WasmContext & current_wasm_context()
+{
+    if (execution_state.context)
+        return *execution_state.context;
+    return WasmEngine::Get_Wasm_Context_By_ID(Module::ID());
+}
+
+/** Returns the message with index \p idx of the module executed by the current thread. */
+const std::tuple<const char*, unsigned, const char*> & current_message(std::size_t idx)
+{
+    if (execution_state.messages)
+        return execution_state.messages->at(idx);
+    return Module::Get().get_message(idx);
+}
+
+/** Serializes the callbacks for result sets, which may be issued concurrently by multiple threads. */
+std::mutex result_set_mutex;
+
+
+/*======================================================================================================================
+ * Tiered compilation
+ *====================================================================================================================*/
+
+/** Guards the V8 flags, which are global to the process and are read by V8 while compiling a Wasm module.  Hence, a
+ * module is compiled while holding this lock in shared mode, and the flags are only changed while holding it
+ * exclusively. */
+std::shared_mutex v8_flags_mutex;
+/** The V8 flags set by `V8Engine::initialize()`.  They are restored after temporarily changing flags. */
+std::string v8_flags;
+/** The V8 flags to compile a Wasm module to baseline code only. */
+constexpr const char *V8_BASELINE_FLAGS = "--liftoff --no-wasm-tier-up --no-wasm-dynamic-tiering";
+
+/** The state shared by a query that starts on baseline code and the compilation of its optimized code in the
+ * background.  The compilation may outlive the query, if the query finishes on baseline code. */
+struct TierUpState
+{
+    ///> the binary of the Wasm module
+    std::unique_ptr<uint8_t, decltype(&std::free)> binary{nullptr, &std::free};
+    std::size_t binary_size = 0; ///< the size of `binary` in bytes
+    std::optional<v8::CompiledWasmModule> optimized_module; ///< the optimized code, once compiled
+    std::exception_ptr exception; ///< the exception thrown by the compilation, if any
+    Timer::time_point begin; ///< the begin of the compilation
+    Timer::time_point end; ///< the end of the compilation
+    std::mutex mutex; ///< protects `dispatcher`
+    ///> the dispatcher to yield once the optimized code is available; `nullptr` once the query stopped waiting for it
+    MorselDispatcher *dispatcher = nullptr;
+};
+
+
+/*======================================================================================================================
+ * CompiledPlanCache
+ *====================================================================================================================*/
+
+/** A cache of compiled WebAssembly modules, keyed by a canonical representation of the physical plan they were
+ * compiled from and of all options affecting code generation.  Evicts the least recently used module when its
+ * capacity is exceeded. */
+struct CompiledPlanCache
+{
+    /** Everything required to execute a cached module without compiling its plan again. */
+    struct entry_type
+    {
+        ///> the compiled module
+        v8::Global<v8::WasmModuleObject> wasm_module;
+        ///> the messages of the runtime checks and exceptions emitted into the module
+        ExecutionState::messages_type messages;
+        ///> factory used to create the result set data layout
+        std::unique_ptr<const storage::DataLayoutFactory> result_set_factory;
+        ///> the beginning of the heap the module was compiled for
+        uint32_t heap;
+        ///> the data written to pre-allocated memory during compilation, starting at `heap`
+        std::string pre_allocated_memory;
+    };
+
+    private:
+    using list_type = std::list<std::pair<const std::string, entry_type>>;
+
+    std::size_t capacity_; ///< the maximum number of cached entries
+    list_type entries_; ///< the cached entries, from most to least recently used
+    ///> maps keys to their entries; views the keys stored in `entries_`
+    std::unordered_map<std::string_view, list_type::iterator> index_;
+
+    public:
+    explicit CompiledPlanCache(std::size_t capacity = 0) : capacity_(capacity) { }
+    CompiledPlanCache(const CompiledPlanCache&) = delete;
+    CompiledPlanCache(CompiledPlanCache&&) = default;
+
+    std::size_t capacity() const { return capacity_; }
+    std::size_t size() const { return entries_.size(); }
+
+    /** Sets the capacity to \p capacity and evicts the least recently used entries exceeding it. */
+    void capacity(std::size_t capacity) {
+        capacity_ = capacity;
+        evict();
+    }
+
+    /** Returns the entry for \p key and marks it as most recently used, or `nullptr` if there is none. */
+    entry_type * find(const std::string &key) {
+        auto it = index_.find(key);
+        if (it == index_.end())
+            return nullptr;
+        entries_.splice(entries_.begin(), entries_, it->second); // iterators remain valid
+        return &it->second->second;
+    }
+
+    /** Inserts \p entry for \p key as most recently used entry and evicts the least recently used entries exceeding
+     * the capacity.  Returns the inserted entry, or `nullptr` if the cache has no capacity. */
+    entry_type * insert(std::string key, entry_type entry) {
+        M_insist(not index_.contains(key), "entry for that key already exists");
+        if (capacity_ == 0)
+            return nullptr;
+        auto &elem = entries_.emplace_front(std::move(key), std::move(entry));
+        index_.emplace(elem.first, entries_.begin());
+        evict();
+        return &elem.second;
+    }
+
+    /** Removes all entries. */
+    void clear() {
+        index_.clear();
+        entries_.clear();
+    }
+
+    private:
+    void evict() {
+        while (entries_.size() > capacity_) {
+            index_.erase(entries_.back().first);
+            entries_.pop_back();
+        }
+    }
+};
+
+
 /*======================================================================================================================
  * V8Engine
  *====================================================================================================================*/
@@ -79,6 +389,23 @@ struct V8Engine : m::WasmEngine
     /*----- Objects for remote debugging via CDT. --------------------------------------------------------------------*/
     std::unique_ptr<V8InspectorClientImpl> inspector_;
 
+    /*----- Objects for morsel-driven parallel execution. ------------------------------------------------------------*/
+    ///> the allocators of the worker isolates
+    std::vector<std::unique_ptr<v8::ArrayBuffer::Allocator>> worker_allocators_;
+    ///> the isolates of the worker threads, created on demand; a V8 isolate must not be entered by multiple threads
+    std::vector<v8::Isolate*> worker_isolates_;
+
+    /*----- Objects for tiered compilation. --------------------------------------------------------------------------*/
+    ///> the allocator of `tier_up_isolate_`
+    v8::ArrayBuffer::Allocator *tier_up_allocator_ = nullptr;
+    ///> the isolate to compile optimized code in the background, created on demand
+    v8::Isolate *tier_up_isolate_ = nullptr;
+    ///> the thread compiling optimized code in the background; may outlive the query it compiles for
+    std::thread tier_up_thread_;
+
+    /*----- Cache of compiled plans. ---------------------------------------------------------------------------------*/
+    CompiledPlanCache plan_cache_;
+
     public:
     V8Engine();
     V8Engine(const V8Engine&) = delete;
@@ -94,6 +421,13 @@ struct V8Engine : m::WasmEngine
     void initialize();
     void compile(const m::MatchBase &plan) const override;
     void execute(const m::MatchBase &plan) override;
+
+    private:
+    /** Returns the isolate of the worker thread with index \p i.  Creates the isolate if it does not exist yet. */
+    v8::Isolate & worker_isolate(std::size_t i);
+    /** Returns the isolate to compile optimized code in the background.  Waits for a compilation of a previous query
+     * that still runs in the background and creates the isolate if it does not exist yet. */
+    v8::Isolate & tier_up_isolate();
 };
 
 
@@ -234,7 +568,7 @@ void m::wasm::detail::insist(const v8::FunctionCallbackInfo<v8::Value> &info)
 {
     M_insist(info.Length() == 1);
     auto idx = info[0].As<v8::BigInt>()->Uint64Value();
-    auto [filename, line, msg] = Module::Get().get_message(idx);
+    auto [filename, line, msg] = current_message(idx);
 
     std::cout.flush();
     std::cerr << filename << ':' << line << ": Wasm_insist failed.";
@@ -250,7 +584,7 @@ void m::wasm::detail::_throw(const v8::FunctionCallbackInfo<v8::Value> &info)
     M_insist(info.Length() == 2);
     auto type = static_cast<m::wasm::exception::exception_t>(info[0].As<v8::BigInt>()->Uint64Value());
     auto idx = info[1].As<v8::BigInt>()->Uint64Value();
-    auto [filename, line, msg] = Module::Get().get_message(idx);
+    auto [filename, line, msg] = current_message(idx);
 
     std::ostringstream oss;
     oss << filename << ':' << line << ": Exception `" << m::wasm::exception::names_[type] << "` thrown.";
@@ -303,9 +637,72 @@ void m::wasm::detail::set_wasm_instance_raw_memory(const v8::FunctionCallbackInf
     v8::SetWasmInstanceRawMemory(wasm_instance, wasm_context.vm.as<uint8_t*>(), wasm_context.vm.size());
 }
 
+void m::wasm::detail::next_morsel(const v8::FunctionCallbackInfo<v8::Value> &info)
+{
+    M_insist(info.Length() == 0);
+    M_insist(execution_state.dispatcher, "query is not executed morsel-driven");
+    info.GetReturnValue().Set(execution_state.dispatcher->next());
+}
+
+void m::wasm::detail::skip_zone(const v8::FunctionCallbackInfo<v8::Value> &info)
+{
+    M_insist(info.Length() == 2);
+    auto &context = current_wasm_context();
+    const auto id = info[0].As<v8::Uint32>()->Value();
+    const auto zone = info[1].As<v8::Uint32>()->Value();
+    M_insist(id < context.skippable_zones.size(), "invalid ID of skippable zones");
+    auto &skippable = context.skippable_zones[id].second;
+    info.GetReturnValue().Set(uint32_t(zone < skippable.size() and skippable[zone]));
+}
+
+void m::wasm::detail::grouping_publish_partitions(const v8::FunctionCallbackInfo<v8::Value> &info)
+{
+    M_insist(info.Length() == 4);
+    M_insist(execution_state.grouping_exchange, "query is not executed by multiple threads");
+    auto &context = current_wasm_context();
+    auto rows = context.vm.as<const uint8_t*>() + info[0].As<v8::Uint32>()->Value();
+    auto offsets = reinterpret_cast<const uint32_t*>(context.vm.as<const uint8_t*>() + info[1].As<v8::Uint32>()->Value());
+    auto row_size = info[2].As<v8::Uint32>()->Value();
+    auto num_partitions = info[3].As<v8::Uint32>()->Value();
+    execution_state.grouping_exchange->publish(rows, offsets, row_size, num_partitions);
+}
+
+void m::wasm::detail::grouping_next_partition(const v8::FunctionCallbackInfo<v8::Value> &info)
+{
+    M_insist(info.Length() == 0);
+    M_insist(execution_state.grouping_exchange, "query is not executed by multiple threads");
+    info.GetReturnValue().Set(execution_state.grouping_exchange->next_partition());
+}
+
+void m::wasm::detail::grouping_partition_size(const v8::FunctionCallbackInfo<v8::Value> &info)
+{
+    M_insist(info.Length() == 1);
+    M_insist(execution_state.grouping_exchange, "query is not executed by multiple threads");
+    auto partition = info[0].As<v8::Uint32>()->Value();
+    info.GetReturnValue().Set(execution_state.grouping_exchange->partition_size(partition));
+}
+
+void m::wasm::detail::grouping_fetch_partition(const v8::FunctionCallbackInfo<v8::Value> &info)
+{
+    M_insist(info.Length() == 2);
+    M_insist(execution_state.grouping_exchange, "query is not executed by multiple threads");
+    auto &context = current_wasm_context();
+    auto partition = info[0].As<v8::Uint32>()->Value();
+    auto dst = context.vm.as<uint8_t*>() + info[1].As<v8::Uint32>()->Value();
+    execution_state.grouping_exchange->fetch_partition(partition, dst);
+}
+
+void m::wasm::detail::grouping_finish(const v8::FunctionCallbackInfo<v8::Value> &info)
+{
+    M_insist(info.Length() == 0);
+    M_insist(execution_state.grouping_exchange, "query is not executed by multiple threads");
+    execution_state.grouping_exchange->finish();
+}
+
 void m::wasm::detail::read_result_set(const v8::FunctionCallbackInfo<v8::Value> &info)
 {
-    auto &context = WasmEngine::Get_Wasm_Context_By_ID(Module::ID());
+    auto &context = current_wasm_context();
+    std::lock_guard<std::mutex> lock(result_set_mutex); // result sets of concurrent instances must not interleave
 
     auto &root_op = context.plan.get_matched_root();
     auto &schema = root_op.schema();
@@ -413,8 +810,15 @@ void m::wasm::detail::read_result_set(const v8::FunctionCallbackInfo<v8::Value>
                 M_insist(e.id.is_constant());
                 tup.set(i, Interpreter::eval(as<const ast::Constant>(projections[i].first)));
             }
-            for (std::size_t i = 0; i < num_tuples; ++i)
-                callback_op->callback()(schema, tup);
+            if (callback_op->batch_callback()) {
+                const storage::DataLayout empty_layout;
+                callback_op->batch_callback()(schema, CallbackOperator::batch_type{
+                    deduplicated_schema_without_constants, empty_layout, nullptr, num_tuples, tup
+                });
+            } else {
+                for (std::size_t i = 0; i < num_tuples; ++i)
+                    callback_op->callback()(schema, tup);
+            }
         } else if (auto print_op = cast<const PrintOperator>(&root_op)) {
             std::ostringstream tup;
             for (std::size_t i = 0; i < schema.num_entries(); ++i) {
@@ -435,7 +839,21 @@ void m::wasm::detail::read_result_set(const v8::FunctionCallbackInfo<v8::Value>
     auto layout = context.result_set_factory->make(deduplicated_schema_without_constants);
 
     /* Extract results. */
-    if (auto callback_op = cast<const CallbackOperator>(&root_op)) {
+    if (auto batch_op = cast<const CallbackOperator>(&root_op); batch_op and batch_op->batch_callback()) {
+        /* Hand the result set window directly to the callback, without materializing a `Tuple` per result. */
+        Tuple constants(schema); // tuple entries which are not set are implicitly NULL
+        for (std::size_t i = 0; i < schema.num_entries(); ++i) {
+            auto &e = schema[i];
+            if (e.type->is_none()) continue; // NULL constant
+            if (e.id.is_constant()) { // other constant
+                M_insist(bool(projection), "projection must be found");
+                constants.set(i, Interpreter::eval(as<const ast::Constant>(projection->projections()[i].first)));
+            }
+        }
+        batch_op->batch_callback()(schema, CallbackOperator::batch_type{
+            deduplicated_schema_without_constants, layout, result_set, num_tuples, constants
+        });
+    } else if (auto callback_op = cast<const CallbackOperator>(&root_op)) {
         auto loader = Interpreter::compile_load(deduplicated_schema_without_constants, result_set, layout,
                                                 deduplicated_schema_without_constants);
         if (schema.num_entries() == deduplicated_schema.num_entries()) {
@@ -656,7 +1074,7 @@ struct CollectStringLiterals : ConstOperatorVisitor, ast::ConstASTExprVisitor
     void operator()(const ast::ErrorExpr&) override { M_unreachable("no errors at this stage"); }
     void operator()(const ast::Designator&) override { /* nothing to be done */ }
     void operator()(const ast::Constant &e) override {
-        if (e.is_string()) {
+        if (e.is_string() or (is<const ast::Parameter>(&e) and e.type()->is_character_sequence())) {
             auto s = Interpreter::eval(e);
             literals_.emplace(s.as<const char*>());
         }
@@ -721,16 +1139,385 @@ struct CollectTables : ConstOperatorVisitor
     void operator()(const SortingOperator &op) override { recurse(op); }
 };
 
+/** Returns `true` iff \p plan can be executed morsel-driven by multiple threads, i.e. iff it forms a single pipeline
+ * that starts at a sequential scan of one table and contains only operators that neither keep state across tuples
+ * nor depend on the order of tuples.  If \p allow_grouping, the pipeline may be broken by a single hash-based grouping
+ * which exchanges its thread-local groups via the host. */
+bool is_morsel_parallelizable(const m::MatchBase &plan, bool allow_grouping)
+{
+    bool is_parallelizable = true;
+    std::size_t num_scans = 0;
+    std::size_t num_groupings = 0;
+    visit(overloaded {
+        [&](const Match<m::wasm::HashBasedGrouping> &M) {
+            if (not allow_grouping or M.grouping.group_by().empty() or num_groupings++ != 0) {
+                is_parallelizable = false;
+                throw visit_stop_recursion();
+            }
+        },
+        [&](const Match<m::wasm::Scan<false>>&) { ++num_scans; },
+        [&](const Match<m::wasm::Scan<true>>&) { ++num_scans; },
+        [](const Match<m::wasm::Filter<false>>&) { },
+        [](const Match<m::wasm::Filter<true>>&) { },
+        [](const Match<m::wasm::LazyDisjunctiveFilter>&) { },
+        [](const Match<m::wasm::Projection>&) { },
+        [](const Match<m::wasm::Callback<false>>&) { },
+        [](const Match<m::wasm::Callback<true>>&) { },
+        [](const Match<m::wasm::Print<false>>&) { },
+        [](const Match<m::wasm::Print<true>>&) { },
+        [](const Match<m::wasm::NoOp>&) { },
+        [&](auto&&) { is_parallelizable = false; throw visit_stop_recursion(); },
+    }, as<const m::wasm::MatchBase>(plan), tag<m::wasm::ConstPreOrderMatchBaseVisitor>());
+    return is_parallelizable and num_scans == 1;
+}
+
+/** Invokes \p callback on each `ast::Constant` within the expressions of the logical plan \p plan, in pre-order. */
+void for_each_constant(const Operator &plan, const std::function<void(const ast::Constant&)> &callback)
+{
+    auto visit_expr = [&callback](const ast::Expr &e) {
+        visit(overloaded {
+            [&callback](const ast::Constant &c) { callback(c); },
+            [](auto&) { },
+        }, e, m::tag<m::ast::ConstPreOrderExprVisitor>());
+    };
+    auto visit_cnf = [&visit_expr](const cnf::CNF &cnf) {
+        for (auto &clause : cnf) {
+            for (auto &pred : clause)
+                visit_expr(*pred);
+        }
+    };
+
+    visit(overloaded {
+        [&](const FilterOperator &op) { visit_cnf(op.filter()); },
+        [&](const DisjunctiveFilterOperator &op) { visit_cnf(op.filter()); },
+        [&](const JoinOperator &op) { visit_cnf(op.predicate()); },
+        [&](const ProjectionOperator &op) { for (auto &p : op.projections()) visit_expr(p.first); },
+        [&](const GroupingOperator &op) {
+            for (auto &g : op.group_by()) visit_expr(g.first);
+            for (auto &a : op.aggregates()) visit_expr(a);
+        },
+        [&](const AggregationOperator &op) { for (auto &a : op.aggregates()) visit_expr(a); },
+        [&](const SortingOperator &op) { for (auto &o : op.order_by()) visit_expr(o.first); },
+        [](auto&) { },
+    }, plan, m::tag<ConstPreOrderOperatorVisitor>());
+}
+
+/** Returns `true` iff the constant \p c is hoisted into an imported global of the Wasm module instead of being compiled
+ * into the code, s.t. plans differing only in such constants share their compiled code.  Only numeric and temporal
+ * constants are hoisted.  Strings are compiled in since operators specialize their code for string constants, e.g.
+ * for `LIKE` patterns. */
+bool is_hoisted(const ast::Constant &c)
+{
+    if (auto param = cast<const ast::Parameter>(&c); param and param->value().type == TK_Null)
+        return false;
+    return c.type()->is_numeric() or c.type()->is_date() or c.type()->is_date_time();
+}
+
+/** Collects the constants of the logical plan \p plan that are hoisted into imported globals of the Wasm module, see
+ * `is_hoisted()`.  The constants are collected in a canonical order, s.t. the globals of plans differing only in these
+ * constants coincide.  The constant at position `i` is imported as global `constant_<i>`. */
+std::vector<const ast::Constant*> collect_hoisted_constants(const Operator &plan)
+{
+    std::vector<const ast::Constant*> constants;
+    std::unordered_set<const ast::Constant*> seen;
+    for_each_constant(plan, [&](const ast::Constant &c) {
+        if (is_hoisted(c) and seen.emplace(&c).second)
+            constants.push_back(&c);
+    });
+    return constants;
+}
+
+/** Adds the values of the hoisted \p constants, collected by `collect_hoisted_constants()`, to the environment \p env.
+ * If \p emit_imports, additionally imports the respective globals into the current Wasm module. */
+void add_constants_to_env(v8::Isolate &isolate, v8::Local<v8::Object> env,
+                          const std::vector<const ast::Constant*> &constants, bool emit_imports)
+{
+    auto Ctx = isolate.GetCurrentContext();
+    for (std::size_t i = 0; i != constants.size(); ++i) {
+        const ast::Constant &c = *constants[i];
+        const std::string name = "constant_" + std::to_string(i);
+        auto value = Interpreter::eval(c);
+
+        auto add = [&]<typename T>(v8::Local<v8::Value> v8_value) {
+            M_DISCARD env->Set(Ctx, to_v8_string(&isolate, name), v8_value);
+            if (emit_imports) {
+                Module::Get().emit_import<T>(name.c_str());
+                CodeGenContext::Get().add_constant(c, name);
+            }
+        };
+        visit(overloaded {
+            [&](const Numeric &n) {
+                if (n.kind == Numeric::N_Float) {
+                    if (n.size() <= 32)
+                        add.operator()<float>(v8::Number::New(&isolate, value.as_f()));
+                    else
+                        add.operator()<double>(v8::Number::New(&isolate, value.as_d()));
+                    return;
+                }
+                switch (n.size()) {
+                    default: M_unreachable("invalid integer size");
+                    case  8: add.operator()<int8_t>(v8::Int32::New(&isolate, value.as_i()));  break;
+                    case 16: add.operator()<int16_t>(v8::Int32::New(&isolate, value.as_i())); break;
+                    case 32: add.operator()<int32_t>(v8::Int32::New(&isolate, value.as_i())); break;
+                    case 64: add.operator()<int64_t>(v8::BigInt::New(&isolate, value.as_i())); break;
+                }
+            },
+            [&](const Date&) { add.operator()<int32_t>(v8::Int32::New(&isolate, value.as_i())); },
+            [&](const DateTime&) { add.operator()<int64_t>(v8::BigInt::New(&isolate, value.as_i())); },
+            [](auto&&) { M_unreachable("constant is not hoisted"); },
+        }, *c.type());
+    }
+}
+
+/** Prints expressions like `ast::ASTPrinter` but prints the constants hoisted into imported globals by their type only,
+ * see `is_hoisted()`. */
+struct HoistedConstantsPrinter : ast::ASTPrinter
+{
+    using ast::ASTPrinter::ASTPrinter;
+    using ast::ASTPrinter::operator();
+
+    void operator()(const ast::Constant &e) override {
+        if (CodeGenContext::Get().get_constant_global(e))
+            out << '$' << *e.type();
+        else
+            ast::ASTPrinter::operator()(e);
+    }
+
+    void operator()(const cnf::CNF &cnf) {
+        for (auto &clause : cnf) {
+            out << '(';
+            for (auto &pred : clause) {
+                out << (pred.negative() ? " -" : " ");
+                (*this)(*pred);
+            }
+            out << " )";
+        }
+    }
+};
+
+/** Prints the shape of the logical plan \p plan to \p out, i.e. the plan without its estimated cardinalities and with
+ * the constants hoisted into imported globals printed by their type only. */
+void print_plan_shape(std::ostream &out, const Operator &plan)
+{
+    HoistedConstantsPrinter print(out);
+    print.expand_nested_queries(false);
+    auto print_exprs = [&](const auto &exprs) {
+        out << " [";
+        for (auto &e : exprs) {
+            print(e.get());
+            out << ',';
+        }
+        out << ']';
+    };
+
+    auto print_op = overloaded {
+        [&](const CallbackOperator&) { out << "Callback"; },
+        [&](const PrintOperator&) { out << "Print"; },
+        [&](const NoOpOperator&) { out << "NoOp"; },
+        [&](const ScanOperator &op) {
+            out << "Scan " << op.store().table().name() << " AS " << op.alias();
+            if (op.has_snapshot())
+                out << " snapshot " << op.snapshot();
+        },
+        [&](const FilterOperator &op) { out << "Filter "; print(op.filter()); },
+        [&](const DisjunctiveFilterOperator &op) { out << "DisjunctiveFilter "; print(op.filter()); },
+        [&](const JoinOperator &op) { out << "Join " << op.children().size() << ' '; print(op.predicate()); },
+        [&](const ProjectionOperator &op) {
+            out << "Projection [";
+            for (auto &p : op.projections()) {
+                print(p.first.get());
+                if (p.second.has_value())
+                    out << " AS " << p.second;
+                out << ',';
+            }
+            out << ']';
+        },
+        [&](const LimitOperator &op) { out << "Limit " << op.limit() << ", " << op.offset(); },
+        [&](const GroupingOperator &op) {
+            out << "Grouping [";
+            for (auto &[grp, alias] : op.group_by()) {
+                print(grp.get());
+                if (alias.has_value())
+                    out << " AS " << alias;
+                out << ',';
+            }
+            out << ']';
+            print_exprs(op.aggregates());
+        },
+        [&](const AggregationOperator &op) { out << "Aggregation"; print_exprs(op.aggregates()); },
+        [&](const SortingOperator &op) {
+            out << "Sorting [";
+            for (auto &[e, asc] : op.order_by()) {
+                print(e.get());
+                out << (asc ? " ASC," : " DESC,");
+            }
+            out << ']';
+        },
+    };
+    visit([&](const auto &op) { print_op(op); out << '\n'; }, plan, m::tag<ConstPreOrderOperatorVisitor>());
+}
+
+/** Prints the constants bound to the `ast::Parameter`s of the logical plan \p plan that are compiled into the code to
+ * \p out.  The plan prints a parameter by its placeholder only. */
+void print_bound_parameters(std::ostream &out, const Operator &plan)
+{
+    for_each_constant(plan, [&out](const ast::Constant &c) {
+        if (auto param = cast<const ast::Parameter>(&c); param and not CodeGenContext::Get().get_constant_global(c))
+            out << ' ' << param->tok.text << '=' << param->value().text;
+    });
+}
+
+/** Computes the key of \p plan in the `CompiledPlanCache`, i.e. a canonical representation of the shape of the logical
+ * and the physical plan together with all options affecting code generation.  The constants hoisted into imported
+ * globals by `create_env()` are represented by their type only, s.t. plans differing only in these constants or in the
+ * constants bound to their parameters share their compiled code.  The layouts and encodings of the scanned tables are
+ * part of the key.  The code refers to the string literals and dictionaries by their absolute addresses, which start at
+ * the beginning \p heap of the heap and hence move with the sizes of the mapped tables.  Must be called *after*
+ * `create_env()`. */
+std::string plan_cache_key(const m::MatchBase &plan, std::size_t morsel_size, std::size_t num_threads, uint32_t heap)
+{
+    namespace wasm_options = m::wasm::options;
+
+    /* Strip the estimated cardinalities and costs from the physical plan since they depend on the constants. */
+    static const std::regex estimates(R"(( <[^<>]*>)? \(cumulative cost [^)]*\))");
+    std::ostringstream physical_plan;
+    physical_plan << plan;
+
+    std::ostringstream oss;
+    print_plan_shape(oss, plan.get_matched_root());
+    oss << std::regex_replace(physical_plan.str(), estimates, "") << '\n';
+    print_bound_parameters(oss, plan.get_matched_root());
+    /* The layouts of the scanned tables are compiled into the code, including their encodings, i.e. the code widths,
+     * the frames of reference, and the sizes of the dictionaries, which determine the dictionaries' addresses.  They
+     * change when a table is compressed, or decompressed to append rows. */
+    for (auto &table : CollectTables::Collect(plan.get_matched_root()))
+        oss << '\n' << table.get().name() << ' ' << table.get().layout();
+    oss << "\nheap " << heap
+        << ", opt " << options::wasm_optimization_level
+        << ", morsel " << morsel_size
+        << ", threads " << num_threads
+        << ", simd " << wasm_options::simd << ' ' << wasm_options::double_pumping << ' ' << wasm_options::simd_lanes
+        << ", filter " << uint64_t(wasm_options::filter_selection_strategy)
+        << ", quicksort " << uint64_t(wasm_options::quicksort_cmp_selection_strategy)
+        << ", nlj " << uint64_t(wasm_options::nested_loops_join_selection_strategy)
+        << ", shj " << uint64_t(wasm_options::simple_hash_join_selection_strategy)
+        << ' ' << uint64_t(wasm_options::simple_hash_join_ordering_strategy)
+        << ", smj " << uint64_t(wasm_options::sort_merge_join_selection_strategy)
+        << ' ' << uint64_t(wasm_options::sort_merge_join_cmp_selection_strategy)
+        << ", rhj " << wasm_options::radix_hash_join_partition_size
+        << ' ' << wasm_options::radix_hash_join_radix_bits.value_or(-1U)
+        << ", unique " << wasm_options::exploit_unique_build
+        << ", groupjoin " << wasm_options::hash_based_group_join
+        << ", ht " << uint64_t(wasm_options::hash_table_implementation)
+        << ' ' << uint64_t(wasm_options::hash_table_probing_strategy)
+        << ' ' << uint64_t(wasm_options::hash_table_storing_strategy)
+        << ' ' << wasm_options::load_factor_open_addressing << ' ' << wasm_options::load_factor_chained
+        << ' ' << wasm_options::hash_table_initial_capacity.value_or(0)
+        << ", index " << uint64_t(wasm_options::index_scan_strategy)
+        << ' ' << uint64_t(wasm_options::index_scan_compilation_strategy)
+        << ' ' << uint64_t(wasm_options::index_scan_materialization_strategy)
+        << ' ' << wasm_options::index_sequential_scan_batch_size
+        << ", spb " << uint64_t(wasm_options::soft_pipeline_breaker)
+        << ' ' << wasm_options::soft_pipeline_breaker_num_tuples
+        << ", window " << wasm_options::result_set_window_size
+        << ' ' << wasm_options::streaming_result_set_window_size
+        << ", grouping " << wasm_options::parallel_grouping_preaggregation_capacity
+        << ' ' << wasm_options::parallel_grouping_radix_bits.value_or(-1U)
+        << ", sorted";
+    for (auto &[id, asc] : wasm_options::sorted_attributes)
+        oss << ' ' << id << (asc ? " ASC" : " DESC");
+    oss << ", layouts ";
+    wasm_options::soft_pipeline_breaker_layout->print(oss);
+    oss << ' ';
+    wasm_options::hard_pipeline_breaker_layout->print(oss);
+    return oss.str();
+}
+
+/** The state of a worker thread participating in the morsel-driven execution of a query. */
+struct MorselWorker
+{
+    std::unique_ptr<WasmEngine::WasmContext> context; ///< the worker's private `WasmContext`
+    memory::Memory heap; ///< the memory backing the worker's heap
+    std::vector<std::pair<std::string, int32_t>> globals; ///< the values of the global imports of the Wasm module
+    std::vector<const ast::Constant*> constants; ///< the constants hoisted into global imports of the Wasm module
+    uint32_t num_rows = 0; ///< the number of result tuples produced by the worker
+    std::exception_ptr exception; ///< the exception thrown by the worker, if any
+};
+
+/** Prepares a `MorselWorker` for executing \p plan.  The worker's address space replicates the address space of \p
+ * main_context, i.e. all addresses compiled into the Wasm module remain valid, however, the heap is private to the
+ * worker.  Must be called *after* compilation, s.t. the data written to pre-allocated memory is replicated as well. */
+MorselWorker prepare_morsel_worker(const WasmEngine::WasmContext &main_context, const m::MatchBase &plan,
+                                   WasmEngine::WasmContext::config_t config, uint32_t pre_alloc_end)
+{
+    MorselWorker worker;
+    worker.context = std::make_unique<WasmEngine::WasmContext>(main_context.id, plan, config, main_context.vm.size());
+    auto &context = *worker.context;
+
+    /* Map accessed tables in the same order as in `create_env()`. */
+    auto tables = CollectTables::Collect(plan.get_matched_root());
+    for (auto &table : tables) {
+        const auto off = context.map_table(table.get());
+        std::ostringstream oss;
+        oss << table.get().name() << "_mem";
+        worker.globals.emplace_back(oss.str(), off);
+        oss.str("");
+        oss << table.get().name() << "_num_rows";
+        worker.globals.emplace_back(oss.str(), table.get().store().num_rows());
+    }
+
+    worker.constants = collect_hoisted_constants(plan.get_matched_root());
+
+    /* Copy the string literals, which are located between the tables and the heap and followed by a guard page. */
+    if (context.heap != main_context.heap) {
+        M_insist(context.heap + get_pagesize() < main_context.heap);
+        const auto bytes = main_context.heap - context.heap - get_pagesize();
+        auto addr = context.vm.as<uint8_t*>() + context.heap;
+        M_DISCARD mmap(addr, bytes, PROT_READ|PROT_WRITE, MAP_FIXED|MAP_ANON|MAP_PRIVATE, -1, 0);
+        std::memcpy(addr, main_context.vm.as<const uint8_t*>() + context.heap, bytes);
+        context.heap += bytes;
+        context.install_guard_page();
+    }
+    M_insist(context.heap == main_context.heap, "address spaces of worker and main context must coincide");
+
+    /* Map the remaining address space to the worker's private heap. */
+    const auto bytes_remaining = context.vm.size() - context.heap;
+    worker.heap = Catalog::Get().allocator().allocate(bytes_remaining);
+    worker.heap.map(bytes_remaining, 0, context.vm, context.heap);
+
+    /* Copy the data written to pre-allocated memory during compilation. */
+    M_insist(pre_alloc_end >= context.heap);
+    std::memcpy(context.vm.as<uint8_t*>() + context.heap, main_context.vm.as<const uint8_t*>() + context.heap,
+                pre_alloc_end - context.heap);
+
+    context.result_set_factory = main_context.result_set_factory->clone();
+    context.indexes = main_context.indexes;
+    context.skippable_zones = main_context.skippable_zones;
+
+    return worker;
+}
+
 
 /*======================================================================================================================
  * V8Engine implementation
  *====================================================================================================================*/
 
-V8Engine::V8Engine() { initialize(); }
+V8Engine::V8Engine() : plan_cache_(options::wasm_plan_cache_size) { initialize(); }
 
 V8Engine::~V8Engine()
 {
     inspector_.reset();
+    if (tier_up_thread_.joinable())
+        tier_up_thread_.join(); // the background compilation uses `tier_up_isolate_`
+    if (tier_up_isolate_) {
+        tier_up_isolate_->Dispose();
+        delete tier_up_allocator_;
+    }
+    plan_cache_.clear(); // release cached modules before disposing their isolate
+    for (auto isolate : worker_isolates_)
+        isolate->Dispose();
+    worker_isolates_.clear();
+    worker_allocators_.clear();
     if (isolate_) {
         M_insist(allocator_);
         isolate_->Dispose();
@@ -757,6 +1544,11 @@ void V8Engine::initialize()
     } else {
         flags << "--no-liftoff "
               << "--no-wasm-lazy-compilation "; // compile code before starting execution
+        if (options::wasm_tiered) {
+            flags << "--no-wasm-native-module-cache-enabled " // do not reuse baseline code for optimized modules
+                  << "--wasm-tier-up " // V8 defaults, stated to restore them after compiling baseline code
+                  << "--wasm-dynamic-tiering ";
+        }
     }
     if (not options::wasm_compilation_cache) {
         flags << "--no-compilation-cache "
@@ -780,13 +1572,40 @@ void V8Engine::initialize()
               << "--no-wasm-stack-checks "
               << "--wasm-simd-ssse3-codegen ";
     }
-    v8::V8::SetFlagsFromString(flags.str().c_str());
+    {
+        std::unique_lock<std::shared_mutex> lock(v8_flags_mutex);
+        v8_flags = flags.str();
+        v8::V8::SetFlagsFromString(v8_flags.c_str());
+    }
 
     v8::Isolate::CreateParams create_params;
     create_params.array_buffer_allocator = allocator_ = v8::ArrayBuffer::Allocator::NewDefaultAllocator();
     isolate_ = v8::Isolate::New(create_params);
 }
 
+v8::Isolate & V8Engine::worker_isolate(std::size_t i)
+{
+    while (worker_isolates_.size() <= i) {
+        v8::Isolate::CreateParams create_params;
+        create_params.array_buffer_allocator =
+            worker_allocators_.emplace_back(v8::ArrayBuffer::Allocator::NewDefaultAllocator()).get();
+        worker_isolates_.push_back(v8::Isolate::New(create_params));
+    }
+    return *worker_isolates_[i];
+}
+
+v8::Isolate & V8Engine::tier_up_isolate()
+{
+    if (tier_up_thread_.joinable())
+        tier_up_thread_.join();
+    if (not tier_up_isolate_) {
+        v8::Isolate::CreateParams create_params;
+        create_params.array_buffer_allocator = tier_up_allocator_ = v8::ArrayBuffer::Allocator::NewDefaultAllocator();
+        tier_up_isolate_ = v8::Isolate::New(create_params);
+    }
+    return *tier_up_isolate_;
+}
+
 void V8Engine::compile(const m::MatchBase &plan) const
 {
 #if 1
@@ -908,6 +1727,17 @@ void V8Engine::execute(const m::MatchBase &plan)
             wasm_config |= WasmContext::TRAP_GUARD_PAGES;
         auto &wasm_context = Create_Wasm_Context_For_ID(Module::ID(), plan, wasm_config);
 
+        /* Decide whether to execute the query morsel-driven by multiple threads. */
+        const bool is_parallel =
+            options::wasm_threads > 1 and options::cdt_port < 1024 and is_morsel_parallelizable(plan, true);
+        /* Decide whether to execute the query tiered, i.e. start on baseline code and switch to optimized code. */
+        const bool is_tiered = not is_parallel and options::wasm_tiered and not options::wasm_adaptive and
+                               options::cdt_port < 1024 and is_morsel_parallelizable(plan, false);
+        if (is_parallel or is_tiered)
+            CodeGenContext::Get().set_morsel_size(options::wasm_morsel_size);
+        if (is_parallel)
+            CodeGenContext::Get().set_num_threads(options::wasm_threads);
+
         auto imports = v8::Object::New(isolate_);
         auto env = create_env(*isolate_, plan);
         M_DISCARD imports->Set(context, mkstr(*isolate_, "imports"), env);
@@ -918,11 +1748,77 @@ void V8Engine::execute(const m::MatchBase &plan)
         memory::Memory mem = Catalog::Get().allocator().allocate(bytes_remaining);
         mem.map(bytes_remaining, 0, wasm_context.vm, wasm_context.heap);
 
+        /* Look up the plan in the cache of compiled plans. */
+        const bool use_plan_cache = plan_cache_.capacity() != 0 and options::cdt_port < 1024;
+        std::string key;
+        CompiledPlanCache::entry_type *cached = nullptr;
+        if (use_plan_cache) {
+            key = plan_cache_key(plan, CodeGenContext::Get().morsel_size(), CodeGenContext::Get().num_threads(),
+                                 wasm_context.heap);
+            cached = plan_cache_.find(key);
+            C.timer().increment(cached ? "Compiled plan cache hits" : "Compiled plan cache misses");
+        }
+
         auto compile_time = C.timer().create_timing("Compile SQL to machine code");
-        /* Compile the plan and thereby build the Wasm module. */
-        M_TIME_EXPR(compile(plan), "|- Compile SQL to WebAssembly", C.timer());
+        v8::Local<v8::WasmModuleObject> wasm_module;
+        const ExecutionState::messages_type *execution_messages;
+        uint32_t pre_alloc_end;
+        CompiledPlanCache::entry_type *cache_entry = cached;
+        ///> the state of tiered compilation, if the module must still be compiled to optimized code in the background
+        std::shared_ptr<TierUpState> tier_up;
+        if (cached) {
+            /* Restore the state the cached module was compiled for. */
+            M_insist(wasm_context.heap == cached->heap, "heap must begin at the same address as during compilation");
+            wasm_context.result_set_factory = cached->result_set_factory->clone();
+            std::memcpy(wasm_context.vm.as<uint8_t*>() + wasm_context.heap, cached->pre_allocated_memory.data(),
+                        cached->pre_allocated_memory.size());
+            pre_alloc_end = wasm_context.heap + cached->pre_allocated_memory.size();
+            wasm_module = cached->wasm_module.Get(isolate_);
+            execution_messages = &cached->messages;
+        } else {
+            /* Compile the plan and thereby build the Wasm module. */
+            M_TIME_EXPR(compile(plan), "|- Compile SQL to WebAssembly", C.timer());
+            pre_alloc_end = Module::Allocator().pre_allocated_memory_end();
+            /* Compile the Wasm module to machine code. */
+            if (is_tiered) {
+                /* Compile to baseline code only.  The optimized code is compiled in the background later on. */
+                tier_up = std::make_shared<TierUpState>();
+                auto [binary_addr, size] = Module::Get().binary();
+                tier_up->binary.reset(binary_addr);
+                tier_up->binary_size = size;
+                std::unique_lock<std::shared_mutex> lock(v8_flags_mutex);
+                v8::V8::SetFlagsFromString(V8_BASELINE_FLAGS);
+                try {
+                    wasm_module = M_TIME_EXPR(compile_wasm_module(*isolate_, tier_up->binary.get(), size),
+                                              " ` Compile WebAssembly to baseline code", C.timer());
+                } catch (...) {
+                    v8::V8::SetFlagsFromString(v8_flags.c_str());
+                    throw;
+                }
+                v8::V8::SetFlagsFromString(v8_flags.c_str()); // restore *all* flags changed for baseline code
+            } else {
+                std::shared_lock<std::shared_mutex> lock(v8_flags_mutex);
+                wasm_module = M_TIME_EXPR(compile_wasm_module(*isolate_), " ` Compile WebAssembly to machine code",
+                                          C.timer());
+            }
+            execution_messages = &Module::Get().messages();
+
+            /* Cache the compiled plan.  Plans using indexes are not cached since they refer to the indexes by ID. */
+            if (use_plan_cache and wasm_context.indexes.empty()) {
+                M_insist(bool(wasm_context.result_set_factory));
+                const auto pre_alloc_begin = wasm_context.vm.as<const char*>() + wasm_context.heap;
+                cache_entry = plan_cache_.insert(std::move(key), CompiledPlanCache::entry_type{
+                    .wasm_module = v8::Global<v8::WasmModuleObject>(isolate_, wasm_module),
+                    .messages = Module::Get().messages(),
+                    .result_set_factory = wasm_context.result_set_factory->clone(),
+                    .heap = wasm_context.heap,
+                    .pre_allocated_memory = std::string(pre_alloc_begin, pre_alloc_end - wasm_context.heap),
+                });
+            }
+        }
+
         /* Create a WebAssembly instance object. */
-        auto instance = M_TIME_EXPR(instantiate(*isolate_, imports), " ` Compile WebAssembly to machine code", C.timer());
+        auto instance = instantiate(*isolate_, wasm_module, imports);
         compile_time.stop();
 
         /* Set the underlying memory for the instance. */
@@ -942,9 +1838,165 @@ void V8Engine::execute(const m::MatchBase &plan)
 
         /* Invoke the exported function `main` of the module. */
         args_t args { v8::Int32::New(isolate_, wasm_context.id), };
-        const uint32_t num_rows =
-            M_TIME_EXPR(main->Call(context, context->Global(), 1, args).ToLocalChecked().As<v8::Uint32>()->Value(),
-                        "Execute machine code", C.timer());
+        uint32_t num_rows;
+        MorselDispatcher dispatcher(options::wasm_morsel_size);
+        GroupingExchange grouping_exchange(options::wasm_threads);
+        if (is_parallel) {
+            /* Prepare one worker per additional thread, each with its own copy of the address space. */
+            std::vector<MorselWorker> workers;
+            for (std::size_t i = 1; i != options::wasm_threads; ++i)
+                workers.emplace_back(prepare_morsel_worker(wasm_context, plan, wasm_config, pre_alloc_end));
+            for (std::size_t i = 0; i != workers.size(); ++i)
+                M_DISCARD worker_isolate(i); // create isolates in advance
+            auto compiled_module = wasm_module->GetCompiledModule();
+            const auto &messages = *execution_messages;
+
+            /* Instantiates the compiled module in the worker's isolate and executes it. */
+            auto run_worker = [&](MorselWorker &worker, v8::Isolate *isolate) {
+                try {
+                    scoped_execution_state S({ worker.context.get(), &messages, &dispatcher, &grouping_exchange });
+                    v8::Locker locker(isolate);
+                    v8::Isolate::Scope isolate_scope(isolate);
+                    v8::HandleScope handle_scope(isolate);
+                    v8::Local<v8::Context> context = v8::Context::New(isolate);
+                    v8::Context::Scope context_scope(context);
+
+                    auto env = v8::Object::New(isolate);
+                    for (auto &[name, value] : worker.globals)
+                        M_DISCARD env->Set(context, mkstr(*isolate, name), v8::Int32::New(isolate, value));
+                    add_constants_to_env(*isolate, env, worker.constants, false);
+                    add_functions_to_env(*isolate, env);
+                    auto imports = v8::Object::New(isolate);
+                    M_DISCARD imports->Set(context, mkstr(*isolate, "imports"), env);
+
+                    auto wasm_module =
+                        v8::WasmModuleObject::FromCompiledModule(isolate, compiled_module).ToLocalChecked();
+                    auto instance = instantiate(*isolate, wasm_module, imports);
+                    v8::SetWasmInstanceRawMemory(instance, worker.context->vm.as<uint8_t*>(),
+                                                 worker.context->vm.size());
+
+                    auto exports = instance->Get(context, mkstr(*isolate, "exports")).ToLocalChecked().As<v8::Object>();
+                    auto main = exports->Get(context, mkstr(*isolate, "main")).ToLocalChecked().As<v8::Function>();
+                    args_t args { v8::Int32::New(isolate, worker.context->id), };
+                    worker.num_rows =
+                        main->Call(context, context->Global(), 1, args).ToLocalChecked().As<v8::Uint32>()->Value();
+                } catch (...) {
+                    worker.exception = std::current_exception();
+                    grouping_exchange.abort(); // do not let other threads wait for this worker
+                }
+            };
+
+            auto execute_time = C.timer().create_timing("Execute machine code");
+            std::vector<std::thread> threads;
+            for (std::size_t i = 0; i != workers.size(); ++i)
+                threads.emplace_back(run_worker, std::ref(workers[i]), worker_isolates_[i]);
+            std::exception_ptr exception;
+            try {
+                /* The current thread participates as well, using the already instantiated module. */
+                scoped_execution_state S({ &wasm_context, &messages, &dispatcher, &grouping_exchange });
+                num_rows = main->Call(context, context->Global(), 1, args).ToLocalChecked().As<v8::Uint32>()->Value();
+            } catch (...) {
+                exception = std::current_exception(); // rethrow after all workers finished
+                grouping_exchange.abort(); // do not let the workers wait for this thread
+            }
+            for (auto &t : threads)
+                t.join();
+            execute_time.stop();
+
+            if (exception)
+                std::rethrow_exception(exception);
+            for (auto &worker : workers) {
+                if (worker.exception)
+                    std::rethrow_exception(worker.exception);
+                num_rows += worker.num_rows;
+            }
+        } else if (tier_up) {
+            /* Compile the module to optimized code in the background, while executing the baseline code. */
+            const std::string pre_allocated_memory(wasm_context.vm.as<const char*>() + wasm_context.heap,
+                                                   pre_alloc_end - wasm_context.heap); // to reset before switching
+            v8::Isolate *background_isolate = &tier_up_isolate();
+            tier_up->dispatcher = &dispatcher;
+            tier_up->begin = Timer::clock::now();
+
+            auto execute_time = C.timer().create_timing("Execute machine code");
+            /* The compilation only accesses the shared `TierUpState`, s.t. it may continue after the query finished. */
+            tier_up_thread_ = std::thread([tier_up, background_isolate]() {
+                try {
+                    std::shared_lock<std::shared_mutex> flags_lock(v8_flags_mutex);
+                    v8::Locker locker(background_isolate);
+                    v8::Isolate::Scope isolate_scope(background_isolate);
+                    v8::HandleScope handle_scope(background_isolate);
+                    v8::Local<v8::Context> context = v8::Context::New(background_isolate);
+                    v8::Context::Scope context_scope(context);
+                    auto wasm_module =
+                        compile_wasm_module(*background_isolate, tier_up->binary.get(), tier_up->binary_size);
+                    tier_up->optimized_module.emplace(wasm_module->GetCompiledModule());
+                } catch (...) {
+                    tier_up->exception = std::current_exception();
+                }
+                tier_up->end = Timer::clock::now();
+                std::lock_guard<std::mutex> lock(tier_up->mutex);
+                if (tier_up->dispatcher)
+                    tier_up->dispatcher->yield(); // switch to the optimized code at the next morsel boundary
+            });
+
+            /* Stops waiting for the optimized code.  Returns `true` iff the baseline code stopped at a morsel boundary
+             * since the optimized code is available. */
+            auto stop_waiting = [&]() {
+                std::lock_guard<std::mutex> lock(tier_up->mutex);
+                tier_up->dispatcher = nullptr;
+                return dispatcher.has_yielded();
+            };
+
+            std::exception_ptr exception;
+            try {
+                scoped_execution_state S({ &wasm_context, execution_messages, &dispatcher });
+                num_rows = main->Call(context, context->Global(), 1, args).ToLocalChecked().As<v8::Uint32>()->Value();
+                if (stop_waiting()) {
+                    tier_up_thread_.join();
+                    if (tier_up->exception)
+                        std::rethrow_exception(tier_up->exception);
+                    M_insist(tier_up->optimized_module.has_value());
+                    C.timer().add(" ` Compile WebAssembly to optimized code in the background", tier_up->begin,
+                                  tier_up->end);
+
+                    /* Reset the pre-allocated memory and continue with the remaining morsels on optimized code. */
+                    std::memcpy(wasm_context.vm.as<uint8_t*>() + wasm_context.heap, pre_allocated_memory.data(),
+                                pre_allocated_memory.size());
+                    auto optimized =
+                        v8::WasmModuleObject::FromCompiledModule(isolate_, *tier_up->optimized_module).ToLocalChecked();
+                    auto optimized_instance = instantiate(*isolate_, optimized, imports);
+                    v8::SetWasmInstanceRawMemory(optimized_instance, wasm_context.vm.as<uint8_t*>(),
+                                                 wasm_context.vm.size());
+                    auto optimized_exports = optimized_instance->Get(context, mkstr(*isolate_, "exports"))
+                                                 .ToLocalChecked().As<v8::Object>();
+                    auto optimized_main = optimized_exports->Get(context, mkstr(*isolate_, "main"))
+                                              .ToLocalChecked().As<v8::Function>();
+                    dispatcher.resume();
+                    num_rows += optimized_main->Call(context, context->Global(), 1, args)
+                                    .ToLocalChecked().As<v8::Uint32>()->Value();
+                    C.timer().increment("Tier-up transitions");
+
+                    /* Cache the optimized code rather than the baseline code. */
+                    if (cache_entry)
+                        cache_entry->wasm_module.Reset(isolate_, optimized);
+                }
+                /* Otherwise, the query finished on baseline code and the compilation continues in the background.  It
+                 * is awaited before `tier_up_isolate_` is used again. */
+            } catch (...) {
+                exception = std::current_exception();
+                stop_waiting(); // `dispatcher` is about to be destroyed
+            }
+            execute_time.stop();
+
+            if (exception)
+                std::rethrow_exception(exception);
+        } else {
+            scoped_execution_state S({ &wasm_context, execution_messages, &dispatcher });
+            num_rows =
+                M_TIME_EXPR(main->Call(context, context->Global(), 1, args).ToLocalChecked().As<v8::Uint32>()->Value(),
+                            "Execute machine code", C.timer());
+        }
 
         /* Print total number of result tuples. */
         auto &root_op = plan.get_matched_root();
@@ -1000,6 +2052,14 @@ static void register_WasmV8()
         /* description= */ "enable adaptive execution of Wasm with Liftoff and dynamic tier-up",
                            [] (bool b) { options::wasm_adaptive = b; }
     );
+    C.arg_parser().add<bool>(
+        /* group=       */ "WasmV8",
+        /* short=       */ nullptr,
+        /* long=        */ "--wasm-tiered",
+        /* description= */ "start single-pipeline queries on Liftoff code and switch to TurboFan code at a morsel "
+                           "boundary once it is compiled in the background",
+                           [] (bool b) { options::wasm_tiered = b; }
+    );
     C.arg_parser().add<bool>(
         /* group=       */ "WasmV8",
         /* short=       */ nullptr,
@@ -1028,6 +2088,38 @@ static void register_WasmV8()
         /* description= */ "specify the port for debugging via ChromeDevTools",
                            [] (int i) { options::cdt_port = i; }
     );
+    C.arg_parser().add<std::size_t>(
+        /* group=       */ "WasmV8",
+        /* short=       */ nullptr,
+        /* long=        */ "--wasm-threads",
+        /* description= */ "set the number of threads to execute single-pipeline queries, optionally broken "
+                           "by a hash-based grouping, morsel-driven with",
+                           [] (std::size_t n) {
+                               if (n == 0)
+                                   std::cerr << "warning: ignore invalid number of threads " << n << std::endl;
+                               else
+                                   options::wasm_threads = n;
+                           }
+    );
+    C.arg_parser().add<std::size_t>(
+        /* group=       */ "WasmV8",
+        /* short=       */ nullptr,
+        /* long=        */ "--wasm-plan-cache-size",
+        /* description= */ "set the maximum number of compiled plans to cache for reuse (0 disables the cache)",
+                           [] (std::size_t n) { options::wasm_plan_cache_size = n; }
+    );
+    C.arg_parser().add<std::size_t>(
+        /* group=       */ "WasmV8",
+        /* short=       */ nullptr,
+        /* long=        */ "--wasm-morsel-size",
+        /* description= */ "set the number of tuples per morsel (a multiple of 64) for morsel-driven execution",
+                           [] (std::size_t n) {
+                               if (n == 0 or n % 64 != 0 or n > std::numeric_limits<uint32_t>::max())
+                                   std::cerr << "warning: ignore invalid morsel size " << n << std::endl;
+                               else
+                                   options::wasm_morsel_size = n;
+                           }
+    );
 }
 
 }
@@ -1042,10 +2134,26 @@ v8::Local<v8::String> m::wasm::detail::mkstr(v8::Isolate &isolate, const std::st
     return to_v8_string(&isolate, str);
 }
 
-v8::Local<v8::WasmModuleObject> m::wasm::detail::instantiate(v8::Isolate &isolate, v8::Local<v8::Object> imports)
+v8::Local<v8::WasmModuleObject> m::wasm::detail::compile_wasm_module(v8::Isolate &isolate)
 {
-    auto Ctx = isolate.GetCurrentContext();
     auto [binary_addr, binary_size] = Module::Get().binary();
+
+    if (Options::Get().statistics)
+        std::cout << "Wasm code size: " << binary_size << std::endl;
+
+    auto wasm_module = compile_wasm_module(isolate, binary_addr, binary_size);
+    free(binary_addr);
+
+    if (Options::Get().statistics)
+        std::cout << "Machine code size: " << wasm_module->GetCompiledModule().Serialize().size << std::endl;
+
+    return wasm_module;
+}
+
+v8::Local<v8::WasmModuleObject> m::wasm::detail::compile_wasm_module(v8::Isolate &isolate, uint8_t *binary_addr,
+                                                                     std::size_t binary_size)
+{
+    auto Ctx = isolate.GetCurrentContext();
     auto bs = v8::ArrayBuffer::NewBackingStore(
         /* data =        */ binary_addr,
         /* byte_length=  */ binary_size,
@@ -1054,18 +2162,18 @@ v8::Local<v8::WasmModuleObject> m::wasm::detail::instantiate(v8::Isolate &isolat
     );
     auto buffer = v8::ArrayBuffer::New(&isolate, std::move(bs));
 
-    if (Options::Get().statistics)
-        std::cout << "Wasm code size: " << binary_size << std::endl;
-
     args_t module_args { buffer };
     auto wasm = Ctx->Global()->Get(Ctx, mkstr(isolate, "WebAssembly")).ToLocalChecked().As<v8::Object>(); // WebAssembly class
-    auto wasm_module = wasm->Get(Ctx, mkstr(isolate, "Module")).ToLocalChecked().As<v8::Object>()
-                           ->CallAsConstructor(Ctx, 1, module_args).ToLocalChecked().As<v8::WasmModuleObject>();
-    free(binary_addr);
-
-    if (Options::Get().statistics)
-        std::cout << "Machine code size: " << wasm_module->GetCompiledModule().Serialize().size << std::endl;
+    return wasm->Get(Ctx, mkstr(isolate, "Module")).ToLocalChecked().As<v8::Object>()
+               ->CallAsConstructor(Ctx, 1, module_args).ToLocalChecked().As<v8::WasmModuleObject>();
+}
 
+v8::Local<v8::WasmModuleObject> m::wasm::detail::instantiate(v8::Isolate &isolate,
+                                                             v8::Local<v8::WasmModuleObject> wasm_module,
+                                                             v8::Local<v8::Object> imports)
+{
+    auto Ctx = isolate.GetCurrentContext();
+    auto wasm = Ctx->Global()->Get(Ctx, mkstr(isolate, "WebAssembly")).ToLocalChecked().As<v8::Object>(); // WebAssembly class
     args_t instance_args { wasm_module, imports };
     return wasm->Get(Ctx, mkstr(isolate, "Instance")).ToLocalChecked().As<v8::Object>()
                ->CallAsConstructor(Ctx, 2, instance_args).ToLocalChecked().As<v8::WasmModuleObject>();
@@ -1095,13 +2203,28 @@ v8::Local<v8::Object> m::wasm::detail::create_env(v8::Isolate &isolate, const m:
         Module::Get().emit_import<uint32_t>(oss.str().c_str());
     }
 
-    /* Map all string literals into the Wasm module. */
+    /* Map all string literals and the dictionaries of all dictionary encoded leaves of accessed tables into the Wasm
+     * module.  Both are copied into a single region that is followed by a guard page, s.t. morsel workers can replicate
+     * the region at once, see `prepare_morsel_worker()`. */
     M_insist(Is_Page_Aligned(context.heap));
     auto literals = CollectStringLiterals::Collect(plan.get_matched_root());
+    std::vector<const storage::DataLayout::encoding_t*> dictionaries;
+    for (auto &table : tables) {
+        table.get().layout().for_sibling_leaves([&](const std::vector<storage::DataLayout::leaf_info_t> &leaves,
+                                                    const storage::DataLayout::level_info_stack_t&, uint64_t)
+        {
+            for (auto &leaf_info : leaves) {
+                if (leaf_info.leaf.encoding().kind == storage::DataLayout::encoding_t::E_Dictionary)
+                    dictionaries.push_back(&leaf_info.leaf.encoding());
+            }
+        });
+    }
     std::size_t bytes = 0;
     for (auto literal : literals)
         bytes += strlen(literal) + 1;
-    auto aligned_bytes = Ceil_To_Next_Page(bytes);
+    for (auto dictionary : dictionaries)
+        bytes += dictionary->dictionary->size();
+    const auto aligned_bytes = Ceil_To_Next_Page(bytes);
     if (aligned_bytes) {
         auto base_addr = context.vm.as<uint8_t*>() + context.heap;
         M_DISCARD mmap(base_addr, aligned_bytes, PROT_READ|PROT_WRITE, MAP_FIXED|MAP_ANON|MAP_PRIVATE, -1, 0);
@@ -1111,13 +2234,77 @@ v8::Local<v8::Object> m::wasm::detail::create_env(v8::Isolate &isolate, const m:
             CodeGenContext::Get().add_literal(literal, context.heap + (dst - start_addr)); // add literal
             dst = stpcpy(dst, literal) + 1; // copy into sequential memory
         }
+        for (auto dictionary : dictionaries) {
+            CodeGenContext::Get().add_dictionary(dictionary->dictionary->data(), context.heap + (dst - start_addr));
+            dst = std::copy(dictionary->dictionary->begin(), dictionary->dictionary->end(), dst); // copy dictionary
+        }
         context.heap += aligned_bytes;
         context.install_guard_page();
     }
     M_insist(Is_Page_Aligned(context.heap));
 
+    /* Hoist the numeric and temporal constants into imported globals, s.t. the code does not depend on their values. */
+    add_constants_to_env(isolate, env, collect_hoisted_constants(plan.get_matched_root()), true);
+
+    /* Map the memory of all indexes accessed by index scans and index nested-loops joins that expose their memory into
+     * the Wasm module, s.t. the generated code can traverse the indexes directly.  The memory is mapped without
+     * copying. */
+    auto map_index = [&](const idx::IndexBase &index) {
+        if (CodeGenContext::Get().has_index(index))
+            return;
+        M_insist(index.exposed_memory(), "index must expose its memory");
+        const auto off = context.map_memory(*index.exposed_memory(), index.exposed_memory_size());
+        CodeGenContext::Get().add_index(index, off);
+    };
+    visit(overloaded {
+        [&](const Match<m::wasm::IndexScan<idx::IndexMethod::BPlusTree>> &M) {
+            auto &DB = Catalog::Get().get_database_in_use();
+            const Schema designators = M.filter.filter().get_required();
+            M_insist(designators.num_entries() == 1, "filter condition must contain exactly one designator");
+            map_index(DB.get_index(M.scan.store().table().name(), designators[0].id.name,
+                                   idx::IndexMethod::BPlusTree));
+        },
+        [&](const Match<m::wasm::IndexNestedLoopsJoin> &M) {
+            auto &DB = Catalog::Get().get_database_in_use();
+            const Schema designators = M.join.predicate().get_required() & M.scan.schema();
+            M_insist(designators.num_entries() == 1, "join predicate must contain exactly one key of the scan");
+            map_index(DB.get_index(M.scan.store().table().name(), designators[0].id.name, idx::IndexMethod::Hash));
+        },
+        [](auto&&) { },
+    }, as<const m::wasm::MatchBase>(plan), tag<m::wasm::ConstPreOrderMatchBaseVisitor>());
+
+    /* Consult the zone maps of the tables scanned directly below a filter to find the zones to skip.  The zones are
+     * found in the same order on every execution, s.t. the IDs of the skippable zones used by a cached plan remain
+     * valid. */
+    auto find_skippable_zones = [&](const Operator &op, auto &find_skippable_zones_ref) -> void {
+        if (auto scan = cast<const ScanOperator>(&op)) {
+            if (auto filter = cast<const FilterOperator>(scan->parent())) {
+                auto &table = scan->store().table();
+                auto skippable = scan->store().zone_map().skippable_zones(filter->filter(), table.schema(scan->alias()));
+                Catalog::Get().timer().increment("Zones skipped by zone maps",
+                                                 std::count(skippable.begin(), skippable.end(), true));
+                context.skippable_zones.emplace_back(scan, std::move(skippable));
+            }
+        } else if (auto consumer = cast<const Consumer>(&op)) {
+            for (auto child : consumer->children())
+                find_skippable_zones_ref(*child, find_skippable_zones_ref);
+        }
+    };
+    find_skippable_zones(plan.get_matched_root(), find_skippable_zones);
+
     /* Add functions to environment. */
     Module::Get().emit_function_import<void(void*,uint32_t)>("read_result_set");
+    if (CodeGenContext::Get().morsel_size())
+        Module::Get().emit_function_import<uint32_t(void)>("next_morsel");
+    if (not context.skippable_zones.empty())
+        Module::Get().emit_function_import<uint32_t(uint32_t,uint32_t)>("skip_zone");
+    if (CodeGenContext::Get().num_threads() > 1) {
+        Module::Get().emit_function_import<void(void*,void*,uint32_t,uint32_t)>("grouping_publish_partitions");
+        Module::Get().emit_function_import<uint32_t(void)>("grouping_next_partition");
+        Module::Get().emit_function_import<uint32_t(uint32_t)>("grouping_partition_size");
+        Module::Get().emit_function_import<void(uint32_t,void*)>("grouping_fetch_partition");
+        Module::Get().emit_function_import<void(void)>("grouping_finish");
+    }
 
 #define EMIT_FUNC_IMPORTS(KEYTYPE, IDXNAME, SUFFIX) \
     Module::Get().emit_function_import<uint32_t(std::size_t,KEYTYPE)>(M_STR(idx_lower_bound_##IDXNAME##_##SUFFIX)); \
@@ -1140,6 +2327,15 @@ v8::Local<v8::Object> m::wasm::detail::create_env(v8::Isolate &isolate, const m:
     EMIT_FUNC_IMPORTS(double,      rmi, d);
 #undef EMIT_FUNC_IMPORTS
 
+    add_functions_to_env(isolate, env);
+
+    return env;
+}
+
+void m::wasm::detail::add_functions_to_env(v8::Isolate &isolate, v8::Local<v8::Object> env)
+{
+    auto Ctx = isolate.GetCurrentContext();
+
 #define ADD_FUNC(FUNC, NAME) { \
     auto func = v8::Function::New(Ctx, (FUNC)).ToLocalChecked(); \
     env->Set(Ctx, mkstr(isolate, NAME), func).Check(); \
@@ -1149,6 +2345,13 @@ v8::Local<v8::Object> m::wasm::detail::create_env(v8::Isolate &isolate, const m:
     ADD_FUNC_(print)
     ADD_FUNC_(print_memory_consumption)
     ADD_FUNC_(read_result_set)
+    ADD_FUNC_(next_morsel)
+    ADD_FUNC_(skip_zone)
+    ADD_FUNC_(grouping_publish_partitions)
+    ADD_FUNC_(grouping_next_partition)
+    ADD_FUNC_(grouping_partition_size)
+    ADD_FUNC_(grouping_fetch_partition)
+    ADD_FUNC_(grouping_finish)
     ADD_FUNC(_throw, "throw")
 
 #define ADD_FUNCS(IDXTYPE, KEYTYPE, V8TYPE, IDXNAME, SUFFIX) \
@@ -1173,8 +2376,6 @@ v8::Local<v8::Object> m::wasm::detail::create_env(v8::Isolate &isolate, const m:
 #undef ADD_FUNCS
 #undef ADD_FUNC_
 #undef ADD_FUNC
-
-    return env;
 }
 
 v8::Local<v8::String> m::wasm::detail::to_json(v8::Isolate &isolate, v8::Local<v8::Value> val)
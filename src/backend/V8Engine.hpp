@@ -82,6 +82,13 @@ void _throw(const v8::FunctionCallbackInfo<v8::Value> &info);
 void print(const v8::FunctionCallbackInfo<v8::Value> &info);
 void print_memory_consumption(const v8::FunctionCallbackInfo<v8::Value> &info);
 void set_wasm_instance_raw_memory(const v8::FunctionCallbackInfo<v8::Value> &info);
+void next_morsel(const v8::FunctionCallbackInfo<v8::Value> &info);
+void skip_zone(const v8::FunctionCallbackInfo<v8::Value> &info);
+void grouping_publish_partitions(const v8::FunctionCallbackInfo<v8::Value> &info);
+void grouping_next_partition(const v8::FunctionCallbackInfo<v8::Value> &info);
+void grouping_partition_size(const v8::FunctionCallbackInfo<v8::Value> &info);
+void grouping_fetch_partition(const v8::FunctionCallbackInfo<v8::Value> &info);
+void grouping_finish(const v8::FunctionCallbackInfo<v8::Value> &info);
 void read_result_set(const v8::FunctionCallbackInfo<v8::Value> &info);
 template<typename Index, typename V8ValueT, bool IsLower>
 void index_seek(const v8::FunctionCallbackInfo<v8::Value> &info);
@@ -89,8 +96,13 @@ template<typename Index>
 void index_sequential_scan(const v8::FunctionCallbackInfo<v8::Value> &info);
 
 v8::Local<v8::String> mkstr(v8::Isolate &isolate, const std::string &str);
-v8::Local<v8::WasmModuleObject> instantiate(v8::Isolate &isolate, v8::Local<v8::Object> imports);
+v8::Local<v8::WasmModuleObject> compile_wasm_module(v8::Isolate &isolate);
+v8::Local<v8::WasmModuleObject> compile_wasm_module(v8::Isolate &isolate, uint8_t *binary_addr,
+                                                    std::size_t binary_size);
+v8::Local<v8::WasmModuleObject> instantiate(v8::Isolate &isolate, v8::Local<v8::WasmModuleObject> wasm_module,
+                                            v8::Local<v8::Object> imports);
 v8::Local<v8::Object> create_env(v8::Isolate &isolate, const m::MatchBase &plan);
+void add_functions_to_env(v8::Isolate &isolate, v8::Local<v8::Object> env);
 v8::Local<v8::String> to_json(v8::Isolate &isolate, v8::Local<v8::Value> val);
 std::string create_js_debug_script(v8::Isolate &isolate, v8::Local<v8::Object> env,
                                    const WasmEngine::WasmContext &wasm_context);
@@ -248,6 +248,103 @@ template void m::wasm::quicksort<false>(GlobalBuffer&, const std::vector<Sorting
 template void m::wasm::quicksort<true>(GlobalBuffer&, const std::vector<SortingOperator::order_type>&);
 
 
+/*======================================================================================================================
+ * partitioning
+ *====================================================================================================================*/
+
+template<bool IsGlobal>
+Var<Ptr<U32x1>> m::wasm::radix_partition(Buffer<IsGlobal> &buffer, const std::vector<Schema::Identifier> &keys,
+                                         const std::vector<const Type*> &key_types, uint32_t num_radix_bits,
+                                         uint32_t radix_shift)
+{
+    static_assert(IsGlobal, "radix partitioning of local buffers is not yet supported");
+    M_insist(not keys.empty(), "cannot partition on an empty sequence of keys");
+    M_insist(keys.size() == key_types.size(), "number of keys and key types differ");
+    M_insist(num_radix_bits < 32 and radix_shift + num_radix_bits <= 64, "radix bits exceed the hash value");
+
+    const uint32_t num_partitions = 1U << num_radix_bits;
+
+    /*----- Create load and swap proxies for buffer.  Only the keys have to be loaded to compute partitions. -----*/
+    Schema key_schema;
+    for (auto &key : keys) {
+        if (not key_schema.has(key))
+            key_schema.add(buffer.schema()[key].second);
+    }
+    auto load = buffer.create_load_proxy(key_schema);
+    auto swap = buffer.create_swap_proxy();
+
+    /*----- Create function to compute the partition of the tuple with the given ID. -----*/
+    auto partition_of = [&](U32x1 tuple_id) -> U32x1 {
+        auto S = CodeGenContext::Get().scoped_environment(); // create scoped environment for the loaded keys
+        load(tuple_id);
+        auto &env = CodeGenContext::Get().env();
+        std::vector<std::pair<const Type*, SQL_t>> values;
+        values.reserve(keys.size());
+        for (std::size_t i = 0; i != keys.size(); ++i)
+            values.emplace_back(key_types[i], env.get(keys[i]));
+        U64x1 hash = murmur3_64a_hash(std::move(values));
+        return (hash >> uint64_t(radix_shift)).to<uint32_t>() bitand (num_partitions - 1U);
+    };
+
+    auto offsets = Module::Allocator().malloc<uint32_t>(num_partitions + 1U);
+    auto heads = Module::Allocator().malloc<uint32_t>(num_partitions); // write head of each partition
+    Var<U32x1> partition;
+
+    /*----- Compute histogram of the partition sizes. -----*/
+    partition = 0U;
+    WHILE (partition < num_partitions) {
+        *(heads + partition.make_signed()) = 0U;
+        partition += 1U;
+    }
+    Var<U32x1> tuple_id(0U);
+    WHILE (tuple_id < buffer.size()) {
+        *(heads + partition_of(tuple_id).make_signed()) += 1U;
+        tuple_id += 1U;
+    }
+
+    /*----- Compute prefix sums, i.e. the partition boundaries, and initialize the write heads to them. -----*/
+    Var<U32x1> sum(0U);
+    partition = 0U;
+    WHILE (partition < num_partitions) {
+        const Var<U32x1> count(U32x1(*(heads + partition.make_signed())));
+        *(offsets + partition.make_signed()) = sum.val();
+        *(heads + partition.make_signed()) = sum.val();
+        sum += count;
+        partition += 1U;
+    }
+    *(offsets + int32_t(num_partitions)) = sum.val();
+    Wasm_insist(sum == buffer.size(), "partition sizes must sum up to the buffer size");
+
+    /*----- Permute tuples in-place by swapping each misplaced tuple to the write head of its partition. -----*/
+    partition = 0U;
+    WHILE (partition < num_partitions) {
+        const Var<U32x1> end(U32x1(*(offsets + (partition + 1U).make_signed())));
+        Var<U32x1> head(U32x1(*(heads + partition.make_signed())));
+        WHILE (head < end) {
+            const Var<U32x1> target(partition_of(head));
+            IF (target == partition) {
+                head += 1U; // tuple already resides in its partition
+            } ELSE {
+                const Var<Ptr<U32x1>> target_head(heads + target.make_signed());
+                Wasm_insist(U32x1(*target_head) < U32x1(*(offsets + (target + 1U).make_signed())),
+                            "target partition overflow");
+                swap(head, U32x1(*target_head));
+                *target_head += 1U;
+            };
+        }
+        partition += 1U;
+    }
+
+    Module::Allocator().deallocate(heads.val().to<void*>(), num_partitions * uint32_t(sizeof(uint32_t)));
+
+    return offsets;
+}
+
+// explicit instantiations to prevent linker errors
+template Var<Ptr<U32x1>> m::wasm::radix_partition(GlobalBuffer&, const std::vector<Schema::Identifier>&,
+                                                  const std::vector<const Type*>&, uint32_t, uint32_t);
+
+
 /*======================================================================================================================
  * hashing
  *====================================================================================================================*/
@@ -687,6 +784,7 @@ void ChainedHashTable<IsGlobal>::clear()
         *(it + ptr_offset_in_bytes_).template to<uint32_t*>() = 0U; // set to nullptr
         it += int32_t(sizeof(uint32_t));
     }
+    *num_entries_ = 0U; // reset number of occupied entries s.t. hash table is not grown unnecessarily
 }
 
 template<bool IsGlobal>
@@ -28,6 +28,21 @@ template<bool CmpPredicated, bool IsGlobal>
 void quicksort(Buffer<IsGlobal> &buffer, const std::vector<SortingOperator::order_type> &order);
 
 
+/*======================================================================================================================
+ * partitioning
+ *====================================================================================================================*/
+
+/** Radix-partitions the buffer \p buffer in-place into `1 << num_radix_bits` consecutive partitions.  The partition of
+ * a tuple is given by the bits [`radix_shift`, `radix_shift + num_radix_bits`[ of the Murmur3-64a hash of its keys
+ * \p keys, where \p key_types contains the types used for hashing the respective keys.  Returns a pointer to freshly
+ * allocated memory containing the `(1 << num_radix_bits) + 1` partition boundaries, i.e. the tuples of partition `p`
+ * are located at IDs [`offsets[p]`, `offsets[p + 1]`[.  The caller is responsible to deallocate this memory. */
+template<bool IsGlobal>
+Var<Ptr<U32x1>> radix_partition(Buffer<IsGlobal> &buffer, const std::vector<Schema::Identifier> &keys,
+                                const std::vector<const Type*> &key_types, uint32_t num_radix_bits,
+                                uint32_t radix_shift);
+
+
 /*======================================================================================================================
  * hashing
  *====================================================================================================================*/
@@ -941,6 +956,12 @@ struct OpenAddressingHashTable : OpenAddressingHashTableBase
      * access method, i.e. clearing, insertion, lookup, or dummy entry creation. */
     void teardown() override;
 
+    void clear() override {
+        M_insist(bool(num_entries_), "must call `setup()` before");
+        OpenAddressingHashTableBase::clear();
+        *num_entries_ = 0U; // reset number of occupied entries s.t. hash table is not grown unnecessarily
+    }
+
     private:
     void update_high_watermark() override {
         M_insist(bool(high_watermark_absolute_), "must call `setup()` before");
@@ -1039,6 +1060,8 @@ struct QuadraticProbing : OpenAddressingHashTableBase::ProbingStrategy
 
 extern template void quicksort<false>(GlobalBuffer&, const std::vector<SortingOperator::order_type>&);
 extern template void quicksort<true>(GlobalBuffer&, const std::vector<SortingOperator::order_type>&);
+extern template Var<Ptr<U32x1>> radix_partition(GlobalBuffer&, const std::vector<Schema::Identifier>&,
+                                                const std::vector<const Type*>&, uint32_t, uint32_t);
 extern template struct m::wasm::ChainedHashTable<false>;
 extern template struct m::wasm::ChainedHashTable<true>;
 extern template struct m::wasm::OpenAddressingHashTable<false, false>;
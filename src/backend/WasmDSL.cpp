@@ -298,6 +298,7 @@ struct LinearAllocator : Allocator
     }
 
     uint32_t pre_allocated_memory_consumption() const override { return pre_alloc_total_mem_; }
+    uint32_t pre_allocated_memory_end() const override { return pre_alloc_addr_; }
     U32x1 allocated_memory_consumption() const override { return alloc_total_mem_; }
     U32x1 allocated_memory_peak() const override { return alloc_peak_mem_; }
 
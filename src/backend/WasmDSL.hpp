@@ -907,6 +907,8 @@ struct Module final
     const std::tuple<const char*, unsigned, const char*> & get_message(std::size_t idx) const {
         return messages_.at(idx);
     }
+    /** Returns the messages of all emitted runtime checks and exceptions, indexed by their message index. */
+    const std::vector<std::tuple<const char*, unsigned, const char*>> & messages() const { return messages_; }
 
     /*----- Garbage collected data -----------------------------------------------------------------------------------*/
     /** Adds and returns an instance of \tparam C, which will be created by calling its c`tor with an
@@ -6500,6 +6502,9 @@ struct Allocator
 
     /** Returns the pre-allocated memory overall consumption. */
     virtual uint32_t pre_allocated_memory_consumption() const = 0;
+    /** Returns the address one past the last pre-allocated byte, i.e. the pre-allocations reside in the address range
+     * up to this address. */
+    virtual uint32_t pre_allocated_memory_end() const = 0;
     /** Returns the allocated memory overall consumption. */
     virtual U32x1 allocated_memory_consumption() const = 0;
     /** Returns the allocated memory peak consumption. */
@@ -5,6 +5,7 @@
 #include "backend/WasmMacro.hpp"
 #include <mutable/catalog/Catalog.hpp>
 #include <mutable/parse/AST.hpp>
+#include <mutable/storage/Versioning.hpp>
 #include <mutable/util/fn.hpp>
 #include <numeric>
 
@@ -85,7 +86,7 @@ static void add_wasm_operator_args()
         /* short=       */ nullptr,
         /* long=        */ "--join-implementations",
         /* description= */ "a comma seperated list of physical join implementations to consider (`NestedLoops`, "
-                           "`SimpleHash`, or `SortMerge`)",
+                           "`SimpleHash`, `SortMerge`, `RadixHash`, or `IndexNestedLoops`)",
         /* callback=    */ [](std::vector<std::string_view> impls){
             options::join_implementations = option_configs::JoinImplementation(0UL);
             for (const auto &elem : impls) {
@@ -95,6 +96,10 @@ static void add_wasm_operator_args()
                     options::join_implementations |= option_configs::JoinImplementation::SIMPLE_HASH;
                 else if (strneq(elem.data(), "SortMerge", elem.size()))
                     options::join_implementations |= option_configs::JoinImplementation::SORT_MERGE;
+                else if (strneq(elem.data(), "RadixHash", elem.size()))
+                    options::join_implementations |= option_configs::JoinImplementation::RADIX_HASH;
+                else if (strneq(elem.data(), "IndexNestedLoops", elem.size()))
+                    options::join_implementations |= option_configs::JoinImplementation::INDEX_NESTED_LOOPS;
                 else
                     std::cerr << "warning: ignore invalid physical join implementation " << elem << std::endl;
             }
@@ -104,8 +109,8 @@ static void add_wasm_operator_args()
         /* group=       */ "Wasm",
         /* short=       */ nullptr,
         /* long=        */ "--index-implementations",
-        /* description= */ "a comma separated list of index implementations to consider for index scans (`Array`, or"
-                           " `Rmi`)",
+        /* description= */ "a comma separated list of index implementations to consider for index scans (`Array`,"
+                           " `Rmi`, or `BPlusTree`)",
         /* callback=    */ [](std::vector<std::string_view> impls){
             options::index_implementations = option_configs::IndexImplementation(0UL);
             for (const auto &elem : impls) {
@@ -113,6 +118,8 @@ static void add_wasm_operator_args()
                     options::index_implementations |= option_configs::IndexImplementation::ARRAY;
                 else if (strneq(elem.data(), "Rmi", elem.size()))
                     options::index_implementations |= option_configs::IndexImplementation::RMI;
+                else if (strneq(elem.data(), "BPlusTree", elem.size()))
+                    options::index_implementations |= option_configs::IndexImplementation::BPLUS_TREE;
                 else
                     std::cerr << "warning: ignore invalid index implementation " << elem << std::endl;
             }
@@ -324,6 +331,59 @@ static void add_wasm_operator_args()
             options::hash_table_initial_capacity = initial_capacity;
         }
     );
+    C.arg_parser().add<std::size_t>(
+        /* group=       */ "Wasm",
+        /* short=       */ nullptr,
+        /* long=        */ "--radix-hash-join-partition-size",
+        /* description= */ "specify the size in bytes a single partition of radix hash joins should fit in",
+        /* callback=    */ [](std::size_t partition_size){
+            if (partition_size == 0)
+                std::cerr << "warning: ignore invalid radix hash join partition size " << partition_size << std::endl;
+            else
+                options::radix_hash_join_partition_size = partition_size;
+        }
+    );
+    C.arg_parser().add<std::size_t>(
+        /* group=       */ "Wasm",
+        /* short=       */ nullptr,
+        /* long=        */ "--radix-hash-join-radix-bits",
+        /* description= */ "specify the number of radix bits, i.e. the binary logarithm of the number of partitions, "
+                           "for radix hash joins (must be in [0,16]); otherwise, it is derived from the estimated size "
+                           "of the build input",
+        /* callback=    */ [](std::size_t radix_bits){
+            if (radix_bits > 16)
+                std::cerr << "warning: ignore invalid number of radix bits " << radix_bits << std::endl;
+            else
+                options::radix_hash_join_radix_bits = radix_bits;
+        }
+    );
+    C.arg_parser().add<std::size_t>(
+        /* group=       */ "Wasm",
+        /* short=       */ nullptr,
+        /* long=        */ "--parallel-grouping-preaggregation-capacity",
+        /* description= */ "specify the number of groups a thread-local pre-aggregation table of a hash-based grouping "
+                           "may hold before it is spilled, if the grouping is executed by multiple threads",
+        /* callback=    */ [](std::size_t capacity){
+            if (capacity == 0 or capacity > std::numeric_limits<uint32_t>::max() / 2)
+                std::cerr << "warning: ignore invalid pre-aggregation capacity " << capacity << std::endl;
+            else
+                options::parallel_grouping_preaggregation_capacity = capacity;
+        }
+    );
+    C.arg_parser().add<std::size_t>(
+        /* group=       */ "Wasm",
+        /* short=       */ nullptr,
+        /* long=        */ "--parallel-grouping-radix-bits",
+        /* description= */ "specify the number of radix bits, i.e. the binary logarithm of the number of partitions, "
+                           "for hash-based groupings executed by multiple threads (must be in [0,16]); otherwise, it is "
+                           "derived from the number of threads",
+        /* callback=    */ [](std::size_t radix_bits){
+            if (radix_bits > 16)
+                std::cerr << "warning: ignore invalid number of radix bits " << radix_bits << std::endl;
+            else
+                options::parallel_grouping_radix_bits = radix_bits;
+        }
+    );
     C.arg_parser().add<bool>(
         /* group=       */ "Wasm",
         /* short=       */ nullptr,
@@ -468,6 +528,14 @@ static void add_wasm_operator_args()
         /* description= */ "set the window size in tuples for the result set (0 means infinite)",
         /* callback=    */ [](std::size_t size){ options::result_set_window_size = size; }
     );
+    C.arg_parser().add<std::size_t>(
+        /* group=       */ "Wasm",
+        /* short=       */ nullptr,
+        /* long=        */ "--streaming-result-set-window-size",
+        /* description= */ "set the window size in tuples for result sets streamed to batch callbacks if "
+                           "--result-set-window-size is 0 (0 means infinite)",
+        /* callback=    */ [](std::size_t size){ options::streaming_result_set_window_size = size; }
+    );
     C.arg_parser().add<bool>(
         /* group=       */ "Wasm",
         /* short=       */ nullptr,
@@ -556,6 +624,8 @@ void m::register_wasm_operators(PhysicalOptimizer &phys_opt)
             phys_opt.register_operator<IndexScan<idx::IndexMethod::Array>>();
         if (bool(options::index_implementations bitand option_configs::IndexImplementation::RMI))
             phys_opt.register_operator<IndexScan<idx::IndexMethod::Rmi>>();
+        if (bool(options::index_implementations bitand option_configs::IndexImplementation::BPLUS_TREE))
+            phys_opt.register_operator<IndexScan<idx::IndexMethod::BPlusTree>>();
     }
     if (bool(options::filter_selection_strategy bitand option_configs::SelectionStrategy::BRANCHING))
         phys_opt.register_operator<Filter<false>>();
@@ -594,6 +664,13 @@ void m::register_wasm_operators(PhysicalOptimizer &phys_opt)
                 phys_opt.register_operator<SimpleHashJoin<true,  true>>();
         }
     }
+    if (bool(options::join_implementations bitand option_configs::JoinImplementation::RADIX_HASH)) {
+        phys_opt.register_operator<RadixHashJoin<false>>();
+        if (options::exploit_unique_build)
+            phys_opt.register_operator<RadixHashJoin<true>>();
+    }
+    if (bool(options::join_implementations bitand option_configs::JoinImplementation::INDEX_NESTED_LOOPS))
+        phys_opt.register_operator<IndexNestedLoopsJoin>();
     if (bool(options::join_implementations bitand option_configs::JoinImplementation::SORT_MERGE)) {
         if (bool(options::sort_merge_join_selection_strategy bitand option_configs::SelectionStrategy::BRANCHING)) {
             if (bool(options::sort_merge_join_cmp_selection_strategy bitand option_configs::SelectionStrategy::BRANCHING)) {
@@ -967,6 +1044,14 @@ U32x1 get_num_rows(const ThreadSafePooledString &table_name) {
     return Module::Get().get_global<uint32_t>(oss.str().c_str());
 }
 
+/** Returns `true` iff the zone containing the tuple with ID \p tuple_id can be skipped by the scan whose skippable zones
+ * have ID \p id, see `WasmEngine::WasmContext::skippable_zones`. */
+Boolx1 skip_zone(std::size_t id, U32x1 tuple_id) {
+    M_insist(std::in_range<uint32_t>(id), "ID must fit in uint32_t");
+    return Module::Get().emit_call<uint32_t>("skip_zone", U32x1(uint32_t(id)),
+                                             tuple_id / uint32_t(ZoneMap::ZONE_SIZE)).to<bool>();
+}
+
 /** Returns a pointer to the beginning of table \p table_name in the WebAssembly linear memory. */
 Ptr<void> get_base_address(const ThreadSafePooledString &table_name) {
     static std::ostringstream oss;
@@ -992,6 +1077,41 @@ uint32_t compute_initial_ht_capacity(const Operator &op, double load_factor) {
     return std::in_range<uint32_t>(initial_capacity) ? initial_capacity : std::numeric_limits<uint32_t>::max();
 }
 
+/** Returns `true` iff \p op is a `ScanOperator` whose rows can be read directly from the scanned table, i.e. which does
+ * not scan a snapshot and thereby skip invisible versions of rows. */
+bool is_plain_scan(const Operator &op) {
+    auto scan = cast<const ScanOperator>(&op);
+    return scan and not scan->has_snapshot();
+}
+
+/** Returns the estimated size in bytes of the materialized result of \p op, i.e. its estimated cardinality times the
+ * size of a single tuple of its schema (ignoring padding and constants). */
+double estimate_materialized_size_in_bytes(const Operator &op) {
+    uint64_t tuple_size_in_bits = 0;
+    for (auto &e : op.schema().drop_constants().deduplicate())
+        tuple_size_in_bits += e.type->size();
+    double num_tuples;
+    if (op.has_info())
+        num_tuples = op.info().estimated_cardinality;
+    else if (auto scan = cast<const ScanOperator>(&op))
+        num_tuples = scan->store().num_rows();
+    else
+        num_tuples = 1024; // fallback
+    return num_tuples * std::ceil(tuple_size_in_bits / 8.0);
+}
+
+/** Returns the number of radix bits s.t. each partition of the build input \p build of a `RadixHashJoin` is expected
+ * to fit into `options::radix_hash_join_partition_size` bytes. */
+uint32_t compute_num_radix_bits(const Operator &build) {
+    if (options::radix_hash_join_radix_bits)
+        return *options::radix_hash_join_radix_bits;
+    const double num_partitions =
+        estimate_materialized_size_in_bytes(build) / options::radix_hash_join_partition_size;
+    if (num_partitions <= 1.0)
+        return 0;
+    return std::min<uint32_t>(uint32_t(std::ceil(std::log2(num_partitions))), 16);
+}
+
 ///> helper struct holding the bounds for index scan
 struct index_scan_bounds_t
 {
@@ -1220,6 +1340,10 @@ ConditionSet Scan<SIMDfied>::pre_condition(std::size_t child_idx,
         auto &scan = *std::get<0>(partial_inner_nodes);
         auto &table = scan.store().table();
 
+        /*----- SIMDfied scan does not support checking the visibility of versions of rows. -----*/
+        if (scan.has_snapshot())
+            return ConditionSet::Make_Unsatisfiable();
+
         /*----- SIMDfied scan needs the data layout to support SIMD. -----*/
         if (not supports_simd(table.layout(), table.schema(scan.alias()), scan.schema()))
             return ConditionSet::Make_Unsatisfiable();
@@ -1291,8 +1415,95 @@ void Scan<SIMDfied>::execute(const Match<Scan> &M, setup_t setup, pipeline_t pip
     /*----- Import the number of rows of `table`. -----*/
     U32x1 num_rows = get_num_rows(table.name());
 
+    /*----- If a filter is directly on top of the scan, skip the zones in which no row can satisfy the filter. -----*/
+    const auto skippable_zones_id =
+        WasmEngine::Get_Wasm_Context_By_ID(Module::ID()).find_skippable_zones(M.scan);
+
+    /*----- If a snapshot is scanned, additionally load the timestamps and execute the pipeline only for the versions
+     * of rows visible in the snapshot. -----*/
+    Schema load_schema = schema;
+    pipeline_t visible_pipeline = pipeline;
+    if (M.scan.has_snapshot()) {
+        const auto ts = get_timestamp_attributes(table);
+        M_insist(bool(ts), "only multi-versioned tables can be scanned in a snapshot");
+        const auto &ts_begin = layout_schema[ts->begin];
+        const auto &ts_end = layout_schema[ts->end];
+        if (not load_schema.has(ts_begin.id)) load_schema.add(ts_begin.id, ts_begin.type, ts_begin.constraints);
+        if (not load_schema.has(ts_end.id)) load_schema.add(ts_end.id, ts_end.type, ts_end.constraints);
+        visible_pipeline = [&pipeline, begin_id=ts_begin.id, end_id=ts_end.id, snapshot=M.scan.snapshot()]() {
+            auto &env = CodeGenContext::Get().env();
+            I64x1 begin = env.get<_I64x1>(begin_id).insist_not_null();
+            Var<I64x1> end(env.get<_I64x1>(end_id).insist_not_null());
+            IF (begin <= snapshot and (end == int64_t(-1) or end > snapshot)) {
+                pipeline();
+            };
+        };
+    }
+
+    /*----- If the query is executed morsel-driven, scan only the morsels handed out by the host. -----*/
+    if (const std::size_t morsel_size = CodeGenContext::Get().morsel_size()) {
+        M_insist(morsel_size % num_simd_lanes == 0, "morsel size must be a multiple of the number of SIMD lanes");
+        M_insist(morsel_size <= std::numeric_limits<uint32_t>::max(), "morsel size must fit in uint32_t");
+        Var<U32x1> table_size(num_rows);
+
+        /*----- Emit setup code *before* compiling data layout to not overwrite its temporary boolean variables. --*/
+        setup();
+
+        /*----- Compile data layout to generate sequential load from table, if any attributes must be loaded. -----*/
+        std::optional<std::tuple<Block, Block, Block>> load_blocks;
+        if (load_schema.num_entries() != 0) {
+            static Schema empty_schema;
+            load_blocks.emplace(compile_load_sequential(load_schema, empty_schema, get_base_address(table.name()),
+                                                        table.layout(), num_simd_lanes, layout_schema, tuple_id));
+        }
+
+        /*----- Generate the loop fetching morsels, with the loop over a single morsel emitted into its body. -----*/
+        Var<U32x1> morsel_end;
+        tuple_id = Module::Get().emit_call<uint32_t>("next_morsel");
+        WHILE (tuple_id < table_size) {
+            morsel_end = Select(table_size - tuple_id > uint32_t(morsel_size), tuple_id + uint32_t(morsel_size),
+                                table_size);
+            if (load_blocks and skippable_zones_id) {
+                auto &[inits, loads, jumps] = *load_blocks;
+                Var<U32x1> zone_end;
+                WHILE (tuple_id < morsel_end) {
+                    zone_end = (tuple_id / uint32_t(ZoneMap::ZONE_SIZE) + 1U) * uint32_t(ZoneMap::ZONE_SIZE);
+                    zone_end = Select(zone_end < morsel_end, zone_end, morsel_end);
+                    IF (skip_zone(*skippable_zones_id, tuple_id.val())) {
+                        tuple_id = zone_end; // skip the remainder of the zone within this morsel
+                    } ELSE {
+                        inits.attach_to_current(); // initialize pointers for the first tuple of this zone
+                        WHILE (tuple_id < zone_end) {
+                            loads.attach_to_current();
+                            visible_pipeline();
+                            jumps.attach_to_current();
+                        }
+                    };
+                }
+            } else if (load_blocks) {
+                auto &[inits, loads, jumps] = *load_blocks;
+                inits.attach_to_current(); // initialize pointers for the first tuple of this morsel
+                WHILE (tuple_id < morsel_end) {
+                    loads.attach_to_current();
+                    visible_pipeline();
+                    jumps.attach_to_current();
+                }
+            } else {
+                WHILE (tuple_id < morsel_end) {
+                    tuple_id += uint32_t(num_simd_lanes);
+                    pipeline();
+                }
+            }
+            tuple_id = Module::Get().emit_call<uint32_t>("next_morsel");
+        }
+
+        /*----- Emit teardown code. -----*/
+        teardown();
+        return;
+    }
+
     /*----- If no attributes must be loaded, generate a loop just executing the pipeline `num_rows`-times. -----*/
-    if (schema.num_entries() == 0) {
+    if (load_schema.num_entries() == 0) {
         setup();
         WHILE (tuple_id < num_rows) {
             tuple_id += uint32_t(num_simd_lanes);
@@ -1310,15 +1521,34 @@ void Scan<SIMDfied>::execute(const Match<Scan> &M, setup_t setup, pipeline_t pip
 
     /*----- Compile data layout to generate sequential load from table. -----*/
     static Schema empty_schema;
-    auto [inits, loads, jumps] = compile_load_sequential(schema, empty_schema, base_address, table.layout(),
+    auto [inits, loads, jumps] = compile_load_sequential(load_schema, empty_schema, base_address, table.layout(),
                                                          num_simd_lanes, layout_schema, tuple_id);
 
     /*----- Generate the loop for the actual scan, with the pipeline emitted into the loop body. -----*/
-    inits.attach_to_current();
-    WHILE (tuple_id < num_rows) {
-        loads.attach_to_current();
-        pipeline();
-        jumps.attach_to_current();
+    if (skippable_zones_id) {
+        /*----- Generate an outer loop over the zones, skipping the zones marked as skippable. -----*/
+        Var<U32x1> table_size(num_rows), zone_end;
+        WHILE (tuple_id < table_size) {
+            zone_end = Select(table_size - tuple_id > uint32_t(ZoneMap::ZONE_SIZE),
+                              tuple_id + uint32_t(ZoneMap::ZONE_SIZE), table_size);
+            IF (skip_zone(*skippable_zones_id, tuple_id.val())) {
+                tuple_id = zone_end; // skip entire zone
+            } ELSE {
+                inits.attach_to_current(); // initialize pointers for the first tuple of this zone
+                WHILE (tuple_id < zone_end) {
+                    loads.attach_to_current();
+                    visible_pipeline();
+                    jumps.attach_to_current();
+                }
+            };
+        }
+    } else {
+        inits.attach_to_current();
+        WHILE (tuple_id < num_rows) {
+            loads.attach_to_current();
+            visible_pipeline();
+            jumps.attach_to_current();
+        }
     }
 
     /*----- Emit teardown code. -----*/
@@ -1345,6 +1575,10 @@ ConditionSet IndexScan<IndexMethod>::pre_condition(std::size_t child_idx,
     auto &scan = *std::get<1>(partial_inner_nodes);
     auto &table = scan.store().table();
 
+    /*----- Indexes contain all versions of rows and hence cannot be used to scan a snapshot. -----*/
+    if (scan.has_snapshot())
+        return ConditionSet::Make_Unsatisfiable();
+
     Catalog &C = Catalog::Get();
     auto &DB = C.get_database_in_use();
 
@@ -1870,6 +2104,120 @@ void index_scan_codegen_hybrid(const Index &index, const index_scan_bounds_t &bo
     }
 }
 
+/** Emits code for an index scan on an index that exposes its memory, i.e. a `BPlusTreeIndex`.  The nodes of the index
+ * are mapped into the linear memory of the Wasm module by `create_env()`.  The generated code seeks the lower bound by
+ * descending from the root and walks the linked leaves up to the upper bound, without any calls to the host. */
+template<idx::IndexMethod IndexMethod, typename Index, sql_type SqlT>
+void index_scan_codegen_exposed_memory(const Index &index, const index_scan_bounds_t &bounds,
+                                       const Match<IndexScan<IndexMethod>> &M,
+                                       setup_t setup, pipeline_t pipeline, teardown_t teardown)
+{
+    using sql_type = SqlT;
+    using key_type = typename Index::key_type;
+    using key_t = PrimitiveExpr<key_type, 1>;
+
+    /*----- Add index to context.  The root and the height of the index are baked into the code, hence the code must
+     * not be reused. -----*/
+    auto &context = WasmEngine::Get_Wasm_Context_By_ID(Module::ID());
+    M_DISCARD context.add_index(index);
+
+    /*----- Define accessors to the nodes of the index. -----*/
+    const Var<Ptr<void>> nodes(CodeGenContext::Get().get_index_address(index));
+    /* Returns the address of the element at position `pos` of the array of elements of `size` bytes at byte offset
+     * `offset` within node `node`. */
+    auto element_address = [&](U32x1 node, U32x1 pos, std::size_t offset, std::size_t size) -> Ptr<void> {
+        return nodes + (std::move(node) * uint32_t(Index::NODE_SIZE) + std::move(pos) * uint32_t(size)).make_signed()
+                     + int32_t(offset);
+    };
+    using header_t = typename Index::header_t;
+    auto num_keys = [&](U32x1 node) -> U32x1 {
+        PrimitiveExpr<uint16_t, 1> n =
+            *element_address(std::move(node), U32x1(0U), offsetof(header_t, num_keys), 0).template to<uint16_t*>();
+        return n.template to<uint32_t>();
+    };
+    auto next = [&](U32x1 leaf) -> U32x1 {
+        return *element_address(std::move(leaf), U32x1(0U), offsetof(header_t, next), 0).template to<uint32_t*>();
+    };
+    auto key_at = [&](U32x1 node, U32x1 pos) -> key_t {
+        return *element_address(std::move(node), std::move(pos), Index::KEYS_OFFSET, sizeof(key_type))
+            .template to<key_type*>();
+    };
+    auto value_at = [&](U32x1 leaf, U32x1 pos) -> U32x1 {
+        return *element_address(std::move(leaf), std::move(pos), Index::VALUES_OFFSET, sizeof(uint32_t))
+            .template to<uint32_t*>();
+    };
+    auto child_at = [&](U32x1 node, U32x1 pos) -> U32x1 {
+        return *element_address(std::move(node), std::move(pos), Index::CHILDREN_OFFSET, sizeof(uint32_t))
+            .template to<uint32_t*>();
+    };
+    auto compile_bound = [&](const ast::Expr &bound) -> key_t {
+        auto key = CodeGenContext::Get().env().compile(bound);
+        return convert<sql_type>(key).insist_not_null();
+    };
+
+    /*----- Seek the first entry within the lower bound. -----*/
+    Var<U32x1> leaf(uint32_t(Index::FIRST_LEAF));
+    Var<U32x1> pos(0U);
+    if (bounds.lo) {
+        const Var<key_t> lo(compile_bound(bounds.lo->get()));
+        /* Sets `pos` to the position of the first key of `leaf` that is within the lower bound. */
+        auto find_in_node = [&]() {
+            pos = 0U;
+            WHILE (pos < num_keys(leaf) and
+                   (bounds.is_inclusive_lo ? key_at(leaf, pos) < lo : key_at(leaf, pos) <= lo))
+            {
+                pos += 1U;
+            }
+        };
+        leaf = uint32_t(index.root());
+        for (std::size_t level = 1; level != index.height(); ++level) {
+            find_in_node();
+            leaf = child_at(leaf, pos);
+        }
+        find_in_node();
+    }
+
+    /*----- Emit setup code. -----*/
+    setup();
+
+    /*----- Walk the leaves up to the upper bound. -----*/
+    std::optional<Var<key_t>> hi;
+    if (bounds.hi)
+        hi.emplace(compile_bound(bounds.hi->get()));
+    WHILE (leaf != 0U) {
+        IF (pos == num_keys(leaf)) { // leaf exhausted, continue with its right sibling
+            leaf = next(leaf);
+            pos = 0U;
+        } ELSE {
+            auto emit_entry = [&]() {
+                static Schema empty_schema;
+                compile_load_point_access(
+                    /* tuple_value_schema=   */ M.scan.schema(),
+                    /* tuple_address_schema= */ empty_schema,
+                    /* base_address=         */ get_base_address(M.scan.store().table().name()),
+                    /* layout=               */ M.scan.store().table().layout(),
+                    /* layout_schema=        */ M.scan.store().table().schema(M.scan.alias()),
+                    /* tuple_id=             */ value_at(leaf, pos)
+                );
+                pipeline();
+                pos += 1U;
+            };
+            if (hi) {
+                IF (bounds.is_inclusive_hi ? key_at(leaf, pos) <= *hi : key_at(leaf, pos) < *hi) {
+                    emit_entry();
+                } ELSE {
+                    leaf = 0U; // upper bound exceeded
+                };
+            } else {
+                emit_entry();
+            }
+        };
+    }
+
+    /*----- Emit teardown code. -----*/
+    teardown();
+}
+
 /** Resolves the index scan strategy and calls the appropriate codegen function. */
 template<idx::IndexMethod IndexMethod, typename Index, sql_type SqlT>
 void index_scan_resolve_strategy(const Index &index, const index_scan_bounds_t &bounds, const Match<IndexScan<IndexMethod>> &M, setup_t setup, pipeline_t pipeline, teardown_t teardown)
@@ -1908,6 +2256,12 @@ void index_scan_resolve_index_method(const index_scan_bounds_t &bounds, const Ma
         index_scan_resolve_strategy<IndexMethod, const idx::RecursiveModelIndex<AttrT>, SqlT>(
             index, bounds, M, std::move(setup), std::move(pipeline), std::move(teardown)
         );
+    } else if constexpr(IndexMethod == idx::IndexMethod::BPlusTree and requires { typename idx::BPlusTreeIndex<AttrT>; }) {
+        /* B+-trees are always traversed in generated code, regardless of the index scan strategy. */
+        auto &index = as<const idx::BPlusTreeIndex<AttrT>>(index_base);
+        index_scan_codegen_exposed_memory<IndexMethod, const idx::BPlusTreeIndex<AttrT>, SqlT>(
+            index, bounds, M, std::move(setup), std::move(pipeline), std::move(teardown)
+        );
     } else {
         M_unreachable("invalid index method");
     }
@@ -2325,40 +2679,94 @@ void HashBasedGrouping::execute(const Match<HashBasedGrouping> &M, setup_t setup
         aggregates_size_in_bits += info.entry.type->size();
     }
 
-    /*----- Compute initial capacity of hash table. -----*/
-    uint32_t initial_capacity = compute_initial_ht_capacity(M.grouping, M.load_factor);
+    /*----- If executed by multiple threads, each thread pre-aggregates into its own table of fixed capacity, which is
+     * spilled into a buffer whenever it is full.  Afterwards, the spilled groups of all threads are partitioned on
+     * the keys and each partition is merged by a single thread. -----*/
+    const std::size_t num_threads = CodeGenContext::Get().num_threads();
+    const bool is_parallel = num_threads > 1;
+    const uint32_t preaggregation_capacity = options::parallel_grouping_preaggregation_capacity;
+    M_insist(not is_parallel or num_keys != 0, "parallel grouping requires at least one key to partition on");
 
     /*----- Create hash table. -----*/
+    auto create_hash_table = [&](uint32_t initial_capacity) -> std::unique_ptr<HashTable> {
+        std::unique_ptr<HashTable> ht;
+        std::vector<HashTable::index_t> key_indices(num_keys);
+        std::iota(key_indices.begin(), key_indices.end(), 0);
+        if (M.use_open_addressing_hashing) {
+            if (aggregates_size_in_bits < AGGREGATES_SIZE_THRESHOLD_IN_BITS)
+                ht = std::make_unique<GlobalOpenAddressingInPlaceHashTable>(ht_schema, std::move(key_indices),
+                                                                            initial_capacity);
+            else
+                ht = std::make_unique<GlobalOpenAddressingOutOfPlaceHashTable>(ht_schema, std::move(key_indices),
+                                                                               initial_capacity);
+            if (M.use_quadratic_probing)
+                as<OpenAddressingHashTableBase>(*ht).set_probing_strategy<QuadraticProbing>();
+            else
+                as<OpenAddressingHashTableBase>(*ht).set_probing_strategy<LinearProbing>();
+        } else {
+            ht = std::make_unique<GlobalChainedHashTable>(ht_schema, std::move(key_indices), initial_capacity);
+        }
+        return ht;
+    };
     std::unique_ptr<HashTable> ht;
-    std::vector<HashTable::index_t> key_indices(num_keys);
-    std::iota(key_indices.begin(), key_indices.end(), 0);
-    if (M.use_open_addressing_hashing) {
-        if (aggregates_size_in_bits < AGGREGATES_SIZE_THRESHOLD_IN_BITS)
-            ht = std::make_unique<GlobalOpenAddressingInPlaceHashTable>(ht_schema, std::move(key_indices),
-                                                                        initial_capacity);
-        else
-            ht = std::make_unique<GlobalOpenAddressingOutOfPlaceHashTable>(ht_schema, std::move(key_indices),
-                                                                           initial_capacity);
-        if (M.use_quadratic_probing)
-            as<OpenAddressingHashTableBase>(*ht).set_probing_strategy<QuadraticProbing>();
-        else
-            as<OpenAddressingHashTableBase>(*ht).set_probing_strategy<LinearProbing>();
+    if (is_parallel) {
+        /* A pre-aggregation table must hold all its groups w/o growing.  Use an in-place open addressing table s.t.
+         * pre-aggregation never allocates memory, which would prevent the spill buffer from growing sequentially. */
+        const uint32_t initial_capacity =
+            uint32_t(std::ceil(preaggregation_capacity / options::load_factor_open_addressing)) + 1U;
+        std::vector<HashTable::index_t> key_indices(num_keys);
+        std::iota(key_indices.begin(), key_indices.end(), 0);
+        ht = std::make_unique<GlobalOpenAddressingInPlaceHashTable>(ht_schema, std::move(key_indices),
+                                                                    initial_capacity);
+        as<OpenAddressingHashTableBase>(*ht).set_probing_strategy<LinearProbing>();
     } else {
-        ht = std::make_unique<GlobalChainedHashTable>(ht_schema, std::move(key_indices), initial_capacity);
+        ht = create_hash_table(compute_initial_ht_capacity(M.grouping, M.load_factor));
     }
 
+    /*----- Create buffer for the groups spilled from the pre-aggregation table.  Rows are laid out consecutively s.t.
+     * the partitions of all threads can simply be concatenated. -----*/
+    const Schema spill_schema = ht_schema.deduplicate();
+    storage::RowLayoutFactory spill_factory;
+    std::optional<GlobalBuffer> spill_buffer;
+    if (is_parallel)
+        spill_buffer.emplace(spill_schema, spill_factory);
+
     /*----- Create child function. -----*/
     FUNCTION(hash_based_grouping_child_pipeline, void(void)) // create function for pipeline
     {
         auto S = CodeGenContext::Get().scoped_environment(); // create scoped environment for this function
 
         std::optional<HashTable::entry_t> dummy; ///< *local* dummy slot
+        std::optional<Var<U32x1>> num_groups; ///< number of groups in the pre-aggregation table
+
+        /*----- Spills all groups of the pre-aggregation table into the buffer and clears the table. -----*/
+        auto spill = [&](){
+            M_insist(bool(num_groups));
+            ht->for_each([&](HashTable::const_entry_t entry){
+                auto S = CodeGenContext::Get().scoped_environment(); // create scoped environment for the spilled group
+                auto &env = CodeGenContext::Get().env();
+                for (auto &e : spill_schema) {
+                    std::visit(overloaded {
+                        [&]<typename T>(HashTable::const_reference_t<Expr<T>> &&r) -> void { env.add(e.id, Expr<T>(r)); },
+                        [&](HashTable::const_reference_t<NChar> &&r) -> void { env.add(e.id, NChar(r)); },
+                        [](std::monostate&&) -> void { M_unreachable("invalid reference"); },
+                    }, entry.get(e.id));
+                }
+                spill_buffer->consume();
+            });
+            ht->clear();
+            *num_groups = 0U;
+        };
 
         M.child->execute(
             /* setup=    */ setup_t::Make_Without_Parent([&](){
                 ht->setup();
-                ht->set_high_watermark(M.load_factor);
+                ht->set_high_watermark(is_parallel ? options::load_factor_open_addressing : M.load_factor);
                 dummy.emplace(ht->dummy_entry()); // create dummy slot to ignore NULL values in aggregate computations
+                if (is_parallel) {
+                    spill_buffer->setup();
+                    num_groups.emplace(0U);
+                }
             }),
             /* pipeline= */ [&](){
                 M_insist(bool(dummy));
@@ -2641,21 +3049,38 @@ void HashBasedGrouping::execute(const Match<HashBasedGrouping> &M, setup_t setup
                 /*----- If group has been inserted, initialize aggregates. Otherwise, update them. -----*/
                 IF (inserted) {
                     init_aggs.attach_to_current();
+                    if (is_parallel)
+                        *num_groups += 1U;
                 } ELSE {
                     update_aggs.attach_to_current();
                     update_avg_aggs.attach_to_current(); // after others to ensure that running count is incremented before
                 };
+
+                /*----- Spill a full pre-aggregation table. -----*/
+                if (is_parallel) {
+                    IF (*num_groups == preaggregation_capacity) {
+                        spill();
+                    };
+                }
             },
-            /* teardown= */ teardown_t::Make_Without_Parent([&](){ ht->teardown(); })
+            /* teardown= */ teardown_t::Make_Without_Parent([&](){
+                if (is_parallel) {
+                    /* Spill remaining groups.  Set up the buffer anew since `consume()` is emitted a second time. */
+                    spill_buffer->teardown();
+                    spill_buffer->setup();
+                    spill();
+                    spill_buffer->teardown();
+                }
+                ht->teardown();
+            })
         );
     }
     hash_based_grouping_child_pipeline(); // call child function
 
     auto &env = CodeGenContext::Get().env();
 
-    /*----- Process each computed group. -----*/
-    setup_t(std::move(setup), [&](){ ht->setup(); })();
-    ht->for_each([&, pipeline=std::move(pipeline)](HashTable::const_entry_t entry){
+    /*----- Emits a computed group and resumes the pipeline. -----*/
+    auto emit_group = [&, pipeline=std::move(pipeline)](HashTable::const_entry_t entry){
         /*----- Compute key schema to detect duplicated keys. -----*/
         Schema key_schema;
         for (std::size_t i = 0; i < num_keys; ++i) {
@@ -2719,8 +3144,201 @@ void HashBasedGrouping::execute(const Match<HashBasedGrouping> &M, setup_t setup
 
         /*----- Resume pipeline. -----*/
         pipeline();
-    });
-    teardown_t(std::move(teardown), [&](){ ht->teardown(); })();
+    };
+
+    if (not is_parallel) {
+        /*----- Process each computed group. -----*/
+        setup_t(std::move(setup), [&](){ ht->setup(); })();
+        ht->for_each(std::move(emit_group));
+        teardown_t(std::move(teardown), [&](){ ht->teardown(); })();
+        return;
+    }
+
+    /*----- Radix-partition the spilled groups on the keys.  Use several partitions per thread to balance the merge
+     * phase.  The hash table uses the lower 32 bits of the hash, thus partition on the upper 32 bits. -----*/
+    std::vector<Schema::Identifier> key_ids;
+    std::vector<const Type*> key_types;
+    for (std::size_t i = 0; i < num_keys; ++i) {
+        key_ids.push_back(ht_schema[i].id);
+        key_types.push_back(ht_schema[i].type);
+    }
+    const uint32_t num_radix_bits = options::parallel_grouping_radix_bits.value_or(
+        std::min<uint32_t>(log2_ceil(8 * num_threads), 16)
+    );
+    const uint32_t num_partitions = 1U << num_radix_bits;
+    auto offsets = radix_partition(*spill_buffer, key_ids, key_types, num_radix_bits, /* radix_shift= */ 32);
+
+    /*----- Publish the partitions to the host and wait for all other threads to publish theirs. -----*/
+    M_insist(spill_buffer->layout().child().num_tuples() == 1, "spilled groups must be laid out row-wise");
+    M_insist(spill_buffer->layout().stride_in_bits() % 8 == 0, "spilled groups must be byte-aligned");
+    const uint32_t row_size = spill_buffer->layout().stride_in_bits() / 8;
+    Module::Get().emit_call<void>("grouping_publish_partitions", spill_buffer->base_address(),
+                                  offsets.val().to<void*>(), U32x1(row_size), U32x1(num_partitions));
+
+    /*----- Create hash table sized for a single partition.  It is cleared and reused for each merged partition. -----*/
+    auto merge_ht = create_hash_table(
+        std::max(compute_initial_ht_capacity(M.grouping, M.load_factor) >> num_radix_bits, 1U)
+    );
+
+    /*----- Merge the partitions claimed by this thread, i.e. the groups of all threads falling into it. -----*/
+    setup_t(std::move(setup), [&](){
+        merge_ht->setup();
+        merge_ht->set_high_watermark(M.load_factor);
+    })();
+    Var<U32x1> partition(Module::Get().emit_call<uint32_t>("grouping_next_partition"));
+    WHILE (partition < num_partitions) {
+        /*----- Copy the groups of the partition from all threads into local memory. -----*/
+        const Var<U32x1> num_rows(Module::Get().emit_call<uint32_t>("grouping_partition_size", partition.val()));
+        const Var<U32x1> num_bytes(num_rows * row_size);
+        auto rows = Module::Allocator().allocate(num_bytes, 8);
+        Module::Get().emit_call<void>("grouping_fetch_partition", partition.val(), rows.val());
+
+        merge_ht->clear();
+        Var<U32x1> row_id(0U);
+        WHILE (row_id < num_rows) {
+            auto S = CodeGenContext::Get().scoped_environment(); // create scoped environment for the loaded group
+            compile_load_point_access(spill_schema, Schema(), rows, spill_buffer->layout(), spill_schema, row_id);
+            auto &env = CodeGenContext::Get().env();
+
+            /*----- Insert key if not yet done. -----*/
+            std::vector<SQL_t> key;
+            for (auto &id : key_ids)
+                key.emplace_back(env.get(id));
+            auto p = merge_ht->try_emplace(std::move(key));
+            auto &entry = p.first;
+            auto &inserted = p.second;
+
+            /*----- Merge aggregates. -----*/
+            Block init_aggs("hash_based_grouping.merge.init_aggs", false),
+                  merge_aggs("hash_based_grouping.merge.merge_aggs", false),
+                  merge_avg_aggs("hash_based_grouping.merge.merge_avg_aggs", false);
+            for (auto &info : aggregates) {
+                const auto &id = info.entry.id;
+
+                BLOCK_OPEN(init_aggs) {
+                    std::visit(overloaded {
+                        [&]<sql_type T>(HashTable::reference_t<T> &&r) -> void { r = env.get<T>(id); },
+                        [](std::monostate) -> void { M_unreachable("invalid reference"); },
+                    }, entry.get(id)); // do not extract to be able to access for AVG case
+                }
+
+                bool is_min = false; ///< flag to indicate whether aggregate function is MIN
+                switch (info.fnid) {
+                    default:
+                        M_unreachable("unsupported aggregate function");
+                    case m::Function::FN_MIN:
+                        is_min = true; // set flag and delegate to MAX case
+                    case m::Function::FN_MAX:
+                    case m::Function::FN_SUM: {
+                        const bool is_sum = info.fnid == m::Function::FN_SUM;
+                        std::visit(overloaded {
+                            [&]<sql_type _T>(HashTable::reference_t<_T> &&r) -> void
+                            requires (not (std::same_as<_T, _Boolx1> or std::same_as<_T, NChar>)) {
+                                using type = typename _T::type;
+                                using T = PrimitiveExpr<type>;
+
+                                BLOCK_OPEN(merge_aggs) {
+                                    auto [new_val_, new_val_is_null_] = env.get<_T>(id).split();
+                                    auto [old_val_, old_val_is_null_] = _T(r.clone()).split();
+                                    const Var<T> new_val(new_val_), old_val(old_val_); // due to multiple uses
+                                    const Var<Boolx1> new_val_is_null(new_val_is_null_),
+                                                      old_val_is_null(old_val_is_null_); // due to multiple uses
+
+                                    /* The value of a NULL aggregate is unspecified, thus select the other one. */
+                                    T merged = is_sum ? T(old_val + new_val)
+                                                      : Select(is_min ? new_val < old_val : new_val > old_val,
+                                                               new_val, old_val);
+                                    auto value = Select(new_val_is_null, old_val,
+                                                        Select(old_val_is_null, new_val, merged));
+                                    if (info.entry.nullable()) {
+                                        r.clone().set_value(value);
+                                        r.set_null_bit(
+                                            old_val_is_null and new_val_is_null // NULL iff all values are NULL
+                                        );
+                                    } else {
+                                        r.set_value(value);
+                                    }
+                                }
+                            },
+                            []<sql_type _T>(HashTable::reference_t<_T>&&) -> void
+                            requires std::same_as<_T,_Boolx1> or std::same_as<_T, NChar> {
+                                M_unreachable("invalid type");
+                            },
+                            [](std::monostate) -> void { M_unreachable("invalid reference"); },
+                        }, entry.get(id));
+                        break;
+                    }
+                    case m::Function::FN_AVG: {
+                        auto it = avg_aggregates.find(id);
+                        M_insist(it != avg_aggregates.end());
+                        const auto &avg_info = it->second;
+                        M_insist(avg_info.compute_running_avg,
+                                 "AVG aggregate may only occur for running average computations");
+
+                        BLOCK_OPEN(merge_avg_aggs) {
+                            auto r = entry.get<_Doublex1>(id);
+                            auto [new_avg_, new_avg_is_null_] = env.get<_Doublex1>(id).split();
+                            auto [old_avg_, old_avg_is_null_] = _Doublex1(r.clone()).split();
+                            const Var<Doublex1> new_avg(new_avg_), old_avg(old_avg_); // due to multiple uses
+                            const Var<Boolx1> new_avg_is_null(new_avg_is_null_),
+                                              old_avg_is_null(old_avg_is_null_); // due to multiple uses
+
+                            /* Weight both averages by their running counts, i.e. the numbers of non-NULL values. */
+                            auto old_count =
+                                _I64x1(entry.get<_I64x1>(avg_info.running_count)).insist_not_null().to<double>();
+                            const Var<Doublex1> new_count(
+                                env.get<_I64x1>(avg_info.running_count).insist_not_null().to<double>()
+                            ); // due to multiple uses
+                            auto merged = old_avg + (new_avg - old_avg) * (new_count / (old_count + new_count));
+                            auto value = Select(new_avg_is_null, old_avg, Select(old_avg_is_null, new_avg, merged));
+                            if (info.entry.nullable()) {
+                                r.clone().set_value(value);
+                                r.set_null_bit(
+                                    old_avg_is_null and new_avg_is_null // AVG is NULL iff all values are NULL
+                                );
+                            } else {
+                                r.set_value(value);
+                            }
+                        }
+                        break;
+                    }
+                    case m::Function::FN_COUNT: {
+                        BLOCK_OPEN(merge_aggs) {
+                            auto r = entry.get<_I64x1>(id);
+                            auto old_count = _I64x1(r.clone()).insist_not_null();
+                            auto new_count = env.get<_I64x1>(id).insist_not_null();
+                            r.set_value(
+                                old_count + new_count // add both counts
+                            );
+                            /* do not update NULL bit since it is already set to `false` */
+                        }
+                        break;
+                    }
+                }
+            }
+
+            /*----- If group has been inserted, copy aggregates. Otherwise, merge them. -----*/
+            IF (inserted) {
+                init_aggs.attach_to_current();
+            } ELSE {
+                merge_avg_aggs.attach_to_current(); // before others to ensure that running counts are not yet merged
+                merge_aggs.attach_to_current();
+            };
+
+            row_id += 1U;
+        }
+
+        /*----- Process each merged group of the partition. -----*/
+        merge_ht->for_each(emit_group);
+
+        Module::Allocator().deallocate(rows, num_bytes);
+        partition = Module::Get().emit_call<uint32_t>("grouping_next_partition");
+    }
+    teardown_t(std::move(teardown), [&](){ merge_ht->teardown(); })();
+
+    /*----- Wait for all threads to finish merging before the published partitions may be freed. -----*/
+    Module::Get().emit_call<void>("grouping_finish");
+    Module::Allocator().deallocate(offsets.val().to<void*>(), (num_partitions + 1U) * uint32_t(sizeof(uint32_t)));
 }
 
 ConditionSet OrderedGrouping::pre_condition(
@@ -4935,47 +5553,342 @@ void SimpleHashJoin<UniqueBuild, Predicated>::execute(const Match<SimpleHashJoin
     );
 }
 
-template<bool SortLeft, bool SortRight, bool Predicated, bool CmpPredicated>
-ConditionSet SortMergeJoin<SortLeft, SortRight, Predicated, CmpPredicated>::pre_condition(
-    std::size_t child_idx,
+template<bool UniqueBuild>
+ConditionSet RadixHashJoin<UniqueBuild>::pre_condition(
+    std::size_t,
     const std::tuple<const JoinOperator*, const Wildcard*, const Wildcard*> &partial_inner_nodes)
 {
     ConditionSet pre_cond;
 
-    /*----- Sort merge join can only be used for binary joins on conjunctions of equi-predicates. -----*/
+    /*----- Radix hash join can only be used for binary joins on equi-predicates. -----*/
     auto &join = *std::get<0>(partial_inner_nodes);
     if (not join.predicate().is_equi())
         return ConditionSet::Make_Unsatisfiable();
 
-    /*----- Decompose each clause of the join predicate of the form `A.x = B.y` into parts `A.x` and `B.y`. -----*/
-    auto parent = std::get<1>(partial_inner_nodes);
-    auto child  = std::get<2>(partial_inner_nodes);
-    M_insist(parent);
-    M_insist(child_idx != 1 or child);
-    std::vector<Schema::Identifier> keys_parent, keys_child;
-    for (auto &clause : join.predicate()) {
-        M_insist(clause.size() == 1, "invalid equi-predicate");
-        auto &literal = clause[0];
-        auto &binary = as<const BinaryExpr>(literal.expr());
-        M_insist((not literal.negative() and binary.tok == TK_EQUAL) or
-                 (literal.negative() and binary.tok == TK_BANG_EQUAL), "invalid equi-predicate");
-        M_insist(is<const Designator>(binary.lhs), "invalid equi-predicate");
-        M_insist(is<const Designator>(binary.rhs), "invalid equi-predicate");
-        Schema::Identifier id_first(*binary.lhs), id_second(*binary.rhs);
-        auto dummy = Schema::entry_type::CreateArtificial(); ///< dummy entry used in case of `child_idx` != 1, i.e. `child` is not yet set
-        const auto &[entry_parent, entry_child] = parent->schema().has(id_first)
-            ? std::make_pair(parent->schema()[id_first].second, child_idx == 1 ? child->schema()[id_second].second : std::move(dummy))
-            : std::make_pair(parent->schema()[id_second].second, child_idx == 1 ? child->schema()[id_first].second : std::move(dummy));
-        keys_parent.push_back(entry_parent.id);
-        keys_child.push_back(entry_child.id);
-
-        /*----- Sort merge join can only be used on unique parent key. -----*/
-        if (not entry_parent.unique())
-            return ConditionSet::Make_Unsatisfiable();
-    }
-    M_insist(keys_parent.size() == keys_child.size(), "number of found IDs differ");
-    M_insist(not keys_parent.empty(), "must find at least one ID");
-
+    if constexpr (UniqueBuild) {
+        /*----- Decompose each clause of the join predicate of the form `A.x = B.y` into parts `A.x` and `B.y`. -----*/
+        auto &build = *std::get<1>(partial_inner_nodes);
+        for (auto &clause : join.predicate()) {
+            M_insist(clause.size() == 1, "invalid equi-predicate");
+            auto &literal = clause[0];
+            auto &binary = as<const BinaryExpr>(literal.expr());
+            M_insist((not literal.negative() and binary.tok == TK_EQUAL) or
+                     (literal.negative() and binary.tok == TK_BANG_EQUAL), "invalid equi-predicate");
+            M_insist(is<const Designator>(binary.lhs), "invalid equi-predicate");
+            M_insist(is<const Designator>(binary.rhs), "invalid equi-predicate");
+            Schema::Identifier id_first(*binary.lhs), id_second(*binary.rhs);
+            const auto &entry_build = build.schema().has(id_first) ? build.schema()[id_first].second
+                                                                   : build.schema()[id_second].second;
+
+            /*----- Unique radix hash join can only be used on unique build key. -----*/
+            if (not entry_build.unique())
+                return ConditionSet::Make_Unsatisfiable();
+        }
+    }
+
+    /*----- Radix hash join does not support SIMD. -----*/
+    pre_cond.add_condition(NoSIMD());
+
+    return pre_cond;
+}
+
+template<bool UniqueBuild>
+ConditionSet RadixHashJoin<UniqueBuild>::adapt_post_conditions(
+    const Match<RadixHashJoin>&,
+    std::vector<std::reference_wrapper<const ConditionSet>> &&post_cond_children)
+{
+    M_insist(post_cond_children.size() == 2);
+
+    ConditionSet post_cond;
+
+    /*----- Radix hash join does not introduce predication (it is already handled by the hash table). -----*/
+    post_cond.add_or_replace_condition(m::Predicated(false));
+
+    /*----- Radix hash join does not introduce SIMD. -----*/
+    post_cond.add_condition(NoSIMD());
+
+    /* Sortedness of the probe input is not preserved since the probe input is partitioned. */
+
+    return post_cond;
+}
+
+template<bool UniqueBuild>
+double RadixHashJoin<UniqueBuild>::cost(const Match<RadixHashJoin> &M)
+{
+    const double build_cardinality = M.build.info().estimated_cardinality;
+    const double probe_cardinality = M.probe.info().estimated_cardinality;
+
+    /* Materializing and partitioning both inputs requires additional passes over them. */
+    const double partitioning_cost = 0.5 * (build_cardinality + probe_cardinality);
+
+    /* If the build input fits into a single partition, the join itself costs as much as a `SimpleHashJoin`.
+     * Otherwise, each partition's hash table stays cache resident and, thus, inserting and probing are cheaper than
+     * in a single hash table exceeding the cache. */
+    const double locality_factor = compute_num_radix_bits(M.build) == 0 ? 1.0 : 0.5;
+    return partitioning_cost +
+        locality_factor * (1.5 * build_cardinality + (UniqueBuild ? 1.0 : 1.1) * probe_cardinality);
+}
+
+template<bool UniqueBuild>
+void RadixHashJoin<UniqueBuild>::execute(const Match<RadixHashJoin> &M, setup_t setup, pipeline_t pipeline,
+                                         teardown_t teardown)
+{
+    // TODO: determine setup
+    const uint64_t PAYLOAD_SIZE_THRESHOLD_IN_BITS =
+        M.use_in_place_values ? std::numeric_limits<uint64_t>::max() : 0;
+
+    M_insist(((M.join.schema() | M.join.predicate().get_required()) & M.build.schema()) == M.build.schema());
+    M_insist(M.build.schema().drop_constants() == M.build.schema());
+    const auto ht_schema = M.build.schema().deduplicate();
+    const auto probe_schema = M.probe.schema().drop_constants().deduplicate();
+
+    /*----- Decompose each clause of the join predicate of the form `A.x = B.y` into parts `A.x` and `B.y`. -----*/
+    const auto [build_keys, probe_keys] = decompose_equi_predicate(M.join.predicate(), ht_schema);
+
+    /*----- Compute payload IDs and its total size in bits (ignoring padding). -----*/
+    std::vector<Schema::Identifier> payload_ids;
+    uint64_t payload_size_in_bits = 0;
+    for (auto &e : ht_schema) {
+        if (not contains(build_keys, e.id)) {
+            payload_ids.push_back(e.id);
+            payload_size_in_bits += e.type->size();
+        }
+    }
+
+    /*----- Both inputs are hashed using the types of the build keys to assign join partners the same partition. -----*/
+    std::vector<const Type*> key_types;
+    for (auto &build_key : build_keys)
+        key_types.push_back(ht_schema[build_key].second.type);
+
+    /*----- Compute number of partitions.  The hash table uses the lower 32 bits of the hash, thus partition on the
+     * upper 32 bits s.t. the keys of a partition are still uniformly distributed in the hash table. -----*/
+    const uint32_t num_radix_bits = compute_num_radix_bits(M.build);
+    const uint32_t num_partitions = 1U << num_radix_bits;
+    const uint32_t radix_shift = 32;
+
+    /*----- Materialize both inputs into infinite buffers. -----*/
+    M_insist(bool(M.build_materializing_factory), "`wasm::RadixHashJoin` must have a factory for the materialized build");
+    M_insist(bool(M.probe_materializing_factory), "`wasm::RadixHashJoin` must have a factory for the materialized probe");
+    GlobalBuffer build_buffer(ht_schema, *M.build_materializing_factory);
+    GlobalBuffer probe_buffer(probe_schema, *M.probe_materializing_factory);
+
+    FUNCTION(radix_hash_join_build_pipeline, void(void)) // create function for build pipeline
+    {
+        auto S = CodeGenContext::Get().scoped_environment(); // create scoped environment for this function
+        M.children[0]->execute(
+            /* setup=    */ setup_t::Make_Without_Parent([&](){ build_buffer.setup(); }),
+            /* pipeline= */ [&](){ build_buffer.consume(); },
+            /* teardown= */ teardown_t::Make_Without_Parent([&](){ build_buffer.teardown(); })
+        );
+    }
+    radix_hash_join_build_pipeline(); // call build function
+
+    FUNCTION(radix_hash_join_probe_pipeline, void(void)) // create function for probe pipeline
+    {
+        auto S = CodeGenContext::Get().scoped_environment(); // create scoped environment for this function
+        M.children[1]->execute(
+            /* setup=    */ setup_t::Make_Without_Parent([&](){ probe_buffer.setup(); }),
+            /* pipeline= */ [&](){ probe_buffer.consume(); },
+            /* teardown= */ teardown_t::Make_Without_Parent([&](){ probe_buffer.teardown(); })
+        );
+    }
+    radix_hash_join_probe_pipeline(); // call probe function
+
+    /*----- Radix-partition both buffers in-place. -----*/
+    auto build_offsets = radix_partition(build_buffer, build_keys, key_types, num_radix_bits, radix_shift);
+    auto probe_offsets = radix_partition(probe_buffer, probe_keys, key_types, num_radix_bits, radix_shift);
+
+    /*----- Create hash table sized for a single partition.  It is cleared and reused for each partition. -----*/
+    const uint32_t initial_capacity = std::max(compute_initial_ht_capacity(M.build, M.load_factor) >> num_radix_bits,
+                                               1U);
+    std::unique_ptr<HashTable> ht;
+    std::vector<HashTable::index_t> build_key_indices;
+    for (auto &build_key : build_keys)
+        build_key_indices.push_back(ht_schema[build_key].first);
+    if (M.use_open_addressing_hashing) {
+        if (payload_size_in_bits < PAYLOAD_SIZE_THRESHOLD_IN_BITS)
+            ht = std::make_unique<GlobalOpenAddressingInPlaceHashTable>(ht_schema, std::move(build_key_indices),
+                                                                        initial_capacity);
+        else
+            ht = std::make_unique<GlobalOpenAddressingOutOfPlaceHashTable>(ht_schema, std::move(build_key_indices),
+                                                                           initial_capacity);
+        if (M.use_quadratic_probing)
+            as<OpenAddressingHashTableBase>(*ht).set_probing_strategy<QuadraticProbing>();
+        else
+            as<OpenAddressingHashTableBase>(*ht).set_probing_strategy<LinearProbing>();
+    } else {
+        ht = std::make_unique<GlobalChainedHashTable>(ht_schema, std::move(build_key_indices), initial_capacity);
+    }
+
+    auto load_build = build_buffer.create_load_proxy();
+    auto load_probe = probe_buffer.create_load_proxy();
+
+    /*----- Join corresponding partitions of both inputs. -----*/
+    setup();
+    ht->setup();
+    ht->set_high_watermark(M.load_factor);
+    Var<U32x1> partition(0U);
+    WHILE (partition < num_partitions) {
+        ht->clear();
+
+        /*----- Build hash table on current partition of build input. -----*/
+        Var<U32x1> build_id(U32x1(*(build_offsets + partition.make_signed())));
+        const Var<U32x1> build_end(U32x1(*(build_offsets + (partition + 1U).make_signed())));
+        WHILE (build_id < build_end) {
+            auto S = CodeGenContext::Get().scoped_environment(); // create scoped environment for the loaded tuple
+            load_build(build_id);
+            auto &env = CodeGenContext::Get().env();
+
+            std::optional<Boolx1> build_key_not_null;
+            for (auto &build_key : build_keys) {
+                auto val = env.get(build_key);
+                if (build_key_not_null)
+                    build_key_not_null.emplace(*build_key_not_null and not_null(val));
+                else
+                    build_key_not_null.emplace(not_null(val));
+            }
+            M_insist(bool(build_key_not_null));
+            IF (*build_key_not_null) {
+                /*----- Insert key. -----*/
+                std::vector<SQL_t> key;
+                for (auto &build_key : build_keys)
+                    key.emplace_back(env.get(build_key));
+                auto entry = ht->emplace(std::move(key));
+
+                /*----- Insert payload. -----*/
+                for (auto &id : payload_ids) {
+                    std::visit(overloaded {
+                        [&]<sql_type T>(HashTable::reference_t<T> &&r) -> void { r = env.extract<T>(id); },
+                        [](std::monostate) -> void { M_unreachable("invalid reference"); },
+                    }, entry.extract(id));
+                }
+            };
+            build_id += 1U;
+        }
+
+        /*----- Probe hash table with current partition of probe input. -----*/
+        Var<U32x1> probe_id(U32x1(*(probe_offsets + partition.make_signed())));
+        const Var<U32x1> probe_end(U32x1(*(probe_offsets + (partition + 1U).make_signed())));
+        WHILE (probe_id < probe_end) {
+            auto S = CodeGenContext::Get().scoped_environment(); // create scoped environment for the loaded tuple
+            load_probe(probe_id);
+            auto &env = CodeGenContext::Get().env();
+
+            auto emit_tuple_and_resume_pipeline = [&](HashTable::const_entry_t entry){
+                /*----- Add found entry from hash table, i.e. from build input, to current environment. -----*/
+                for (auto &e : ht_schema) {
+                    if (not entry.has(e.id)) { // entry may not contain build key in case `ht->find()` was used
+                        M_insist(contains(build_keys, e.id));
+                        M_insist(env.has(e.id), "build key must already be contained in the current environment");
+                        continue;
+                    }
+
+                    std::visit(overloaded {
+                        [&]<typename T>(HashTable::const_reference_t<Expr<T>> &&r) -> void {
+                            Expr<T> value = r;
+                            if (value.can_be_null()) {
+                                Var<Expr<T>> var(value); // introduce variable s.t. uses only load from it
+                                env.add(e.id, var);
+                            } else {
+                                /* introduce variable w/o NULL bit s.t. uses only load from it */
+                                Var<PrimitiveExpr<T>> var(value.insist_not_null());
+                                env.add(e.id, Expr<T>(var));
+                            }
+                        },
+                        [&](HashTable::const_reference_t<NChar> &&r) -> void {
+                            NChar value(r);
+                            Var<Ptr<Charx1>> var(value.val()); // introduce variable s.t. uses only load from it
+                            env.add(e.id, NChar(var, value.can_be_null(), value.length(),
+                                                value.guarantees_terminating_nul()));
+                        },
+                        [](std::monostate) -> void { M_unreachable("invalid reference"); },
+                    }, entry.extract(e.id));
+                }
+
+                /*----- Resume pipeline. -----*/
+                pipeline();
+            };
+
+            /*----- Probe with probe key. -----*/
+            std::vector<SQL_t> key;
+            for (auto &probe_key : probe_keys)
+                key.emplace_back(env.get(probe_key));
+            if constexpr (UniqueBuild) {
+                /*----- Add build key to current environment since `ht->find()` will only return the payload values. -----*/
+                for (auto build_it = build_keys.cbegin(), probe_it = probe_keys.cbegin(); build_it != build_keys.cend();
+                     ++build_it, ++probe_it)
+                {
+                    M_insist(probe_it != probe_keys.cend());
+                    if (not env.has(*build_it)) // skip duplicated build keys and only add first occurrence
+                        env.add(*build_it, env.get(*probe_it)); // since build and probe keys match for join partners
+                }
+
+                /*----- Try to find the *single* possible join partner. -----*/
+                auto p = ht->find(std::move(key));
+                auto &entry = p.first;
+                auto &found = p.second;
+                IF (found) {
+                    emit_tuple_and_resume_pipeline(std::move(entry));
+                };
+            } else {
+                /*----- Search for *all* join partners. -----*/
+                ht->for_each_in_equal_range(std::move(key), std::move(emit_tuple_and_resume_pipeline),
+                                            /* predicated= */ false);
+            }
+            probe_id += 1U;
+        }
+
+        partition += 1U;
+    }
+    ht->teardown();
+    teardown();
+
+    /*----- Free partition boundaries. -----*/
+    Module::Allocator().deallocate(build_offsets.val().to<void*>(), (num_partitions + 1U) * uint32_t(sizeof(uint32_t)));
+    Module::Allocator().deallocate(probe_offsets.val().to<void*>(), (num_partitions + 1U) * uint32_t(sizeof(uint32_t)));
+}
+
+template<bool SortLeft, bool SortRight, bool Predicated, bool CmpPredicated>
+ConditionSet SortMergeJoin<SortLeft, SortRight, Predicated, CmpPredicated>::pre_condition(
+    std::size_t child_idx,
+    const std::tuple<const JoinOperator*, const Wildcard*, const Wildcard*> &partial_inner_nodes)
+{
+    ConditionSet pre_cond;
+
+    /*----- Sort merge join can only be used for binary joins on conjunctions of equi-predicates. -----*/
+    auto &join = *std::get<0>(partial_inner_nodes);
+    if (not join.predicate().is_equi())
+        return ConditionSet::Make_Unsatisfiable();
+
+    /*----- Decompose each clause of the join predicate of the form `A.x = B.y` into parts `A.x` and `B.y`. -----*/
+    auto parent = std::get<1>(partial_inner_nodes);
+    auto child  = std::get<2>(partial_inner_nodes);
+    M_insist(parent);
+    M_insist(child_idx != 1 or child);
+    std::vector<Schema::Identifier> keys_parent, keys_child;
+    for (auto &clause : join.predicate()) {
+        M_insist(clause.size() == 1, "invalid equi-predicate");
+        auto &literal = clause[0];
+        auto &binary = as<const BinaryExpr>(literal.expr());
+        M_insist((not literal.negative() and binary.tok == TK_EQUAL) or
+                 (literal.negative() and binary.tok == TK_BANG_EQUAL), "invalid equi-predicate");
+        M_insist(is<const Designator>(binary.lhs), "invalid equi-predicate");
+        M_insist(is<const Designator>(binary.rhs), "invalid equi-predicate");
+        Schema::Identifier id_first(*binary.lhs), id_second(*binary.rhs);
+        auto dummy = Schema::entry_type::CreateArtificial(); ///< dummy entry used in case of `child_idx` != 1, i.e. `child` is not yet set
+        const auto &[entry_parent, entry_child] = parent->schema().has(id_first)
+            ? std::make_pair(parent->schema()[id_first].second, child_idx == 1 ? child->schema()[id_second].second : std::move(dummy))
+            : std::make_pair(parent->schema()[id_second].second, child_idx == 1 ? child->schema()[id_first].second : std::move(dummy));
+        keys_parent.push_back(entry_parent.id);
+        keys_child.push_back(entry_child.id);
+
+        /*----- Sort merge join can only be used on unique parent key. -----*/
+        if (not entry_parent.unique())
+            return ConditionSet::Make_Unsatisfiable();
+    }
+    M_insist(keys_parent.size() == keys_child.size(), "number of found IDs differ");
+    M_insist(not keys_parent.empty(), "must find at least one ID");
+
     if constexpr (not SortLeft or not SortRight) {
         /*----- Sort merge join without sorting needs its data sorted on the respective key. -----*/
         Sortedness::order_t orders;
@@ -5072,8 +5985,8 @@ void SortMergeJoin<SortLeft, SortRight, Predicated, CmpPredicated>::execute(
     teardown_t teardown)
 {
     auto &env = CodeGenContext::Get().env();
-    const bool needs_buffer_parent = not is<const ScanOperator>(M.parent) or SortLeft;
-    const bool needs_buffer_child  = not is<const ScanOperator>(M.child) or SortRight;
+    const bool needs_buffer_parent = not is_plain_scan(M.parent) or SortLeft;
+    const bool needs_buffer_child  = not is_plain_scan(M.child) or SortRight;
 
     /*----- Create infinite buffers to materialize the current results (if necessary). -----*/
     M_insist(bool(M.left_materializing_factory),
@@ -5220,6 +6133,207 @@ void SortMergeJoin<SortLeft, SortRight, Predicated, CmpPredicated>::execute(
 }
 
 
+ConditionSet IndexNestedLoopsJoin::pre_condition(
+    std::size_t child_idx,
+    const std::tuple<const JoinOperator*, const Wildcard*, const ScanOperator*> &partial_inner_nodes)
+{
+    if (child_idx == 0) { // outer input
+        ConditionSet pre_cond;
+
+        /*----- Index nested-loops join does not support SIMD. -----*/
+        pre_cond.add_condition(NoSIMD());
+
+        return pre_cond;
+    }
+    M_insist(child_idx == 1); // inner scan
+
+    /*----- Index nested-loops join can only be used for binary joins on a single equi-predicate. -----*/
+    auto &join = *std::get<0>(partial_inner_nodes);
+    auto &outer = *std::get<1>(partial_inner_nodes);
+    auto &scan = *std::get<2>(partial_inner_nodes);
+    if (not join.predicate().is_equi() or join.predicate().size() != 1)
+        return ConditionSet::Make_Unsatisfiable();
+
+    /*----- Indexes contain all versions of rows and hence cannot be used to probe a snapshot. -----*/
+    if (scan.has_snapshot())
+        return ConditionSet::Make_Unsatisfiable();
+    const auto [scan_keys, outer_keys] = decompose_equi_predicate(join.predicate(), scan.schema());
+    if (not scan.schema().has(scan_keys[0]) or not outer.schema().has(outer_keys[0]))
+        return ConditionSet::Make_Unsatisfiable();
+
+    /*----- The key of the scanned table must be indexed by a hash index and match the type of the outer key. -----*/
+    auto &DB = Catalog::Get().get_database_in_use();
+    auto &table = scan.store().table();
+    if (not DB.has_index(table.name(), scan_keys[0].name, idx::IndexMethod::Hash))
+        return ConditionSet::Make_Unsatisfiable();
+    if (scan.schema()[scan_keys[0]].second.type != outer.schema()[outer_keys[0]].second.type)
+        return ConditionSet::Make_Unsatisfiable();
+
+    /*----- Rows are loaded by their ID, which requires an infinite layout. -----*/
+    if (table.layout().is_finite())
+        return ConditionSet::Make_Unsatisfiable();
+
+    return ConditionSet();
+}
+
+ConditionSet IndexNestedLoopsJoin::adapt_post_condition(const Match<IndexNestedLoopsJoin>&,
+                                                        const ConditionSet &post_cond_child)
+{
+    /* The outer input is processed in order and a predicate of the outer input is retained, thus preserve all
+     * conditions of the outer input. */
+    return ConditionSet(post_cond_child);
+}
+
+double IndexNestedLoopsJoin::cost(const Match<IndexNestedLoopsJoin> &M)
+{
+    /* Instead of scanning and hashing the inner input, every tuple of the outer input probes the index. */
+    return 2.0 * M.outer.info().estimated_cardinality;
+}
+
+/** Emits code to probe the `idx::HashIndex` \p index with the key \p outer_key of every tuple of the outer input of
+ * \p M and to load the matching rows of the scanned table.  The slots of the index are mapped into the linear memory of
+ * the Wasm module by `create_env()`.  The capacity of the index is baked into the code, hence the code must not be
+ * reused. */
+template<typename Index, sql_type SqlT>
+void index_nested_loops_join_codegen(const Index &index, const Match<IndexNestedLoopsJoin> &M,
+                                     const Schema::Identifier &outer_key,
+                                     setup_t setup, pipeline_t pipeline, teardown_t teardown)
+{
+    using key_type = typename Index::key_type;
+    using key_t = PrimitiveExpr<key_type, 1>;
+    using slot_t = typename Index::slot_t;
+
+    /*----- Add index to context. -----*/
+    auto &context = WasmEngine::Get_Wasm_Context_By_ID(Module::ID());
+    M_DISCARD context.add_index(index);
+
+    auto &table = M.scan.store().table();
+    const auto schema = M.scan.schema().drop_constants().deduplicate();
+
+    M.child->execute(
+        /* setup=    */ std::move(setup),
+        /* pipeline= */ [&, pipeline=std::move(pipeline)](){
+            auto &env = CodeGenContext::Get().env();
+
+            /*----- Define accessors to the slots of the index. -----*/
+            const Var<Ptr<void>> slots(CodeGenContext::Get().get_index_address(index));
+            auto slot_address = [&](U32x1 slot, std::size_t offset) -> Ptr<void> {
+                return slots + (std::move(slot) * uint32_t(sizeof(slot_t))).make_signed() + int32_t(offset);
+            };
+            auto key_at = [&](U32x1 slot) -> key_t {
+                return *slot_address(std::move(slot), offsetof(slot_t, key)).template to<key_type*>();
+            };
+            auto value_at = [&](U32x1 slot) -> U32x1 {
+                return *slot_address(std::move(slot), offsetof(slot_t, value)).template to<uint32_t*>();
+            };
+
+            /* Emits code to probe the index with `key` and to resume the pipeline for every matching row. */
+            auto probe = [&](key_t key) {
+                const Var<key_t> probe_key(std::move(key));
+
+                /*----- Compute the first slot exactly like `idx::HashIndex::first_slot()`. -----*/
+                U64x1 bits = [&]() -> U64x1 {
+                    if constexpr (std::floating_point<key_type>) {
+                        using bits_type = std::conditional_t<sizeof(key_type) == 4, int32_t, int64_t>;
+                        return (key_t(probe_key) + key_type(0)).template reinterpret<bits_type>().make_unsigned();
+                    } else if constexpr (sizeof(key_type) < 4) {
+                        /* mask the bits beyond the key width, which may hold the sign extension */
+                        U64x1 unsigned_key = key_t(probe_key).make_unsigned();
+                        return std::move(unsigned_key) bitand uint64_t((1UL << (8 * sizeof(key_type))) - 1UL);
+                    } else {
+                        return key_t(probe_key).make_unsigned();
+                    }
+                }();
+                Var<U32x1> slot(
+                    ((std::move(bits) * uint64_t(Index::HASH_FACTOR)) >> uint64_t(64 - index.log2_capacity()))
+                        .template to<uint32_t>()
+                );
+
+                /*----- Walk the slots up to the first empty slot. -----*/
+                WHILE (value_at(slot) != Index::EMPTY) {
+                    IF (key_at(slot) == probe_key) {
+                        static Schema empty_schema;
+                        compile_load_point_access(
+                            /* tuple_value_schema=   */ schema,
+                            /* tuple_address_schema= */ empty_schema,
+                            /* base_address=         */ get_base_address(table.name()),
+                            /* layout=               */ table.layout(),
+                            /* layout_schema=        */ table.schema(M.scan.alias()),
+                            /* tuple_id=             */ value_at(slot)
+                        );
+                        pipeline();
+                    };
+                    slot = (slot + 1U) bitand uint32_t(index.capacity() - 1);
+                }
+            };
+
+            /*----- Probe with the outer key unless it is NULL, which never joins. -----*/
+            auto key = env.get<SqlT>(outer_key);
+            if (key.can_be_null()) {
+                auto split = key.split();
+                IF (not split.second) {
+                    probe(std::move(split.first));
+                };
+            } else {
+                probe(key.insist_not_null());
+            }
+        },
+        /* teardown= */ std::move(teardown)
+    );
+}
+
+void IndexNestedLoopsJoin::execute(const Match<IndexNestedLoopsJoin> &M, setup_t setup, pipeline_t pipeline,
+                                   teardown_t teardown)
+{
+    auto &table = M.scan.store().table();
+    M_insist(not table.layout().is_finite(), "layout for `wasm::IndexNestedLoopsJoin` must be infinite");
+
+    /*----- Decompose the join predicate of the form `A.x = B.y` into the scanned and the outer key. -----*/
+    const auto [scan_keys, outer_keys] = decompose_equi_predicate(M.join.predicate(), M.scan.schema());
+    M_insist(scan_keys.size() == 1, "index nested-loops join requires a single equi-predicate");
+    auto &outer_key = outer_keys[0];
+
+    /*----- Lookup index. -----*/
+    auto &DB = Catalog::Get().get_database_in_use();
+    auto &index_base = DB.get_index(table.name(), scan_keys[0].name, idx::IndexMethod::Hash);
+
+    /*----- Resolve the key type. -----*/
+#define RESOLVE_KEYTYPE(KEYTYPE, SQLTYPE) \
+    index_nested_loops_join_codegen<idx::HashIndex<KEYTYPE>, SQLTYPE>( \
+        as<const idx::HashIndex<KEYTYPE>>(index_base), M, outer_key, \
+        std::move(setup), std::move(pipeline), std::move(teardown) \
+    )
+
+    visit(overloaded {
+        [&](const Numeric &n) {
+            switch (n.kind) {
+                case Numeric::N_Int:
+                case Numeric::N_Decimal:
+                    switch (n.size()) {
+                        default: M_unreachable("invalid size");
+                        case  8: RESOLVE_KEYTYPE(int8_t,   _I8x1); break;
+                        case 16: RESOLVE_KEYTYPE(int16_t, _I16x1); break;
+                        case 32: RESOLVE_KEYTYPE(int32_t, _I32x1); break;
+                        case 64: RESOLVE_KEYTYPE(int64_t, _I64x1); break;
+                    }
+                    break;
+                case Numeric::N_Float:
+                    switch (n.size()) {
+                        default: M_unreachable("invalid size");
+                        case 32: RESOLVE_KEYTYPE(float,   _Floatx1); break;
+                        case 64: RESOLVE_KEYTYPE(double, _Doublex1); break;
+                    }
+                    break;
+            }
+        },
+        [&](const Date&) { RESOLVE_KEYTYPE(int32_t, _I32x1); },
+        [&](const DateTime&) { RESOLVE_KEYTYPE(int64_t, _I64x1); },
+        [](auto&&) { M_unreachable("invalid key type"); },
+    }, *M.scan.schema()[scan_keys[0]].second.type);
+#undef RESOLVE_KEYTYPE
+}
+
+
 /*======================================================================================================================
  * Limit
  *====================================================================================================================*/
@@ -6079,10 +7193,14 @@ void Match<m::wasm::IndexScan<IndexMethod>>::print(std::ostream &out, unsigned l
         indent(out, level) << "wasm::ArrayIndexScan(";
     else if (IndexMethod == idx::IndexMethod::Rmi)
         indent(out, level) << "wasm::RecursiveModelIndexScan(";
+    else if (IndexMethod == idx::IndexMethod::BPlusTree)
+        indent(out, level) << "wasm::BPlusTreeIndexScan(";
     else
         M_unreachable("unknown index");
 
-    if (options::index_scan_strategy == option_configs::IndexScanStrategy::COMPILATION) {
+    if (IndexMethod == idx::IndexMethod::BPlusTree) {
+        out << "Compilation[ExposedMemory"; // B+-trees are always traversed in generated code
+    } else if (options::index_scan_strategy == option_configs::IndexScanStrategy::COMPILATION) {
         out << "Compilation[";
         if (options::index_scan_compilation_strategy == option_configs::IndexScanCompilationStrategy::CALLBACK)
             out << "Callback";
@@ -6226,6 +7344,23 @@ void Match<m::wasm::SimpleHashJoin<Unique, Predicated>>::print(std::ostream &out
     build.print(out, level + 1);
 }
 
+template<bool Unique>
+void Match<m::wasm::RadixHashJoin<Unique>>::print(std::ostream &out, unsigned level) const
+{
+    indent(out, level) << "wasm::RadixHashJoin";
+    if (Unique) out << " on UNIQUE key";
+    out << " with " << (1U << compute_num_radix_bits(this->build)) << " partitions ";
+    out << this->join.schema() << print_info(this->join) << " (cumulative cost " << cost() << ')';
+
+    ++level;
+    const m::wasm::MatchBase &build = *this->children[0];
+    const m::wasm::MatchBase &probe = *this->children[1];
+    indent(out, level) << "probe input";
+    probe.print(out, level + 1);
+    indent(out, level) << "build input";
+    build.print(out, level + 1);
+}
+
 template<bool SortLeft, bool SortRight, bool Predicated, bool CmpPredicated>
 void Match<m::wasm::SortMergeJoin<SortLeft, SortRight, Predicated, CmpPredicated>>::print(std::ostream &out,
                                                                                           unsigned level) const
@@ -6238,8 +7373,8 @@ void Match<m::wasm::SortMergeJoin<SortLeft, SortRight, Predicated, CmpPredicated
         case 2: out << "sorting left input " << (CmpPredicated ? "predicated " : ""); break;
         case 3: out << "sorting both inputs " << (CmpPredicated ? "predicated " : ""); break;
     }
-    const bool needs_buffer_parent = not is<const ScanOperator>(this->parent) or SortLeft;
-    const bool needs_buffer_child  = not is<const ScanOperator>(this->child) or SortRight;
+    const bool needs_buffer_parent = not is_plain_scan(this->parent) or SortLeft;
+    const bool needs_buffer_child  = not is_plain_scan(this->child) or SortRight;
     if (needs_buffer_parent and needs_buffer_child)
         out << "and materializing both inputs ";
     else if (needs_buffer_parent)
@@ -6257,6 +7392,16 @@ void Match<m::wasm::SortMergeJoin<SortLeft, SortRight, Predicated, CmpPredicated
     left.print(out, level + 1);
 }
 
+void Match<m::wasm::IndexNestedLoopsJoin>::print(std::ostream &out, unsigned level) const
+{
+    indent(out, level) << "wasm::IndexNestedLoopsJoin(" << this->scan.alias() << ") " << this->join.schema()
+                       << print_info(this->join) << " (cumulative cost " << cost() << ')';
+
+    ++level;
+    indent(out, level) << "outer input";
+    this->child->print(out, level + 1);
+}
+
 void Match<m::wasm::Limit>::print(std::ostream &out, unsigned level) const
 {
     indent(out, level) << "wasm::Limit " << this->limit.schema() << print_info(this->limit)
@@ -38,16 +38,19 @@ enum class SortingImplementation : uint64_t {
 };
 
 enum class JoinImplementation : uint64_t {
-    ALL          = 0b111,
-    NESTED_LOOPS = 0b001,
-    SIMPLE_HASH  = 0b010,
-    SORT_MERGE   = 0b100,
+    ALL                = 0b11111,
+    NESTED_LOOPS       = 0b00001,
+    SIMPLE_HASH        = 0b00010,
+    SORT_MERGE         = 0b00100,
+    RADIX_HASH         = 0b01000,
+    INDEX_NESTED_LOOPS = 0b10000,
 };
 
 enum class IndexImplementation : uint64_t {
-    ALL   = 0b11,
-    ARRAY = 0b01,
-    RMI   = 0b10,
+    ALL        = 0b111,
+    ARRAY      = 0b001,
+    RMI        = 0b010,
+    BPLUS_TREE = 0b100,
 };
 
 enum class SoftPipelineBreakerStrategy : uint64_t {
@@ -184,6 +187,23 @@ inline double load_factor_chained = 1.5;
 /** Which initial capacity should be used for `wasm::HashTable`s. */
 inline std::optional<uint32_t> hash_table_initial_capacity;
 
+/** Which size in bytes a single partition of `wasm::RadixHashJoin` should not exceed, i.e. the size of the cache
+ * the partitions should fit in. */
+inline std::size_t radix_hash_join_partition_size = 256 * 1024;
+
+/** Which number of radix bits, i.e. the binary logarithm of the number of partitions, should be used for
+ * `wasm::RadixHashJoin`.  If not set, it is computed from the estimated size of the build input. */
+inline std::optional<uint32_t> radix_hash_join_radix_bits;
+
+/** Which number of groups a thread-local pre-aggregation table of `wasm::HashBasedGrouping` may hold before it is
+ * spilled, if the grouping is executed by multiple threads. */
+inline std::size_t parallel_grouping_preaggregation_capacity = 4096;
+
+/** Which number of radix bits, i.e. the binary logarithm of the number of partitions merged in parallel, should be used
+ * for `wasm::HashBasedGrouping` if executed by multiple threads.  If not set, it is derived from the number of
+ * threads. */
+inline std::optional<uint32_t> parallel_grouping_radix_bits;
+
 /** Whether to use `wasm::HashBasedGroupJoin` if possible. */
 inline bool hash_based_group_join = true;
 
@@ -209,6 +229,11 @@ inline std::size_t index_sequential_scan_batch_size = 1;
 /** Which window size should be used for the result set. */
 inline std::size_t result_set_window_size = 0;
 
+/** Which window size should be used for the result set of a `CallbackOperator` with a batch callback if
+ * `result_set_window_size` is 0, s.t. the result set is streamed to the callback instead of being materialized
+ * entirely.  0 means that such result sets are materialized entirely as well. */
+inline std::size_t streaming_result_set_window_size = 1UL << 16;
+
 /** Whether to exploit uniqueness of build key in hash joins. */
 inline bool exploit_unique_build = true;
 
@@ -239,6 +264,7 @@ namespace m {
     X(OrderedGrouping) \
     X(Aggregation) \
     X(NoOpSorting) \
+    X(IndexNestedLoopsJoin) \
     X(Limit) \
     X(HashBasedGroupJoin)
 #define M_WASM_OPERATOR_LIST_TEMPLATED(X) \
@@ -250,6 +276,7 @@ namespace m {
     X(Scan<true>) \
     X(IndexScan<m::idx::IndexMethod::Array>) \
     X(IndexScan<m::idx::IndexMethod::Rmi>) \
+    X(IndexScan<m::idx::IndexMethod::BPlusTree>) \
     X(Filter<false>) \
     X(Filter<true>) \
     X(Quicksort<false>) \
@@ -260,6 +287,8 @@ namespace m {
     X(SimpleHashJoin<M_COMMA(false) true>) \
     X(SimpleHashJoin<M_COMMA(true) false>) \
     X(SimpleHashJoin<M_COMMA(true) true>) \
+    X(RadixHashJoin<false>) \
+    X(RadixHashJoin<true>) \
     X(SortMergeJoin<M_COMMA(false) M_COMMA(false) M_COMMA(false) false>) \
     X(SortMergeJoin<M_COMMA(false) M_COMMA(false) M_COMMA(false) true>) \
     X(SortMergeJoin<M_COMMA(false) M_COMMA(false) M_COMMA(true)  false>) \
@@ -292,6 +321,7 @@ namespace m {
     X(m::Match<m::wasm::Scan<true>>) \
     X(m::Match<m::wasm::IndexScan<m::idx::IndexMethod::Array>>) \
     X(m::Match<m::wasm::IndexScan<m::idx::IndexMethod::Rmi>>) \
+    X(m::Match<m::wasm::IndexScan<m::idx::IndexMethod::BPlusTree>>) \
     X(m::Match<m::wasm::Filter<false>>) \
     X(m::Match<m::wasm::Filter<true>>) \
     X(m::Match<m::wasm::Quicksort<false>>) \
@@ -302,6 +332,8 @@ namespace m {
     X(m::Match<m::wasm::SimpleHashJoin<M_COMMA(false) true>>) \
     X(m::Match<m::wasm::SimpleHashJoin<M_COMMA(true) false>>) \
     X(m::Match<m::wasm::SimpleHashJoin<M_COMMA(true) true>>) \
+    X(m::Match<m::wasm::RadixHashJoin<false>>) \
+    X(m::Match<m::wasm::RadixHashJoin<true>>) \
     X(m::Match<m::wasm::SortMergeJoin<M_COMMA(false) M_COMMA(false) M_COMMA(false) false>>) \
     X(m::Match<m::wasm::SortMergeJoin<M_COMMA(false) M_COMMA(false) M_COMMA(false) true>>) \
     X(m::Match<m::wasm::SortMergeJoin<M_COMMA(false) M_COMMA(false) M_COMMA(true)  false>>) \
@@ -353,6 +385,9 @@ template<bool Predicated> struct Match<wasm::NestedLoopsJoin<Predicated>>;
 namespace wasm { template<bool UniqueBuild, bool Predicated> struct SimpleHashJoin; }
 template<bool UniqueBuild, bool Predicated> struct Match<wasm::SimpleHashJoin<UniqueBuild, Predicated>>;
 
+namespace wasm { template<bool UniqueBuild> struct RadixHashJoin; }
+template<bool UniqueBuild> struct Match<wasm::RadixHashJoin<UniqueBuild>>;
+
 namespace wasm { template<bool SortLeft, bool SortRight, bool Predicated, bool CmpPredicated> struct SortMergeJoin; }
 template<bool SortLeft, bool SortRight, bool Predicated, bool CmpPredicated>
 struct Match<wasm::SortMergeJoin<SortLeft, SortRight, Predicated, CmpPredicated>>;
@@ -542,6 +577,20 @@ struct SimpleHashJoin
                           std::vector<std::reference_wrapper<const ConditionSet>> &&post_cond_children);
 };
 
+template<bool UniqueBuild>
+struct RadixHashJoin
+    : PhysicalOperator<RadixHashJoin<UniqueBuild>, pattern_t<JoinOperator, Wildcard, Wildcard>>
+{
+    static void execute(const Match<RadixHashJoin> &M, setup_t setup, pipeline_t pipeline, teardown_t teardown);
+    static double cost(const Match<RadixHashJoin> &M);
+    static ConditionSet
+    pre_condition(std::size_t child_idx,
+                  const std::tuple<const JoinOperator*, const Wildcard*, const Wildcard*> &partial_inner_nodes);
+    static ConditionSet
+    adapt_post_conditions(const Match<RadixHashJoin> &M,
+                          std::vector<std::reference_wrapper<const ConditionSet>> &&post_cond_children);
+};
+
 template<bool SortLeft, bool SortRight, bool Predicated, bool CmpPredicated>
 struct SortMergeJoin
     : PhysicalOperator<SortMergeJoin<SortLeft, SortRight, Predicated, CmpPredicated>,
@@ -557,6 +606,22 @@ struct SortMergeJoin
                           std::vector<std::reference_wrapper<const ConditionSet>> &&post_cond_children);
 };
 
+/** Joins an arbitrary *outer* input with a scan of a table, the *inner* input, on an equi-predicate on an attribute of
+ * the table for which an `idx::HashIndex` exists.  Instead of scanning the table, every tuple of the outer input probes
+ * the hash index, whose memory is mapped into the Wasm module, and loads matching rows of the table directly. */
+struct IndexNestedLoopsJoin
+    : PhysicalOperator<IndexNestedLoopsJoin, pattern_t<JoinOperator, Wildcard, ScanOperator>>
+{
+    static void execute(const Match<IndexNestedLoopsJoin> &M, setup_t setup, pipeline_t pipeline,
+                        teardown_t teardown);
+    static double cost(const Match<IndexNestedLoopsJoin> &M);
+    static ConditionSet
+    pre_condition(std::size_t child_idx,
+                  const std::tuple<const JoinOperator*, const Wildcard*, const ScanOperator*> &partial_inner_nodes);
+    static ConditionSet adapt_post_condition(const Match<IndexNestedLoopsJoin> &M,
+                                             const ConditionSet &post_cond_child);
+};
+
 struct Limit : PhysicalOperator<Limit, LimitOperator>
 {
     static void execute(const Match<Limit> &M, setup_t setup, pipeline_t pipeline, teardown_t teardown);
@@ -683,7 +748,11 @@ struct Match<wasm::Callback<SIMDfied>> : wasm::MatchSingleChild
     Match(const CallbackOperator *callback, std::vector<unsharable_shared_ptr<const m::MatchBase>> &&children)
         : wasm::MatchSingleChild(std::move(children))
         , callback(*callback)
-    { }
+    {
+        /* Stream the result set to batch callbacks, which must not rely on receiving all results at once. */
+        if (result_set_window_size == 0 and callback->batch_callback())
+            result_set_window_size = options::streaming_result_set_window_size;
+    }
 
     void execute(setup_t setup, pipeline_t pipeline, teardown_t teardown) const override {
         wasm::Callback<SIMDfied>::execute(*this, std::move(setup), std::move(pipeline), std::move(teardown));
@@ -1111,6 +1180,46 @@ struct Match<wasm::SimpleHashJoin<UniqueBuild, Predicated>> : wasm::MatchMultipl
     void print(std::ostream &out, unsigned level) const override;
 };
 
+template<bool UniqueBuild>
+struct Match<wasm::RadixHashJoin<UniqueBuild>> : wasm::MatchMultipleChildren
+{
+    const JoinOperator &join;
+    const Wildcard &build;
+    const Wildcard &probe;
+    std::unique_ptr<const storage::DataLayoutFactory> build_materializing_factory =
+        M_notnull(options::hard_pipeline_breaker_layout.get())->clone();
+    std::unique_ptr<const storage::DataLayoutFactory> probe_materializing_factory =
+        M_notnull(options::hard_pipeline_breaker_layout.get())->clone();
+    bool use_open_addressing_hashing =
+        bool(options::hash_table_implementation bitand option_configs::HashTableImplementation::OPEN_ADDRESSING);
+    bool use_in_place_values = bool(options::hash_table_storing_strategy bitand option_configs::StoringStrategy::IN_PLACE);
+    bool use_quadratic_probing = bool(options::hash_table_probing_strategy bitand option_configs::ProbingStrategy::QUADRATIC);
+    double load_factor =
+        use_open_addressing_hashing ? options::load_factor_open_addressing : options::load_factor_chained;
+
+    Match(const JoinOperator *join, const Wildcard *build, const Wildcard *probe,
+          std::vector<unsharable_shared_ptr<const m::MatchBase>> &&children)
+        : wasm::MatchMultipleChildren(std::move(children))
+        , join(*join)
+        , build(*build)
+        , probe(*probe)
+    {
+        M_insist(children.size() == 2);
+    }
+
+    void execute(setup_t setup, pipeline_t pipeline, teardown_t teardown) const override {
+        wasm::RadixHashJoin<UniqueBuild>::execute(*this, std::move(setup), std::move(pipeline), std::move(teardown));
+    }
+
+    const Operator & get_matched_root() const override { return join; }
+
+    void accept(wasm::MatchBaseVisitor &v) override;
+    void accept(wasm::ConstMatchBaseVisitor &v) const override;
+
+    protected:
+    void print(std::ostream &out, unsigned level) const override;
+};
+
 template<bool SortLeft, bool SortRight, bool Predicated, bool CmpPredicated>
 struct Match<wasm::SortMergeJoin<SortLeft, SortRight, Predicated, CmpPredicated>> : wasm::MatchMultipleChildren
 {
@@ -1147,6 +1256,34 @@ struct Match<wasm::SortMergeJoin<SortLeft, SortRight, Predicated, CmpPredicated>
     void print(std::ostream &out, unsigned level) const override;
 };
 
+template<>
+struct Match<wasm::IndexNestedLoopsJoin> : wasm::MatchSingleChild
+{
+    const JoinOperator &join;
+    const Wildcard &outer;
+    const ScanOperator &scan;
+
+    Match(const JoinOperator *join, const Wildcard *outer, const ScanOperator *scan,
+          std::vector<unsharable_shared_ptr<const m::MatchBase>> &&children)
+        : wasm::MatchSingleChild(std::move(children))
+        , join(*join)
+        , outer(*outer)
+        , scan(*scan)
+    { }
+
+    void execute(setup_t setup, pipeline_t pipeline, teardown_t teardown) const override {
+        wasm::IndexNestedLoopsJoin::execute(*this, std::move(setup), std::move(pipeline), std::move(teardown));
+    }
+
+    const Operator & get_matched_root() const override { return join; }
+
+    void accept(wasm::MatchBaseVisitor &v) override;
+    void accept(wasm::ConstMatchBaseVisitor &v) const override;
+
+    protected:
+    void print(std::ostream &out, unsigned level) const override;
+};
+
 template<>
 struct Match<wasm::Limit> : wasm::MatchSingleChild
 {
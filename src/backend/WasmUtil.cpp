@@ -189,16 +189,27 @@ void ExprCompiler::operator()(const ast::Constant &e)
 
     /* Interpret constant. */
     auto value = Interpreter::eval(e);
+    /* Constants hoisted into imported globals are read from these, s.t. the code does not depend on their values. */
+    const char *global = CodeGenContext::Get().get_constant_global(e);
 
-    auto set_constant = [this, &e, &value]<std::size_t L>(){
+    auto set_constant = [this, &e, &value, global]<std::size_t L>(){
         auto set_helper = overloaded {
             [this]<sql_type T>(T &&actual) { this->set(std::forward<T>(actual)); },
             [](auto&&) { M_unreachable("not a SQL type"); }
         };
+        auto constant = [global]<dsl_primitive T>(T value) -> PrimitiveExpr<T, L> {
+            if (not global)
+                return PrimitiveExpr<T, L>(value);
+            auto imported = Module::Get().get_global<T>(global);
+            if constexpr (L == 1)
+                return imported;
+            else
+                return imported.template broadcast<L>();
+        };
 
         visit(overloaded {
             [&value, &set_helper](const Boolean&) { set_helper(_Bool<L>(value.as_b())); },
-            [&value, &set_helper](const Numeric &n) {
+            [&value, &set_helper, &constant](const Numeric &n) {
                 switch (n.kind) {
                     case Numeric::N_Int:
                     case Numeric::N_Decimal:
@@ -206,32 +217,34 @@ void ExprCompiler::operator()(const ast::Constant &e)
                             default:
                                 M_unreachable("invalid integer size");
                             case 8:
-                                set_helper(_I8<L>(value.as_i()));
+                                set_helper(_I8<L>(constant(int8_t(value.as_i()))));
                                 break;
                             case 16:
-                                set_helper(_I16<L>(value.as_i()));
+                                set_helper(_I16<L>(constant(int16_t(value.as_i()))));
                                 break;
                             case 32:
-                                set_helper(_I32<L>(value.as_i()));
+                                set_helper(_I32<L>(constant(int32_t(value.as_i()))));
                                 break;
                             case 64:
-                                set_helper(_I64<L>(value.as_i()));
+                                set_helper(_I64<L>(constant(int64_t(value.as_i()))));
                                 break;
                         }
                         break;
                     case Numeric::N_Float:
                         if (n.size() <= 32)
-                            set_helper(_Float<L>(value.as_f()));
+                            set_helper(_Float<L>(constant(float(value.as_f()))));
                         else
-                            set_helper(_Double<L>(value.as_d()));
+                            set_helper(_Double<L>(constant(double(value.as_d()))));
                 }
             },
             [this, &value](const CharacterSequence&) {
                 M_insist(L == 1, "string SIMDfication currently not supported");
                 set(CodeGenContext::Get().get_literal_address(value.as<const char*>()));
             },
-            [&value, &set_helper](const Date&) { set_helper(_I32<L>(value.as_i())); },
-            [&value, &set_helper](const DateTime&) { set_helper(_I64<L>(value.as_i())); },
+            [&value, &set_helper, &constant](const Date&) { set_helper(_I32<L>(constant(int32_t(value.as_i())))); },
+            [&value, &set_helper, &constant](const DateTime&) {
+                set_helper(_I64<L>(constant(int64_t(value.as_i()))));
+            },
             [](const NoneType&) { M_unreachable("should've been handled earlier"); },
             [](auto&&) { M_unreachable("invalid type for given number of SIMD lanes"); },
         }, *e.type());
@@ -359,8 +372,10 @@ void ExprCompiler::operator()(const ast::BinaryExpr &e)
             (*this)(*e.lhs);
             NChar str = get<NChar>();
             if (auto static_pattern = cast<ast::Constant>(e.rhs.get())) { // check whether specialization is applicable
+                auto param = cast<ast::Parameter>(static_pattern); // a parameter's pattern is known once it is bound
+                const ast::Token &pattern_tok = param ? param->value() : static_pattern->tok;
                 auto pattern = Catalog::Get().pool(
-                    interpret(*static_pattern->tok.text.assert_not_none()) // interpret pattern to handle escaped chars
+                    interpret(*pattern_tok.text.assert_not_none()) // interpret pattern to handle escaped chars
                 );
                 if (std::regex_match(*pattern, std::regex("%[^_%\\\\]+%"))) { // contains expression
                     set(like_contains(str, pattern));
@@ -555,6 +570,36 @@ namespace m {
 
 namespace wasm {
 
+/** Loads the unsigned code of an encoded leaf of encoding \p enc stored at address \p ptr and zero-extends it to `T`. */
+template<std::integral T>
+PrimitiveExpr<T> load_code(Ptr<void> ptr, const storage::DataLayout::encoding_t &enc)
+{
+    switch (enc.stored_type->size()) {
+        default: M_unreachable("invalid code size");
+        case  8: return PrimitiveExpr<uint8_t> (*ptr.to<uint8_t*>() ).template to<T>();
+        case 16: return PrimitiveExpr<uint16_t>(*ptr.to<uint16_t*>()).template to<T>();
+        case 32: return PrimitiveExpr<uint32_t>(*ptr.to<uint32_t*>()).template to<T>();
+    }
+}
+
+/** Decodes the value of the frame-of-reference encoded leaf of encoding \p enc whose code is stored at address
+ * \p ptr. */
+template<std::integral T>
+PrimitiveExpr<T> decode_frame_of_reference(Ptr<void> ptr, const storage::DataLayout::encoding_t &enc)
+{
+    M_insist(enc.kind == storage::DataLayout::encoding_t::E_FrameOfReference);
+    return load_code<T>(ptr, enc) + PrimitiveExpr<T>(T(enc.reference));
+}
+
+/** Returns the address of the dictionary entry of the dictionary encoded leaf of encoding \p enc whose code is stored
+ * at address \p ptr.  The dictionary must have been mapped into the module, see `CodeGenContext::add_dictionary()`. */
+Ptr<Charx1> decode_dictionary(Ptr<void> ptr, const storage::DataLayout::encoding_t &enc)
+{
+    M_insist(enc.kind == storage::DataLayout::encoding_t::E_Dictionary);
+    I32x1 entry_offset = load_code<int32_t>(ptr, enc) * int32_t(enc.entry_size);
+    return CodeGenContext::Get().get_dictionary_address(enc.dictionary->data()) + entry_offset;
+}
+
 /** Compiles the data layout \p layout containing tuples of schema \p layout_schema such that it sequentially
  * stores/loads (depending on \tparam IsStore) tuples of schema \p _tuple_value_schema starting at memory address \p
  * base_address and tuple ID \p tuple_id.  If \tparam SinglePass, the store has to be done in a single pass, i.e. the
@@ -1165,6 +1210,10 @@ compile_data_layout_sequential(const Schema &_tuple_value_schema, const Schema &
                 M_insist(*tuple_it->type == *layout_entry.type);
                 const auto tuple_value_idx = std::distance(tuple_value_schema.begin(), tuple_value_it);
                 const auto tuple_addr_idx = std::distance(tuple_addr_schema.begin(), tuple_addr_it);
+                auto &enc = leaf_info.leaf.encoding();
+                M_insist(not enc or not IsStore, "storing to encoded leaves not supported");
+                M_insist(not enc or L == 1, "SIMDfied loading of encoded leaves currently not supported");
+                M_insist(not enc or tuple_addr_it == tuple_addr_schema.end(), "encoded values have no address");
 
                 if (bit_stride) { // entry with bit stride requires dynamic masking (for scalar loading)
                     M_insist(tuple_it->type->is_boolean(),
@@ -1328,10 +1377,21 @@ compile_data_layout_sequential(const Schema &_tuple_value_schema, const Schema &
                                      "leaf offset of `Numeric`, `Date`, or `DateTime` must be byte aligned");
                             BLOCK_OPEN(loads) {
                                 if (tuple_value_it != tuple_value_schema.end()) {
-                                    Var<PrimitiveExpr<type, lanes>> value(
-                                        *(ptr + static_byte_offset).template to<type*, lanes>()
-                                    );
-                                    new (&values[tuple_value_idx]) SQL_t(T(value));
+                                    if (enc) {
+                                        if constexpr (lanes == 1 and std::integral<type> and sizeof(type) > 1) {
+                                            Var<PrimitiveExpr<type>> value(
+                                                decode_frame_of_reference<type>(ptr + static_byte_offset, enc)
+                                            );
+                                            new (&values[tuple_value_idx]) SQL_t(T(value));
+                                        } else {
+                                            M_unreachable("invalid type of frame-of-reference encoded leaf");
+                                        }
+                                    } else {
+                                        Var<PrimitiveExpr<type, lanes>> value(
+                                            *(ptr + static_byte_offset).template to<type*, lanes>()
+                                        );
+                                        new (&values[tuple_value_idx]) SQL_t(T(value));
+                                    }
                                 }
                                 if (tuple_addr_it != tuple_addr_schema.end())
                                     new (&addrs[tuple_addr_idx]) SQL_addr_t(
@@ -1415,7 +1475,8 @@ compile_data_layout_sequential(const Schema &_tuple_value_schema, const Schema &
                             } else {
                                 /*----- Load value. -----*/
                                 BLOCK_OPEN(loads) {
-                                    Ptr<Charx1> address((ptr + static_byte_offset).template to<char*>());
+                                    Ptr<Charx1> address(enc ? decode_dictionary(ptr + static_byte_offset, enc)
+                                                            : (ptr + static_byte_offset).template to<char*>());
                                     new (&values[tuple_value_idx]) SQL_t(
                                         NChar(address, layout_entry.nullable(), cs.length, cs.is_varying)
                                     );
@@ -2273,6 +2334,9 @@ void compile_data_layout_point_access(const Schema &_tuple_value_schema, const S
                 M_insist(*tuple_it->type == *layout_entry.type);
                 const auto tuple_value_idx = std::distance(tuple_value_schema.begin(), tuple_value_it);
                 const auto tuple_addr_idx = std::distance(tuple_addr_schema.begin(), tuple_addr_it);
+                auto &enc = leaf_info.leaf.encoding();
+                M_insist(not enc or not IsStore, "storing to encoded leaves not supported");
+                M_insist(not enc or tuple_addr_it == tuple_addr_schema.end(), "encoded values have no address");
 
                 if (bit_stride) { // entry with bit stride requires dynamic masking
                     M_insist(tuple_it->type->is_boolean(), "leaf bit stride currently only for `Boolean` supported");
@@ -2335,8 +2399,19 @@ void compile_data_layout_point_access(const Schema &_tuple_value_schema, const S
                         M_insist(static_bit_offset == 0,
                                  "leaf offset of `Numeric`, `Date`, or `DateTime` must be byte aligned");
                         if (tuple_value_it != tuple_value_schema.end()) {
-                            Var<PrimitiveExpr<type>> value(*(ptr.clone() + static_byte_offset).template to<type*>());
-                            new (&values[tuple_value_idx]) SQL_t(T(value));
+                            if (enc) {
+                                if constexpr (std::integral<type> and sizeof(type) > 1) {
+                                    Var<PrimitiveExpr<type>> value(
+                                        decode_frame_of_reference<type>(ptr.clone() + static_byte_offset, enc)
+                                    );
+                                    new (&values[tuple_value_idx]) SQL_t(T(value));
+                                } else {
+                                    M_unreachable("invalid type of frame-of-reference encoded leaf");
+                                }
+                            } else {
+                                Var<PrimitiveExpr<type>> value(*(ptr.clone() + static_byte_offset).template to<type*>());
+                                new (&values[tuple_value_idx]) SQL_t(T(value));
+                            }
                         }
                         if (tuple_addr_it != tuple_addr_schema.end())
                             new (&addrs[tuple_addr_idx]) SQL_addr_t(
@@ -2388,7 +2463,8 @@ void compile_data_layout_point_access(const Schema &_tuple_value_schema, const S
                         },
                         [&](const CharacterSequence &cs) {
                             M_insist(static_bit_offset == 0, "leaf offset of `CharacterSequence` must be byte aligned");
-                            Ptr<Charx1> addr = (ptr + static_byte_offset).template to<char*>();
+                            Ptr<Charx1> addr = enc ? decode_dictionary(ptr + static_byte_offset, enc)
+                                                   : (ptr + static_byte_offset).template to<char*>();
                             if constexpr (IsStore) {
                                 /*----- Store value. -----*/
                                 auto value = env.get<NChar>(tuple_it->id); // get value
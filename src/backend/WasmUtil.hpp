@@ -845,6 +845,8 @@ struct Scope
  * - an `ExprCompiler` to compile expressions within the current `Environment`
  * - the number of tuples written to the result set
  * / the number of SIMD lanes currently used
+ * - the number of tuples per morsel if the query is executed morsel-driven
+ * - the number of threads executing instances of the module concurrently
  */
 struct CodeGenContext
 {
@@ -854,10 +856,20 @@ struct CodeGenContext
     Environment *env_ = nullptr; ///< environment for locally bound identifiers
     Global<U32x1> num_tuples_; ///< variable to hold the number of result tuples produced
     std::unordered_map<const char*, NChar> literals_; ///< maps each literal to its address at which it is stored
+    ///> maps each dictionary of an encoded `storage::DataLayout::Leaf` to its address at which it is stored
+    std::unordered_map<const char*, uint32_t> dictionaries_;
+    ///> maps each constant that is hoisted into an imported global to the name of this global
+    std::unordered_map<const ast::Constant*, std::string> constants_;
+    ///> maps each index whose memory is exposed to generated code to the address at which the memory is mapped
+    std::unordered_map<const idx::IndexBase*, uint32_t> indexes_;
     ///> number of SIMD lanes currently used, i.e. 1 for scalar and at least 2 for vectorial values
     std::size_t num_simd_lanes_ = 1;
     ///> number of SIMD lanes currently preferred, i.e. 1 for scalar and at least 2 for vectorial values
     std::size_t num_simd_lanes_preferred_ = 1;
+    ///> number of tuples per morsel if the query is executed morsel-driven, 0 otherwise
+    std::size_t morsel_size_ = 0;
+    ///> number of threads executing instances of the module concurrently, i.e. 1 for single-threaded execution
+    std::size_t num_threads_ = 1;
 
     public:
     CodeGenContext() = default;
@@ -923,6 +935,45 @@ struct CodeGenContext
         return it->second.clone();
     }
 
+    /** Adds the dictionary `dictionary` of an encoded `storage::DataLayout::Leaf` located at pointer offset `ptr`. */
+    void add_dictionary(const char *dictionary, uint32_t ptr) {
+        auto [_, inserted] = dictionaries_.emplace(dictionary, ptr);
+        M_insist(inserted);
+    }
+    /** Returns the address at which `dictionary` is stored. */
+    Ptr<Charx1> get_dictionary_address(const char *dictionary) const {
+        auto it = dictionaries_.find(dictionary);
+        M_insist(it != dictionaries_.end(), "unknown dictionary");
+        return Ptr<Charx1>(U32x1(it->second));
+    }
+
+    /** Adds the constant `constant` that is hoisted into the imported global `name`. */
+    void add_constant(const ast::Constant &constant, std::string name) {
+        auto [_, inserted] = constants_.emplace(&constant, std::move(name));
+        M_insist(inserted);
+    }
+    /** Returns the name of the imported global `constant` is hoisted into, or `nullptr` if `constant` is compiled into
+     * the code. */
+    const char * get_constant_global(const ast::Constant &constant) const {
+        auto it = constants_.find(&constant);
+        return it != constants_.end() ? it->second.c_str() : nullptr;
+    }
+
+    /** Adds the exposed memory of index `index` located at pointer offset `ptr`, see
+     * `idx::IndexBase::exposed_memory()`. */
+    void add_index(const idx::IndexBase &index, uint32_t ptr) {
+        auto [_, inserted] = indexes_.emplace(&index, ptr);
+        M_insist(inserted);
+    }
+    /** Returns `true` iff the exposed memory of index `index` was added. */
+    bool has_index(const idx::IndexBase &index) const { return indexes_.contains(&index); }
+    /** Returns the address at which the exposed memory of `index` is stored. */
+    Ptr<void> get_index_address(const idx::IndexBase &index) const {
+        auto it = indexes_.find(&index);
+        M_insist(it != indexes_.end(), "unknown index");
+        return Ptr<void>(U32x1(it->second));
+    }
+
     /** Returns the number of SIMD lanes used. */
     std::size_t num_simd_lanes() const { return num_simd_lanes_; }
     /** Sets the number of SIMD lanes used to `n`. */
@@ -934,6 +985,17 @@ struct CodeGenContext
     void update_num_simd_lanes_preferred(std::size_t n) {
         num_simd_lanes_preferred_ = std::max(num_simd_lanes_preferred_, n);
     }
+
+    /** Returns the number of tuples per morsel if the query is executed morsel-driven, 0 otherwise. */
+    std::size_t morsel_size() const { return morsel_size_; }
+    /** Sets the number of tuples per morsel to `n` to execute the query morsel-driven, or 0 to disable it. */
+    void set_morsel_size(std::size_t n) { morsel_size_ = n; }
+
+    /** Returns the number of threads executing instances of the module concurrently. */
+    std::size_t num_threads() const { return num_threads_; }
+    /** Sets the number of threads executing instances of the module concurrently to `n`.  For `n > 1`, operators
+     * keeping state across tuples must exchange their thread-local state via the host. */
+    void set_num_threads(std::size_t n) { M_insist(n != 0); num_threads_ = n; }
 };
 
 inline Scope::Scope(Environment inner)
@@ -73,15 +73,25 @@ uint32_t WasmEngine::WasmContext::map_table(const Table &table)
     const std::size_t num_instances = (table.store().num_rows() + num_rows_per_instance - 1) / num_rows_per_instance;
     const std::size_t bytes = instance_stride_in_bytes * num_instances;
 
-    /* Map entry into WebAssembly linear memory. */
+    return map_memory(table.store().memory(), bytes);
+}
+
+uint32_t WasmEngine::WasmContext::map_memory(const memory::Memory &mem, std::size_t bytes)
+{
+    M_insist(Is_Page_Aligned(heap));
+
+    if (bytes == 0)
+        return heap;
+
+    /* Map memory into WebAssembly linear memory.  Memory backed by huge pages must be mapped at and in whole multiples
+     * of huge pages, hence align to the pages of the memory's allocator. */
+    const auto page_size = mem.allocator().page_size();
+    heap = ((heap - 1UL) | (page_size - 1UL)) + 1UL;
     const auto off = heap;
-    const auto aligned_bytes = Ceil_To_Next_Page(bytes);
-    const auto &mem = table.store().memory();
-    if (aligned_bytes) {
-        mem.map(aligned_bytes, 0, vm, off);
-        heap += aligned_bytes;
-        install_guard_page();
-    }
+    const auto aligned_bytes = ((bytes - 1UL) | (page_size - 1UL)) + 1UL;
+    mem.map(aligned_bytes, 0, vm, off);
+    heap += aligned_bytes;
+    install_guard_page();
     M_insist(Is_Page_Aligned(heap));
 
     return off;
@@ -413,15 +413,16 @@ ThreadSafePooledString InjectionCardinalityEstimator::make_identifier(const Quer
         names.emplace_back(G.sources()[id]->name());
     std::sort(names.begin(), names.end(), [](auto lhs, auto rhs){ return strcmp(*lhs, *rhs) < 0; });
 
-    buf_.clear();
+    /* Use a buffer per thread, s.t. joins can be estimated concurrently, e.g. by `DPccpParallel`. */
+    static thread_local std::string buf;
+    buf.clear();
     for (auto it = names.begin(); it != names.end(); ++it) {
         if (it != names.begin())
-            buf_.emplace_back('$');
-        buf_append(**it);
+            buf += '$';
+        buf += **it;
     }
 
-    buf_.emplace_back(0);
-    return C.pool(buf_view());
+    return C.pool(buf.c_str());
 }
 
 
@@ -445,6 +446,8 @@ struct FilterTranslator : ast::ConstASTExprVisitor {
     void operator()(const ast::Designator &designator) { attribute = designator.attr_name.text.assert_not_none(); }
 
     void operator()(const ast::Constant &constant) {
+        if (auto param = cast<const ast::Parameter>(&constant); param and not param->is_bound())
+            return; // the value of the parameter is yet unknown
         auto val = Interpreter::eval(constant);
 
         visit(overloaded {
@@ -1,6 +1,7 @@
 #include <mutable/catalog/Catalog.hpp>
 
 #include "backend/Interpreter.hpp"
+#include "catalog/GarbageCollector.hpp"
 #include "storage/ColumnStore.hpp"
 #include "storage/PaxStore.hpp"
 #include "storage/RowStore.hpp"
@@ -15,6 +16,7 @@ using namespace m;
  *====================================================================================================================*/
 
 Catalog * Catalog::the_catalog_(nullptr);
+thread_local Timer * Catalog::thread_timer_(nullptr);
 
 Catalog::Catalog()
     : allocator_(new memory::LinearAllocator())
@@ -32,12 +34,19 @@ Catalog::Catalog()
 
 Catalog::~Catalog()
 {
+    garbage_collector_.reset(); // stop collecting garbage before the databases are destroyed
     for (auto db : databases_)
         delete db.second;
     for (auto fn : standard_functions_)
         delete fn.second;
 }
 
+void Catalog::garbage_collector(std::unique_ptr<GarbageCollector> garbage_collector)
+{
+    garbage_collector_.reset();
+    garbage_collector_ = std::move(garbage_collector);
+}
+
 __attribute__((constructor(200)))
 Catalog & Catalog::Get()
 {
@@ -74,6 +83,16 @@ void Catalog::drop_database(const ThreadSafePooledString &name)
     databases_.erase(it);
 }
 
+/** Applies the default `memory::Placement` to the allocator of \p C, which is created before command-line arguments are
+ * parsed.  Its memory file already exists, hence explicit huge pages are replaced by transparent huge pages. */
+static void update_catalog_placement(Catalog &C)
+{
+    auto P = memory::Placement::Default();
+    if (P.huge_pages == memory::Placement::HP_Explicit)
+        P.huge_pages = memory::Placement::HP_Transparent;
+    C.allocator().placement(P);
+}
+
 __attribute__((constructor(201)))
 static void add_catalog_args()
 {
@@ -150,4 +169,44 @@ static void add_catalog_args()
             }
         }
     );
+    C.arg_parser().add<const char*>(
+        /* group=       */ "Memory",
+        /* short=       */ nullptr,
+        /* long=        */ "--huge-pages",
+        /* description= */ "back table data with huge pages: none, transparent, or explicit (from the huge page pool)",
+        [&C] (const char *str) {
+            auto &P = memory::Placement::Default();
+            if (streq(str, "none")) {
+                P.huge_pages = memory::Placement::HP_None;
+            } else if (streq(str, "transparent")) {
+                P.huge_pages = memory::Placement::HP_Transparent;
+            } else if (streq(str, "explicit")) {
+                P.huge_pages = memory::Placement::HP_Explicit;
+            } else {
+                std::cerr << "There is no huge page mode with the name \"" << str << "\".\n";
+                std::exit(EXIT_FAILURE);
+            }
+            update_catalog_placement(C);
+        }
+    );
+    C.arg_parser().add<unsigned>(
+        /* group=       */ "Memory",
+        /* short=       */ nullptr,
+        /* long=        */ "--numa-node",
+        /* description= */ "bind table data and WebAssembly memory to the given NUMA node",
+        [&C] (unsigned node) {
+            memory::Placement::Default().numa_node = node;
+            update_catalog_placement(C);
+        }
+    );
+    C.arg_parser().add<bool>(
+        /* group=       */ "Memory",
+        /* short=       */ nullptr,
+        /* long=        */ "--numa-interleave",
+        /* description= */ "interleave table data and WebAssembly memory across all NUMA nodes",
+        [&C] (bool interleave) {
+            memory::Placement::Default().numa_interleave = interleave;
+            update_catalog_placement(C);
+        }
+    );
 }
@@ -0,0 +1,309 @@
+#include "catalog/ConcurrentScheduler.hpp"
+#include "parse/Sema.hpp"
+#include <algorithm>
+#include <mutable/mutable.hpp>
+
+
+using namespace m;
+
+
+namespace {
+
+void collect_tables(const ast::Stmt &stmt, std::map<std::string, bool> &tables);
+
+/** Adds all tables read by queries nested in \p expr to \p tables. */
+void collect_tables(const ast::Expr &expr, std::map<std::string, bool> &tables)
+{
+    visit(overloaded {
+        [](auto&) { },
+        [&tables](const ast::QueryExpr &e) { collect_tables(*e.query, tables); },
+    }, expr, m::tag<ast::ConstPreOrderExprVisitor>());
+}
+
+/** Adds all tables read by the `SelectStmt` \p stmt, including tables read by nested queries, to \p tables. */
+void collect_tables(const ast::Stmt &stmt, std::map<std::string, bool> &tables)
+{
+    auto S = cast<const ast::SelectStmt>(&stmt);
+    if (not S) return;
+
+    if (auto select = cast<const ast::SelectClause>(S->select.get())) {
+        for (auto &s : select->select)
+            collect_tables(*s.first, tables);
+    }
+    if (auto from = cast<const ast::FromClause>(S->from.get())) {
+        for (auto &f : from->from) {
+            if (auto name = std::get_if<ast::Token>(&f.source)) {
+                if (name->text.has_value())
+                    tables.try_emplace(*name->text.assert_not_none(), false);
+            } else {
+                collect_tables(*M_notnull(std::get<ast::Stmt*>(f.source)), tables);
+            }
+        }
+    }
+    if (auto where = cast<const ast::WhereClause>(S->where.get()))
+        collect_tables(*where->where, tables);
+    if (auto group_by = cast<const ast::GroupByClause>(S->group_by.get())) {
+        for (auto &g : group_by->group_by)
+            collect_tables(*g.first, tables);
+    }
+    if (auto having = cast<const ast::HavingClause>(S->having.get()))
+        collect_tables(*having->having, tables);
+    if (auto order_by = cast<const ast::OrderByClause>(S->order_by.get())) {
+        for (auto &o : order_by->order_by)
+            collect_tables(*o.first, tables);
+    }
+}
+
+/** Adds the table \p name to \p tables as being written. */
+void add_written_table(const ast::Token &name, std::map<std::string, bool> &tables)
+{
+    if (name.text.has_value())
+        tables[*name.text.assert_not_none()] = true;
+}
+
+}
+
+
+/*======================================================================================================================
+ * ConcurrentScheduler::CommandQueue
+ *====================================================================================================================*/
+
+std::optional<m::Scheduler::queued_command> ConcurrentScheduler::CommandQueue::pop()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    for (;;) {
+        if (closed_) [[unlikely]]
+            return std::nullopt;
+
+        /* Find the oldest command whose transaction is not running, s.t. the commands of a transaction are executed
+         * one at a time and in order. */
+        auto it = std::find_if(command_list_.begin(), command_list_.end(), [this](queued_command &x) {
+            return not running_transactions_.contains(&std::get<0>(x));
+        });
+        if (it != command_list_.end()) {
+            queued_command res = std::move(*it);
+            command_list_.erase(it);
+            running_transactions_.insert(&std::get<0>(res));
+            return {std::move(res)};
+        }
+
+        has_element_.wait(lock);
+    }
+}
+
+void ConcurrentScheduler::CommandQueue::push(Transaction &t, std::unique_ptr<ast::Command> command, Diagnostic &diag,
+                                             std::promise<bool> promise)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (closed_) {
+        /* Since the command queue is closed, no more command will be executed
+         * => set the promise of this newly pushed command to false right away */
+        promise.set_value(false);
+        return;
+    }
+    command_list_.emplace_back(t, std::move(command), diag, std::move(promise));
+    lock.unlock();
+    has_element_.notify_one();
+}
+
+void ConcurrentScheduler::CommandQueue::close()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    closed_ = true;
+    while (not command_list_.empty()) {
+        std::get<3>(command_list_.front()).set_value(false);
+        command_list_.pop_front();
+    }
+    lock.unlock();
+    has_element_.notify_all();
+}
+
+void ConcurrentScheduler::CommandQueue::finish(Transaction &t)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    M_insist(running_transactions_.contains(&t));
+    running_transactions_.erase(&t);
+    lock.unlock();
+    has_element_.notify_all(); // a command of `t` may be waiting while other workers wait for other commands
+}
+
+
+/*======================================================================================================================
+ * ConcurrentScheduler
+ *====================================================================================================================*/
+
+std::atomic<int64_t> ConcurrentScheduler::next_start_time = 0;
+
+ConcurrentScheduler::~ConcurrentScheduler()
+{
+    query_queue_.close();
+    for (auto &worker : workers_) {
+        if (worker.joinable())
+            worker.join();
+    }
+}
+
+std::future<bool> ConcurrentScheduler::schedule_command(Transaction &t, std::unique_ptr<ast::Command> command,
+                                                        Diagnostic &diag)
+{
+    std::promise<bool> execution_completed;
+    auto execution_completed_future = execution_completed.get_future();
+    query_queue_.push(t, std::move(command), diag, std::move(execution_completed));
+
+    /* Creating the worker threads not here but in the constructor causes deadlocks, see `SerialScheduler`. */
+    std::call_once(workers_started_, [this]() {
+        const std::size_t n = num_threads_ ? num_threads_ : std::max(1U, std::thread::hardware_concurrency());
+        workers_.reserve(n);
+        for (std::size_t i = 0; i != n; ++i)
+            workers_.emplace_back(&ConcurrentScheduler::worker_thread, this);
+    });
+    return execution_completed_future;
+}
+
+std::unique_ptr<ConcurrentScheduler::Transaction> ConcurrentScheduler::begin_transaction() {
+    return std::make_unique<ConcurrentScheduler::Transaction>();
+}
+
+bool ConcurrentScheduler::commit(std::unique_ptr<ConcurrentScheduler::Transaction>) {
+    /* Every command releases its locks after execution and hence its changes are visible right away. */
+    return true;
+}
+
+bool ConcurrentScheduler::abort(std::unique_ptr<ConcurrentScheduler::Transaction>) {
+    /* TODO: Undo changes of transaction */
+    return true;
+}
+
+bool ConcurrentScheduler::get_table_accesses(const ast::Command &command, table_access_map &tables)
+{
+    if (auto S = cast<const ast::SelectStmt>(&command)) {
+        collect_tables(*S, tables);
+        return true;
+    }
+    if (auto I = cast<const ast::InsertStmt>(&command)) {
+        for (auto &tuple : I->tuples) {
+            for (auto &elem : tuple) {
+                if (elem.second)
+                    collect_tables(*elem.second, tables);
+            }
+        }
+        add_written_table(I->table_name, tables);
+        return true;
+    }
+    if (auto U = cast<const ast::UpdateStmt>(&command)) {
+        for (auto &s : U->set)
+            collect_tables(*s.second, tables);
+        if (auto where = cast<const ast::WhereClause>(U->where.get()))
+            collect_tables(*where->where, tables);
+        add_written_table(U->table_name, tables);
+        return true;
+    }
+    if (auto D = cast<const ast::DeleteStmt>(&command)) {
+        if (auto where = cast<const ast::WhereClause>(D->where.get()))
+            collect_tables(*where->where, tables);
+        add_written_table(D->table_name, tables);
+        return true;
+    }
+    return false; // DDL, imports, instructions, and erroneous statements
+}
+
+reader_writer_mutex & ConcurrentScheduler::table_mutex(const std::string &name)
+{
+    std::lock_guard<std::mutex> lock(table_mutexes_mutex_);
+    auto &mutex = table_mutexes_[name];
+    if (not mutex)
+        mutex = std::make_unique<reader_writer_mutex>();
+    return *mutex;
+}
+
+ConcurrentScheduler::lock_set ConcurrentScheduler::acquire_locks(const ast::Command &command)
+{
+    lock_set locks;
+    table_access_map tables;
+    if (not get_table_accesses(command, tables)) {
+        locks.catalog_write.emplace(catalog_mutex_);
+        return locks;
+    }
+
+    locks.catalog_read.emplace(catalog_mutex_);
+    for (auto &[name, is_write] : tables) { // in lexicographical order of the names to avoid deadlocks
+        if (is_write)
+            locks.table_writes.emplace_back(table_mutex(name));
+        else
+            locks.table_reads.emplace_back(table_mutex(name));
+    }
+    return locks;
+}
+
+bool ConcurrentScheduler::execute(Transaction &t, std::unique_ptr<ast::Command> ast, Diagnostic &diag)
+{
+    Catalog &C = Catalog::Get();
+    bool err = diag.num_errors() > 0; // parser errors
+
+    /* Acquire the locks before the semantic analysis, s.t. the analyzed schema does not change concurrently. */
+    auto locks = acquire_locks(*ast);
+
+    /* Record measurements separately from concurrently executed commands. */
+    Timer timer;
+    C.thread_timer(&timer);
+
+    ast::Sema sema(diag);
+    diag.clear();
+    auto cmd = sema.analyze(std::move(ast));
+    err |= diag.num_errors() > 0; // sema errors
+
+    M_insist(not err == bool(cmd), "when there are no errors, Sema must have returned a command");
+    if (not err and cmd) {
+        cmd->transaction(&t);
+        cmd->execute(diag);
+    }
+
+    /* Merge the measurements into the global timer. */
+    C.thread_timer(nullptr);
+    {
+        std::lock_guard<std::mutex> lock(timer_mutex_);
+        for (auto &M : timer) {
+            if (M.is_finished())
+                C.timer().add(M.name, M.begin, M.end);
+        }
+        for (auto &[name, value] : timer.counters())
+            C.timer().increment(name, value);
+    }
+
+    return not err and cmd;
+}
+
+void ConcurrentScheduler::worker_thread()
+{
+    while (auto ret = query_queue_.pop()) {
+        auto [t, ast, diag, promise] = std::move(ret.value());
+
+        // check if transaction has a start_time, set one if not. -1 represents an undefined value.
+        if (t.start_time() == -1) t.start_time(next_start_time++);
+        if (next_start_time < 0) [[unlikely]] M_unreachable("Transaction timestamp overflow");
+
+        const bool success = execute(t, std::move(ast), diag);
+        query_queue_.finish(t);
+        promise.set_value(success);
+    }
+}
+
+__attribute__((constructor(202)))
+static void register_concurrent_scheduler()
+{
+    Catalog &C = Catalog::Get();
+    auto scheduler = std::make_unique<ConcurrentScheduler>();
+    C.arg_parser().add<std::size_t>(
+        /* group=       */ "Scheduler",
+        /* short=       */ nullptr,
+        /* long=        */ "--scheduler-threads",
+        /* description= */ "set the number of worker threads of the ConcurrentScheduler (0 means one per hardware "
+                           "thread)",
+        /* callback=    */ [S=scheduler.get()](std::size_t n){ S->num_threads(n); }
+    );
+    C.register_scheduler(
+        C.pool("ConcurrentScheduler"),
+        std::move(scheduler),
+        "executes independent queries concurrently on a pool of worker threads"
+    );
+}
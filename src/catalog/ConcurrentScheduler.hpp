@@ -0,0 +1,120 @@
+#pragma once
+
+#include <mutable/catalog/Scheduler.hpp>
+#include <mutable/util/reader_writer_lock.hpp>
+#include <condition_variable>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+
+namespace m {
+
+/** This class implements a Scheduler that executes independent `ast::Command`s concurrently on a pool of worker
+ * threads.
+ *
+ * Commands of the same `Transaction` are executed one at a time and in the order they were scheduled.  To keep
+ * conflicting commands serialized, every command acquires locks before its semantic analysis:
+ *  - queries (`SELECT`) acquire a read lock on every table they read, including tables read by nested queries,
+ *  - `INSERT`, `UPDATE`, and `DELETE` acquire a write lock on the table they modify and read locks on all tables read
+ *    by nested queries, and
+ *  - all other commands, e.g. DDL, imports, and instructions, acquire an exclusive lock on the entire catalog.
+ *
+ * Table locks are acquired in lexicographical order of the table names to avoid deadlocks.  Consequently, read-only
+ * queries run concurrently with each other and with writes to other tables, while the outcome of every command is
+ * the same as in a serial execution. */
+struct ConcurrentScheduler : Scheduler
+{
+    private:
+    /** A thread-safe query queue. */
+    struct CommandQueue
+    {
+        private:
+        std::list<queued_command> command_list_;
+        ///> transactions of which a command is currently being executed.  No other command of them is returned.
+        std::unordered_set<const Transaction*> running_transactions_;
+        std::mutex mutex_;
+        std::condition_variable has_element_;
+        bool closed_ = false;
+
+        public:
+        CommandQueue() = default;
+        ~CommandQueue() = default;
+
+        /** Returns the oldest queued `ast::Command` whose `Transaction` has no command in execution and marks that
+         * `Transaction` as running.  Returns `std::nullopt` if the queue is closed. */
+        std::optional<queued_command> pop();
+        /** Inserts the command at the end of the queue. */
+        void push(Transaction &t, std::unique_ptr<ast::Command> command, Diagnostic &diag, std::promise<bool> promise);
+        void close(); ///< empties and closes the queue without executing the remaining `ast::Command`s.
+        void finish(Transaction &t); ///< marks the running command of `t` as completed
+    };
+
+    /** The locks held by a command during its execution. */
+    struct lock_set
+    {
+        std::optional<read_lock> catalog_read;
+        std::optional<write_lock> catalog_write;
+        std::vector<read_lock> table_reads;
+        std::vector<write_lock> table_writes;
+    };
+
+    ///> maps the names of the tables accessed by a command to whether the command writes to the table
+    using table_access_map = std::map<std::string, bool>;
+
+    CommandQueue query_queue_; ///< the queue of all scheduled commands
+    std::vector<std::thread> workers_; ///< the worker threads executing the scheduled commands
+    std::once_flag workers_started_; ///< whether the worker threads have been started
+    std::size_t num_threads_ = 0; ///< the number of worker threads; 0 means one per hardware thread
+
+    reader_writer_mutex catalog_mutex_; ///< held exclusively by commands that change the catalog
+    std::mutex table_mutexes_mutex_; ///< guards `table_mutexes_`
+    std::map<std::string, std::unique_ptr<reader_writer_mutex>> table_mutexes_; ///< one mutex per table name
+    std::mutex timer_mutex_; ///< guards merging measurements into the global `Timer` of the `Catalog`
+
+    static std::atomic<int64_t> next_start_time; ///< stores the next transaction start time
+
+    public:
+    ConcurrentScheduler() = default;
+    ~ConcurrentScheduler();
+
+    /** Returns the number of worker threads.  0 means one worker thread per hardware thread. */
+    std::size_t num_threads() const { return num_threads_; }
+    /** Sets the number of worker threads to \p n.  Must be called before the first command is scheduled. */
+    void num_threads(std::size_t n) { M_insist(workers_.empty(), "workers already started"); num_threads_ = n; }
+
+    std::future<bool> schedule_command(Transaction &t, std::unique_ptr<ast::Command> command, Diagnostic &diag) override;
+
+    std::unique_ptr<Transaction> begin_transaction() override;
+
+    bool commit(std::unique_ptr<Transaction> t) override;
+
+    bool abort(std::unique_ptr<Transaction> t) override;
+
+    /** Adds all tables accessed by \p command to \p tables.  Returns `false` iff \p command may change the catalog and
+     * must therefore be executed exclusively. */
+    static bool get_table_accesses(const ast::Command &command, table_access_map &tables);
+
+    private:
+    /** The method run by every worker thread.  While stopping, the queries that are already being executed will
+     * complete their execution but queued queries will not be executed. */
+    void worker_thread();
+
+    /** Analyzes and executes \p ast within \p t while holding the necessary locks.  Returns `true` iff the command was
+     * executed successfully. */
+    bool execute(Transaction &t, std::unique_ptr<ast::Command> ast, Diagnostic &diag);
+
+    /** Acquires the locks required to execute \p command. */
+    lock_set acquire_locks(const ast::Command &command);
+
+    /** Returns the `reader_writer_mutex` of the table named \p name. */
+    reader_writer_mutex & table_mutex(const std::string &name);
+};
+
+}
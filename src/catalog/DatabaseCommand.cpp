@@ -1,5 +1,6 @@
 #include <mutable/catalog/DatabaseCommand.hpp>
 
+#include "backend/Interpreter.hpp"
 #include "backend/StackMachine.hpp"
 #include <mutable/catalog/Catalog.hpp>
 #include <mutable/catalog/Schema.hpp>
@@ -7,7 +8,10 @@
 #include <mutable/mutable.hpp>
 #include <mutable/Options.hpp>
 #include <mutable/storage/Index.hpp>
+#include <mutable/storage/Versioning.hpp>
 #include <mutable/util/DotTool.hpp>
+#include <limits>
+#include <optional>
 
 
 using namespace m;
@@ -36,6 +40,112 @@ void learn_spns::execute(Diagnostic &diag)
     if (not Options::Get().quiet) { diag.out() << "Learned SPN on every table in " << DB.name << ".\n"; }
 }
 
+void save_snapshot::execute(Diagnostic &diag)
+{
+    auto &C = Catalog::Get();
+    if (not C.has_database_in_use()) { diag.err() << "No database selected.\n"; return; }
+    if (args().size() != 1) { diag.err() << "Expected the path of the snapshot file as sole argument.\n"; return; }
+
+    auto &DB = C.get_database_in_use();
+    try {
+        M_TIME_BLOCK("Write snapshot", C.timer(), { write_snapshot(DB, args()[0]); });
+    } catch (const runtime_error &e) {
+        diag.err() << e.what() << '\n';
+        return;
+    }
+
+    if (not Options::Get().quiet) { diag.out() << "Wrote snapshot of " << DB.name << " to " << args()[0] << ".\n"; }
+}
+
+void load_snapshot::execute(Diagnostic &diag)
+{
+    auto &C = Catalog::Get();
+    if (args().size() != 1) { diag.err() << "Expected the path of the snapshot file as sole argument.\n"; return; }
+
+    Database *DB;
+    try {
+        M_TIME_BLOCK("Read snapshot", C.timer(), { DB = &read_snapshot(args()[0]); });
+    } catch (const runtime_error &e) {
+        diag.err() << e.what() << '\n';
+        return;
+    } catch (const invalid_argument &e) {
+        diag.err() << e.what() << '\n';
+        return;
+    }
+    C.set_database_in_use(*DB);
+
+    if (not Options::Get().quiet) { diag.out() << "Loaded snapshot of " << DB->name << " from " << args()[0] << ".\n"; }
+}
+
+void compress::execute(Diagnostic &diag)
+{
+    auto &C = Catalog::Get();
+    if (not C.has_database_in_use()) { diag.err() << "No database selected.\n"; return; }
+
+    auto &DB = C.get_database_in_use();
+    std::vector<Table*> tables;
+    if (args().empty()) {
+        for (auto it = DB.begin_tables(); it != DB.end_tables(); ++it)
+            tables.push_back(it->second.get());
+    } else {
+        for (auto &name : args()) {
+            try {
+                tables.push_back(&DB.get_table(C.pool(name.c_str())));
+            } catch (const std::out_of_range&) {
+                diag.err() << "Table " << name << " does not exist in " << DB.name << ".\n";
+                return;
+            }
+        }
+    }
+
+    for (auto T : tables) {
+        bool is_compressed;
+        M_TIME_BLOCK("Compress table", C.timer(), { is_compressed = compress_table(*T); });
+        if (not Options::Get().quiet)
+            diag.out() << (is_compressed ? "Compressed table " : "Did not compress table ") << T->name() << ".\n";
+    }
+}
+
+void vacuum::execute(Diagnostic &diag)
+{
+    auto &C = Catalog::Get();
+    if (not C.has_database_in_use()) { diag.err() << "No database selected.\n"; return; }
+
+    auto &DB = C.get_database_in_use();
+    std::vector<Table*> tables;
+    if (args().empty()) {
+        for (auto it = DB.begin_tables(); it != DB.end_tables(); ++it) {
+            if (get_timestamp_attributes(*it->second))
+                tables.push_back(it->second.get());
+        }
+    } else {
+        for (auto &name : args()) {
+            try {
+                tables.push_back(&DB.get_table(C.pool(name.c_str())));
+            } catch (const std::out_of_range&) {
+                diag.err() << "Table " << name << " does not exist in " << DB.name << ".\n";
+                return;
+            }
+            if (not get_timestamp_attributes(*tables.back())) {
+                diag.err() << "Table " << name << " is not multi-versioned.\n";
+                return;
+            }
+        }
+    }
+
+    /* Versions deleted at or before the start of the oldest active transaction are invisible to every transaction. */
+    const int64_t horizon =
+        Scheduler::Transaction::Oldest_Active_Start_Time().value_or(std::numeric_limits<int64_t>::max());
+    for (auto T : tables) {
+        std::size_t num_removed;
+        M_TIME_BLOCK("Collect garbage", C.timer(), { num_removed = collect_garbage(*T, horizon); });
+        if (num_removed)
+            DB.invalidate_indexes(T->name()); // the IDs of the remaining rows have changed
+        if (not Options::Get().quiet)
+            diag.out() << "Removed " << num_removed << " versions of rows from table " << T->name() << ".\n";
+    }
+}
+
 __attribute__((constructor(201)))
 static void register_instructions()
 {
@@ -43,6 +153,10 @@ static void register_instructions()
 #define REGISTER(NAME, DESCRIPTION) \
     C.register_instruction<NAME>(C.pool(#NAME), DESCRIPTION)
     REGISTER(learn_spns, "create an SPN for every table in the database");
+    REGISTER(save_snapshot, "write a snapshot of the database to the given file");
+    REGISTER(load_snapshot, "restore a database from the given snapshot file");
+    REGISTER(compress, "compress the given tables, or all tables of the database, with lightweight encodings");
+    REGISTER(vacuum, "remove dead versions of rows from the given, or all, multi-versioned tables of the database");
 #undef REGISTER
 }
 
@@ -132,6 +246,7 @@ void InsertRecords::execute(Diagnostic&)
 
     auto &I = ast<ast::InsertStmt>();
     auto &T = DB.get_table(I.table_name.text.assert_not_none());
+    decompress_table(T); // rows cannot be appended to encoded leaves
     auto &store = T.store();
     StoreWriter W(store);
     auto &S = W.schema();
@@ -181,41 +296,163 @@ void InsertRecords::execute(Diagnostic&)
         }
 
         W.append(tup);
+        DB.insert_into_indexes(T.name(), tup, store.num_rows() - 1);
     }
-    /* Invalidate all indexes on the table. */
-    DB.invalidate_indexes(T.name());
+}
+
+namespace {
+
+/** Compiles the condition of the `WHERE` clause \p where, if any, to a `StackMachine` that evaluates the condition on a
+ * tuple of `Schema` \p S.  The result is written to the first argument and the tuple is read from the second. */
+std::optional<StackMachine> compile_condition(const Schema &S, const ast::Clause *where)
+{
+    if (not where)
+        return std::nullopt;
+    std::optional<StackMachine> SM(std::in_place, S);
+    SM->emit(*as<const ast::WhereClause>(*where).where, 1);
+    SM->emit_St_Tup_b(0, 0);
+    return SM;
+}
+
+/** Returns `true` iff the tuple \p tup satisfies the condition compiled by `compile_condition()`, if any. */
+bool satisfies(const std::optional<StackMachine> &condition, Tuple &res, Tuple &tup)
+{
+    if (not condition)
+        return true;
+    Tuple *args[] = { &res, &tup };
+    (*condition)(args);
+    return not res.is_null(0) and res[0].as_b();
+}
+
 }
 
 void UpdateRecords::execute(Diagnostic&)
 {
-    M_unreachable("not yet implemented");
+    Catalog &C = Catalog::Get();
+    auto &DB = C.get_database_in_use();
+
+    auto &U = ast<ast::UpdateStmt>();
+    auto &T = DB.get_table(U.table_name.text.assert_not_none());
+    const Schema S = T.schema();
+    const auto ts = get_timestamp_attributes(T);
+    const int64_t snapshot = ts ? M_notnull(transaction())->start_time() : -1;
+
+    /* Compile the condition and the assignments.  The assignments read the old tuple, which is the second argument, and
+     * write the new tuple, which is the first argument. */
+    auto condition = compile_condition(S, U.where.get());
+    Tuple res({ Type::Get_Boolean(Type::TY_Vector) });
+    StackMachine assign(S);
+    for (auto &[attr_name, expr] : U.set) {
+        const auto idx = T.at(attr_name.text.assert_not_none()).id;
+        if (expr->type()->is_none()) {
+            assign.emit_St_Tup_Null(0, idx);
+        } else {
+            assign.emit(*expr, 1);
+            assign.emit_Cast(S[idx].type, expr->type());
+            assign.emit_St_Tup(0, idx, S[idx].type);
+        }
+    }
+
+    /* Modify the rows in place.  In a multi-versioned table, the visible versions of the modified rows are deleted by
+     * stamping their end timestamp instead and the new versions are appended afterwards. */
+    std::vector<Tuple> new_versions;
+    update_rows(T, [&](Tuple &tup) {
+        if (ts and not is_visible(tup[ts->begin].as_i(), tup[ts->end].as_i(), snapshot))
+            return false;
+        if (not satisfies(condition, res, tup))
+            return false;
+        Tuple new_tup = tup.clone(S);
+        Tuple *args[] = { &new_tup, &tup };
+        assign(args);
+        if (ts) {
+            new_tup.set(ts->begin, Value(snapshot));
+            new_tup.set(ts->end, Value(-1));
+            tup.set(ts->end, Value(snapshot));
+            new_versions.emplace_back(std::move(new_tup));
+        } else {
+            tup = std::move(new_tup);
+        }
+        return true;
+    });
+
+    if (ts) {
+        auto &store = T.store();
+        StoreWriter W(store);
+        for (auto &tup : new_versions) {
+            W.append(tup);
+            DB.insert_into_indexes(T.name(), tup, store.num_rows() - 1);
+        }
+    } else {
+        DB.invalidate_indexes(T.name()); // the indexed keys of the modified rows may have changed
+    }
 }
 
 void DeleteRecords::execute(Diagnostic&)
 {
-    M_unreachable("not yet implemented");
+    Catalog &C = Catalog::Get();
+    auto &DB = C.get_database_in_use();
+
+    auto &D = ast<ast::DeleteStmt>();
+    auto &T = DB.get_table(D.table_name.text.assert_not_none());
+    const Schema S = T.schema();
+    const auto ts = get_timestamp_attributes(T);
+    const int64_t snapshot = ts ? M_notnull(transaction())->start_time() : -1;
+
+    auto condition = compile_condition(S, D.where.get());
+    Tuple res({ Type::Get_Boolean(Type::TY_Vector) });
+
+    if (ts) {
+        /* Delete the visible versions of the rows by stamping their end timestamp.  Transactions that started before
+         * still see the versions, which are eventually removed by `collect_garbage()`. */
+        update_rows(T, [&](Tuple &tup) {
+            if (not is_visible(tup[ts->begin].as_i(), tup[ts->end].as_i(), snapshot))
+                return false;
+            if (not satisfies(condition, res, tup))
+                return false;
+            tup.set(ts->end, Value(snapshot));
+            return true;
+        });
+    } else {
+        if (remove_rows(T, [&](Tuple &tup) { return satisfies(condition, res, tup); }))
+            DB.invalidate_indexes(T.name()); // the IDs of the remaining rows have changed
+    }
 }
 
 void ImportDSV::execute(Diagnostic &diag)
 {
     Catalog &C = Catalog::Get();
+    auto &DB = C.get_database_in_use();
+    auto &T = DB.get_table(table_.name());
+    decompress_table(T); // rows cannot be appended to encoded leaves
+    const std::size_t first_row = T.store().num_rows();
     try {
         DSVReader R(table_, cfg_, diag, transaction());
 
         errno = 0;
-        std::ifstream file(path_);
-        if (not file) {
+        const bool is_open = M_TIME_EXPR(R.read_file(path_), "Read DSV file", C.timer());
+        if (not is_open) {
             const auto errsv = errno;
             diag.err() << "Could not open file " << path_;
             if (errsv)
                 diag.err() << ": " << strerror(errsv);
             diag.err() << std::endl;
-        } else {
-            M_TIME_EXPR(R(file, path_.c_str()), "Read DSV file", C.timer());
         }
     } catch (m::invalid_argument e) {
         diag.err() << "Error reading DSV file: " << e.what() << "\n";
     }
+
+    /*----- Add the imported rows to the indexes of the table. -----*/
+    auto &store = T.store();
+    if (not DB.has_indexes(T.name()) or store.num_rows() == first_row)
+        return;
+    const Schema S = T.schema();
+    auto loader = Interpreter::compile_load(S, store.memory().addr(), T.layout(), S, first_row);
+    Tuple tup(S);
+    Tuple *args[] = { &tup };
+    for (std::size_t i = first_row, end = store.num_rows(); i != end; ++i) {
+        loader(args);
+        DB.insert_into_indexes(T.name(), tup, i);
+    }
 }
 
 
@@ -0,0 +1,67 @@
+#include "catalog/GarbageCollector.hpp"
+
+#include <mutable/catalog/Catalog.hpp>
+#include <mutable/parse/AST.hpp>
+#include <mutable/util/Diagnostic.hpp>
+#include <sstream>
+
+
+using namespace m;
+
+
+GarbageCollector::GarbageCollector(std::chrono::milliseconds interval)
+    : interval_(interval)
+    , thread_(&GarbageCollector::run, this)
+{ }
+
+GarbageCollector::~GarbageCollector()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopped_ = true;
+    }
+    stop_.notify_all();
+    if (thread_.joinable())
+        thread_.join();
+}
+
+void GarbageCollector::run()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (not stop_.wait_for(lock, interval_, [this]() { return stopped_; })) {
+        lock.unlock();
+        collect();
+        lock.lock();
+    }
+}
+
+void GarbageCollector::collect()
+{
+    Catalog &C = Catalog::Get();
+    if (not C.has_database_in_use() or not C.has_default_scheduler())
+        return;
+
+    std::ostringstream out, err; // discard the output of the instruction
+    Diagnostic diag(false, out, err);
+    auto vacuum = std::make_unique<ast::Instruction>(ast::Token::CreateArtificial(), C.pool("vacuum"),
+                                                     std::vector<std::string>());
+    C.scheduler().autocommit(std::move(vacuum), diag);
+}
+
+__attribute__((constructor(202)))
+static void register_garbage_collector_options()
+{
+    Catalog &C = Catalog::Get();
+    C.arg_parser().add<std::size_t>(
+        /* group=       */ "Scheduler",
+        /* short=       */ nullptr,
+        /* long=        */ "--gc-interval",
+        /* description= */ "periodically remove dead versions of rows from multi-versioned tables every given number of "
+                           "milliseconds (0 disables the garbage collector)",
+        /* callback=    */ [](std::size_t ms){
+            Catalog::Get().garbage_collector(
+                ms ? std::make_unique<GarbageCollector>(std::chrono::milliseconds(ms)) : nullptr
+            );
+        }
+    );
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+
+namespace m {
+
+/** A background thread that periodically removes the versions of rows that are invisible to all active and future
+ * transactions from all multi-versioned tables of the `Database` in use, see `vacuum`.  The `vacuum` instruction is
+ * executed through the default `Scheduler` like any other command and is therefore serialized with concurrently
+ * executed commands by the `Scheduler`. */
+struct GarbageCollector
+{
+    private:
+    std::chrono::milliseconds interval_; ///< the time between two collections
+    std::mutex mutex_; ///< guards `stopped_`
+    std::condition_variable stop_; ///< notified when the collector is stopped
+    bool stopped_ = false; ///< whether the collector is stopped
+    std::thread thread_; ///< the thread running the collector
+
+    public:
+    /** Starts a collector that collects garbage every \p interval. */
+    GarbageCollector(std::chrono::milliseconds interval);
+    GarbageCollector(const GarbageCollector&) = delete;
+    /** Stops the collector.  Waits for a running collection to complete. */
+    ~GarbageCollector();
+
+    std::chrono::milliseconds interval() const { return interval_; }
+
+    private:
+    /** The method run by the collector thread. */
+    void run();
+    /** Schedules the `vacuum` instruction and waits for its completion. */
+    void collect();
+};
+
+}
@@ -5,6 +5,32 @@ using namespace m;
 
 
 std::atomic<uint64_t> Scheduler::Transaction::next_id_;
+std::mutex Scheduler::Transaction::active_mutex_;
+std::multiset<int64_t> Scheduler::Transaction::active_start_times_;
+
+Scheduler::Transaction::~Transaction()
+{
+    if (start_time_ == -1)
+        return;
+    std::lock_guard<std::mutex> lock(active_mutex_);
+    active_start_times_.erase(active_start_times_.find(start_time_));
+}
+
+void Scheduler::Transaction::start_time(int64_t time)
+{
+    M_insist(start_time_ == -1 and time >= 0);
+    start_time_ = time;
+    std::lock_guard<std::mutex> lock(active_mutex_);
+    active_start_times_.insert(time);
+}
+
+std::optional<int64_t> Scheduler::Transaction::Oldest_Active_Start_Time()
+{
+    std::lock_guard<std::mutex> lock(active_mutex_);
+    if (active_start_times_.empty())
+        return std::nullopt;
+    return *active_start_times_.begin();
+}
 
 bool Scheduler::autocommit (std::unique_ptr<ast::Command> command, Diagnostic &diag) {
     auto t = begin_transaction();
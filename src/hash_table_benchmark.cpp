@@ -0,0 +1,170 @@
+#include "backend/FlatHashTable.hpp"
+#include "util/container/RefCountingHashMap.hpp"
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <mutable/catalog/Type.hpp>
+#include <mutable/IR/Tuple.hpp>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+
+using namespace m;
+using namespace std::chrono;
+
+#ifndef NDEBUG
+static constexpr std::size_t NUM_TUPLES_START = 1UL<<10;
+static constexpr std::size_t NUM_TUPLES_STOP  = 1UL<<14;
+#else
+static constexpr std::size_t NUM_TUPLES_START = 1UL<<10;
+static constexpr std::size_t NUM_TUPLES_STOP  = 1UL<<22;
+#endif
+
+
+/** Hashes and compares `Tuple`s by their first attribute, as done by the `Interpreter`'s hash-based grouping. */
+struct first_attr_hash
+{
+    uint64_t operator()(const Tuple &tup) const { return tup.is_null(0) ? 0 : std::hash<Value>{}(tup[0]); }
+};
+struct first_attr_equal
+{
+    bool operator()(const Tuple &first, const Tuple &second) const {
+        if (first.is_null(0) != second.is_null(0)) return false;
+        return first.is_null(0) or first[0] == second[0];
+    }
+};
+
+/** Creates `num_tuples` tuples of two 64-bit integers `(key, payload)` with `num_distinct` distinct keys. */
+std::vector<Tuple> generate(const std::vector<const Type*> &types, std::size_t num_tuples, std::size_t num_distinct)
+{
+    std::mt19937_64 g(42);
+    std::uniform_int_distribution<int64_t> dist(0, num_distinct - 1);
+    std::vector<Tuple> tuples;
+    tuples.reserve(num_tuples);
+    for (std::size_t i = 0; i != num_tuples; ++i) {
+        auto &t = tuples.emplace_back(types);
+        t.set(0, dist(g));
+        t.set(1, int64_t(i));
+    }
+    return tuples;
+}
+
+/** Builds a hash table on `build` and probes it with `probe`, like the `Interpreter`'s simple hash join.  Reports the
+ * build and probe time. */
+void run_benchmark_join(const std::vector<const Type*> &types, std::size_t num_tuples)
+{
+    auto build = generate(types, num_tuples, num_tuples);
+    auto probe = generate(types, num_tuples, 2 * num_tuples);
+    Tuple key({ types[0] });
+
+    auto report = [&](const char *name, auto build_time, auto probe_time, std::size_t num_matches) {
+        std::cout << "join," << name << ',' << num_tuples << ',' << num_tuples << ','
+                  << duration_cast<microseconds>(build_time).count() / 1e3 << ','
+                  << duration_cast<microseconds>(probe_time).count() / 1e3 << ','
+                  << num_matches << std::endl;
+    };
+
+    /*----- RefCountingHashMap, as used previously. -----*/
+    {
+        RefCountingHashMap<Tuple, Tuple> ht(1024);
+        std::size_t num_matches = 0;
+        auto t0 = steady_clock::now();
+        for (auto &t : build) {
+            Tuple k({ types[0] }); // heap-allocated copies of key and tuple
+            k.set(0, t[0]);
+            Tuple v(types);
+            v.insert(t, 0, types.size());
+            ht.insert_with_duplicates(std::move(k), std::move(v));
+        }
+        auto t1 = steady_clock::now();
+        for (auto &t : probe) {
+            key.set(0, t[0]);
+            ht.for_all(key, [&](std::pair<const Tuple, Tuple> &v) { num_matches += v.second[1].as_i() != -1; });
+        }
+        auto t2 = steady_clock::now();
+        report("RefCountingHashMap", t1 - t0, t2 - t1, num_matches);
+    }
+
+    /*----- FlatHashTable -----*/
+    {
+        FlatHashTable ht({ types[0] }, types);
+        Tuple build_tuple(types);
+        std::size_t num_matches = 0;
+        auto t0 = steady_clock::now();
+        for (auto &t : build) {
+            key.set(0, t[0]);
+            ht.insert_with_duplicates(key, t);
+        }
+        auto t1 = steady_clock::now();
+        for (auto &t : probe) {
+            key.set(0, t[0]);
+            ht.for_each_in_equal_range(key, [&](std::size_t row) {
+                ht.load_payload(row, build_tuple);
+                num_matches += build_tuple[1].as_i() != -1;
+            });
+        }
+        auto t2 = steady_clock::now();
+        report("FlatHashTable", t1 - t0, t2 - t1, num_matches);
+    }
+}
+
+/** Groups `num_tuples` tuples with `num_distinct` distinct keys and counts the tuples per group, like the
+ * `Interpreter`'s hash-based grouping. */
+void run_benchmark_grouping(const std::vector<const Type*> &types, std::size_t num_tuples, std::size_t num_distinct)
+{
+    auto input = generate(types, num_tuples, num_distinct);
+
+    auto report = [&](const char *name, auto time, std::size_t num_groups) {
+        std::cout << "grouping," << name << ',' << num_tuples << ',' << num_distinct << ','
+                  << duration_cast<microseconds>(time).count() / 1e3 << ",0," << num_groups << std::endl;
+    };
+
+    /*----- std::unordered_map, as used previously. -----*/
+    {
+        std::unordered_map<Tuple, unsigned, first_attr_hash, first_attr_equal> groups(1024);
+        Tuple key(types);
+        auto t0 = steady_clock::now();
+        for (auto &t : input) {
+            key.set(0, t[0]);
+            auto it = groups.find(key);
+            if (it == groups.end()) {
+                it = groups.emplace_hint(it, std::move(key), 0);
+                key = Tuple(types);
+            }
+            ++it->second;
+        }
+        auto t1 = steady_clock::now();
+        report("unordered_map", t1 - t0, groups.size());
+    }
+
+    /*----- FlatHashTable -----*/
+    {
+        FlatHashTable groups({ types[0] }, { types[1] });
+        Tuple key(types);
+        auto t0 = steady_clock::now();
+        for (auto &t : input) {
+            key.set(0, t[0]);
+            ++groups.count(groups.find_or_insert(key).first);
+        }
+        auto t1 = steady_clock::now();
+        report("FlatHashTable", t1 - t0, groups.size());
+    }
+}
+
+
+int main(void)
+{
+    const std::vector<const Type*> types{
+        Type::Get_Integer(Type::TY_Vector, 8),
+        Type::Get_Integer(Type::TY_Vector, 8),
+    };
+
+    std::cout << "benchmark,container,num_tuples,num_distinct,time_build,time_probe,result" << std::endl;
+    for (std::size_t num_tuples = NUM_TUPLES_START; num_tuples <= NUM_TUPLES_STOP; num_tuples *= 4) {
+        run_benchmark_join(types, num_tuples);
+        for (std::size_t num_distinct = 16; num_distinct <= num_tuples; num_distinct *= 16)
+            run_benchmark_grouping(types, num_tuples, num_distinct);
+    }
+}
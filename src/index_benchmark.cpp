@@ -0,0 +1,97 @@
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <mutable/storage/Index.hpp>
+#include <random>
+#include <vector>
+
+
+using namespace m;
+using namespace m::idx;
+using namespace std::chrono;
+
+#ifndef NDEBUG
+static constexpr std::size_t NUM_KEYS_START = 1UL<<10;
+static constexpr std::size_t NUM_KEYS_STOP  = 1UL<<16;
+static constexpr std::size_t NUM_PROBES     = 1UL<<14;
+#else
+static constexpr std::size_t NUM_KEYS_START = 1UL<<10;
+static constexpr std::size_t NUM_KEYS_STOP  = 1UL<<26;
+static constexpr std::size_t NUM_PROBES     = 1UL<<22;
+#endif
+
+
+/** Fills `idx` with `num_keys` distinct, uniformly spread 64-bit keys and finalizes it. */
+template<typename Index>
+void fill(Index &idx, std::size_t num_keys)
+{
+    std::mt19937_64 g(42);
+    std::uniform_int_distribution<int64_t> gap(1, 100);
+    int64_t key = 0;
+    for (std::size_t i = 0; i != num_keys; ++i) {
+        key += gap(g);
+        idx.add(key, i);
+    }
+    idx.finalize();
+}
+
+/** Looks up `NUM_PROBES` random keys in an `ArrayIndex` and a `RecursiveModelIndex` of `num_keys` entries, with single
+ * and with batched lookups.  Reports the lookup time and a checksum of the results. */
+void run_benchmark_lower_bound(std::size_t num_keys)
+{
+    ArrayIndex<int64_t> array;
+    RecursiveModelIndex<int64_t> rmi;
+    fill(array, num_keys);
+    fill(rmi, num_keys);
+
+    std::mt19937_64 g(1337);
+    std::uniform_int_distribution<int64_t> dist(0, (array.end() - 1)->first);
+    std::vector<int64_t> probes(NUM_PROBES);
+    for (auto &p : probes)
+        p = dist(g);
+
+    auto report = [&](const char *name, auto time, std::size_t checksum) {
+        std::cout << "lower_bound," << name << ',' << num_keys << ',' << NUM_PROBES << ','
+                  << duration_cast<microseconds>(time).count() / 1e3 << ',' << checksum << std::endl;
+    };
+
+    /*----- ArrayIndex, i.e. binary search -----*/
+    {
+        std::size_t checksum = 0;
+        auto t0 = steady_clock::now();
+        for (auto p : probes)
+            checksum += array.lower_bound(p)->second;
+        auto t1 = steady_clock::now();
+        report("ArrayIndex", t1 - t0, checksum);
+    }
+
+    /*----- RecursiveModelIndex, one key at a time -----*/
+    {
+        std::size_t checksum = 0;
+        auto t0 = steady_clock::now();
+        for (auto p : probes)
+            checksum += rmi.lower_bound(p)->second;
+        auto t1 = steady_clock::now();
+        report("RecursiveModelIndex", t1 - t0, checksum);
+    }
+
+    /*----- RecursiveModelIndex, batched -----*/
+    {
+        std::size_t checksum = 0;
+        std::vector<RecursiveModelIndex<int64_t>::const_iterator> results(NUM_PROBES);
+        auto t0 = steady_clock::now();
+        rmi.lower_bound_batch(probes.data(), probes.size(), results.data());
+        for (auto it : results)
+            checksum += it->second;
+        auto t1 = steady_clock::now();
+        report("RecursiveModelIndex batched", t1 - t0, checksum);
+    }
+}
+
+
+int main(void)
+{
+    std::cout << "benchmark,index,num_keys,num_probes,time,checksum" << std::endl;
+    for (std::size_t num_keys = NUM_KEYS_START; num_keys <= NUM_KEYS_STOP; num_keys *= 4)
+        run_benchmark_lower_bound(num_keys);
+}
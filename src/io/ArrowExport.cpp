@@ -0,0 +1,455 @@
+#include <mutable/io/ArrowExport.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <memory>
+#include <mutable/catalog/Type.hpp>
+#include <mutable/IR/Tuple.hpp>
+#include <mutable/util/fn.hpp>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <vector>
+
+
+using namespace m;
+using namespace m::storage;
+
+
+namespace {
+
+/*======================================================================================================================
+ * Memory management of exported structures
+ *====================================================================================================================*/
+
+/** Owns the memory of an exported `ArrowSchema` of type struct and of all its children. */
+struct SchemaData
+{
+    std::vector<std::string> formats;
+    std::vector<std::string> names;
+    std::vector<ArrowSchema> children;
+    std::vector<ArrowSchema*> child_ptrs;
+};
+
+/** Owns the memory of an exported `ArrowArray` of type struct and of all its children. */
+struct ArrayData
+{
+    std::vector<ArrowArray> children;
+    std::vector<ArrowArray*> child_ptrs;
+    std::vector<std::array<const void*, 3>> buffers; ///< the buffers of each child
+    std::vector<std::unique_ptr<uint8_t[]>> memory; ///< the converted buffers
+    const void *struct_buffers[1] = { nullptr }; ///< the struct itself contains no `NULL`s
+};
+
+/** The memory of children is owned by the parent, hence releasing a child only marks it as released. */
+void release_child_schema(ArrowSchema *schema) { schema->release = nullptr; }
+void release_child_array(ArrowArray *array) { array->release = nullptr; }
+
+void release_schema(ArrowSchema *schema)
+{
+    auto data = static_cast<SchemaData*>(schema->private_data);
+    for (auto &child : data->children) {
+        if (child.release)
+            child.release(&child);
+    }
+    delete data;
+    schema->release = nullptr;
+}
+
+void release_array(ArrowArray *array)
+{
+    auto data = static_cast<ArrayData*>(array->private_data);
+    for (auto &child : data->children) {
+        if (child.release)
+            child.release(&child);
+    }
+    delete data;
+    array->release = nullptr;
+}
+
+
+/*======================================================================================================================
+ * Type mapping
+ *====================================================================================================================*/
+
+/** Returns the Arrow format string of `Type` \p ty. */
+std::string arrow_format(const Type *ty)
+{
+    if (ty->is_none()) return "n";
+    if (ty->is_boolean()) return "b";
+    if (ty->is_character_sequence()) return "u";
+    if (ty->is_date()) return "tdD";
+    if (ty->is_date_time()) return "tss:";
+    auto n = as<const Numeric>(ty);
+    switch (n->kind) {
+        case Numeric::N_Int:
+            switch (n->size()) {
+                case 8:  return "c";
+                case 16: return "s";
+                case 32: return "i";
+                case 64: return "l";
+                default: M_unreachable("invalid integer size");
+            }
+        case Numeric::N_Float:
+            return n->size() == 32 ? "f" : "g";
+        case Numeric::N_Decimal: {
+            std::ostringstream oss;
+            oss << "d:" << n->precision << ',' << n->scale;
+            return oss.str();
+        }
+    }
+    M_unreachable("invalid numeric kind");
+}
+
+/** Returns `true` iff the in-memory representation of `Type` \p ty equals the representation of its Arrow type. */
+bool has_arrow_representation(const Type *ty)
+{
+    if (ty->is_date_time()) return true;
+    if (auto n = cast<const Numeric>(ty))
+        return n->kind != Numeric::N_Decimal;
+    return false;
+}
+
+/** Converts a date of the form `year << 9 | month << 5 | day` to the number of days since the UNIX epoch. */
+int32_t date_to_days(int32_t date)
+{
+    /* See http://howardhinnant.github.io/date_algorithms.html#days_from_civil */
+    int32_t y = date >> 9;
+    const int32_t m = (date >> 5) & 0xF;
+    const int32_t d = date & 0x1F;
+    y -= m <= 2;
+    const int32_t era = (y >= 0 ? y : y - 399) / 400;
+    const int32_t yoe = y - era * 400;
+    const int32_t doy = (153 * (m > 2 ? m - 3 : m + 9) + 2) / 5 + d - 1;
+    const int32_t doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + doe - 719468;
+}
+
+
+/*======================================================================================================================
+ * Locating attributes in a `DataLayout`
+ *====================================================================================================================*/
+
+/** Describes where the values of an attribute reside in memory.  The value of the `r`-th tuple resides at bit offset
+ * `offset + (r / num_tuples) * block_stride + (r % num_tuples) * stride` from `base`. */
+struct location_t
+{
+    const uint8_t *base = nullptr;
+    uint64_t offset = 0; ///< in bits
+    uint64_t stride = 0; ///< in bits, between two consecutive tuples within a block
+    uint64_t block_stride = 0; ///< in bits, between two consecutive blocks
+    uint64_t num_tuples = 1; ///< the number of tuples per block
+
+    uint64_t bit_offset(std::size_t r) const {
+        return offset + (r / num_tuples) * block_stride + (r % num_tuples) * stride;
+    }
+    const uint8_t * address(std::size_t r) const {
+        const uint64_t bits = bit_offset(r);
+        M_insist(bits % 8 == 0, "attribute must be byte aligned");
+        return base + bits / 8;
+    }
+    bool bit(std::size_t r) const {
+        const uint64_t bits = bit_offset(r);
+        return (base[bits / 8] >> (bits % 8)) & 0x1U;
+    }
+
+    /** Returns the stride in bits between the tuples `r` and `r + 1` if it is equal for all tuples in `[begin, end)`. */
+    std::optional<uint64_t> uniform_stride(std::size_t begin, std::size_t end) const {
+        if (num_tuples == 1) return block_stride;
+        if (begin / num_tuples == (end - 1) / num_tuples) return stride; // all tuples reside in the same block
+        return std::nullopt;
+    }
+};
+
+/** Computes the `location_t` of every leaf of \p layout, with \p data as the address of the first tuple.  Only
+ * supports layouts of blocks of tuples, i.e. a single `INode` of leaves, as produced by the `DataLayoutFactory`s. */
+std::vector<location_t> locate_leaves(const DataLayout &layout, const void *data, std::size_t num_leaves)
+{
+    std::vector<location_t> locations(num_leaves);
+    auto &block = as<const DataLayout::INode>(layout.child());
+    for (auto &child : block) {
+        auto leaf = cast<const DataLayout::Leaf>(child.ptr.get());
+        M_insist(bool(leaf), "only layouts of blocks of tuples are supported");
+        M_insist(leaf->index() < num_leaves);
+        auto &loc = locations[leaf->index()];
+        loc.base = static_cast<const uint8_t*>(data);
+        loc.offset = child.offset_in_bits;
+        loc.stride = child.stride_in_bits;
+        loc.block_stride = layout.stride_in_bits();
+        loc.num_tuples = block.num_tuples();
+    }
+    return locations;
+}
+
+
+/*======================================================================================================================
+ * Exporting columns
+ *====================================================================================================================*/
+
+/** Exports the tuples `[begin, end)` of a single column as a child of a record batch. */
+struct ColumnExporter
+{
+    ArrayData &data;
+    const std::size_t begin, end;
+
+    std::size_t length() const { return end - begin; }
+
+    uint8_t * allocate(std::size_t num_bytes) {
+        /* Zero-initialized, such that padding bits of bitmaps are defined. */
+        return data.memory.emplace_back(std::make_unique<uint8_t[]>(std::max<std::size_t>(num_bytes, 1))).get();
+    }
+
+    /** Computes the validity bitmap from the NULL bits of the tuples.  Returns `nullptr` if no tuple is `NULL`. */
+    const void * validity(const location_t *null_bitmap, std::size_t attr, int64_t &null_count) {
+        null_count = 0;
+        if (not null_bitmap) return nullptr;
+        auto bitmap = allocate((length() + 7) / 8);
+        location_t loc = *null_bitmap;
+        loc.offset += attr;
+        for (std::size_t r = begin; r != end; ++r) {
+            const bool is_null = loc.bit(r);
+            null_count += is_null;
+            bitmap[(r - begin) / 8] |= uint8_t(not is_null) << ((r - begin) % 8);
+        }
+        if (null_count == 0) {
+            data.memory.pop_back();
+            return nullptr;
+        }
+        return bitmap;
+    }
+
+    /** Exports the values of `Type` \p ty at \p loc into the buffers \p buffers and returns the number of buffers. */
+    int64_t values(const Type *ty, const location_t &loc, std::array<const void*, 3> &buffers) {
+        if (ty->is_boolean()) {
+            auto bitmap = allocate((length() + 7) / 8);
+            for (std::size_t r = begin; r != end; ++r)
+                bitmap[(r - begin) / 8] |= uint8_t(loc.bit(r)) << ((r - begin) % 8);
+            buffers[1] = bitmap;
+            return 2;
+        }
+
+        if (auto cs = cast<const CharacterSequence>(ty)) {
+            auto offsets = reinterpret_cast<int32_t*>(allocate((length() + 1) * sizeof(int32_t)));
+            std::size_t num_bytes = 0;
+            for (std::size_t r = begin; r != end; ++r) {
+                offsets[r - begin] = num_bytes;
+                num_bytes += strnlen(reinterpret_cast<const char*>(loc.address(r)), cs->length);
+            }
+            offsets[length()] = num_bytes;
+            auto chars = allocate(num_bytes);
+            for (std::size_t r = begin; r != end; ++r)
+                std::memcpy(chars + offsets[r - begin], loc.address(r), offsets[r - begin + 1] - offsets[r - begin]);
+            buffers[1] = offsets;
+            buffers[2] = chars;
+            return 3;
+        }
+
+        const std::size_t size = ty->size() / 8;
+
+        /* Hand off the values if they are stored contiguously in their Arrow representation. */
+        if (has_arrow_representation(ty)) {
+            if (auto stride = loc.uniform_stride(begin, end); stride and *stride == ty->size()) {
+                buffers[1] = loc.address(begin);
+                return 2;
+            }
+        }
+
+        if (ty->is_date()) {
+            auto dates = reinterpret_cast<int32_t*>(allocate(length() * sizeof(int32_t)));
+            for (std::size_t r = begin; r != end; ++r) {
+                int32_t date;
+                std::memcpy(&date, loc.address(r), sizeof(date));
+                dates[r - begin] = date_to_days(date);
+            }
+            buffers[1] = dates;
+            return 2;
+        }
+
+        if (ty->is_decimal()) {
+            /* Sign-extend to 128 bit little-endian integers. */
+            auto decimals = reinterpret_cast<int64_t*>(allocate(length() * 2 * sizeof(int64_t)));
+            for (std::size_t r = begin; r != end; ++r) {
+                int64_t value;
+                if (size == 4) {
+                    int32_t v;
+                    std::memcpy(&v, loc.address(r), sizeof(v));
+                    value = v;
+                } else {
+                    std::memcpy(&value, loc.address(r), sizeof(value));
+                }
+                decimals[2 * (r - begin)] = value;
+                decimals[2 * (r - begin) + 1] = value < 0 ? -1 : 0;
+            }
+            buffers[1] = decimals;
+            return 2;
+        }
+
+        /* Gather fixed-width values. */
+        auto values = allocate(length() * size);
+        for (std::size_t r = begin; r != end; ++r)
+            std::memcpy(values + (r - begin) * size, loc.address(r), size);
+        buffers[1] = values;
+        return 2;
+    }
+};
+
+/** Stores the `Value` \p val of `Type` \p ty in its in-memory representation at \p dst and returns a `location_t`
+ * which repeats it for every tuple. */
+location_t repeat_constant(const Type *ty, const Value &val, uint64_t (&dst)[2])
+{
+    location_t loc;
+    if (ty->is_character_sequence()) {
+        loc.base = static_cast<const uint8_t*>(val.as_p());
+        return loc;
+    }
+    if (ty->is_boolean()) {
+        dst[0] = val.as_b();
+    } else if (ty->is_float()) {
+        const float f = val.as_f();
+        std::memcpy(dst, &f, sizeof(f));
+    } else if (ty->is_double()) {
+        const double d = val.as_d();
+        std::memcpy(dst, &d, sizeof(d));
+    } else {
+        dst[0] = val.as_i(); // little endian, hence the first bytes hold narrower integers
+    }
+    loc.base = reinterpret_cast<const uint8_t*>(dst);
+    return loc;
+}
+
+}
+
+
+/*======================================================================================================================
+ * ArrowExportOperator
+ *====================================================================================================================*/
+
+ArrowExportOperator::ArrowExportOperator(record_batch_callback_type callback)
+    : CallbackOperator(batch_callback_type([callback=std::move(callback)](const Schema &schema, const batch_type &batch) {
+        export_batch(schema, batch, callback);
+    }))
+{ }
+
+void ArrowExportOperator::export_batch(const Schema &schema, const batch_type &batch,
+                                       const record_batch_callback_type &callback)
+{
+    if (batch.num_tuples == 0) return;
+
+    /*----- Locate the materialized attributes and the NULL bitmap. -----*/
+    const std::size_t null_bitmap_idx = batch.schema.num_entries();
+    std::vector<location_t> locations;
+    bool has_null_bitmap = false;
+    std::size_t tuples_per_batch = batch.num_tuples;
+    if (batch.layout) {
+        locations = locate_leaves(batch.layout, batch.data, null_bitmap_idx + 1);
+        has_null_bitmap = locations[null_bitmap_idx].base != nullptr;
+        /* Export one record batch per block, such that attributes stored contiguously within a block can be handed
+         * off.  Blocks of a single tuple are merged into a single record batch. */
+        if (locations[0].num_tuples > 1)
+            tuples_per_batch = locations[0].num_tuples;
+    }
+
+    for (std::size_t begin = 0; begin < batch.num_tuples; begin += tuples_per_batch) {
+        const std::size_t end = std::min(begin + tuples_per_batch, batch.num_tuples);
+
+        /*----- Export schema. -----*/
+        auto schema_data = new SchemaData();
+        schema_data->children.resize(schema.num_entries());
+        for (std::size_t i = 0; i != schema.num_entries(); ++i) {
+            auto &e = schema[i];
+            schema_data->formats.emplace_back(arrow_format(e.type));
+            std::ostringstream name;
+            name << e.id.name;
+            schema_data->names.emplace_back(name.str());
+        }
+        for (std::size_t i = 0; i != schema.num_entries(); ++i) {
+            auto &child = schema_data->children[i];
+            child = ArrowSchema {
+                .format = schema_data->formats[i].c_str(),
+                .name = schema_data->names[i].c_str(),
+                .metadata = nullptr,
+                .flags = schema[i].nullable() ? ARROW_FLAG_NULLABLE : 0,
+                .n_children = 0,
+                .children = nullptr,
+                .dictionary = nullptr,
+                .release = release_child_schema,
+                .private_data = nullptr,
+            };
+            schema_data->child_ptrs.push_back(&child);
+        }
+        ArrowSchema arrow_schema {
+            .format = "+s",
+            .name = "",
+            .metadata = nullptr,
+            .flags = 0,
+            .n_children = int64_t(schema.num_entries()),
+            .children = schema_data->child_ptrs.data(),
+            .dictionary = nullptr,
+            .release = release_schema,
+            .private_data = schema_data,
+        };
+
+        /*----- Export columns. -----*/
+        auto array_data = new ArrayData();
+        array_data->children.resize(schema.num_entries());
+        array_data->buffers.resize(schema.num_entries(), { nullptr, nullptr, nullptr });
+        ColumnExporter exporter{ *array_data, begin, end };
+        for (std::size_t i = 0; i != schema.num_entries(); ++i) {
+            auto &e = schema[i];
+            auto &child = array_data->children[i];
+            auto &buffers = array_data->buffers[i];
+            child = ArrowArray {
+                .length = int64_t(end - begin),
+                .null_count = 0,
+                .offset = 0,
+                .n_buffers = 0,
+                .n_children = 0,
+                .buffers = buffers.data(),
+                .children = nullptr,
+                .dictionary = nullptr,
+                .release = release_child_array,
+                .private_data = nullptr,
+            };
+            array_data->child_ptrs.push_back(&child);
+
+            if (e.type->is_none()) { // NULL constant
+                child.null_count = child.length;
+                continue;
+            }
+
+            if (e.id.is_constant()) {
+                uint64_t value[2] = { 0, 0 };
+                auto loc = repeat_constant(e.type, batch.constants[i], value);
+                buffers[0] = nullptr;
+                child.n_buffers = exporter.values(e.type, loc, buffers);
+                continue;
+            }
+
+            const std::size_t attr = batch.schema[e.id].first;
+            const bool nullable = has_null_bitmap and batch.schema[attr].nullable();
+            buffers[0] = exporter.validity(nullable ? &locations[null_bitmap_idx] : nullptr, attr, child.null_count);
+            child.n_buffers = exporter.values(e.type, locations[attr], buffers);
+        }
+        ArrowArray arrow_array {
+            .length = int64_t(end - begin),
+            .null_count = 0,
+            .offset = 0,
+            .n_buffers = 1,
+            .n_children = int64_t(schema.num_entries()),
+            .buffers = array_data->struct_buffers,
+            .children = array_data->child_ptrs.data(),
+            .dictionary = nullptr,
+            .release = release_array,
+            .private_data = array_data,
+        };
+
+        callback(&arrow_schema, &arrow_array);
+
+        /* Release the structures unless the callback moved them. */
+        if (arrow_schema.release)
+            arrow_schema.release(&arrow_schema);
+        if (arrow_array.release)
+            arrow_array.release(&arrow_array);
+    }
+}
@@ -2,9 +2,14 @@
 
 #include "backend/Interpreter.hpp"
 #include "backend/StackMachine.hpp"
+#include <algorithm>
+#include <atomic>
 #include <cctype>
 #include <cerrno>
 #include <exception>
+#include <fcntl.h>
+#include <fstream>
+#include <immintrin.h>
 #include <iterator>
 #include <limits>
 #include <map>
@@ -13,13 +18,123 @@
 #include <mutable/storage/DataLayout.hpp>
 #include <mutable/storage/Store.hpp>
 #include <mutable/util/macro.hpp>
+#include <numeric>
+#include <sstream>
 #include <string>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <thread>
+#include <unistd.h>
 
 
 using namespace m;
 using namespace m::storage;
 
 
+namespace {
+
+/** Returns the schema of all attributes of \p table, including the hidden ones. */
+Schema table_schema(const Table &table)
+{
+    Schema S;
+    for (auto it = table.begin_all(); it != table.end_all(); ++it) S.add({table.name(), it->name}, it->type);
+    return S;
+}
+
+/** Returns a bit mask of the characters in `[block, min(block + 32, end))` that equal \p c0, \p c1, or \p c2. */
+uint32_t find_chars(const char *block, const char *end, char c0, char c1, char c2)
+{
+#ifdef __AVX2__
+    if (end - block >= 32) {
+        const __m256i chars = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block));
+        const __m256i eq0 = _mm256_cmpeq_epi8(chars, _mm256_set1_epi8(c0));
+        const __m256i eq1 = _mm256_cmpeq_epi8(chars, _mm256_set1_epi8(c1));
+        const __m256i eq2 = _mm256_cmpeq_epi8(chars, _mm256_set1_epi8(c2));
+        return _mm256_movemask_epi8(_mm256_or_si256(_mm256_or_si256(eq0, eq1), eq2));
+    }
+#endif
+    uint32_t mask = 0;
+    const auto n = std::min<std::ptrdiff_t>(32, end - block);
+    for (std::ptrdiff_t i = 0; i != n; ++i)
+        mask |= uint32_t(block[i] == c0 or block[i] == c1 or block[i] == c2) << i;
+    return mask;
+}
+
+/** A range of rows of the input, which is parsed by a single thread. */
+struct chunk_t
+{
+    const char *begin; ///< the first character of the chunk
+    const char *end; ///< the end of the chunk, i.e. one past the newline of its last row
+    unsigned line; ///< the number of lines preceding the chunk
+    std::size_t first_row; ///< the row of the store the first row of the chunk is written to
+    std::size_t num_rows = 0; ///< the number of rows of the chunk
+    std::unique_ptr<StackMachine> W; ///< the `StackMachine` writing rows to the store, starting at `first_row`
+    std::size_t num_rows_written = 0; ///< the number of rows written, i.e. not dropped as malformed
+    bool rows_match = true; ///< whether the parser found exactly the rows of the chunk
+    std::ostringstream out, err; ///< the messages emitted while parsing the chunk
+    unsigned num_errors = 0; ///< the number of errors emitted while parsing the chunk
+
+    chunk_t(const char *begin, unsigned line, std::size_t first_row)
+        : begin(begin), end(begin), line(line), first_row(first_row)
+    { }
+};
+
+/** Splits the rows in `[begin, end)`, which are preceded by \p line lines, into chunks of at least \p chunk_size
+ * characters, to be written to the store starting at row \p first_row.  A chunk only ends before a row that is a
+ * multiple of \p granule, such that writes to different chunks never share a byte of the store.  Finds newlines,
+ * quotes, and escape characters with SIMD instructions and keeps track of quoted strings, in which newlines do not
+ * end a row. */
+std::vector<chunk_t> split_into_chunks(const char *begin, const char *end, const DSVReader::Config &cfg, unsigned line,
+                                       std::size_t first_row, std::size_t chunk_size, std::size_t granule)
+{
+    std::vector<chunk_t> chunks;
+    chunks.emplace_back(begin, line, first_row);
+    if (cfg.num_rows == 0)
+        return chunks;
+
+    std::size_t num_rows = 0;
+    bool in_quotes = false;
+    const char *escaped = nullptr; ///< the character following the most recent escape character within quotes
+
+    for (const char *block = begin; block < end; block += 32) {
+        for (uint32_t mask = find_chars(block, end, '\n', cfg.quote, cfg.escape); mask; mask &= mask - 1) {
+            const char *p = block + __builtin_ctz(mask);
+            if (p == escaped)
+                continue;
+            if (in_quotes) {
+                if (*p == cfg.quote)
+                    in_quotes = false;
+                else if (*p == cfg.escape)
+                    escaped = p + 1;
+                else if (*p == '\n')
+                    ++line;
+            } else if (*p == cfg.quote) {
+                in_quotes = true;
+            } else if (*p == '\n') {
+                ++line;
+                auto &chunk = chunks.back();
+                chunk.end = p + 1;
+                ++chunk.num_rows;
+                if (++num_rows == cfg.num_rows)
+                    return chunks;
+                if (chunk.end - chunk.begin >= std::ptrdiff_t(chunk_size) and (first_row + num_rows) % granule == 0
+                    and chunk.end != end)
+                    chunks.emplace_back(chunk.end, line, first_row + num_rows);
+            }
+        }
+    }
+
+    /* The last row may lack a terminating newline. */
+    auto &chunk = chunks.back();
+    if (chunk.end != end) {
+        chunk.end = end;
+        ++chunk.num_rows;
+    }
+    return chunks;
+}
+
+}
+
 DSVReader::DSVReader(const Table &table, Config cfg, Diagnostic &diag, Scheduler::Transaction *transaction)
     : Reader(table, diag, transaction)
     , cfg_(cfg)
@@ -27,47 +142,179 @@ DSVReader::DSVReader(const Table &table, Config cfg, Diagnostic &diag, Scheduler
 {
     if (config().delimiter == config().quote)
         throw invalid_argument("delimiter and quote must not be the same character");
+
+    /* Find timestamp attributes */
+    if (transaction) {
+        auto &C = Catalog::Get();
+        for (auto it = table.cbegin_hidden(); it != table.end_hidden(); ++it) {
+            if (it->name == C.pool("$ts_begin"))
+                ts_begin = &*it;
+            else if (it->name == C.pool("$ts_end"))
+                ts_end = &*it;
+        }
+    }
 }
 
 void DSVReader::operator()(std::istream &in, const char *name)
 {
-    auto &C = Catalog::Get();
+    tup = Tuple(table_schema(table)); // allocate intermediate tuple
+    this->in = &in;
+    begin_input(name);
+    read_rows(read_header());
+    this->in = nullptr;
+}
+
+void DSVReader::read_memory(const char *data, std::size_t size, const char *name)
+{
     auto &store = table.store();
+    const Schema S = table_schema(table);
 
-    /* Compute table schema. */
-    Schema S;
-    for (auto it = table.begin_all(); it != table.end_all(); ++it) S.add({table.name(), it->name}, it->type);
+    /*----- Handle header information. -------------------------------------------------------------------------------*/
+    tup = Tuple(S);
+    mem = data;
+    mem_end = data + size;
+    begin_input(name);
+    const auto columns = read_header();
+    const char *rows_begin = good() ? mem - 1 : mem_end;
+    const unsigned rows_line = pos.line - 1; // the number of lines preceding the rows
+
+    /*----- Split the rows into chunks. ------------------------------------------------------------------------------*/
+    const std::size_t num_threads = config().num_threads ? config().num_threads
+                                                         : std::max(1U, std::thread::hardware_concurrency());
+    const std::size_t first_row = store.num_rows();
+    const DataLayout &layout = table.layout();
+    /* Rows in different top-level strides of the layout, e.g. in different PAX blocks, never share a byte. */
+    const std::size_t granule = layout.child().num_tuples() * (8 / std::gcd(layout.stride_in_bits(), uint64_t(8)));
+    const std::size_t chunk_size = std::max(config().chunk_size, std::size_t(mem_end - rows_begin) / (4 * num_threads));
+    auto chunks = split_into_chunks(rows_begin, mem_end, config(), rows_line, first_row, chunk_size, granule);
+
+    /* Allocate all rows up front, such that the chunks can be written concurrently. */
+    for (auto &chunk : chunks) {
+        for (std::size_t i = 0; i != chunk.num_rows; ++i)
+            store.append();
+        chunk.W = std::make_unique<StackMachine>(Interpreter::compile_store(S, store.memory().addr(), layout, S,
+                                                                            chunk.first_row));
+    }
 
-    /* Declare reference to the `StackMachine` for the current `Linearization`. */
-    std::unique_ptr<StackMachine> W;
-    const DataLayout *layout = nullptr;
+    /*----- Read the chunks in parallel. -----------------------------------------------------------------------------*/
+    auto read_chunk = [&](chunk_t &chunk) {
+        Diagnostic chunk_diag(diag.color(), chunk.out, chunk.err);
+        DSVReader R(table, config(), chunk_diag, transaction);
+        R.tup = Tuple(S);
+        R.mem = chunk.begin;
+        /* Unless the chunk ends the input, let the parser see the first character of the next chunk.  This way, a row
+         * the parser does not end at the end of the chunk runs into the end of the input, which is detected below. */
+        const bool is_last = chunk.end == mem_end;
+        R.mem_end = is_last ? chunk.end : chunk.end + 1;
+        R.begin_input(name, chunk.line);
+        std::size_t num_rows = 0;
+        while (R.good() and R.mem <= chunk.end and num_rows++ != chunk.num_rows) {
+            if (R.read_row(columns)) {
+                Tuple *args[] = { &R.tup };
+                (*chunk.W)(args); // write tuple to store
+                ++chunk.num_rows_written;
+            }
+        }
+        chunk.rows_match = num_rows == chunk.num_rows and (is_last ? not R.good() : R.c != EOF);
+        chunk.num_errors = chunk_diag.num_errors();
+    };
 
-    /* Allocate intermediate tuple. */
-    tup = Tuple(S);
+    std::atomic_size_t next_chunk(0);
+    auto worker = [&]() {
+        for (std::size_t idx; (idx = next_chunk.fetch_add(1)) < chunks.size(); )
+            read_chunk(chunks[idx]);
+    };
+    std::vector<std::thread> threads;
+    for (std::size_t i = 1; i < std::min(num_threads, chunks.size()); ++i)
+        threads.emplace_back(worker);
+    worker(); // the current thread participates as well
+    for (auto &t : threads)
+        t.join();
+
+    if (not std::all_of(chunks.begin(), chunks.end(), [](const chunk_t &chunk) { return chunk.rows_match; })) {
+        /* The parser disagrees with the chunks on where rows end, which only happens for malformed quoting, e.g. a
+         * quote within an unquoted cell.  Discard the rows and read the input sequentially instead. */
+        while (store.num_rows() != first_row)
+            store.drop();
+        mem = data;
+        begin_input(name);
+        read_rows(read_header());
+        mem = mem_end = nullptr;
+        return;
+    }
+    mem = mem_end = nullptr;
 
-    std::vector<const Attribute*> columns; ///< maps column offset to attribute
-    this->in = &in;
-    c = '\n';
-    pos = Position(name);
-    step(); // initialize the variable `c` by reading the first character from the input stream
+    for (auto &chunk : chunks)
+        diag.forward(chunk.out.str(), chunk.err.str(), chunk.num_errors); // report messages in order of the input
 
-    auto read_cell = [&]() -> ThreadSafePooledString {
-        buf.clear();
-        while (c != EOF and c != '\n' and c != config().delimiter) {
-            buf.push_back(c);
-            step();
+    /*----- Close the gaps left by dropped rows. ---------------------------------------------------------------------*/
+    std::size_t num_rows = first_row + chunks.front().num_rows_written;
+    std::unique_ptr<StackMachine> W;
+    for (auto it = std::next(chunks.begin()); it != chunks.end(); ++it) {
+        if (num_rows == it->first_row) {
+            W.reset(); // rows are in place
+        } else {
+            if (not W)
+                W = std::make_unique<StackMachine>(Interpreter::compile_store(S, store.memory().addr(), layout, S,
+                                                                              num_rows));
+            auto L = Interpreter::compile_load(S, store.memory().addr(), layout, S, it->first_row);
+            Tuple *args[] = { &tup };
+            for (std::size_t i = 0; i != it->num_rows_written; ++i) {
+                L(args);
+                (*W)(args);
+            }
         }
-        buf.push_back(0);
-        return C.pool(&buf[0]);
-    };
+        num_rows += it->num_rows_written;
+    }
+    while (store.num_rows() != num_rows)
+        store.drop();
+}
+
+bool DSVReader::read_file(const std::filesystem::path &path, const char *name)
+{
+    if (not name) name = path.c_str();
+
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd == -1)
+        return false;
+
+    struct stat st;
+    if (::fstat(fd, &st) == 0 and S_ISREG(st.st_mode) and st.st_size > 0) {
+        void *data = ::mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (data != MAP_FAILED) {
+            ::close(fd);
+            ::madvise(data, st.st_size, MADV_SEQUENTIAL);
+            read_memory(static_cast<const char*>(data), st.st_size, name);
+            ::munmap(data, st.st_size);
+            return true;
+        }
+    }
+    ::close(fd);
+
+    /* Read anything but a non-empty, regular file as a stream. */
+    std::ifstream file(path);
+    if (not file)
+        return false;
+    (*this)(file, name);
+    return true;
+}
+
+std::vector<const Attribute*> DSVReader::read_header()
+{
+    auto &C = Catalog::Get();
+    std::vector<const Attribute*> columns; ///< maps column offset to attribute
 
-    /*----- Handle header information. -------------------------------------------------------------------------------*/
     if (config().has_header and not config().skip_header) {
         while (c != EOF and c != '\n') {
-            auto name = read_cell();
+            buf.clear();
+            while (c != EOF and c != '\n' and c != config().delimiter) {
+                buf.push_back(c);
+                step();
+            }
+            buf.push_back(0);
             const Attribute *attr = nullptr;
             try {
-                attr = &table.at(name);
+                attr = &table.at(C.pool(&buf[0]));
             } catch (std::out_of_range) { /* nothing to do */ }
             columns.push_back(attr);
             if (c == config().delimiter)
@@ -79,76 +326,81 @@ void DSVReader::operator()(std::istream &in, const char *name)
         for (auto &attr : table)
             columns.push_back(&attr);
         if (config().skip_header) {
-            in.ignore(std::numeric_limits<std::streamsize>::max(), '\n'); // skip entire line
-            c = '\n';
+            discard_row(); // skip entire line
             step(); // skip newline
         }
     }
 
-    /* Find timestamp attributes */
-    auto ts_begin = std::find_if(table.cbegin_hidden(), table.end_hidden(),
-                                 [&](const Attribute & attr) {
-                                    return attr.name == C.pool("$ts_begin");
-    });
-    auto ts_end = std::find_if(table.cbegin_hidden(), table.end_hidden(),
-                               [&](const Attribute & attr) {
-                                    return attr.name == C.pool("$ts_end");
-    });
-
-    /*----- Read data. -----------------------------------------------------------------------------------------------*/
-    std::size_t idx = 0;
-    while (in.good() and idx < config().num_rows) {
-        ++idx;
-        store.append();
-        for (std::size_t i = 0; i != columns.size(); ++i) {
-            auto col = columns[i];
-            if (i != 0 and not accept(config().delimiter)) {
-                diag.e(pos) << "Expected a delimiter (" << config().delimiter << ").\n";
-                discard_row();
-                --idx;
-                store.drop(); // drop the unfinished row
-                goto end_of_row;
-            }
+    return columns;
+}
 
-            if (col) { // current cell should be read
-                if ((i == columns.size() - 1 and c == '\n') or (i < columns.size() - 1 and c == config().delimiter)) { // NULL
-                    tup.null(col->id);
-                    continue; // keep delimiter (expected at beginning of each loop)
-                }
-                col_idx = col->id;
-                (*this)(*col->type); // dynamic dispatch based on column type
-                discard_cell(); // discard remainder of the cell
-            } else {
-                discard_cell();
-            }
-        }
-        if (c != EOF and c != '\n') {
-            diag.e(pos) << "Expected end of row.\n";
+bool DSVReader::read_row(const std::vector<const Attribute*> &columns)
+{
+    bool is_valid = true;
+    for (std::size_t i = 0; i != columns.size(); ++i) {
+        auto col = columns[i];
+        if (i != 0 and not accept(config().delimiter)) {
+            diag.e(pos) << "Expected a delimiter (" << config().delimiter << ").\n";
             discard_row();
-        } else {
-            if (layout != &table.layout()) {
-                /* The data layout was updated, recompile stack machine. */
-                layout = &table.layout();
-                W = std::make_unique<StackMachine>(Interpreter::compile_store(S, store.memory().addr(), *layout,
-                                                                              S, store.num_rows() - 1));
-            }
-            /*----- set timestamps if available. -----*/
-            if (this->transaction and ts_begin != table.end_hidden()) {
-                tup.set(ts_begin->id, Value(transaction->start_time()));
-                /* Set $ts_end to -1. It is a special value representing infinity. */
-                M_insist(ts_end != table.end_hidden());
-                tup.set(ts_end->id, Value(-1));
-            }
+            is_valid = false;
+            goto end_of_row;
+        }
 
-            Tuple *args[] = { &tup };
-            (*W)(args); // write tuple to store
+        if (col) { // current cell should be read
+            if ((i == columns.size() - 1 and c == '\n') or (i < columns.size() - 1 and c == config().delimiter)) { // NULL
+                tup.null(col->id);
+                continue; // keep delimiter (expected at beginning of each loop)
+            }
+            col_idx = col->id;
+            (*this)(*col->type); // dynamic dispatch based on column type
+            discard_cell(); // discard remainder of the cell
+        } else {
+            discard_cell();
         }
-end_of_row:
-        M_insist(c == EOF or c == '\n');
-        step();
     }
+    if (c != EOF and c != '\n') {
+        diag.e(pos) << "Expected end of row.\n";
+        discard_row();
+        is_valid = false;
+    } else if (ts_begin) {
+        /*----- set timestamps if available. -----*/
+        tup.set(ts_begin->id, Value(transaction->start_time()));
+        /* Set $ts_end to -1. It is a special value representing infinity. */
+        M_insist(ts_end);
+        tup.set(ts_end->id, Value(-1));
+    }
+end_of_row:
+    M_insist(c == EOF or c == '\n');
+    step();
+    return is_valid;
+}
 
-    this->in = nullptr;
+void DSVReader::read_rows(const std::vector<const Attribute*> &columns)
+{
+    auto &store = table.store();
+    const Schema S = table_schema(table);
+
+    /* Declare reference to the `StackMachine` for the current `Linearization`. */
+    std::unique_ptr<StackMachine> W;
+    const DataLayout *layout = nullptr;
+
+    /* Malformed rows are dropped but count towards `Config::num_rows`, such that the same rows are read no matter
+     * whether the input is read sequentially or in parallel. */
+    for (std::size_t idx = 0; good() and idx != config().num_rows; ++idx) {
+        store.append();
+        if (not read_row(columns)) {
+            store.drop(); // drop the malformed row
+            continue;
+        }
+        if (layout != &table.layout()) {
+            /* The data layout was updated, recompile stack machine. */
+            layout = &table.layout();
+            W = std::make_unique<StackMachine>(Interpreter::compile_store(S, store.memory().addr(), *layout,
+                                                                          S, store.num_rows() - 1));
+        }
+        Tuple *args[] = { &tup };
+        (*W)(args); // write tuple to store
+    }
 }
 
 
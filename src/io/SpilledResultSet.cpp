@@ -0,0 +1,122 @@
+#include <mutable/io/SpilledResultSet.hpp>
+
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <mutable/util/exception.hpp>
+#include <mutable/util/fn.hpp>
+#include <string>
+#include <sys/mman.h>
+#include <unistd.h>
+
+
+using namespace m;
+using namespace m::storage;
+
+
+namespace {
+
+/** Adds copies of all children of \p src to \p dst. */
+void copy_children(const DataLayout::INode &src, DataLayout::INode &dst)
+{
+    for (std::size_t i = 0; i != src.num_children(); ++i) {
+        auto &child = src[i];
+        if (auto leaf = cast<const DataLayout::Leaf>(child.ptr.get())) {
+            dst.add_leaf(leaf->type(), leaf->index(), child.offset_in_bits, child.stride_in_bits, leaf->encoding());
+        } else {
+            auto &inode = as<const DataLayout::INode>(*child.ptr);
+            copy_children(inode, dst.add_inode(inode.num_tuples(), child.offset_in_bits, child.stride_in_bits));
+        }
+    }
+}
+
+/** Returns a deep copy of \p src. */
+DataLayout copy_layout(const DataLayout &src)
+{
+    DataLayout dst(src.is_finite() ? src.num_tuples() : 0);
+    if (not src) return dst;
+    if (auto leaf = cast<const DataLayout::Leaf>(&src.child())) {
+        dst.add_leaf(leaf->type(), leaf->index(), src.stride_in_bits(), leaf->encoding());
+    } else {
+        auto &inode = as<const DataLayout::INode>(src.child());
+        copy_children(inode, dst.add_inode(inode.num_tuples(), src.stride_in_bits()));
+    }
+    return dst;
+}
+
+/** Returns the size in bytes of \p num_tuples tuples laid out by \p layout, starting at the first tuple. */
+std::size_t batch_size_in_bytes(const DataLayout &layout, std::size_t num_tuples)
+{
+    if (not layout or num_tuples == 0) return 0;
+    const std::size_t tuples_per_instance = layout.child().num_tuples();
+    const std::size_t num_instances = (num_tuples + tuples_per_instance - 1) / tuples_per_instance;
+    return num_instances * ((layout.stride_in_bits() + 7) / 8);
+}
+
+}
+
+SpilledResultSet::SpilledResultSet(const char *directory)
+{
+    if (not directory) directory = std::getenv("TMPDIR");
+    if (not directory) directory = "/tmp";
+    std::string path = std::string(directory) + "/mutable-result-set-XXXXXX";
+    fd_ = mkstemp(path.data());
+    if (fd_ == -1)
+        throw m::runtime_error(std::string("cannot create spill file: ") + strerror(errno));
+    unlink(path.c_str()); // remove the file as soon as it is closed
+}
+
+SpilledResultSet::~SpilledResultSet()
+{
+    if (fd_ != -1) close(fd_);
+}
+
+void SpilledResultSet::append(const Schema &schema, const CallbackOperator::batch_type &batch)
+{
+    if (not schema_) {
+        operator_schema_.emplace(schema);
+        schema_.emplace(batch.schema);
+        layout_ = copy_layout(batch.layout);
+        constants_ = batch.constants.clone(schema);
+    }
+    M_insist(schema == *operator_schema_ and batch.schema == *schema_, "batches must be produced by the same operator");
+
+    /* Write the batch verbatim at the next page aligned offset, s.t. it can be mapped back individually. */
+    const std::size_t size = batch_size_in_bytes(batch.layout, batch.num_tuples);
+    const std::size_t offset = file_size_;
+    M_insist(Is_Page_Aligned(offset));
+    auto data = static_cast<const uint8_t*>(batch.data);
+    for (std::size_t written = 0; written != size; ) {
+        const auto res = pwrite(fd_, data + written, size - written, offset + written);
+        if (res == -1) {
+            if (errno == EINTR) continue;
+            throw m::runtime_error(std::string("cannot write spill file: ") + strerror(errno));
+        }
+        written += res;
+    }
+    if (size) file_size_ = Ceil_To_Next_Page(offset + size);
+
+    batches_.push_back(batch_t{ offset, size, batch.num_tuples });
+    num_tuples_ += batch.num_tuples;
+}
+
+void SpilledResultSet::for_each_batch(const CallbackOperator::batch_callback_type &callback) const
+{
+    for (auto &batch : batches_) {
+        void *addr = nullptr;
+        if (batch.size) {
+            addr = mmap(nullptr, batch.size, PROT_READ, MAP_PRIVATE, fd_, batch.offset);
+            if (addr == MAP_FAILED)
+                throw m::runtime_error(std::string("cannot map spill file: ") + strerror(errno));
+        }
+        try {
+            callback(*operator_schema_, CallbackOperator::batch_type{
+                *schema_, layout_, addr, batch.num_tuples, constants_
+            });
+        } catch (...) {
+            if (addr) munmap(addr, batch.size);
+            throw;
+        }
+        if (addr) munmap(addr, batch.size);
+    }
+}
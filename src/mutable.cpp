@@ -85,6 +85,8 @@ void m::process_stream(std::istream &in, const char *filename, Diagnostic diag)
                 if (M.is_finished())
                     std::cout << M.name << ": " << duration_cast<microseconds>(M.duration()).count() / 1e3 << '\n';
             }
+            for (const auto &[name, value] : timer.counters())
+                std::cout << name << ": " << value << '\n';
             std::cout.flush();
             timer.clear();
         }
@@ -189,6 +191,7 @@ void m::execute_statement(Diagnostic &diag, const ast::Stmt &stmt, const bool is
     } else if (auto I = cast<const ast::InsertStmt>(&stmt)) {
         auto &DB = C.get_database_in_use();
         auto &T = DB.get_table(I->table_name.text.assert_not_none());
+        decompress_table(T); // rows cannot be appended to encoded leaves
         auto &store = T.store();
         StoreWriter W(store);
         auto &S = W.schema();
@@ -263,6 +266,7 @@ void m::execute_statement(Diagnostic &diag, const ast::Stmt &stmt, const bool is
     } else if (auto S = cast<const ast::DSVImportStmt>(&stmt)) {
         auto &DB = C.get_database_in_use();
         auto &T = DB.get_table(S->table_name.text.assert_not_none());
+        decompress_table(T); // rows cannot be appended to encoded leaves
 
         DSVReader::Config cfg;
         if (S->rows) cfg.num_rows = strtol(*S->rows.text, nullptr, 10);
@@ -277,15 +281,13 @@ void m::execute_statement(Diagnostic &diag, const ast::Stmt &stmt, const bool is
 
             std::string filename(*S->path.text, 1, strlen(*S->path.text) - 2);
             errno = 0;
-            std::ifstream file(filename);
-            if (not file) {
+            const bool is_open = M_TIME_EXPR((R.read_file(filename, *S->path.text)), "Read DSV file", timer);
+            if (not is_open) {
                 const auto errsv = errno;
                 diag.e(S->path.pos) << "Could not open file '" << S->path.text << '\'';
                 if (errsv)
                     diag.err() << ": " << strerror(errsv);
                 diag.err() << std::endl;
-            } else {
-                M_TIME_EXPR(R(file, *S->path.text), "Read DSV file", timer);
             }
         } catch (m::invalid_argument e) {
             diag.err() << "Error reading DSV file: " << e.what() << "\n";
@@ -298,6 +300,8 @@ void m::execute_statement(Diagnostic &diag, const ast::Stmt &stmt, const bool is
             if (M.is_finished())
                 std::cout << M.name << ": " << duration_cast<microseconds>(M.duration()).count() / 1e3 << '\n';
         }
+        for (const auto &[name, value] : timer.counters())
+            std::cout << name << ": " << value << '\n';
         std::cout.flush();
         timer.clear();
     }
@@ -382,6 +386,148 @@ void m::execute_query(Diagnostic &diag, const SelectStmt &stmt, std::unique_ptr<
     execute_physical_plan(diag, *physical_plan, backend);
 }
 
+void m::execute_query_to_arrow(Diagnostic &diag, const SelectStmt &stmt,
+                               ArrowExportOperator::record_batch_callback_type callback)
+{
+    auto &C = Catalog::Get();
+    static thread_local std::unique_ptr<Backend> backend;
+    if (not backend)
+        backend = M_TIME_EXPR(C.create_backend(), "Create backend", C.timer());
+    auto consumer = std::make_unique<ArrowExportOperator>(std::move(callback));
+    auto logical_plan = logical_plan_from_statement(diag, stmt, std::move(consumer));
+    auto physical_plan = physical_plan_from_logical_plan(diag, *logical_plan, *backend);
+    execute_physical_plan(diag, *physical_plan, *backend);
+}
+
+PreparedStatement::PreparedStatement(std::unique_ptr<ast::Stmt> stmt, std::vector<ast::Parameter*> parameters,
+                                     std::unique_ptr<Consumer> logical_plan, std::unique_ptr<MatchBase> physical_plan)
+    : stmt_(M_notnull(std::move(stmt)))
+    , parameters_(std::move(parameters))
+    , logical_plan_(M_notnull(std::move(logical_plan)))
+    , physical_plan_(M_notnull(std::move(physical_plan)))
+{
+    M_insist(is<const SelectStmt>(*stmt_), "only select statements can be prepared");
+}
+
+namespace {
+
+/** Converts \p value to a constant `Token` of the type of \p param.  Reports an error to \p diag and returns an
+ * artificial token if \p value cannot be bound to \p param. */
+Token parameter_to_token(Diagnostic &diag, const Parameter &param, const PreparedStatement::parameter_type &value)
+{
+    auto &C = Catalog::Get();
+    const Type &ty = *param.type();
+    auto make_token = [&](const std::string &text, TokenType tt) {
+        return Token(param.tok.pos, C.pool(text.c_str()), tt);
+    };
+    auto to_float = [](double d) {
+        char buf[32];
+        snprintf(buf, sizeof(buf), "%.17g", d);
+        return std::string(buf);
+    };
+
+    auto tok = std::visit(overloaded {
+        [&](bool b) {
+            if (ty.is_boolean())
+                return make_token(b ? "TRUE" : "FALSE", b ? TK_True : TK_False);
+            return Token::CreateArtificial();
+        },
+        [&](int64_t i) {
+            if (ty.is_integral())
+                return make_token(std::to_string(i), TK_DEC_INT);
+            if (ty.is_double())
+                return make_token(to_float(i), TK_DEC_FLOAT);
+            return Token::CreateArtificial();
+        },
+        [&](double d) {
+            if (ty.is_double())
+                return make_token(to_float(d), TK_DEC_FLOAT);
+            return Token::CreateArtificial();
+        },
+        [&](const std::string &str) {
+            if (auto cs = cast<const CharacterSequence>(&ty); cs and str.length() <= cs->length)
+                return make_token(quote(escape(str)), TK_STRING_LITERAL);
+            int year, month, day, hour, minute, second, len = -1;
+            if (ty.is_date() and
+                3 == sscanf(str.c_str(), "%d-%d-%d%n", &year, &month, &day, &len) and len == int(str.length()) and
+                year != 0 and month >= 1 and month <= 12 and day >= 1 and day <= 31)
+                return make_token("d'" + str + "'", TK_DATE);
+            if (ty.is_date_time() and
+                6 == sscanf(str.c_str(), "%d-%d-%d %d:%d:%d%n", &year, &month, &day, &hour, &minute, &second, &len) and
+                len == int(str.length()) and year != 0 and month >= 1 and month <= 12 and day >= 1 and day <= 31 and
+                hour >= 0 and hour <= 23 and minute >= 0 and minute <= 59 and second >= 0 and second <= 59)
+                return make_token("d'" + str + "'", TK_DATE_TIME);
+            return Token::CreateArtificial();
+        },
+    }, value);
+
+    if (not tok)
+        diag.e(param.tok.pos) << "Cannot bind a value of this kind to parameter " << param << " of type " << ty
+                              << ".\n";
+    return tok;
+}
+
+}
+
+void PreparedStatement::bind(Diagnostic &diag, const std::vector<parameter_type> &params)
+{
+    if (params.size() != parameters_.size()) {
+        diag.err() << "Statement has " << parameters_.size() << " parameters but " << params.size()
+                   << " values were given.\n";
+        throw invalid_argument("wrong number of parameter values");
+    }
+
+    for (std::size_t i = 0; i != params.size(); ++i) {
+        auto tok = parameter_to_token(diag, *parameters_[i], params[i]);
+        if (not tok)
+            throw invalid_argument("cannot bind parameter value");
+        parameters_[i]->bind(std::move(tok));
+    }
+}
+
+void PreparedStatement::reset() const
+{
+    visit([](const Operator &op) { delete op.data(nullptr); }, *logical_plan_, m::tag<ConstPreOrderOperatorVisitor>());
+}
+
+std::unique_ptr<PreparedStatement> m::prepare(Diagnostic &diag, const std::string &sql,
+                                              std::unique_ptr<Consumer> consumer)
+{
+    Catalog &C = Catalog::Get();
+
+    std::istringstream in(sql);
+    Lexer lexer(diag, C.get_pool(), "-", in);
+    Parser parser(lexer);
+    auto stmt = M_TIME_EXPR(std::unique_ptr<Stmt>(parser.parse_Stmt()), "Parse the statement", C.timer());
+    if (diag.num_errors() != 0)
+        throw frontend_exception("syntactic error in statement");
+    M_insist(diag.num_errors() == 0);
+    if (not is<const SelectStmt>(*stmt)) {
+        diag.err() << "Only SELECT statements can be prepared.\n";
+        throw frontend_exception("statement cannot be prepared");
+    }
+
+    Sema sema(diag, /* allow_parameters= */ true);
+    M_TIME_EXPR(sema(*stmt), "Semantic analysis", C.timer());
+    if (diag.num_errors() != 0)
+        throw frontend_exception("semantic error in statement");
+    M_insist(diag.num_errors() == 0);
+
+    auto logical_plan = logical_plan_from_statement(diag, as<const SelectStmt>(*stmt), std::move(consumer));
+    auto physical_plan = physical_plan_from_logical_plan(diag, *logical_plan);
+    return std::make_unique<PreparedStatement>(std::move(stmt), parser.parameters(), std::move(logical_plan),
+                                               std::move(physical_plan));
+}
+
+void m::execute(Diagnostic &diag, PreparedStatement &stmt,
+                const std::vector<PreparedStatement::parameter_type> &params)
+{
+    diag.clear();
+    stmt.bind(diag, params);
+    stmt.reset(); // the execution state of the previous execution depends on the previous parameter values
+    execute_physical_plan(diag, stmt.physical_plan());
+}
+
 void m::load_from_CSV(Diagnostic &diag, Table &table, const std::filesystem::path &path, std::size_t num_rows,
                       bool has_header, bool skip_header)
 {
@@ -390,17 +536,15 @@ void m::load_from_CSV(Diagnostic &diag, Table &table, const std::filesystem::pat
     cfg.num_rows = num_rows;
     cfg.has_header = has_header;
     cfg.skip_header = skip_header;
+    decompress_table(table); // rows cannot be appended to encoded leaves
     DSVReader R(table, std::move(cfg), diag);
 
     errno = 0;
-    std::ifstream file(path);
-    if (not file) {
+    if (not R.read_file(path)) {
         diag.e(Position(path.c_str())) << "Could not open file '" << path << '\'';
         if (errno)
             diag.err() << ": " << strerror(errno);
         diag.err() << std::endl;
-    } else {
-        R(file, path.c_str()); // read the file
     }
 
     if (diag.num_errors() != 0)
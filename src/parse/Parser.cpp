@@ -133,6 +133,7 @@ std::unique_ptr<Instruction> Parser::parse_Instruction()
 std::unique_ptr<Stmt> Parser::parse_Stmt()
 {
     Token start = token();
+    parameters_.clear();
     std::unique_ptr<Stmt> stmt = nullptr;
     switch (token().type) {
         default:
@@ -966,7 +967,7 @@ std::unique_ptr<Clause> Parser::parse_LimitClause()
 std::unique_ptr<Expr> Parser::parse_Expr(const int precedence_lhs, std::unique_ptr<Expr> lhs)
 {
     /*
-     * primary-expression ::= designator | constant | '(' expression ')' | '(' select-statement ')' ;
+     * primary-expression ::= designator | constant | '?' | '(' expression ')' | '(' select-statement ')' ;
      * unary-expression ::= [ '+' | '-' | '~' ] postfix-expression ;
      * logical-not-expression ::= 'NOT' logical-not-expression | comparative-expression ;
      */
@@ -988,6 +989,16 @@ std::unique_ptr<Expr> Parser::parse_Expr(const int precedence_lhs, std::unique_p
         case TK_HEX_FLOAT:
             lhs = std::make_unique<Constant>(consume());
             break;
+        case TK_QMARK: {
+            /* Name the parameter by its position to make it distinguishable from other parameters. */
+            auto tok = consume();
+            const unsigned index = parameters_.size();
+            tok.text = Catalog::Get().pool(("?" + std::to_string(index + 1)).c_str());
+            auto param = std::make_unique<Parameter>(std::move(tok), index);
+            parameters_.push_back(param.get());
+            lhs = std::move(param);
+            break;
+        }
         case TK_LPAR:
             consume();
             if (token().type == TK_Select)
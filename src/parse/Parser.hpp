@@ -7,6 +7,7 @@
 #include <mutable/lex/TokenType.hpp>
 #include <mutable/parse/AST.hpp>
 #include <mutable/util/Diagnostic.hpp>
+#include <vector>
 
 
 namespace m {
@@ -23,6 +24,7 @@ struct M_EXPORT Parser
 
     private:
     std::array<Token, 2> lookahead_;
+    std::vector<Parameter*> parameters_; ///< the parameters of the current statement, in order of occurrence
 
     public:
     explicit Parser(Lexer &lexer)
@@ -74,6 +76,9 @@ struct M_EXPORT Parser
         return std::make_unique<T>(std::move(start));
     }
 
+    /** Returns the parameters of the statement parsed last, in order of occurrence. */
+    const std::vector<Parameter*> & parameters() const { return parameters_; }
+
     std::unique_ptr<Command> parse();
     std::unique_ptr<Instruction> parse_Instruction();
     std::unique_ptr<Stmt> parse_Stmt();
@@ -85,6 +85,31 @@ ThreadSafePooledOptionalString Sema::make_unique_id_from_binding_path(context_st
     return C.pool(oss.str().c_str());
 }
 
+void Sema::infer_parameter_type(Parameter &param, const Type &other)
+{
+    if (not allow_parameters_) {
+        diag.e(param.tok.pos) << "Parameters are only allowed in prepared statements.\n";
+        param.type_ = Type::Get_Error();
+    } else if (other.is_error()) {
+        param.type_ = Type::Get_Error();
+    } else if (other.is_boolean()) {
+        param.type_ = Type::Get_Boolean(Type::TY_Scalar);
+    } else if (auto cs = cast<const CharacterSequence>(&other)) {
+        param.type_ = Type::Get_Char(Type::TY_Scalar, cs->length);
+    } else if (other.is_date()) {
+        param.type_ = Type::Get_Date(Type::TY_Scalar);
+    } else if (other.is_date_time()) {
+        param.type_ = Type::Get_Datetime(Type::TY_Scalar);
+    } else if (other.is_integral()) {
+        param.type_ = Type::Get_Integer(Type::TY_Scalar, 8);
+    } else if (other.is_numeric()) {
+        param.type_ = Type::Get_Double(Type::TY_Scalar); // floating-point and decimal
+    } else {
+        diag.e(param.tok.pos) << "Cannot infer the type of parameter " << param << " from type " << other << ".\n";
+        param.type_ = Type::Get_Error();
+    }
+}
+
 bool Sema::is_composable_of(const ast::Expr &expr,
                             const std::vector<std::reference_wrapper<ast::Expr>> components)
 {
@@ -402,6 +427,17 @@ void Sema::operator()(Constant &e)
             e.type_ = Type::Get_None();
             break;
 
+        case TK_QMARK:
+            /* The type of a parameter is inferred from its context, e.g. the other operand of a comparison. */
+            if (not allow_parameters_) {
+                diag.e(e.tok.pos) << "Parameters are only allowed in prepared statements.\n";
+                e.type_ = Type::Get_Error();
+            } else if (not e.has_type()) {
+                diag.e(e.tok.pos) << "Cannot infer the type of parameter " << e << ".\n";
+                e.type_ = Type::Get_Error();
+            }
+            break;
+
         case TK_STRING_LITERAL:
             e.type_ = Type::Get_Char(Type::TY_Scalar, interpret(*e.tok.text).length());
             break;
@@ -753,9 +789,19 @@ void Sema::operator()(UnaryExpr &e)
 
 void Sema::operator()(BinaryExpr &e)
 {
-    /* Analyze sub-expressions. */
-    (*this)(*e.lhs);
-    (*this)(*e.rhs);
+    /* Analyze sub-expressions.  The type of a parameter is inferred from the type of the other operand. */
+    auto lhs_param = cast<Parameter>(e.lhs.get());
+    auto rhs_param = cast<Parameter>(e.rhs.get());
+    if (lhs_param and rhs_param) {
+        diag.e(e.op().pos) << "Cannot infer the types of parameters in " << e << ", both operands are parameters.\n";
+        lhs_param->type_ = rhs_param->type_ = Type::Get_Error();
+        e.type_ = Type::Get_Error();
+        return;
+    }
+    if (not lhs_param) (*this)(*e.lhs);
+    if (not rhs_param) (*this)(*e.rhs);
+    if (lhs_param) infer_parameter_type(*lhs_param, *e.rhs->type());
+    if (rhs_param) infer_parameter_type(*rhs_param, *e.lhs->type());
 
     /* If at least one of the sub-expressions is erroneous, so is this expression. */
     if (e.lhs->type()->is_error() or e.rhs->type()->is_error()) {
@@ -1667,6 +1713,10 @@ void Sema::operator()(CreateIndexStmt &s)
                 break;
             else if (s.method.text == C.pool("rmi")) // ok
                 break;
+            else if (s.method.text == C.pool("bplustree")) // ok
+                break;
+            else if (s.method.text == C.pool("hash")) // ok
+                break;
             else { // unknown method, not ok
                 diag.e(s.method.pos) << "Index method " << s.method.text << " not supported.\n";
                 return;
@@ -1746,6 +1796,10 @@ void Sema::operator()(CreateIndexStmt &s)
                 set_index.operator()<idx::ArrayIndex>();
             else if (s.method.text == C.pool("rmi"))
                 set_index.operator()<idx::RecursiveModelIndex>();
+            else if (s.method.text == C.pool("bplustree"))
+                set_index.operator()<idx::BPlusTreeIndex>();
+            else if (s.method.text == C.pool("hash"))
+                set_index.operator()<idx::HashIndex>();
             break;
         default:
             M_unreachable("invalid token type");
@@ -1881,20 +1935,113 @@ void Sema::operator()(InsertStmt &s)
         command_ = std::make_unique<InsertRecords>();
 }
 
+namespace {
+
+/** Reports an error for every nested query in \p expr of an `UPDATE` or `DELETE` statement and returns `true` iff
+ * there is any.  The rows to modify are evaluated one at a time, without a query plan, and hence nested queries cannot
+ * be evaluated. */
+bool reject_nested_queries(Diagnostic &diag, const Expr &expr)
+{
+    bool has_nested_query = false;
+    visit(overloaded {
+        [](auto&) { },
+        [&](const QueryExpr &e) {
+            diag.e(e.tok.pos) << "Nested queries are not supported in UPDATE and DELETE statements.\n";
+            has_nested_query = true;
+        },
+    }, expr, m::tag<ConstPreOrderExprVisitor>());
+    return has_nested_query;
+}
+
+}
+
+const Table * Sema::analyze_target_table(const Token &table_name)
+{
+    Catalog &C = Catalog::Get();
+
+    if (not C.has_database_in_use()) {
+        diag.e(table_name.pos) << "No database in use.\n";
+        return nullptr;
+    }
+    auto &DB = C.get_database_in_use();
+
+    const Table *tbl;
+    try {
+        tbl = &DB.get_table(table_name.text.assert_not_none());
+    } catch (std::out_of_range) {
+        diag.e(table_name.pos) << "Table " << table_name.text << " does not exist in database " << DB.name << ".\n";
+        return nullptr;
+    }
+
+    /* Make the attributes of the table accessible to the expressions of the statement. */
+    SemaContext &Ctx = get_context();
+    Ctx.sources.emplace(table_name.text.assert_not_none(), std::make_pair(std::ref(*tbl), 0U));
+    Ctx.stage = SemaContext::S_Where;
+    return tbl;
+}
+
 void Sema::operator()(UpdateStmt &s)
 {
     RequireContext RCtx(this, s);
-    /* TODO */
-    (void) s;
-    M_unreachable("Not implemented.");
+
+    auto tbl = analyze_target_table(s.table_name);
+    if (not tbl)
+        return;
+
+    /* Analyze assignments. */
+    for (auto &[attr_name, expr] : s.set) {
+        if (not tbl->has_attribute(attr_name.text.assert_not_none()) or
+            tbl->at(attr_name.text.assert_not_none()).is_hidden)
+        {
+            diag.e(attr_name.pos) << "Table " << tbl->name() << " has no attribute " << attr_name.text << ".\n";
+            continue;
+        }
+        auto &attr = tbl->at(attr_name.text.assert_not_none());
+
+        if (reject_nested_queries(diag, *expr)) continue;
+        (*this)(*expr);
+        if (expr->type()->is_error()) continue;
+        if (expr->type()->is_none()) {
+            if (attr.not_nullable)
+                diag.e(attr_name.pos) << "Value NULL is not valid for attribute " << attr.name
+                                      << " declared as NOT NULL.\n";
+            continue;
+        }
+        auto ty = as<const PrimitiveType>(expr->type());
+        if (ty->is_boolean() and attr.type->is_boolean())
+            continue;
+        if (ty->is_character_sequence() and attr.type->is_character_sequence())
+            continue;
+        if (ty->is_date() and attr.type->is_date())
+            continue;
+        if (ty->is_date_time() and attr.type->is_date_time())
+            continue;
+        if (ty->is_numeric() and attr.type->is_numeric())
+            continue;
+        diag.e(attr_name.pos) << "Value " << *expr << " is not valid for attribute " << attr.name << ".\n";
+    }
+
+    /* Analyze condition. */
+    if (auto where = cast<WhereClause>(s.where.get()); where and not reject_nested_queries(diag, *where->where))
+        (*this)(*where);
+
+    if (not is_nested() and not diag.num_errors())
+        command_ = std::make_unique<UpdateRecords>();
 }
 
 void Sema::operator()(DeleteStmt &s)
 {
     RequireContext RCtx(this, s);
-    /* TODO */
-    (void) s;
-    M_unreachable("Not implemented.");
+
+    if (not analyze_target_table(s.table_name))
+        return;
+
+    /* Analyze condition. */
+    if (auto where = cast<WhereClause>(s.where.get()); where and not reject_nested_queries(diag, *where->where))
+        (*this)(*where);
+
+    if (not is_nested() and not diag.num_errors())
+        command_ = std::make_unique<DeleteRecords>();
 }
 
 void Sema::operator()(DSVImportStmt &s)
@@ -103,9 +103,13 @@ struct M_EXPORT Sema : ASTVisitor
     std::ostringstream oss;
     ///> the command to execute when semantic analysis completes without errors
     std::unique_ptr<DatabaseCommand> command_;
+    ///> whether parameters are allowed, i.e. whether the statement is analyzed to be prepared
+    bool allow_parameters_;
 
     public:
-    Sema(Diagnostic &diag) : diag(diag) { }
+    /** Creates a `Sema` reporting errors to \p diag.  Parameters are only allowed if \p allow_parameters, i.e. if the
+     * statement is analyzed to be prepared, since otherwise no value is ever bound to them. */
+    Sema(Diagnostic &diag, bool allow_parameters = false) : diag(diag), allow_parameters_(allow_parameters) { }
 
     /** Perform semantic analysis of an `ast::Command`. Returns an `m::DatabaseCommand` to execute when no semantic
      * errors occurred, `nullptr` otherwise. */
@@ -144,6 +148,10 @@ struct M_EXPORT Sema : ASTVisitor
     /** Returns true iff the current statement, that is being analyzed, is a nested statement. */
     bool is_nested() const;
 
+    /** Looks up the table \p table_name modified by an `UPDATE` or `DELETE` statement and makes its attributes
+     * accessible to the expressions of the statement.  Returns the table, or `nullptr` after reporting an error. */
+    const Table * analyze_target_table(const Token &table_name);
+
 
     /*------------------------------------------------------------------------------------------------------------------
      * Sema Designator Helpers
@@ -181,6 +189,10 @@ struct M_EXPORT Sema : ASTVisitor
      * Other Sema Helpers
      *----------------------------------------------------------------------------------------------------------------*/
 
+    /** Infers the type of \p param from the type \p other of the other operand of the binary expression \p param is an
+     * operand of. */
+    void infer_parameter_type(Parameter &param, const Type &other);
+
     /** Computes whether the bound parts of \p expr are composable of elements in \p components. */
     bool is_composable_of(const ast::Expr &expr, const std::vector<std::reference_wrapper<ast::Expr>> components);
 
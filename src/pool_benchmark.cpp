@@ -0,0 +1,83 @@
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <mutable/util/Pool.hpp>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+using namespace m;
+using namespace std::chrono;
+
+#ifndef NDEBUG
+static constexpr std::size_t NUM_LOOKUPS_PER_THREAD = 1UL<<14;
+#else
+static constexpr std::size_t NUM_LOOKUPS_PER_THREAD = 1UL<<20;
+#endif
+static constexpr std::size_t NUM_DISTINCT_STRINGS = 1UL<<12;
+static constexpr std::size_t NUM_THREADS_STOP = 32;
+
+/** The string pool as implemented before sharding: a single hash table guarded by a single lock. */
+using SingleLockStringPool = detail::_StringPool</* ThreadSafe= */ true, /* NumShards= */ 1>;
+
+/** Returns `NUM_DISTINCT_STRINGS` identifier-like strings, e.g. attribute names. */
+std::vector<std::string> make_strings(const char *prefix)
+{
+    std::vector<std::string> strings;
+    strings.reserve(NUM_DISTINCT_STRINGS);
+    for (std::size_t i = 0; i != NUM_DISTINCT_STRINGS; ++i)
+        strings.emplace_back(prefix + std::to_string(i));
+    return strings;
+}
+
+/** Measures the throughput of \p num_threads threads concurrently internalizing strings in a fresh pool of type \p
+ * StringPool.  If \p hits, all strings are internalized before the measurement, s.t. every lookup finds its string.
+ * Otherwise, every thread internalizes strings of its own, s.t. every lookup inserts a new string. */
+template<typename StringPool>
+void run_benchmark(const char *pool_name, std::size_t num_threads, bool hits)
+{
+    StringPool pool;
+    std::vector<std::vector<std::string>> strings(num_threads);
+    for (std::size_t i = 0; i != num_threads; ++i)
+        strings[i] = make_strings(hits ? "attr_" : ("attr_" + std::to_string(i) + "_").c_str());
+    std::vector<typename StringPool::proxy_type> pooled;
+    if (hits) {
+        for (auto &str : strings[0])
+            pooled.emplace_back(pool(str.c_str())); // keep the strings pooled
+    }
+
+    std::vector<std::thread> threads;
+    threads.reserve(num_threads);
+    auto t0 = steady_clock::now();
+    for (std::size_t i = 0; i != num_threads; ++i) {
+        threads.emplace_back([&pool, &strings=strings[i], i]() {
+            std::size_t idx = i * 7919; // different threads start at different strings
+            for (std::size_t n = 0; n != NUM_LOOKUPS_PER_THREAD; ++n) {
+                auto str = pool(strings[idx % NUM_DISTINCT_STRINGS].c_str());
+                idx += 31;
+            }
+        });
+    }
+    for (auto &thread : threads)
+        thread.join();
+    auto t1 = steady_clock::now();
+
+    const std::size_t num_lookups = num_threads * NUM_LOOKUPS_PER_THREAD;
+    const double seconds = duration_cast<microseconds>(t1 - t0).count() / 1e6;
+    std::cout << (hits ? "lookup" : "insert") << ',' << pool_name << ',' << StringPool::num_shards << ','
+              << num_threads << ',' << num_lookups << ',' << seconds * 1e3 << ',' << num_lookups / seconds
+              << std::endl;
+}
+
+
+int main()
+{
+    std::cout << "benchmark,pool,num_shards,num_threads,num_lookups,time_ms,lookups_per_second" << std::endl;
+    for (bool hits : { true, false }) {
+        for (std::size_t num_threads = 1; num_threads <= NUM_THREADS_STOP; num_threads *= 2) {
+            run_benchmark<SingleLockStringPool>("SingleLockStringPool", num_threads, hits);
+            run_benchmark<ThreadSafeStringPool>("ThreadSafeStringPool", num_threads, hits);
+        }
+    }
+}
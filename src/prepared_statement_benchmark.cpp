@@ -0,0 +1,118 @@
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <mutable/mutable.hpp>
+#include <sstream>
+#include <string>
+#include <vector>
+
+
+using namespace m;
+using namespace std::chrono;
+
+#ifndef NDEBUG
+static constexpr std::size_t NUM_CALLS = 100;
+static constexpr std::size_t NUM_TUPLES_STOP = 1UL<<8;
+#else
+static constexpr std::size_t NUM_CALLS = 1000;
+static constexpr std::size_t NUM_TUPLES_STOP = 1UL<<12;
+#endif
+static constexpr std::size_t NUM_TUPLES_START = 1UL<<4;
+
+
+/** A query with a single parameter, given as SQL text with a placeholder `?` for the parameter. */
+struct query_type
+{
+    const char *name;
+    const char *sql;
+};
+
+static const query_type QUERIES[] = {
+    { "point",    "SELECT a, b FROM R WHERE a = ?;" },
+    { "range",    "SELECT a FROM R WHERE a < ? AND b = 3;" },
+    { "join",     "SELECT COUNT(*) FROM R, S WHERE R.a = S.a AND S.c < ?;" },
+};
+
+/** Replaces the placeholder `?` in \p sql by \p value. */
+std::string instantiate(const char *sql, int64_t value)
+{
+    std::string str(sql);
+    return str.replace(str.find('?'), 1, std::to_string(value));
+}
+
+/** Creates the tables `R(a, b)` and `S(a, c)` with \p num_tuples tuples each. */
+void create_tables(Diagnostic &diag, std::size_t num_tuples)
+{
+    Catalog::Clear();
+    Catalog &C = Catalog::Get();
+    auto &DB = C.add_database(C.pool("db"));
+    C.set_database_in_use(DB);
+
+    execute_statement(diag, *statement_from_string(diag, "CREATE TABLE R (a INT(4), b INT(4));"));
+    execute_statement(diag, *statement_from_string(diag, "CREATE TABLE S (a INT(4), c INT(4));"));
+    for (const char *table : { "R", "S" }) {
+        std::ostringstream oss;
+        oss << "INSERT INTO " << table << " VALUES ";
+        for (std::size_t i = 0; i != num_tuples; ++i)
+            oss << (i ? ", (" : "(") << i << ", " << i % 16 << ')';
+        oss << ';';
+        execute_statement(diag, *statement_from_string(diag, oss.str()));
+    }
+}
+
+void report(const query_type &Q, std::size_t num_tuples, const char *mode, nanoseconds d, std::size_t num_results)
+{
+    std::cout << "prepared_statement," << Q.name << ',' << num_tuples << ',' << mode << ',' << NUM_CALLS << ','
+              << duration_cast<nanoseconds>(d).count() / 1e3 / NUM_CALLS << ',' << num_results << std::endl;
+}
+
+/** Measures the latency per call of executing \p Q with varying parameter values, once by going through lexer,
+ * parser, semantic analysis, and optimizer for every call and once by executing a `PreparedStatement`. */
+void run_benchmark(Diagnostic &diag, const query_type &Q, std::size_t num_tuples)
+{
+    std::size_t num_results = 0;
+    auto make_consumer = [&num_results]() {
+        return std::make_unique<CallbackOperator>([&num_results](const Schema&, const Tuple&) { ++num_results; });
+    };
+
+    /*----- Parse, analyze, and optimize for every call. -----*/
+    {
+        num_results = 0;
+        auto t0 = steady_clock::now();
+        for (std::size_t i = 0; i != NUM_CALLS; ++i) {
+            auto stmt = statement_from_string(diag, instantiate(Q.sql, i % num_tuples));
+            auto logical_plan = logical_plan_from_statement(diag, as<const ast::SelectStmt>(*stmt), make_consumer());
+            auto physical_plan = physical_plan_from_logical_plan(diag, *logical_plan);
+            execute_physical_plan(diag, *physical_plan);
+        }
+        auto t1 = steady_clock::now();
+        report(Q, num_tuples, "one-shot", t1 - t0, num_results);
+    }
+
+    /*----- Prepare once, bind and execute for every call. -----*/
+    {
+        num_results = 0;
+        auto stmt = prepare(diag, Q.sql, make_consumer());
+        auto t0 = steady_clock::now();
+        for (std::size_t i = 0; i != NUM_CALLS; ++i)
+            execute(diag, *stmt, int64_t(i % num_tuples));
+        auto t1 = steady_clock::now();
+        report(Q, num_tuples, "prepared", t1 - t0, num_results);
+    }
+}
+
+
+int main(int argc, const char **argv)
+{
+    Catalog &C = Catalog::Get();
+    if (argc > 1)
+        C.default_backend(C.pool(argv[1])); // e.g. `Interpreter` or `WasmV8`
+
+    Diagnostic diag(false, std::cout, std::cerr);
+    std::cout << "benchmark,query,num_tuples,mode,num_calls,latency_us,result" << std::endl;
+    for (std::size_t num_tuples = NUM_TUPLES_START; num_tuples <= NUM_TUPLES_STOP; num_tuples *= 16) {
+        create_tables(diag, num_tuples);
+        for (auto &Q : QUERIES)
+            run_benchmark(diag, Q, num_tuples);
+    }
+}
@@ -0,0 +1,114 @@
+#include "lex/Lexer.hpp"
+#include "parse/Parser.hpp"
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <mutable/mutable.hpp>
+#include <mutable/Options.hpp>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+using namespace m;
+using namespace std::chrono;
+
+#ifndef NDEBUG
+static constexpr std::size_t NUM_QUERIES_PER_CLIENT = 8;
+static constexpr std::size_t NUM_TUPLES = 1UL<<10;
+#else
+static constexpr std::size_t NUM_QUERIES_PER_CLIENT = 64;
+static constexpr std::size_t NUM_TUPLES = 1UL<<16;
+#endif
+static constexpr std::size_t NUM_CLIENTS_STOP = 32;
+
+static const char *SCHEDULERS[] = { "SerialScheduler", "ConcurrentScheduler" };
+
+/** Read-only queries that are issued round-robin by every client. */
+static const char *QUERIES[] = {
+    "SELECT COUNT(*) FROM R WHERE b < 8;",
+    "SELECT b, SUM(a) FROM R GROUP BY b;",
+    "SELECT COUNT(*) FROM R, S WHERE R.a = S.a AND S.c < 4;",
+};
+
+/** Creates the tables `R(a, b)` and `S(a, c)` with `NUM_TUPLES` tuples each. */
+void create_tables(Diagnostic &diag)
+{
+    Catalog::Clear();
+    Catalog &C = Catalog::Get();
+    auto &DB = C.add_database(C.pool("db"));
+    C.set_database_in_use(DB);
+
+    execute_statement(diag, *statement_from_string(diag, "CREATE TABLE R (a INT(4), b INT(4));"));
+    execute_statement(diag, *statement_from_string(diag, "CREATE TABLE S (a INT(4), c INT(4));"));
+    for (const char *table : { "R", "S" }) {
+        std::ostringstream oss;
+        oss << "INSERT INTO " << table << " VALUES ";
+        for (std::size_t i = 0; i != NUM_TUPLES; ++i)
+            oss << (i ? ", (" : "(") << i << ", " << i % 16 << ')';
+        oss << ';';
+        execute_statement(diag, *statement_from_string(diag, oss.str()));
+    }
+}
+
+/** Issues `NUM_QUERIES_PER_CLIENT` queries to \p scheduler, one after another, each in its own transaction.  Returns
+ * the number of successfully executed queries. */
+std::size_t run_client(Scheduler &scheduler, std::size_t client_id)
+{
+    std::ostringstream out, err;
+    Diagnostic diag(false, out, err);
+    std::ostringstream queries;
+    for (std::size_t i = 0; i != NUM_QUERIES_PER_CLIENT; ++i)
+        queries << QUERIES[(client_id + i) % std::size(QUERIES)] << '\n';
+
+    std::istringstream in(queries.str());
+    ast::Lexer lexer(diag, Catalog::Get().get_pool(), "-", in);
+    ast::Parser parser(lexer);
+    std::size_t num_successful = 0;
+    while (parser.token()) {
+        diag.clear();
+        num_successful += scheduler.autocommit(parser.parse(), diag);
+    }
+    return num_successful;
+}
+
+/** Measures the throughput of \p scheduler_name with \p num_clients clients issuing queries concurrently. */
+void run_benchmark(const char *scheduler_name, std::size_t num_clients)
+{
+    Catalog &C = Catalog::Get();
+    Scheduler &scheduler = C.scheduler(C.pool(scheduler_name));
+
+    std::vector<std::size_t> num_successful(num_clients);
+    std::vector<std::thread> clients;
+    clients.reserve(num_clients);
+    auto t0 = steady_clock::now();
+    for (std::size_t i = 0; i != num_clients; ++i)
+        clients.emplace_back([&, i]() { num_successful[i] = run_client(scheduler, i); });
+    for (auto &client : clients)
+        client.join();
+    auto t1 = steady_clock::now();
+
+    std::size_t total = 0;
+    for (auto n : num_successful) total += n;
+    const double seconds = duration_cast<microseconds>(t1 - t0).count() / 1e6;
+    std::cout << "scheduler," << scheduler_name << ',' << num_clients << ',' << NUM_TUPLES << ',' << total << ','
+              << seconds * 1e3 << ',' << total / seconds << std::endl;
+}
+
+
+int main(int argc, const char **argv)
+{
+    Catalog &C = Catalog::Get();
+    if (argc > 1)
+        C.default_backend(C.pool(argv[1])); // e.g. `Interpreter` or `WasmV8`
+    Options::Get().benchmark = true; // discard the query results
+
+    Diagnostic diag(false, std::cout, std::cerr);
+    std::cout << "benchmark,scheduler,num_clients,num_tuples,num_queries,time_ms,queries_per_second" << std::endl;
+    create_tables(diag);
+    for (std::size_t num_clients = 1; num_clients <= NUM_CLIENTS_STOP; num_clients *= 2) {
+        for (auto scheduler_name : SCHEDULERS)
+            run_benchmark(scheduler_name, num_clients);
+    }
+}
@@ -43,6 +43,12 @@ struct ColumnStore : Store
         --num_rows_;
     }
 
+    void set_num_rows(std::size_t n) override {
+        if (n > capacity_)
+            throw std::logic_error("column store exceeds capacity");
+        num_rows_ = n;
+    }
+
     /** Returns the memory of the store. */
     const memory::Memory & memory() const override { return data_; }
     /** Returns the memory address where the column assigned to the attribute with id `attr_id` starts.
@@ -0,0 +1,243 @@
+#include <mutable/storage/Compression.hpp>
+
+#include "backend/Interpreter.hpp"
+#include "backend/StackMachine.hpp"
+#include <cstring>
+#include <limits>
+#include <mutable/catalog/Catalog.hpp>
+#include <mutable/catalog/Schema.hpp>
+#include <mutable/catalog/Type.hpp>
+#include <mutable/IR/Tuple.hpp>
+#include <mutable/storage/DataLayout.hpp>
+#include <mutable/storage/DataLayoutFactory.hpp>
+#include <mutable/storage/Store.hpp>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+
+using namespace m;
+using namespace m::storage;
+
+
+namespace {
+
+using encoding_t = DataLayout::encoding_t;
+
+/** Collects the statistics of a single column which determine the encoding of the column. */
+struct column_stats_t
+{
+    ///> whether the column contains any value that is not `NULL`
+    bool has_values = false;
+    ///> the smallest and largest value of an integral column
+    int64_t min = std::numeric_limits<int64_t>::max(), max = std::numeric_limits<int64_t>::min();
+    ///> maps each distinct value of a character sequence column to its code
+    std::unordered_map<std::string, uint64_t> codes;
+    ///> whether the character sequence column has more than `MAX_DICTIONARY_SIZE` distinct values
+    bool exceeds_dictionary = false;
+};
+
+/** Returns the size in bytes of the smallest unsigned integer that can represent all codes in `[0, max_code]`. */
+std::size_t code_size(uint64_t max_code)
+{
+    if (max_code <= std::numeric_limits<uint8_t>::max())  return 1;
+    if (max_code <= std::numeric_limits<uint16_t>::max()) return 2;
+    if (max_code <= std::numeric_limits<uint32_t>::max()) return 4;
+    return 8;
+}
+
+/** Returns `true` iff values of type \p ty are represented by integers in the `Interpreter`. */
+bool is_integral_value(const Type &ty)
+{
+    return ty.is_integral() or ty.is_decimal() or ty.is_date() or ty.is_date_time();
+}
+
+/** Returns the key of the character sequence of type \p cs at address \p ptr. */
+std::string key(const CharacterSequence &cs, const char *ptr) { return std::string(ptr, strnlen(ptr, cs.length)); }
+
+/** Chooses the encoding of a column of type \p ty from its statistics \p stats.  Returns an encoding of kind `E_None` if
+ * encoding the column does not reduce its size. */
+encoding_t choose_encoding(const Type &ty, const column_stats_t &stats)
+{
+    encoding_t enc;
+    if (not stats.has_values)
+        return enc;
+
+    if (is_integral_value(ty)) {
+        const std::size_t size = code_size(uint64_t(stats.max) - uint64_t(stats.min));
+        if (8 * size < ty.size()) {
+            enc.kind = encoding_t::E_FrameOfReference;
+            enc.stored_type = Type::Get_Integer(Type::TY_Vector, size);
+            enc.reference = stats.min;
+        }
+    } else if (auto cs = cast<const CharacterSequence>(&ty); cs and not stats.exceeds_dictionary) {
+        const std::size_t size = code_size(stats.codes.size() - 1);
+        const std::size_t entry_size = cs->size() / 8;
+        if (size < entry_size) {
+            std::string dictionary(stats.codes.size() * entry_size, '\0');
+            for (auto &[value, code] : stats.codes)
+                std::memcpy(dictionary.data() + code * entry_size, value.data(), value.size());
+            enc.kind = encoding_t::E_Dictionary;
+            enc.stored_type = Type::Get_Integer(Type::TY_Vector, size);
+            enc.dictionary = std::make_shared<const std::string>(std::move(dictionary));
+            enc.entry_size = entry_size;
+        }
+    }
+    return enc;
+}
+
+/** Adds a copy of \p node with the given \p offset_in_bits and \p stride_in_bits to \p parent.  The `Type` of every
+ * `Leaf` of index `i` is replaced by `types[i]` and its encoding by `encodings[i]`, if present. */
+void copy_node(DataLayout::INode &parent, const DataLayout::Node &node, uint64_t offset_in_bits,
+               uint64_t stride_in_bits, const std::vector<const Type*> &types,
+               const std::vector<encoding_t> &encodings)
+{
+    if (auto leaf = cast<const DataLayout::Leaf>(&node)) {
+        if (leaf->index() < types.size())
+            parent.add_leaf(types[leaf->index()], leaf->index(), offset_in_bits, stride_in_bits,
+                            encodings[leaf->index()]);
+        else
+            parent.add_leaf(leaf->type(), leaf->index(), offset_in_bits, stride_in_bits); // NULL bitmap
+    } else {
+        auto &inode = as<const DataLayout::INode>(node);
+        auto &copy = parent.add_inode(inode.num_tuples(), offset_in_bits, stride_in_bits);
+        for (auto &child : inode)
+            copy_node(copy, *child.ptr, child.offset_in_bits, child.stride_in_bits, types, encodings);
+    }
+}
+
+/** Returns a copy of \p layout, where the `Type` of every `Leaf` of index `i` is replaced by `types[i]` and its
+ * encoding by `encodings[i]`. */
+DataLayout copy_layout(const DataLayout &layout, const std::vector<const Type*> &types,
+                       const std::vector<encoding_t> &encodings)
+{
+    DataLayout copy(layout.is_finite() ? layout.num_tuples() : 0);
+    if (auto leaf = cast<const DataLayout::Leaf>(&layout.child())) {
+        copy.add_leaf(types[leaf->index()], leaf->index(), layout.stride_in_bits(), encodings[leaf->index()]);
+    } else {
+        auto &inode = as<const DataLayout::INode>(layout.child());
+        auto &root = copy.add_inode(inode.num_tuples(), layout.stride_in_bits());
+        for (auto &child : inode)
+            copy_node(root, *child.ptr, child.offset_in_bits, child.stride_in_bits, types, encodings);
+    }
+    return copy;
+}
+
+/** Loads every row of table \p table as tuple of schema \p S, in order, and invokes \p callback on it. */
+template<typename Callback>
+void for_each_row(const Table &table, const Schema &S, Callback &&callback)
+{
+    auto &store = table.store();
+    auto loader = Interpreter::compile_load(S, store.memory().addr(), table.layout(), S);
+    Tuple tup(S);
+    Tuple *args[] = { &tup };
+    for (std::size_t i = 0, end = store.num_rows(); i != end; ++i) {
+        loader(args);
+        callback(tup);
+    }
+}
+
+/** Rewrites the rows of table \p table into a new `Store`.  Every row is loaded as tuple of schema \p S, converted by
+ * \p convert to a tuple of schema \p stored_schema, and stored as laid out by \p stored_layout.  Finally, the new
+ * `Store` and the `DataLayout` \p layout replace the `Store` and the `DataLayout` of \p table. */
+template<typename Convert>
+void rewrite(Table &table, const Schema &S, const Schema &stored_schema, const DataLayout &stored_layout,
+             DataLayout layout, Convert &&convert)
+{
+    auto store = Catalog::Get().create_store(table);
+    auto writer = Interpreter::compile_store(stored_schema, store->memory().addr(), stored_layout, stored_schema);
+    for_each_row(table, S, [&](Tuple &tup) {
+        store->append();
+        Tuple *args[] = { &convert(tup) };
+        writer(args);
+    });
+    table.layout(std::move(layout));
+    table.store(std::move(store));
+}
+
+}
+
+bool m::compress_table(Table &table)
+{
+    if (table.store().num_rows() == 0 or table.layout().is_encoded())
+        return false;
+
+    /*----- Collect the statistics of all columns. -----*/
+    const Schema S = table.schema();
+    std::vector<column_stats_t> stats(S.num_entries());
+    for_each_row(table, S, [&](const Tuple &tup) {
+        for (std::size_t i = 0; i != S.num_entries(); ++i) {
+            if (tup.is_null(i))
+                continue;
+            auto &s = stats[i];
+            s.has_values = true;
+            if (is_integral_value(*S[i].type)) {
+                s.min = std::min(s.min, tup[i].as_i());
+                s.max = std::max(s.max, tup[i].as_i());
+            } else if (auto cs = cast<const CharacterSequence>(S[i].type); cs and not s.exceeds_dictionary) {
+                s.codes.try_emplace(key(*cs, static_cast<const char*>(tup[i].as_p())), s.codes.size());
+                if (s.codes.size() > compression::MAX_DICTIONARY_SIZE) {
+                    s.exceeds_dictionary = true;
+                    s.codes.clear();
+                }
+            }
+        }
+    });
+
+    /*----- Choose the encoding of every column. -----*/
+    std::vector<encoding_t> encodings;
+    std::vector<const Type*> types, stored_types;
+    Schema stored_schema;
+    bool is_encoded = false;
+    for (std::size_t i = 0; i != S.num_entries(); ++i) {
+        auto &e = S[i];
+        auto &enc = encodings.emplace_back(choose_encoding(*e.type, stats[i]));
+        is_encoded = is_encoded or bool(enc);
+        types.push_back(e.type);
+        stored_types.push_back(enc ? enc.stored_type : e.type);
+        stored_schema.add(e.id, stored_types.back(), e.constraints);
+    }
+    if (not is_encoded)
+        return false;
+
+    /*----- Lay out the codes by the current data layout factory and write the encoded rows. -----*/
+    auto stored_layout = Catalog::Get().data_layout().make(stored_types);
+    auto layout = copy_layout(stored_layout, types, encodings);
+    Tuple encoded(stored_schema);
+    rewrite(table, S, stored_schema, stored_layout, std::move(layout), [&](const Tuple &tup) -> Tuple & {
+        for (std::size_t i = 0; i != S.num_entries(); ++i) {
+            if (tup.is_null(i)) {
+                encoded.null(i);
+                continue;
+            }
+            switch (auto &enc = encodings[i]; enc.kind) {
+                case encoding_t::E_None:
+                    encoded.set(i, tup[i]);
+                    break;
+                case encoding_t::E_FrameOfReference:
+                    encoded.set(i, int64_t(uint64_t(tup[i].as_i()) - uint64_t(enc.reference)));
+                    break;
+                case encoding_t::E_Dictionary: {
+                    auto &cs = as<const CharacterSequence>(*S[i].type);
+                    encoded.set(i, int64_t(stats[i].codes.at(key(cs, static_cast<const char*>(tup[i].as_p())))));
+                    break;
+                }
+            }
+        }
+        return encoded;
+    });
+    return true;
+}
+
+void m::decompress_table(Table &table)
+{
+    if (not table.layout().is_encoded())
+        return;
+
+    const Schema S = table.schema();
+    std::vector<const Type*> types;
+    for (auto &e : S)
+        types.push_back(e.type);
+    auto &factory = Catalog::Get().data_layout();
+    rewrite(table, S, S, factory.make(types), factory.make(types), [](Tuple &tup) -> Tuple & { return tup; });
+}
@@ -27,15 +27,22 @@ void DataLayout::Leaf::accept(ConstDataLayoutVisitor &v) const { v(*this); };
  *--------------------------------------------------------------------------------------------------------------------*/
 
 DataLayout::Leaf & DataLayout::INode::add_leaf(const m::Type *type, size_type idx,
-                                               uint64_t offset_in_bits, uint64_t stride_in_bits)
+                                               uint64_t offset_in_bits, uint64_t stride_in_bits, encoding_t encoding)
 {
     M_insist(this->num_tuples() != 1 or stride_in_bits == 0, "no stride without repetition");
     M_insist(stride_in_bits % 8 == 0 or type->is_boolean() or type->is_bitmap(),
              "only booleans and bitmaps may not be byte aligned");
     M_insist(offset_in_bits % 8 == 0 or type->is_boolean() or type->is_bitmap(),
              "only booleans and bitmaps may not be byte aligned");
-
-    auto leaf = new Leaf(type, idx);
+    M_insist(not encoding or (encoding.stored_type and encoding.stored_type->is_integral()),
+             "codes of an encoded leaf must be integral");
+    M_insist(encoding.kind != encoding_t::E_FrameOfReference or type->is_integral() or type->is_decimal() or
+             type->is_date() or type->is_date_time(), "only integral values may be frame-of-reference encoded");
+    M_insist(encoding.kind != encoding_t::E_Dictionary or
+             (type->is_character_sequence() and encoding.dictionary and encoding.entry_size == type->size() / 8),
+             "only character sequences may be dictionary encoded");
+
+    auto leaf = new Leaf(type, idx, std::move(encoding));
     children_.emplace_back(child_t{
         .ptr = std::unique_ptr<DataLayout::Node>(as<Node>(leaf)),
         .offset_in_bits = offset_in_bits,
@@ -117,8 +124,19 @@ void DataLayout::INode::print(std::ostream &out, unsigned int indentation) const
 
         auto &child = *it;
         if (auto child_leaf = cast<const Leaf>(child.ptr.get())) {
-            out << "Leaf " << child_leaf->index() << " of type " << *child_leaf->type() << " with bit offset "
-                << child.offset_in_bits << " and bit stride " << child.stride_in_bits;
+            out << "Leaf " << child_leaf->index() << " of type " << *child_leaf->type();
+            switch (auto &enc = child_leaf->encoding(); enc.kind) {
+                case encoding_t::E_None:
+                    break;
+                case encoding_t::E_FrameOfReference:
+                    out << " encoded as " << *enc.stored_type << " with frame of reference " << enc.reference;
+                    break;
+                case encoding_t::E_Dictionary:
+                    out << " encoded as " << *enc.stored_type << " with dictionary of " << enc.num_entries()
+                        << " entries";
+                    break;
+            }
+            out << " with bit offset " << child.offset_in_bits << " and bit stride " << child.stride_in_bits;
         } else {
             auto child_inode = as<const INode>(child.ptr.get());
             out << "INode of " << child_inode->num_tuples() << " tuple(s) with bit offset " << child.offset_in_bits
@@ -134,10 +152,11 @@ M_LCOV_EXCL_STOP
  * DataLayout
  *--------------------------------------------------------------------------------------------------------------------*/
 
-DataLayout::Leaf & DataLayout::add_leaf(const m::Type *type, size_type idx, uint64_t stride_in_bits)
+DataLayout::Leaf & DataLayout::add_leaf(const m::Type *type, size_type idx, uint64_t stride_in_bits,
+                                        encoding_t encoding)
 {
     M_insist(inode_.num_children() == 0, "child already set");
-    return inode_.add_leaf(type, idx, 0, stride_in_bits);
+    return inode_.add_leaf(type, idx, 0, stride_in_bits, std::move(encoding));
 }
 
 DataLayout::INode & DataLayout::add_inode(size_type num_tuples, uint64_t stride_in_bits)
@@ -156,6 +175,20 @@ DataLayout::INode & DataLayout::add_inode(size_type num_tuples, uint64_t stride_
     return *inode;
 }
 
+bool DataLayout::is_encoded() const
+{
+    auto is_encoded_impl = [](const Node &node, auto &is_encoded_ref) -> bool {
+        if (auto leaf = cast<const Leaf>(&node))
+            return bool(leaf->encoding());
+        for (auto &child : as<const INode>(node)) {
+            if (is_encoded_ref(*child.ptr, is_encoded_ref))
+                return true;
+        }
+        return false;
+    };
+    return is_encoded_impl(inode_, is_encoded_impl);
+}
+
 void DataLayout::accept(ConstDataLayoutVisitor &v) const { v(*this); }
 
 void DataLayout::for_sibling_leaves(DataLayout::callback_leaves_t callback) const
@@ -217,6 +250,8 @@ bool m::storage::supports_simd(const DataLayout &layout, const Schema &layout_sc
                 if (tuple_it == tuple_schema.end())
                     continue; // entry not contained in tuple schema
                 M_insist(*tuple_it->type == *child_leaf.type());
+                if (child_leaf.encoding())
+                    return false; // encoded entries are decoded by scalar loads only
 
                 if (bit_stride) {
                     if (child.stride_in_bits != 1)
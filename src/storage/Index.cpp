@@ -1,11 +1,16 @@
 #include <mutable/storage/Index.hpp>
 
+#include <bit>
+#include <limits>
 #include <mutable/catalog/Schema.hpp>
 #include <mutable/catalog/Type.hpp>
 #include <mutable/mutable.hpp>
 #include <mutable/Options.hpp>
 #include <mutable/util/Timer.hpp>
 #include <sstream>
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
 
 
 using namespace m;
@@ -20,6 +25,16 @@ double rmi_model_entry_ratio = 0.01;
 
 }
 
+/** Returns the value at index \p idx of \p tuple as key of type \tparam Key. */
+template<typename Key>
+Key get_key(const Tuple &tuple, std::size_t idx)
+{
+    if constexpr(integral<Key>)
+        return static_cast<Key>(tuple.get(idx).as<int64_t>());
+    else // bool, float, double, const char*
+        return tuple.get(idx).as<Key>();
+}
+
 __attribute__((constructor(201)))
 static void add_index_args()
 {
@@ -50,8 +65,10 @@ std::string IndexBase::build_query(const Table &table, const Schema &schema)
 }
 
 template<typename Key>
-void ArrayIndex<Key>::bulkload(const Table &table, const Schema &key_schema)
+void IndexBase::scan_keys(const Table &table, const Schema &key_schema, const std::function<void(Key, std::size_t)> &add)
 {
+    using key_type = Key;
+
     /* XXX: Disable timer during execution to not print times for query that is performed as part of bulkloading. */
     const auto &old_timer = std::exchange(Catalog::Get().timer(), Timer());
 
@@ -93,7 +110,7 @@ void ArrayIndex<Key>::bulkload(const Table &table, const Schema &key_schema)
         [](const DateTime&) { CHECK(int64_t); },
         [](auto&&) { M_unreachable("invalid type"); },
     }, *attribute_type);
-#undef CHECk
+#undef CHECK
 
     /* Build the query to retrieve keys. */
     auto query = build_query(table, key_schema);
@@ -104,18 +121,11 @@ void ArrayIndex<Key>::bulkload(const Table &table, const Schema &key_schema)
     /* Compute statement from query string. */
     auto stmt = statement_from_string(diag, query);
 
-    /* Define get function based on key_type. */
-    std::function<key_type(const Tuple&)> fn_get;
-    if constexpr(integral<key_type>)
-        fn_get = [](const Tuple &t) { return static_cast<key_type>(t.get(0).as<int64_t>()); };
-    else // bool, float, double, const char*
-        fn_get = [](const Tuple &t) { return t.get(0).as<key_type>(); };
-
-    /* Define callback operator to add keys to index. */
+    /* Define callback operator to pass keys to `add`. */
     std::size_t tuple_id = 0;
     auto fn_add = [&](const Schema&, const Tuple &tuple) {
         if (not tuple.is_null(0))
-            this->add(fn_get(tuple), tuple_id);
+            add(get_key<key_type>(tuple, 0), tuple_id);
         tuple_id++;
     };
     auto consumer = std::make_unique<CallbackOperator>(fn_add);
@@ -131,13 +141,17 @@ void ArrayIndex<Key>::bulkload(const Table &table, const Schema &key_schema)
     /* Execute query to insert tuples. */
     m::execute_query(diag, as<ast::SelectStmt>(*stmt), std::move(consumer), *backend);
 
-    /* Finalize index. */
-    finalize();
-
     /* XXX: Reenable timer. */
     std::exchange(Catalog::Get().timer(), std::move(old_timer));
 }
 
+template<typename Key>
+void ArrayIndex<Key>::bulkload(const Table &table, const Schema &key_schema)
+{
+    scan_keys<key_type>(table, key_schema, [this](key_type key, std::size_t tuple_id) { this->add(key, tuple_id); });
+    finalize();
+}
+
 template<typename Key>
 void ArrayIndex<Key>::add(const key_type key, const value_type value)
 {
@@ -150,17 +164,69 @@ void ArrayIndex<Key>::add(const key_type key, const value_type value)
     finalized_ = false;
 }
 
+template<typename Key>
+void ArrayIndex<Key>::insert(const Tuple &tuple, std::size_t idx, std::size_t tuple_id)
+{
+    if (tuple.is_null(idx))
+        return;
+    const key_type key = get_key<key_type>(tuple, idx);
+    if (not finalized_) {
+        add(key, tuple_id); // sorted by `finalize()` anyways
+        return;
+    }
+    if constexpr(std::same_as<key_type, const char*>) {
+        Catalog &C = Catalog::Get();
+        delta_.emplace_back(C.pool(key), tuple_id);
+    } else {
+        delta_.emplace_back(key, tuple_id);
+    }
+}
+
+template<typename Key>
+void ArrayIndex<Key>::merge()
+{
+    if (delta_.empty())
+        return;
+    std::sort(delta_.begin(), delta_.end(), cmp);
+    const auto num_sorted = data_.size();
+    data_.insert(data_.end(), delta_.begin(), delta_.end());
+    delta_.clear();
+    if (finalized_)
+        std::inplace_merge(data_.begin(), data_.begin() + num_sorted, data_.end(), cmp);
+}
+
 template<arithmetic Key>
 void RecursiveModelIndex<Key>::finalize()
 {
     /* Sort data. */
     std::sort(base_type::data_.begin(), base_type::data_.end(), base_type::cmp);
 
+    /* Build models. */
+    train();
+
+    /* Mark index as finalized. */
+    base_type::finalized_ = true;
+}
+
+template<arithmetic Key>
+void RecursiveModelIndex<Key>::merge()
+{
+    if (not base_type::has_pending())
+        return;
+    base_type::merge();
+    if (base_type::finalized())
+        train(); // the models of the previous data no longer fit
+}
+
+template<arithmetic Key>
+void RecursiveModelIndex<Key>::train()
+{
     /* Compute number of models. */
     auto begin = base_type::begin();
     auto end = base_type::end();
     std::size_t n_keys = std::distance(begin, end);
     std::size_t n_models = std::max<std::size_t>(1, n_keys * options::rmi_model_entry_ratio);
+    models_.clear();
     models_.reserve(n_models + 1);
 
     /* Train first layer. */
@@ -218,10 +284,346 @@ void RecursiveModelIndex<Key>::finalize()
             )
         );
     }
+}
 
-    /* Mark index as finalized. */
-    base_type::finalized_ = true;
-};
+template<arithmetic Key>
+template<bool IsUpper>
+void RecursiveModelIndex<Key>::bound_batch(const key_type *keys, std::size_t num_keys, const_iterator *out) const
+{
+    if (not base_type::finalized()) throw m::exception("Index is not finalized.");
+    if (base_type::data_.empty()) {
+        std::fill_n(out, num_keys, base_type::begin());
+        return;
+    }
+    M_insist(base_type::data_.size() <= std::numeric_limits<int32_t>::max(), "too many entries for batched lookups");
+    static_assert(sizeof(LinearModel) == 2 * sizeof(double), "models must be densely packed for gathering");
+
+    const double max_segment = models_.size() - 2;
+    const double max_pos = base_type::data_.size() - 1;
+    alignas(32) double x[BATCH_SIZE];
+    alignas(32) int32_t pos[BATCH_SIZE];
+
+    for (std::size_t offset = 0; offset < num_keys; offset += BATCH_SIZE) {
+        const std::size_t n = std::min(BATCH_SIZE, num_keys - offset);
+        for (std::size_t i = 0; i != n; ++i)
+            x[i] = static_cast<double>(keys[offset + i]);
+
+        /*----- Evaluate the models for all keys of the batch. -----*/
+        std::size_t i = 0;
+#ifdef __AVX2__
+        {
+            const __m256d zero = _mm256_setzero_pd();
+            const __m256d root_slope = _mm256_set1_pd(models_[0].slope);
+            const __m256d root_intercept = _mm256_set1_pd(models_[0].intercept);
+            const __m256d segment_hi = _mm256_set1_pd(max_segment);
+            const __m256d pos_hi = _mm256_set1_pd(max_pos);
+            const __m128i one = _mm_set1_epi32(1);
+            for (; i + 4 <= n; i += 4) {
+                const __m256d key = _mm256_load_pd(x + i);
+                /* Predict the segment by the root model.  (`max` yields `0` for NaN.) */
+                __m256d segment = _mm256_add_pd(_mm256_mul_pd(root_slope, key), root_intercept);
+                segment = _mm256_min_pd(_mm256_max_pd(segment, zero), segment_hi);
+                /* Gather the second-level models.  Model `segment + 1` starts at double `2 * (segment + 1)`. */
+                const __m128i idx = _mm_slli_epi32(_mm_add_epi32(_mm256_cvttpd_epi32(segment), one), 1);
+                const __m256d slope = _mm256_i32gather_pd(&models_[0].slope, idx, 8);
+                const __m256d intercept = _mm256_i32gather_pd(&models_[0].intercept, idx, 8);
+                /* Predict the position by the second-level models. */
+                __m256d p = _mm256_add_pd(_mm256_mul_pd(slope, key), intercept);
+                p = _mm256_min_pd(_mm256_max_pd(p, zero), pos_hi);
+                _mm_store_si128(reinterpret_cast<__m128i*>(pos + i), _mm256_cvttpd_epi32(p));
+            }
+        }
+#endif
+        for (; i != n; ++i) {
+            const key_type key = keys[offset + i];
+            const std::size_t segment = std::clamp<double>(models_[0](key), 0, max_segment);
+            pos[i] = std::clamp<double>(models_[segment + 1](key), 0, max_pos);
+        }
+
+        /*----- Prefetch the predicted entries of all keys of the batch. -----*/
+        for (std::size_t i = 0; i != n; ++i)
+            __builtin_prefetch(&base_type::data_[pos[i]]);
+
+        /*----- Correct the predictions by exponential search. -----*/
+        for (std::size_t i = 0; i != n; ++i) {
+            const auto pred = base_type::begin() + pos[i];
+            if constexpr (IsUpper)
+                out[offset + i] = upper_bound_exponential_search(pred, keys[offset + i]);
+            else
+                out[offset + i] = lower_bound_exponential_search(pred, keys[offset + i]);
+        }
+    }
+}
+
+template<arithmetic Key>
+void RecursiveModelIndex<Key>::lower_bound_batch(const key_type *keys, std::size_t num_keys, const_iterator *out) const
+{
+    bound_batch<false>(keys, num_keys, out);
+}
+
+template<arithmetic Key>
+void RecursiveModelIndex<Key>::upper_bound_batch(const key_type *keys, std::size_t num_keys, const_iterator *out) const
+{
+    bound_batch<true>(keys, num_keys, out);
+}
+
+template<arithmetic Key>
+BPlusTreeIndex<Key>::BPlusTreeIndex()
+    : nodes_(allocator_.allocate(ALLOCATION_SIZE))
+{
+    num_nodes_ = 1; // node 0 is never used
+    root_ = allocate_node(/* is_leaf= */ true);
+    height_ = 1;
+    M_insist(root_ == FIRST_LEAF);
+}
+
+template<arithmetic Key>
+typename BPlusTreeIndex<Key>::node_id_type BPlusTreeIndex<Key>::allocate_node(bool is_leaf)
+{
+    if ((num_nodes_ + 1) * NODE_SIZE > nodes_.size())
+        throw m::runtime_error("B+-tree exceeds capacity");
+    const node_id_type node = num_nodes_++;
+    std::memset(address(node), 0, NODE_SIZE);
+    header(node).is_leaf = is_leaf;
+    return node;
+}
+
+template<arithmetic Key>
+void BPlusTreeIndex<Key>::bulkload(const Table &table, const Schema &key_schema)
+{
+    if (num_entries_ != 0) {
+        scan_keys<key_type>(table, key_schema, [this](key_type key, std::size_t tuple_id) { add(key, tuple_id); });
+        return;
+    }
+
+    /*----- Retrieve and sort all entries.  Sorting is stable s.t. equal keys remain in the order of their tuples. -----*/
+    std::vector<entry_type> entries;
+    scan_keys<key_type>(table, key_schema, [&entries](key_type key, std::size_t tuple_id) {
+        M_insist(std::in_range<value_type>(tuple_id), "tuple ID must fit in uint32_t");
+        entries.emplace_back(key, tuple_id);
+    });
+    std::stable_sort(entries.begin(), entries.end(), [](const entry_type &lhs, const entry_type &rhs) {
+        return lhs.first < rhs.first;
+    });
+
+    /*----- Distribute the entries evenly over as few leaves as possible. -----*/
+    num_nodes_ = 1;
+    std::vector<std::pair<node_id_type, key_type>> level; // the nodes of the current level and their smallest key
+    const std::size_t num_leaves = std::max<std::size_t>(1, (entries.size() + LEAF_CAPACITY - 1) / LEAF_CAPACITY);
+    for (std::size_t i = 0; i != num_leaves; ++i) {
+        const std::size_t begin = entries.size() * i / num_leaves;
+        const std::size_t end = entries.size() * (i + 1) / num_leaves;
+        const node_id_type leaf = allocate_node(/* is_leaf= */ true);
+        for (std::size_t j = begin; j != end; ++j) {
+            keys(leaf)[j - begin] = entries[j].first;
+            values(leaf)[j - begin] = entries[j].second;
+        }
+        header(leaf).num_keys = end - begin;
+        if (not level.empty())
+            header(level.back().first).next = leaf;
+        level.emplace_back(leaf, begin != end ? entries[begin].first : key_type());
+    }
+    M_insist(level.front().first == FIRST_LEAF);
+    num_entries_ = entries.size();
+    height_ = 1;
+
+    /*----- Build the inner nodes bottom-up, distributing the children of a level evenly over their parents. -----*/
+    while (level.size() > 1) {
+        std::vector<std::pair<node_id_type, key_type>> parents;
+        const std::size_t num_parents = (level.size() + INNER_CAPACITY) / (INNER_CAPACITY + 1);
+        for (std::size_t i = 0; i != num_parents; ++i) {
+            const std::size_t begin = level.size() * i / num_parents;
+            const std::size_t end = level.size() * (i + 1) / num_parents;
+            M_insist(end - begin >= 2, "every inner node must have at least two children");
+            const node_id_type node = allocate_node(/* is_leaf= */ false);
+            for (std::size_t j = begin; j != end; ++j) {
+                children(node)[j - begin] = level[j].first;
+                if (j != begin)
+                    keys(node)[j - begin - 1] = level[j].second;
+            }
+            header(node).num_keys = end - begin - 1;
+            parents.emplace_back(node, level[begin].second);
+        }
+        level = std::move(parents);
+        ++height_;
+    }
+    root_ = level.front().first;
+}
+
+template<arithmetic Key>
+void BPlusTreeIndex<Key>::insert(const Tuple &tuple, std::size_t idx, std::size_t tuple_id)
+{
+    if (not tuple.is_null(idx))
+        add(get_key<key_type>(tuple, idx), tuple_id);
+}
+
+template<arithmetic Key>
+void BPlusTreeIndex<Key>::add(const key_type key, const std::size_t value)
+{
+    M_insist(std::in_range<value_type>(value), "tuple ID must fit in uint32_t");
+
+    /* Inserts `val` at position `pos` into the array `arr` of `n` elements. */
+    auto insert_at = []<typename T>(T *arr, std::size_t n, std::size_t pos, T val) {
+        std::copy_backward(arr + pos, arr + n, arr + n + 1);
+        arr[pos] = val;
+    };
+
+    /*----- Descend to the leaf, remembering the inner nodes and the positions of the children on the path. -----*/
+    std::vector<std::pair<node_id_type, std::size_t>> path;
+    node_id_type node = root_;
+    while (not header(node).is_leaf) {
+        const auto pos = find_in_node<true>(node, key);
+        path.emplace_back(node, pos);
+        node = children(node)[pos];
+    }
+    ++num_entries_;
+
+    /*----- Insert into the leaf.  If the leaf is full, split it into two halves. -----*/
+    const auto pos = find_in_node<true>(node, key); // after all equal keys
+    if (header(node).num_keys != LEAF_CAPACITY) {
+        insert_at(keys(node), header(node).num_keys, pos, key);
+        insert_at(values(node), header(node).num_keys, pos, value_type(value));
+        ++header(node).num_keys;
+        return;
+    }
+
+    key_type all_keys[LEAF_CAPACITY + 1];
+    value_type all_values[LEAF_CAPACITY + 1];
+    std::copy_n(keys(node), LEAF_CAPACITY, all_keys);
+    std::copy_n(values(node), LEAF_CAPACITY, all_values);
+    insert_at(all_keys, LEAF_CAPACITY, pos, key);
+    insert_at(all_values, LEAF_CAPACITY, pos, value_type(value));
+
+    constexpr std::size_t NUM_LEFT = (LEAF_CAPACITY + 1) / 2;
+    const node_id_type right = allocate_node(/* is_leaf= */ true);
+    std::copy_n(all_keys, NUM_LEFT, keys(node));
+    std::copy_n(all_values, NUM_LEFT, values(node));
+    std::copy(all_keys + NUM_LEFT, all_keys + LEAF_CAPACITY + 1, keys(right));
+    std::copy(all_values + NUM_LEFT, all_values + LEAF_CAPACITY + 1, values(right));
+    header(node).num_keys = NUM_LEFT;
+    header(right).num_keys = LEAF_CAPACITY + 1 - NUM_LEFT;
+    header(right).next = header(node).next;
+    header(node).next = right;
+
+    /*----- Insert the separator of the split node into its parent, splitting full inner nodes on the way up. -----*/
+    key_type separator = keys(right)[0];
+    node_id_type new_child = right;
+    while (not path.empty()) {
+        const auto [parent, child_pos] = path.back();
+        path.pop_back();
+        if (header(parent).num_keys != INNER_CAPACITY) {
+            insert_at(keys(parent), header(parent).num_keys, child_pos, separator);
+            insert_at(children(parent), header(parent).num_keys + 1UL, child_pos + 1, new_child);
+            ++header(parent).num_keys;
+            return;
+        }
+
+        key_type inner_keys[INNER_CAPACITY + 1];
+        node_id_type inner_children[INNER_CAPACITY + 2];
+        std::copy_n(keys(parent), INNER_CAPACITY, inner_keys);
+        std::copy_n(children(parent), INNER_CAPACITY + 1, inner_children);
+        insert_at(inner_keys, INNER_CAPACITY, child_pos, separator);
+        insert_at(inner_children, INNER_CAPACITY + 1, child_pos + 1, new_child);
+
+        /* The left node keeps the first `NUM_KEYS_LEFT` keys, the next key moves up, and the right node gets the rest. */
+        constexpr std::size_t NUM_KEYS_LEFT = INNER_CAPACITY / 2;
+        const node_id_type right_node = allocate_node(/* is_leaf= */ false);
+        std::copy_n(inner_keys, NUM_KEYS_LEFT, keys(parent));
+        std::copy_n(inner_children, NUM_KEYS_LEFT + 1, children(parent));
+        std::copy(inner_keys + NUM_KEYS_LEFT + 1, inner_keys + INNER_CAPACITY + 1, keys(right_node));
+        std::copy(inner_children + NUM_KEYS_LEFT + 1, inner_children + INNER_CAPACITY + 2, children(right_node));
+        header(parent).num_keys = NUM_KEYS_LEFT;
+        header(right_node).num_keys = INNER_CAPACITY - NUM_KEYS_LEFT;
+        separator = inner_keys[NUM_KEYS_LEFT];
+        new_child = right_node;
+    }
+
+    /*----- The root was split, grow the tree by a new root. -----*/
+    const node_id_type new_root = allocate_node(/* is_leaf= */ false);
+    keys(new_root)[0] = separator;
+    children(new_root)[0] = root_;
+    children(new_root)[1] = new_child;
+    header(new_root).num_keys = 1;
+    root_ = new_root;
+    ++height_;
+}
+
+template<arithmetic Key>
+HashIndex<Key>::HashIndex()
+    : slots_(allocator_.allocate(ALLOCATION_SIZE))
+{
+    rehash(std::countr_zero(INITIAL_CAPACITY));
+}
+
+template<arithmetic Key>
+void HashIndex<Key>::bulkload(const Table &table, const Schema &key_schema)
+{
+    std::vector<entry_type> entries;
+    scan_keys<key_type>(table, key_schema, [&entries](key_type key, std::size_t tuple_id) {
+        M_insist(std::in_range<value_type>(tuple_id) and tuple_id != EMPTY, "tuple ID must fit in uint32_t");
+        entries.emplace_back(key, tuple_id);
+    });
+    reserve(num_entries_ + entries.size());
+    for (auto &[key, tuple_id] : entries)
+        add(key, tuple_id);
+}
+
+template<arithmetic Key>
+void HashIndex<Key>::insert(const Tuple &tuple, std::size_t idx, std::size_t tuple_id)
+{
+    if (not tuple.is_null(idx))
+        add(get_key<key_type>(tuple, idx), tuple_id);
+}
+
+template<arithmetic Key>
+void HashIndex<Key>::add(const key_type key, const std::size_t value)
+{
+    M_insist(std::in_range<value_type>(value) and value != EMPTY, "tuple ID must fit in uint32_t");
+    reserve(num_entries_ + 1);
+
+    const auto mask = capacity() - 1;
+    auto s = first_slot(key);
+    while (slots()[s].value != EMPTY)
+        s = (s + 1) & mask;
+    slots()[s] = { key, value_type(value) };
+    ++num_entries_;
+}
+
+template<arithmetic Key>
+void HashIndex<Key>::reserve(std::size_t num_entries)
+{
+    std::size_t log2_capacity = log2_capacity_;
+    while (double(num_entries) > MAX_LOAD_FACTOR * double(1UL << log2_capacity))
+        ++log2_capacity;
+    if (log2_capacity != log2_capacity_)
+        rehash(log2_capacity);
+}
+
+template<arithmetic Key>
+void HashIndex<Key>::rehash(std::size_t log2_capacity)
+{
+    if ((1UL << log2_capacity) * sizeof(slot_t) > slots_.size())
+        throw m::runtime_error("hash index exceeds capacity");
+
+    /* Save all entries, as the table is rebuilt in place.  Initially, i.e. without any slots, there is nothing to save. */
+    std::vector<slot_t> entries;
+    entries.reserve(num_entries_);
+    for (std::size_t s = 0; s != capacity() and log2_capacity_ != 0; ++s) {
+        if (slots()[s].value != EMPTY)
+            entries.push_back(slots()[s]);
+    }
+
+    /* Mark all slots of the grown table as empty and reinsert the entries. */
+    log2_capacity_ = log2_capacity;
+    std::memset(slots(), 0xff, capacity() * sizeof(slot_t)); // sets every value to `EMPTY`
+    const auto mask = capacity() - 1;
+    for (auto &entry : entries) {
+        auto s = first_slot(entry.key);
+        while (slots()[s].value != EMPTY)
+            s = (s + 1) & mask;
+        slots()[s] = entry;
+    }
+}
 
 // explicit instantiations to prevent linker errors
 #define INSTANTIATE(CLASS) \
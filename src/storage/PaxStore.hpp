@@ -52,6 +52,12 @@ struct PaxStore : Store
         --num_rows_;
     }
 
+    void set_num_rows(std::size_t n) override {
+        if (n > capacity_)
+            throw std::logic_error("PAX store exceeds capacity");
+        num_rows_ = n;
+    }
+
     /** Returns the memory of the store. */
     const memory::Memory & memory() const override { return data_; }
 
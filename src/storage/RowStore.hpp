@@ -50,6 +50,12 @@ struct RowStore : Store
         --num_rows_;
     }
 
+    void set_num_rows(std::size_t n) override {
+        if (n > capacity_)
+            throw std::logic_error("row store exceeds capacity");
+        num_rows_ = n;
+    }
+
     /** Returns the memory of the store. */
     const memory::Memory & memory() const override { return data_; }
     /** Sets the memory of the store to `memory`. */
@@ -0,0 +1,491 @@
+#include <mutable/storage/Snapshot.hpp>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <mutable/catalog/Catalog.hpp>
+#include <mutable/catalog/Schema.hpp>
+#include <mutable/catalog/Type.hpp>
+#include <mutable/storage/DataLayout.hpp>
+#include <mutable/storage/Store.hpp>
+#include <mutable/util/exception.hpp>
+#include <mutable/util/fn.hpp>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+
+using namespace m;
+using namespace m::snapshot;
+using namespace m::storage;
+
+
+namespace {
+
+/** The fixed-size header at the beginning of a snapshot file. */
+struct header_t
+{
+    uint64_t magic = SNAPSHOT_MAGIC;
+    uint32_t version = SNAPSHOT_VERSION;
+    uint32_t byte_order = 0x01020304U; ///< detects snapshots written on a machine of different endianness
+    uint64_t metadata_offset = 0; ///< the offset of the metadata within the snapshot file
+    uint64_t metadata_size = 0; ///< the size in bytes of the metadata
+};
+
+/** Encodes the kind of a `PrimitiveType` in the snapshot metadata. */
+enum type_tag : uint8_t { T_Boolean, T_Bitmap, T_Char, T_Varchar, T_Date, T_DateTime, T_Int, T_Float, T_Decimal };
+
+/** Encodes the kind of a `DataLayout::Node` in the snapshot metadata. */
+enum node_tag : uint8_t { N_Leaf, N_INode };
+
+/** Encodes the flags of an `Attribute` in the snapshot metadata. */
+enum attr_flag : uint8_t { A_NotNullable = 0b1, A_Unique = 0b10, A_Hidden = 0b100, A_PrimaryKey = 0b1000 };
+
+/** Returns the number of bytes of \p table's memory that are in use, i.e. all strides of the table's `DataLayout`
+ * that contain at least one of the table's rows. */
+std::size_t used_bytes(const DataLayout &layout, std::size_t num_rows)
+{
+    if (not layout) return 0;
+    const std::size_t rows_per_stride = layout.child().num_tuples();
+    const std::size_t num_strides = (num_rows + rows_per_stride - 1) / rows_per_stride;
+    return (num_strides * layout.stride_in_bits() + 7) / 8;
+}
+
+/** Returns the number of bytes of \p table's memory that are occupied by completely filled strides of the table's
+ * `DataLayout`.  These bytes are never written when rows are appended. */
+std::size_t full_bytes(const DataLayout &layout, std::size_t num_rows)
+{
+    if (not layout) return 0;
+    const std::size_t rows_per_stride = layout.child().num_tuples();
+    return (num_rows / rows_per_stride) * layout.stride_in_bits() / 8;
+}
+
+/** Throws an `m::runtime_error` describing the current `errno` for the snapshot at \p path. */
+[[noreturn]] void throw_errno(const char *what, const std::filesystem::path &path)
+{
+    throw runtime_error(std::string(what) + " snapshot \"" + path.string() + "\": " + strerror(errno));
+}
+
+/** Writes \p size bytes at \p data to \p fd at \p offset. */
+void write_all(int fd, const void *data, std::size_t size, std::size_t offset, const std::filesystem::path &path)
+{
+    auto ptr = static_cast<const char*>(data);
+    while (size) {
+        const ssize_t n = pwrite(fd, ptr, size, offset);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            throw_errno("Failed to write", path);
+        }
+        ptr += n;
+        size -= n;
+        offset += n;
+    }
+}
+
+/** Reads \p size bytes from \p fd at \p offset to \p data. */
+void read_all(int fd, void *data, std::size_t size, std::size_t offset, const std::filesystem::path &path)
+{
+    auto ptr = static_cast<char*>(data);
+    while (size) {
+        const ssize_t n = pread(fd, ptr, size, offset);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            throw_errno("Failed to read", path);
+        }
+        if (n == 0)
+            throw invalid_argument("snapshot \"" + path.string() + "\" is truncated");
+        ptr += n;
+        size -= n;
+        offset += n;
+    }
+}
+
+
+/*======================================================================================================================
+ * Metadata serialization
+ *====================================================================================================================*/
+
+/** Serializes the snapshot metadata into a binary buffer. */
+struct MetadataWriter
+{
+    std::string buf;
+
+    void u8(uint8_t v) { buf.push_back(char(v)); }
+    void u64(uint64_t v) { buf.append(reinterpret_cast<const char*>(&v), sizeof(v)); }
+    void str(const char *s) { const std::size_t len = strlen(s); u64(len); buf.append(s, len); }
+
+    void type(const PrimitiveType &ty) {
+        visit(overloaded {
+            [this](const Boolean&) { u8(T_Boolean); },
+            [this](const Bitmap &b) { u8(T_Bitmap); u64(b.length); },
+            [this](const CharacterSequence &cs) { u8(cs.is_varying ? T_Varchar : T_Char); u64(cs.length); },
+            [this](const Date&) { u8(T_Date); },
+            [this](const DateTime&) { u8(T_DateTime); },
+            [this](const Numeric &n) {
+                switch (n.kind) {
+                    case Numeric::N_Int:     u8(T_Int);     u64(n.precision); break;
+                    case Numeric::N_Float:   u8(T_Float);   u64(n.precision); break;
+                    case Numeric::N_Decimal: u8(T_Decimal); u64(n.precision); u64(n.scale); break;
+                }
+            },
+            [](auto&&) { M_unreachable("invalid attribute type"); }
+        }, ty);
+        u8(ty.category);
+    }
+
+    void encoding(const DataLayout::encoding_t &enc) {
+        u8(enc.kind);
+        if (not enc) return;
+        type(*as<const PrimitiveType>(enc.stored_type));
+        u64(enc.reference);
+        u64(enc.entry_size);
+        u64(enc.dictionary ? enc.dictionary->size() : 0);
+        if (enc.dictionary) buf.append(*enc.dictionary);
+    }
+
+    void node(const DataLayout::Node &node) {
+        if (auto leaf = cast<const DataLayout::Leaf>(&node)) {
+            u8(N_Leaf);
+            type(*as<const PrimitiveType>(leaf->type()));
+            u64(leaf->index());
+            encoding(leaf->encoding());
+        } else {
+            auto &inode = as<const DataLayout::INode>(node);
+            u8(N_INode);
+            u64(inode.num_tuples());
+            u64(inode.num_children());
+            for (auto &child : inode) {
+                u64(child.offset_in_bits);
+                u64(child.stride_in_bits);
+                this->node(*child.ptr);
+            }
+        }
+    }
+
+    void layout(const DataLayout &layout) {
+        u64(layout.is_finite() ? layout.num_tuples() : 0);
+        u8(bool(layout));
+        if (layout) {
+            u64(layout.stride_in_bits());
+            node(layout.child());
+        }
+    }
+};
+
+/** Deserializes the snapshot metadata from a binary buffer.  Throws `m::invalid_argument` on malformed metadata. */
+struct MetadataReader
+{
+    const char *pos;
+    const char *end;
+
+    MetadataReader(const std::vector<char> &buf) : pos(buf.data()), end(buf.data() + buf.size()) { }
+
+    bool empty() const { return pos == end; }
+
+    void check(bool cond) const { if (not cond) throw invalid_argument("malformed snapshot metadata"); }
+
+    const char * take(std::size_t size) {
+        check(std::size_t(end - pos) >= size);
+        auto p = pos;
+        pos += size;
+        return p;
+    }
+
+    uint8_t u8() { return uint8_t(*take(1)); }
+    uint64_t u64() { uint64_t v; std::memcpy(&v, take(sizeof(v)), sizeof(v)); return v; }
+    std::string str() { const std::size_t len = u64(); return std::string(take(len), len); }
+
+    const PrimitiveType * type() {
+        const uint8_t tag = u8();
+        uint64_t p = 0, s = 0;
+        switch (tag) {
+            case T_Bitmap: case T_Char: case T_Varchar: case T_Int: case T_Float: p = u64(); break;
+            case T_Decimal: p = u64(); s = u64(); break;
+            default: break;
+        }
+        const uint8_t category = u8();
+        check(category == Type::TY_Scalar or category == Type::TY_Vector);
+        const auto cat = Type::category_t(category);
+
+        switch (tag) {
+            case T_Boolean:  return Type::Get_Boolean(cat);
+            case T_Bitmap:   return Type::Get_Bitmap(cat, p);
+            case T_Char:     return Type::Get_Char(cat, p);
+            case T_Varchar:  return Type::Get_Varchar(cat, p);
+            case T_Date:     return Type::Get_Date(cat);
+            case T_DateTime: return Type::Get_Datetime(cat);
+            case T_Int:
+                check(p == 1 or p == 2 or p == 4 or p == 8);
+                return Type::Get_Integer(cat, p);
+            case T_Float:
+                check(p == 32 or p == 64);
+                return p == 32 ? Type::Get_Float(cat) : Type::Get_Double(cat);
+            case T_Decimal:
+                check(p <= Numeric::MAX_DECIMAL_PRECISION and s <= p);
+                return Type::Get_Decimal(cat, p, s);
+            default:
+                check(false);
+                M_unreachable("invalid type tag");
+        }
+    }
+
+    /** Reads the encoding of a `DataLayout::Leaf` of type \p ty. */
+    DataLayout::encoding_t encoding(const PrimitiveType &ty) {
+        DataLayout::encoding_t enc;
+        const uint8_t kind = u8();
+        check(kind <= DataLayout::encoding_t::E_Dictionary);
+        enc.kind = DataLayout::encoding_t::kind_t(kind);
+        if (not enc) return enc;
+        enc.stored_type = type();
+        check(enc.stored_type->is_integral() and enc.stored_type->size() < ty.size());
+        enc.reference = int64_t(u64());
+        enc.entry_size = u64();
+        auto dictionary = str();
+        if (enc.kind == DataLayout::encoding_t::E_FrameOfReference) {
+            check(ty.is_integral() or ty.is_decimal() or ty.is_date() or ty.is_date_time());
+        } else {
+            check(ty.is_character_sequence() and enc.entry_size == ty.size() / 8);
+            check(dictionary.size() % enc.entry_size == 0);
+            enc.dictionary = std::make_shared<const std::string>(std::move(dictionary));
+        }
+        return enc;
+    }
+
+    /** Reads the children of \p inode. */
+    void children(DataLayout::INode &inode) {
+        const std::size_t num_children = u64();
+        for (std::size_t i = 0; i != num_children; ++i) {
+            const uint64_t offset_in_bits = u64();
+            const uint64_t stride_in_bits = u64();
+            const uint8_t tag = u8();
+            if (tag == N_Leaf) {
+                auto ty = type();
+                const std::size_t idx = u64();
+                inode.add_leaf(ty, idx, offset_in_bits, stride_in_bits, encoding(*ty));
+            } else {
+                check(tag == N_INode);
+                children(inode.add_inode(u64(), offset_in_bits, stride_in_bits));
+            }
+        }
+    }
+
+    DataLayout layout() {
+        DataLayout layout(u64());
+        if (u8()) {
+            const uint64_t stride_in_bits = u64();
+            const uint8_t tag = u8();
+            if (tag == N_Leaf) {
+                auto ty = type();
+                const std::size_t idx = u64();
+                layout.add_leaf(ty, idx, stride_in_bits, encoding(*ty));
+            } else {
+                check(tag == N_INode);
+                children(layout.add_inode(u64(), stride_in_bits));
+            }
+        }
+        return layout;
+    }
+};
+
+/** Owns a file descriptor and closes it on destruction. */
+struct file_descriptor
+{
+    int fd;
+    file_descriptor(int fd) : fd(fd) { }
+    ~file_descriptor() { if (fd != -1) close(fd); }
+    file_descriptor(const file_descriptor&) = delete;
+};
+
+}
+
+
+/*======================================================================================================================
+ * write_snapshot
+ *====================================================================================================================*/
+
+void m::write_snapshot(const Database &db, const std::filesystem::path &path)
+{
+    file_descriptor file(open(path.c_str(), O_WRONLY|O_CREAT|O_TRUNC|O_CLOEXEC, 0644));
+    if (file.fd == -1)
+        throw_errno("Failed to create", path);
+
+    header_t header;
+    MetadataWriter meta;
+    static_assert(sizeof(header_t) <= SNAPSHOT_ALIGNMENT);
+    std::size_t offset = SNAPSHOT_ALIGNMENT; // the offset of the next table's data
+
+    meta.str(*db.name);
+    meta.u64(db.size());
+    for (auto it = db.begin_tables(); it != db.end_tables(); ++it) {
+        const Table &T = *it->second;
+        meta.str(*T.name());
+
+        /*----- Write schema and constraints. -----*/
+        meta.u64(T.num_attrs());
+        const auto primary_key = T.primary_key();
+        for (auto attr = T.begin_all(); attr != T.end_all(); ++attr) {
+            const bool is_primary_key = std::any_of(primary_key.begin(), primary_key.end(), [&](const Attribute &pk) {
+                return pk.id == attr->id;
+            });
+            meta.str(*attr->name);
+            meta.type(*attr->type);
+            meta.u8((attr->not_nullable ? A_NotNullable : 0) | (attr->unique ? A_Unique : 0) |
+                    (attr->is_hidden ? A_Hidden : 0) | (is_primary_key ? A_PrimaryKey : 0));
+            meta.u8(attr->reference != nullptr);
+            if (attr->reference) {
+                meta.str(*attr->reference->table.name());
+                meta.str(*attr->reference->name);
+            }
+        }
+
+        /*----- Write data layout and data.  The data is written exactly as laid out in memory. -----*/
+        meta.layout(T.layout());
+        const Store &store = T.store();
+        const std::size_t size = used_bytes(T.layout(), store.num_rows());
+        M_insist(size <= store.memory().size(), "store exceeds its memory");
+        meta.u64(store.num_rows());
+        meta.u64(offset);
+        meta.u64(size);
+        write_all(file.fd, store.memory().as<const void*>(), size, offset, path);
+        offset = (offset + size + SNAPSHOT_ALIGNMENT - 1) / SNAPSHOT_ALIGNMENT * SNAPSHOT_ALIGNMENT;
+    }
+
+    /*----- Write metadata and header. -----*/
+    header.metadata_offset = offset;
+    header.metadata_size = meta.buf.size();
+    write_all(file.fd, meta.buf.data(), meta.buf.size(), offset, path);
+    write_all(file.fd, &header, sizeof(header), 0, path);
+    if (fsync(file.fd))
+        throw_errno("Failed to write", path);
+}
+
+
+/*======================================================================================================================
+ * read_snapshot
+ *====================================================================================================================*/
+
+namespace {
+
+/** Restores the tables described by \p meta into \p db.  Table data is mapped from the snapshot file \p fd. */
+void restore_tables(Database &db, MetadataReader &meta, int fd, const std::filesystem::path &path)
+{
+    Catalog &C = Catalog::Get();
+    struct reference_t
+    {
+        ThreadSafePooledString table, attr; ///< the referencing attribute
+        std::string ref_table, ref_attr; ///< the referenced attribute
+    };
+    std::vector<reference_t> references;
+
+    const std::size_t num_tables = meta.u64();
+    for (std::size_t i = 0; i != num_tables; ++i) {
+        auto table_name = C.pool(meta.str().c_str());
+        if (db.has_table(table_name))
+            throw invalid_argument("snapshot contains table \"" + std::string(*table_name) + "\" twice");
+        Table &T = db.add_table(table_name);
+
+        /*----- Restore schema and constraints.  The table factory may have added attributes already. -----*/
+        const std::size_t num_attrs = meta.u64();
+        const std::size_t num_factory_attrs = T.num_attrs();
+        if (num_factory_attrs > num_attrs)
+            throw invalid_argument("snapshot of table \"" + std::string(*table_name) +
+                                   "\" does not match the current table factory");
+        for (std::size_t id = 0; id != num_attrs; ++id) {
+            auto attr_name = C.pool(meta.str().c_str());
+            const PrimitiveType *ty = meta.type();
+            const uint8_t flags = meta.u8();
+            if (id < num_factory_attrs) {
+                auto &attr = T.at(id);
+                if (attr.name != attr_name or attr.type != ty or attr.is_hidden != bool(flags & A_Hidden))
+                    throw invalid_argument("snapshot of table \"" + std::string(*table_name) +
+                                           "\" does not match the current table factory");
+            } else {
+                meta.check(not (flags & A_Hidden));
+                T.push_back(attr_name, ty);
+            }
+            auto &attr = T.at(id);
+            attr.not_nullable = flags & A_NotNullable;
+            attr.unique = flags & A_Unique;
+            if (flags & A_PrimaryKey)
+                T.add_primary_key(attr_name);
+            if (meta.u8()) {
+                auto ref_table = meta.str();
+                auto ref_attr = meta.str();
+                references.push_back({ table_name, attr_name, std::move(ref_table), std::move(ref_attr) });
+            }
+        }
+
+        /*----- Restore data layout and store. -----*/
+        T.layout(meta.layout());
+        T.store(C.create_store(T));
+        const std::size_t num_rows = meta.u64();
+        const std::size_t data_offset = meta.u64();
+        const std::size_t data_size = meta.u64();
+        meta.check(data_size == used_bytes(T.layout(), num_rows));
+        memory::Memory &mem = T.store().memory();
+        if (data_size > mem.size())
+            throw invalid_argument("snapshot of table \"" + std::string(*table_name) +
+                                   "\" exceeds the capacity of its store");
+
+        /* Map the completely filled strides straight from the file.  Since these strides are never written by
+         * appending rows, they can be mapped read-only.  The partially filled last stride is copied, s.t. rows can be
+         * appended.  The mapped range must consist of whole pages of the store's allocator, which may be huge pages. */
+        const std::size_t page_mask = mem.allocator().page_size() - 1;
+        const std::size_t mapped_size =
+            Is_Page_Aligned(data_offset) ? full_bytes(T.layout(), num_rows) & ~page_mask : 0;
+        if (mapped_size)
+            mem.map_file(fd, data_offset, mapped_size);
+        read_all(fd, mem.as<uint8_t*>() + mapped_size, data_size - mapped_size, data_offset + mapped_size, path);
+        T.store().set_num_rows(num_rows);
+    }
+
+    /*----- Restore references, which may refer to any table of the database. -----*/
+    for (auto &ref : references) {
+        auto ref_table = C.pool(ref.ref_table.c_str());
+        meta.check(db.has_table(ref_table));
+        db.get_table(ref.table).at(ref.attr).reference = &db.get_table(ref_table).at(C.pool(ref.ref_attr.c_str()));
+    }
+}
+
+}
+
+Database & m::read_snapshot(const std::filesystem::path &path)
+{
+    file_descriptor file(open(path.c_str(), O_RDONLY|O_CLOEXEC));
+    if (file.fd == -1)
+        throw_errno("Failed to open", path);
+
+    /*----- Read and validate the header. -----*/
+    header_t header;
+    read_all(file.fd, &header, sizeof(header), 0, path);
+    if (header.magic != SNAPSHOT_MAGIC)
+        throw invalid_argument("\"" + path.string() + "\" is not a snapshot");
+    if (header.byte_order != header_t().byte_order)
+        throw invalid_argument("snapshot \"" + path.string() + "\" was written with a different byte order");
+    if (header.version != SNAPSHOT_VERSION)
+        throw invalid_argument("snapshot \"" + path.string() + "\" has unsupported version " +
+                               std::to_string(header.version));
+
+    /*----- Read the metadata. -----*/
+    std::vector<char> buf(header.metadata_size);
+    read_all(file.fd, buf.data(), buf.size(), header.metadata_offset, path);
+    MetadataReader meta(buf);
+
+    Catalog &C = Catalog::Get();
+    auto db_name = C.pool(meta.str().c_str());
+    if (C.has_database(db_name))
+        throw invalid_argument("database \"" + std::string(*db_name) + "\" already exists");
+    Database &db = C.add_database(db_name);
+    try {
+        restore_tables(db, meta, file.fd, path);
+        meta.check(meta.empty());
+    } catch (...) {
+        C.drop_database(db_name);
+        throw;
+    }
+    return db;
+}
@@ -10,6 +10,21 @@ using namespace m;
  * Store
  *====================================================================================================================*/
 
+void Store::set_num_rows(std::size_t n)
+{
+    while (num_rows() < n) append();
+    while (num_rows() > n) drop();
+}
+
+const ZoneMap & Store::zone_map() const
+{
+    std::lock_guard<std::mutex> lock(zone_map_mutex_);
+    if (not zone_map_)
+        zone_map_ = std::make_unique<ZoneMap>();
+    zone_map_->update(*this);
+    return *zone_map_;
+}
+
 M_LCOV_EXCL_START
 void Store::dump() const { dump(std::cerr); }
 M_LCOV_EXCL_STOP
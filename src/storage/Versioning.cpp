@@ -0,0 +1,99 @@
+#include <mutable/storage/Versioning.hpp>
+
+#include "backend/Interpreter.hpp"
+#include "backend/StackMachine.hpp"
+#include <mutable/catalog/Catalog.hpp>
+#include <mutable/catalog/Schema.hpp>
+#include <mutable/IR/Tuple.hpp>
+#include <mutable/storage/Compression.hpp>
+#include <mutable/storage/Store.hpp>
+
+
+using namespace m;
+
+
+std::optional<timestamp_attributes_t> m::get_timestamp_attributes(const Table &table)
+{
+    auto &C = Catalog::Get();
+    const auto ts_begin = C.pool("$ts_begin");
+    const auto ts_end = C.pool("$ts_end");
+
+    std::optional<std::size_t> begin, end;
+    for (auto it = table.begin_hidden(); it != table.end_hidden(); ++it) {
+        if (it->name == ts_begin)
+            begin = it->id;
+        else if (it->name == ts_end)
+            end = it->id;
+    }
+    if (not begin or not end)
+        return std::nullopt;
+    return timestamp_attributes_t{ *begin, *end };
+}
+
+std::size_t m::update_rows(Table &table, const std::function<bool(Tuple&)> &callback)
+{
+    decompress_table(table); // encoded leaves cannot be written in place
+
+    auto &store = table.store();
+    store.memory().unmap_file(); // rows restored from a snapshot are mapped read-only from the snapshot file
+    const Schema S = table.schema();
+    auto loader = Interpreter::compile_load(S, store.memory().addr(), table.layout(), S);
+    auto writer = Interpreter::compile_store(S, store.memory().addr(), table.layout(), S);
+
+    /* The writer advances to the next row on every invocation.  Hence, every row is written back, though only modified
+     * rows change. */
+    std::size_t num_modified = 0;
+    Tuple tup(S);
+    Tuple *args[] = { &tup };
+    for (std::size_t i = 0, end = store.num_rows(); i != end; ++i) {
+        loader(args);
+        num_modified += callback(tup);
+        writer(args);
+    }
+
+    if (num_modified)
+        store.invalidate_zone_map();
+    return num_modified;
+}
+
+std::size_t m::remove_rows(Table &table, const std::function<bool(Tuple&)> &predicate)
+{
+    decompress_table(table); // encoded leaves cannot be written in place
+
+    auto &store = table.store();
+    store.memory().unmap_file(); // rows restored from a snapshot are mapped read-only from the snapshot file
+    const Schema S = table.schema();
+    auto loader = Interpreter::compile_load(S, store.memory().addr(), table.layout(), S);
+    auto writer = Interpreter::compile_store(S, store.memory().addr(), table.layout(), S);
+
+    /* Move every remaining row to the next free row.  Since the writer never passes the loader, no row is overwritten
+     * before it is loaded. */
+    const std::size_t num_rows = store.num_rows();
+    std::size_t num_remaining = 0;
+    Tuple tup(S);
+    Tuple *args[] = { &tup };
+    for (std::size_t i = 0; i != num_rows; ++i) {
+        loader(args);
+        if (predicate(tup))
+            continue;
+        writer(args);
+        ++num_remaining;
+    }
+
+    if (num_remaining != num_rows) {
+        store.set_num_rows(num_remaining);
+        store.invalidate_zone_map();
+    }
+    return num_rows - num_remaining;
+}
+
+std::size_t m::collect_garbage(Table &table, int64_t horizon)
+{
+    const auto ts = get_timestamp_attributes(table);
+    M_insist(bool(ts), "garbage can only be collected in multi-versioned tables");
+
+    return remove_rows(table, [&ts, horizon](Tuple &tup) {
+        const int64_t ts_end = tup[ts->end].as_i();
+        return ts_end != -1 and ts_end <= horizon;
+    });
+}
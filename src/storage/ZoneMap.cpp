@@ -0,0 +1,244 @@
+#include <mutable/storage/ZoneMap.hpp>
+
+#include "backend/Interpreter.hpp"
+#include "backend/StackMachine.hpp"
+#include <algorithm>
+#include <cmath>
+#include <mutable/catalog/Schema.hpp>
+#include <mutable/catalog/Type.hpp>
+#include <mutable/IR/CNF.hpp>
+#include <mutable/parse/AST.hpp>
+#include <mutable/storage/Store.hpp>
+#include <optional>
+
+
+using namespace m;
+
+
+namespace {
+
+/** Returns `true` iff attributes of type \p ty are summarized by a `ZoneMap`. */
+bool is_summarized_type(const Type &ty)
+{
+    return ty.is_numeric() or ty.is_date() or ty.is_date_time();
+}
+
+/** Returns the value \p val of type \p ty as `long double`, which represents all 64 bit integers exactly. */
+long double to_long_double(const Type &ty, const Value &val)
+{
+    if (ty.is_float())  return val.as_f();
+    if (ty.is_double()) return val.as_d();
+    return val.as_i();
+}
+
+/** Returns the value of \p expr if \p expr is a numeric, date, or datetime constant, optionally preceded by a unary plus
+ * or minus. */
+std::optional<long double> constant_value(const ast::Expr &expr)
+{
+    bool is_negative = false;
+    const ast::Expr *e = &expr;
+    if (auto u = cast<const ast::UnaryExpr>(e)) {
+        if (u->op().type != TK_MINUS and u->op().type != TK_PLUS)
+            return std::nullopt;
+        is_negative = u->op().type == TK_MINUS;
+        e = u->expr.get();
+    }
+    auto c = cast<const ast::Constant>(e);
+    if (not c or is<const ast::Parameter>(c))
+        return std::nullopt;
+
+    long double value;
+    switch (c->tok.type) {
+        default:
+            return std::nullopt;
+
+        case TK_OCT_INT:
+        case TK_DEC_INT:
+        case TK_HEX_INT:
+        case TK_DATE:
+        case TK_DATE_TIME:
+            value = Interpreter::eval(*c).as_i();
+            break;
+
+        case TK_DEC_FLOAT:
+            value = Interpreter::eval(*c).as_d();
+            break;
+    }
+    return is_negative ? -value : value;
+}
+
+/** Returns `true` iff comparing a value in the range [ \p lo, \p hi ] by token type \p op to \p c may yield `true`. */
+bool may_satisfy(TokenType op, long double lo, long double hi, long double c)
+{
+    switch (op) {
+        default: M_unreachable("invalid comparison");
+        case TK_EQUAL:          return lo <= c and c <= hi;
+        case TK_BANG_EQUAL:     return not (lo == c and hi == c);
+        case TK_LESS:           return lo < c;
+        case TK_LESS_EQUAL:     return lo <= c;
+        case TK_GREATER:        return hi > c;
+        case TK_GREATER_EQUAL:  return hi >= c;
+    }
+}
+
+/** Returns the comparison equivalent to `NOT (a op b)`, ignoring `NULL`. */
+TokenType negate(TokenType op)
+{
+    switch (op) {
+        default: M_unreachable("invalid comparison");
+        case TK_EQUAL:          return TK_BANG_EQUAL;
+        case TK_BANG_EQUAL:     return TK_EQUAL;
+        case TK_LESS:           return TK_GREATER_EQUAL;
+        case TK_LESS_EQUAL:     return TK_GREATER;
+        case TK_GREATER:        return TK_LESS_EQUAL;
+        case TK_GREATER_EQUAL:  return TK_LESS;
+    }
+}
+
+/** Returns the comparison equivalent to `b op a`. */
+TokenType mirror(TokenType op)
+{
+    switch (op) {
+        default: M_unreachable("invalid comparison");
+        case TK_EQUAL:          return TK_EQUAL;
+        case TK_BANG_EQUAL:     return TK_BANG_EQUAL;
+        case TK_LESS:           return TK_GREATER;
+        case TK_LESS_EQUAL:     return TK_GREATER_EQUAL;
+        case TK_GREATER:        return TK_LESS;
+        case TK_GREATER_EQUAL:  return TK_LESS_EQUAL;
+    }
+}
+
+}
+
+void ZoneMap::update(const Store &store)
+{
+    auto &table = store.table();
+    const auto &S = table.schema();
+    const std::size_t num_rows = store.num_rows();
+    if (num_rows == num_rows_ and is_summarized_.size() == S.num_entries())
+        return; // up to date
+
+    /*----- Determine the summarized attributes. -----*/
+    if (is_summarized_.size() != S.num_entries()) {
+        is_summarized_.clear();
+        for (auto &e : S)
+            is_summarized_.push_back(is_summarized_type(*e.type));
+        summaries_.clear();
+        num_rows_ = 0;
+    }
+
+    /*----- Summarize all zones starting with the last zone that is not completely covered. -----*/
+    const std::size_t first_zone = std::min(num_rows_, num_rows) / ZONE_SIZE;
+    num_rows_ = num_rows;
+    summaries_.resize(num_zones() * num_attributes());
+    std::fill(summaries_.begin() + first_zone * num_attributes(), summaries_.end(), summary_t());
+    if (first_zone == num_zones())
+        return;
+
+    Schema tuple_schema;
+    std::vector<std::size_t> attrs; // the index in `S` of every entry of `tuple_schema`
+    for (std::size_t i = 0; i != S.num_entries(); ++i) {
+        if (is_summarized_[i]) {
+            tuple_schema.add(S[i].id, S[i].type, S[i].constraints);
+            attrs.push_back(i);
+        }
+    }
+    if (attrs.empty())
+        return;
+
+    auto loader = Interpreter::compile_load(tuple_schema, store.memory().addr(), table.layout(), S,
+                                            first_zone * ZONE_SIZE);
+    Tuple tup(tuple_schema);
+    Tuple *args[] = { &tup };
+    for (std::size_t row = first_zone * ZONE_SIZE; row != num_rows; ++row) {
+        loader(args);
+        auto zone = &summaries_[row / ZONE_SIZE * num_attributes()];
+        for (std::size_t i = 0; i != attrs.size(); ++i) {
+            auto &summary = zone[attrs[i]];
+            if (tup.is_null(i)) {
+                ++summary.num_nulls;
+                continue;
+            }
+            auto &ty = *tuple_schema[i].type;
+            const auto value = to_long_double(ty, tup[i]);
+            if (summary.num_values == 0 or value < to_long_double(ty, summary.min)) summary.min = tup[i];
+            if (summary.num_values == 0 or value > to_long_double(ty, summary.max)) summary.max = tup[i];
+            ++summary.num_values;
+        }
+    }
+}
+
+bool ZoneMap::can_skip(std::size_t zone, const cnf::CNF &filter, const Schema &schema) const
+{
+    M_insist(zone < num_zones(), "zone out of bounds");
+
+    /* Returns `true` iff the predicate `pred` cannot be satisfied within `zone`. */
+    auto is_unsatisfiable = [&](const cnf::Predicate &pred) -> bool {
+        auto binary = cast<const ast::BinaryExpr>(&pred.expr());
+        if (not binary)
+            return false;
+        switch (binary->tok.type) {
+            default:
+                return false;
+            case TK_EQUAL:
+            case TK_BANG_EQUAL:
+            case TK_LESS:
+            case TK_LESS_EQUAL:
+            case TK_GREATER:
+            case TK_GREATER_EQUAL:
+                break;
+        }
+
+        /*----- Find the attribute and the constant of the comparison. -----*/
+        const bool has_attribute_left = is<const ast::Designator>(binary->lhs);
+        auto &attribute = has_attribute_left ? *binary->lhs : *binary->rhs;
+        auto &constant = has_attribute_left ? *binary->rhs : *binary->lhs;
+        if (not is<const ast::Designator>(attribute))
+            return false;
+        auto it = schema.find(Schema::Identifier(attribute));
+        if (it == schema.end())
+            return false;
+        const std::size_t attr = std::distance(schema.begin(), it);
+        if (not is_summarized(attr))
+            return false;
+        auto c = constant_value(constant);
+        if (not c)
+            return false;
+
+        /*----- Compare the range of the attribute within the zone to the constant. -----*/
+        auto &s = summary(zone, attr);
+        if (s.num_values == 0)
+            return true; // comparisons with `NULL` are never satisfied, neither in positive nor in negative form
+        auto &ty = *it->type;
+        long double lo = to_long_double(ty, s.min);
+        long double hi = to_long_double(ty, s.max);
+        if (auto n = cast<const Numeric>(&ty); n and n->kind == Numeric::N_Decimal) {
+            /* Decimals are stored as integers scaled by 10^scale.  Widen the range by half a unit in the last place to
+             * tolerate rounding of the constant. */
+            const long double factor = std::pow(10.L, n->scale);
+            lo = (lo - .5L) / factor;
+            hi = (hi + .5L) / factor;
+        } else if (ty.is_float()) {
+            *c = float(*c); // the constant is compared to the attribute in single precision
+        }
+        TokenType op = binary->tok.type;
+        if (not has_attribute_left) op = mirror(op);
+        if (pred.negative()) op = negate(op);
+        return not may_satisfy(op, lo, hi, *c);
+    };
+
+    for (auto &clause : filter) {
+        if (std::all_of(clause.begin(), clause.end(), is_unsatisfiable))
+            return true; // clause cannot be satisfied ⇒ entire filter cannot be satisfied
+    }
+    return false;
+}
+
+std::vector<bool> ZoneMap::skippable_zones(const cnf::CNF &filter, const Schema &schema) const
+{
+    std::vector<bool> skippable(num_zones());
+    for (std::size_t zone = 0; zone != num_zones(); ++zone)
+        skippable[zone] = can_skip(zone, filter, schema);
+    return skippable;
+}
@@ -1,17 +1,23 @@
 #include <mutable/util/memory.hpp>
 
 #include <mutable/util/macro.hpp>
+#include <algorithm>
 #include <cerrno>
 #include <climits>
 #include <cstring>
 #include <exception>
+#include <fstream>
 #include <stdexcept>
 
 #if __linux
 #include <sys/mman.h>
 #include <sys/stat.h>
+#include <sys/syscall.h>
 #include <sys/types.h>
 #include <unistd.h>
+#ifndef MFD_HUGE_2MB
+#define MFD_HUGE_2MB (21U << 26) // see <linux/memfd.h>
+#endif
 #elif __APPLE__
 #include <fcntl.h>
 #include <sys/mman.h>
@@ -24,14 +30,62 @@ using namespace m;
 using namespace m::memory;
 
 
+/*======================================================================================================================
+ * Placement
+ *====================================================================================================================*/
+
+namespace {
+
+/** The size in bytes of explicit huge pages, see `Placement::HP_Explicit`. */
+constexpr std::size_t HUGE_PAGE_SIZE = 2UL << 20;
+
+#if __linux
+/* Memory policies of `mbind()`, see `<numaif.h>`.  Defined here to not depend on libnuma. */
+constexpr int MPOL_BIND_ = 2;
+constexpr int MPOL_INTERLEAVE_ = 3;
+
+/** Returns the mask of the online NUMA nodes of the system, or 0 if the system has no NUMA support. */
+uint64_t online_numa_nodes()
+{
+    std::ifstream in("/sys/devices/system/node/online");
+    uint64_t mask = 0;
+    unsigned first, last;
+    while (in >> first) {
+        last = first;
+        if (in.peek() == '-') {
+            in.get();
+            in >> last;
+        }
+        for (unsigned node = first; node <= last and node < 64; ++node)
+            mask |= uint64_t(1) << node;
+        if (in.peek() != ',') break;
+        in.get();
+    }
+    return mask;
+}
+#endif
+
+}
+
+Placement & Placement::Default()
+{
+    static Placement the_placement;
+    return the_placement;
+}
+
+
 /*======================================================================================================================
  * Allocator
  *====================================================================================================================*/
 
-Allocator::Allocator()
+Allocator::Allocator(const Placement &placement)
+    : placement_(placement)
 {
 #if __linux
-    fd_ = memfd_create("rewire_allocator", MFD_CLOEXEC);
+    if (placement_.huge_pages == Placement::HP_Explicit)
+        fd_ = memfd_create("rewire_allocator", MFD_CLOEXEC | MFD_HUGETLB | MFD_HUGE_2MB);
+    else
+        fd_ = memfd_create("rewire_allocator", MFD_CLOEXEC);
 #elif __APPLE__
     auto name = std::to_string(getpid());
     fd_ = shm_open(name.c_str(), O_RDWR | O_TRUNC | O_CREAT, S_IRUSR | S_IWUSR);
@@ -47,11 +101,48 @@ Allocator::~Allocator()
     close(fd_);
 }
 
+std::size_t Allocator::page_size() const
+{
+    return placement_.huge_pages == Placement::HP_Explicit ? HUGE_PAGE_SIZE : get_pagesize();
+}
+
 Memory Allocator::create_memory(void *addr, std::size_t size, std::size_t offset)
 {
     return Memory(*this, addr, size, offset);
 }
 
+void Allocator::place(void *addr, std::size_t size) const
+{
+#if __linux
+    /* Transparent huge pages are merely a hint, hence ignore failure, e.g. if the kernel does not support them. */
+    if (placement_.huge_pages == Placement::HP_Transparent)
+        M_DISCARD madvise(addr, size, MADV_HUGEPAGE);
+
+    /* Bind the memory to NUMA nodes.  Since the mappings are shared, the policy applies to the underlying memory file
+     * and is thereby retained when the memory is rewired, e.g. into the address space of a WebAssembly VM. */
+    if (placement_.numa_node >= 0 or placement_.numa_interleave) {
+        uint64_t nodes;
+        int mode;
+        if (placement_.numa_interleave) {
+            nodes = online_numa_nodes();
+            mode = MPOL_INTERLEAVE_;
+        } else {
+            if (placement_.numa_node >= 64)
+                throw std::invalid_argument("NUMA node out of range");
+            nodes = uint64_t(1) << placement_.numa_node;
+            mode = MPOL_BIND_;
+        }
+        if (nodes == 0) return; // no NUMA support
+        if (syscall(SYS_mbind, addr, size, mode, &nodes, /* maxnode= */ 64UL, /* flags= */ 0U))
+            throw std::runtime_error(strerror(errno));
+    }
+#elif __APPLE__
+    /* Nothing to be done.  macOS supports neither explicit memory placement nor advising huge pages. */
+    (void) addr;
+    (void) size;
+#endif
+}
+
 
 /*======================================================================================================================
  * AddressSpace
@@ -61,9 +152,24 @@ AddressSpace::AddressSpace(std::size_t size)
 {
     if (size != 0) {
         auto aligned_size = Ceil_To_Next_Page(size);
-        addr_ = mmap(nullptr, aligned_size, PROT_NONE, MAP_PRIVATE|MAP_ANONYMOUS, /* fd= */ -1, /* offset= */ 0);
-        if (addr_ == MAP_FAILED)
-            throw std::runtime_error(strerror(errno));
+        if (aligned_size < HUGE_PAGE_SIZE) {
+            addr_ = mmap(nullptr, aligned_size, PROT_NONE, MAP_PRIVATE|MAP_ANONYMOUS, /* fd= */ -1, /* offset= */ 0);
+            if (addr_ == MAP_FAILED)
+                throw std::runtime_error(strerror(errno));
+        } else {
+            /* Align the address space to huge pages, s.t. memory backed by huge pages can be mapped into it.  Reserve
+             * an additional huge page and release the unaligned parts at the front and back. */
+            auto addr = mmap(nullptr, aligned_size + HUGE_PAGE_SIZE, PROT_NONE, MAP_PRIVATE|MAP_ANONYMOUS,
+                             /* fd= */ -1, /* offset= */ 0);
+            if (addr == MAP_FAILED)
+                throw std::runtime_error(strerror(errno));
+            const auto begin = reinterpret_cast<uintptr_t>(addr);
+            const auto aligned_begin = ((begin - 1UL) | (HUGE_PAGE_SIZE - 1UL)) + 1UL;
+            if (aligned_begin != begin)
+                munmap(addr, aligned_begin - begin);
+            munmap(reinterpret_cast<void*>(aligned_begin + aligned_size), begin + HUGE_PAGE_SIZE - aligned_begin);
+            addr_ = reinterpret_cast<void*>(aligned_begin);
+        }
         size_ = aligned_size;
     }
 }
@@ -82,25 +188,99 @@ Memory::Memory(Allocator &allocator, void *addr, std::size_t size, std::size_t o
     , offset_(offset)
 { }
 
+Memory::~Memory()
+{
+    if (allocator_) allocator().deallocate(std::move(*this));
+    if (file_fd_ != -1) close(file_fd_);
+}
+
 void Memory::map(std::size_t size, std::size_t offset_src, const AddressSpace &vm, std::size_t offset_dst) const
 {
     M_insist(size <= this->size(), "size exceeds memory size");
     M_insist(offset_src < this->size(), "source offset out of bounds");
-    M_insist(Is_Page_Aligned(offset_src), "source offset is not page aligned");
+    M_insist(offset_src % allocator().page_size() == 0, "source offset is not page aligned");
     M_insist(offset_src + size <= this->size(), "source range out of bounds");
 
     M_insist(size <= vm.size(), "size exceeds address space");
     M_insist(offset_dst < vm.size(), "destination offset out of bounds");
-    M_insist(Is_Page_Aligned(offset_dst), "destination offset is not page aligned");
+    M_insist(offset_dst % allocator().page_size() == 0, "destination offset is not page aligned");
     M_insist(offset_dst + size <= vm.size(), "destination range out of bounds");
 
-    void *dst_addr = vm.as<uint8_t*>() + offset_dst;
+    uint8_t *dst_addr = vm.as<uint8_t*>() + offset_dst;
+
+    /* Map the part of the range that is backed by a file, see `map_file()`. */
+    if (offset_src < file_size_) {
+        const std::size_t file_part = std::min(size, file_size_ - offset_src);
+        void *addr = mmap(dst_addr, file_part, PROT_READ, MAP_PRIVATE|MAP_FIXED, file_fd_, file_offset_ + offset_src);
+        if (addr == MAP_FAILED)
+            throw std::runtime_error(strerror(errno));
+        if (addr != dst_addr)
+            throw std::runtime_error("MAP_FIXED failed");
+        dst_addr += file_part;
+        offset_src += file_part;
+        size -= file_part;
+        if (size == 0) return;
+    }
+
     void *addr = mmap(dst_addr, size, PROT_READ|PROT_WRITE, MAP_SHARED|MAP_FIXED, allocator().fd(),
                       this->offset() + offset_src);
     if (addr == MAP_FAILED)
         throw std::runtime_error(strerror(errno));
     if (addr != dst_addr)
         throw std::runtime_error("MAP_FIXED failed");
+    if (allocator().placement().huge_pages == Placement::HP_Transparent)
+        M_DISCARD madvise(addr, size, MADV_HUGEPAGE); // advise for the new virtual range as well
+}
+
+void Memory::map_file(int fd, std::size_t file_offset, std::size_t size)
+{
+    M_insist(file_fd_ == -1, "a file is already mapped over this memory");
+    M_insist(size <= this->size(), "size exceeds memory size");
+    M_insist(Is_Page_Aligned(file_offset), "file offset is not page aligned");
+    M_insist(size % allocator().page_size() == 0, "size is not aligned to the pages of the allocator");
+    if (size == 0) return;
+
+    /* Keep our own file descriptor, such that the file can be mapped again by `map()`. */
+    file_fd_ = dup(fd);
+    if (file_fd_ == -1)
+        throw std::runtime_error(strerror(errno));
+    void *addr = mmap(addr_, size, PROT_READ, MAP_PRIVATE|MAP_FIXED, file_fd_, file_offset);
+    if (addr == MAP_FAILED) {
+        const int errsv = errno;
+        close(file_fd_);
+        file_fd_ = -1;
+        throw std::runtime_error(strerror(errsv));
+    }
+    if (addr != addr_)
+        throw std::runtime_error("MAP_FIXED failed");
+    file_offset_ = file_offset;
+    file_size_ = size;
+}
+
+void Memory::unmap_file()
+{
+    if (file_fd_ == -1) return;
+
+    /* Copy the file range into the memory file through a temporary mapping of this allocation. */
+    void *tmp = mmap(nullptr, size_, PROT_READ|PROT_WRITE, MAP_SHARED, allocator().fd(), offset_);
+    if (tmp == MAP_FAILED)
+        throw std::runtime_error(strerror(errno));
+    std::memcpy(tmp, addr_, file_size_);
+    munmap(tmp, size_);
+
+    /* Map the memory file over the file range again. */
+    void *addr = mmap(addr_, size_, PROT_READ|PROT_WRITE, MAP_SHARED|MAP_FIXED, allocator().fd(), offset_);
+    if (addr == MAP_FAILED)
+        throw std::runtime_error(strerror(errno));
+    if (addr != addr_)
+        throw std::runtime_error("MAP_FIXED failed");
+    if (allocator().placement().huge_pages == Placement::HP_Transparent)
+        M_DISCARD madvise(addr, size_, MADV_HUGEPAGE); // advise for the new virtual range as well
+
+    close(file_fd_);
+    file_fd_ = -1;
+    file_offset_ = 0;
+    file_size_ = 0;
 }
 
 M_LCOV_EXCL_START
@@ -121,9 +301,10 @@ Memory LinearAllocator::allocate(std::size_t size)
 {
     if (size == 0) return Memory();
 
-    const std::size_t aligned_size = Ceil_To_Next_Page(size);
+    const std::size_t aligned_size = ((size - 1UL) | (page_size() - 1UL)) + 1UL; // ceil to next page of the allocator
     M_insist(aligned_size >= size, "size must be ceiled");
     M_insist(Is_Page_Aligned(aligned_size), "not page aligned");
+    std::lock_guard<std::mutex> lock(mutex_);
 #if __linux
     if (ftruncate(fd(), offset_ + aligned_size))
         throw std::runtime_error(strerror(errno));
@@ -135,6 +316,7 @@ Memory LinearAllocator::allocate(std::size_t size)
     void *addr = mmap(nullptr, aligned_size, PROT_READ|PROT_WRITE, MAP_SHARED, fd(), offset_);
     if (addr == MAP_FAILED)
         throw std::runtime_error(strerror(errno));
+    place(addr, aligned_size);
 
     auto mem = create_memory(addr, aligned_size, offset_);
     allocations_.push_back(offset_);
@@ -164,6 +346,7 @@ void LinearAllocator::deallocate(Memory &&mem)
     if (&mem.allocator() != this)
         throw std::invalid_argument("memory has not been allocated by this allocator");
 
+    std::lock_guard<std::mutex> lock(mutex_);
     /* Find the allocation. */
     auto it = std::find(allocations_.rbegin(), allocations_.rend(), mem.offset());
     if (it == allocations_.rend())
@@ -12,6 +12,7 @@
 #include <mutable/util/ADT.hpp>
 #include <parse/Parser.hpp>
 #include <parse/Sema.hpp>
+#include <sstream>
 #include <testutil.hpp>
 
 
@@ -255,6 +256,38 @@ WHERE A.id = C.aid AND A.id = D.aid AND B.id = D.bid AND C.id = D.cid;";
             REQUIRE(expected == plan_table);
         }
 
+        SECTION("DPccpParallel")
+        {
+            make_entry(A, C);
+            make_entry(A, D);
+            make_entry(B, D);
+            make_entry(A|D, B);
+            make_entry(C, D);
+            make_entry(A|C, D);
+            make_entry(B, C|D);
+            make_entry(A|C, B|D);
+
+            auto &PE = Cat.plan_enumerator(Cat.pool("DPccpParallel"));
+            PE(G, C_out, plan_table);
+            REQUIRE(expected == plan_table);
+        }
+
+        SECTION("Adaptive")
+        {
+            make_entry(A, C);
+            make_entry(A, D);
+            make_entry(B, D);
+            make_entry(A|D, B);
+            make_entry(C, D);
+            make_entry(A|C, D);
+            make_entry(B, C|D);
+            make_entry(A|C, B|D);
+
+            auto &PE = Cat.plan_enumerator(Cat.pool("Adaptive"));
+            PE(G, C_out, plan_table);
+            REQUIRE(expected == plan_table);
+        }
+
         SECTION("TDbasic")
         {
             make_entry(A, C);
@@ -391,3 +424,169 @@ WHERE A.id = C.aid AND A.id = D.aid AND B.id = D.bid AND C.id = D.cid;";
         }
     }
 }
+
+TEST_CASE("PlanEnumerator/DPccpParallel concurrent", "[core][IR]")
+{
+    using Subproblem = SmallBitset;
+    using PlanTable = PlanTableSmallOrDense;
+
+    /* Get Catalog and create new database to use for unit testing. */
+    Catalog::Clear();
+    Catalog &Cat = Catalog::Get();
+    auto &db = Cat.add_database(Cat.pool("db"));
+    Cat.set_database_in_use(db);
+
+    Diagnostic diag(false, std::cout, std::cerr);
+    CostFunctionCout C_out;
+
+    /* Define a star query of the fact table `F` and the dimension tables `T0`, ..., `T10`.  Its 2^11 - 1 connected
+     * subgraphs of at least two relations exceed the minimal number of CSGs that DPccpParallel solves concurrently. */
+    constexpr std::size_t NUM_DIMENSIONS = 11;
+    ThreadSafePooledString col_id = Cat.pool("id");
+    std::ostringstream from, where;
+    from << "SELECT * FROM F";
+    for (std::size_t i = 0; i <= NUM_DIMENSIONS; ++i) {
+        const std::string name = i == NUM_DIMENSIONS ? "F" : "T" + std::to_string(i);
+        Table &tbl = db.add_table(Cat.pool(name.c_str()));
+        tbl.push_back(col_id, Type::Get_Integer(Type::TY_Vector, 4));
+        tbl.store(Cat.create_store(tbl));
+        tbl.layout(Cat.data_layout());
+        const std::size_t num_rows = i == NUM_DIMENSIONS ? 100 : i + 2; // distinct cardinalities
+        for (std::size_t j = 0; j != num_rows; ++j) { tbl.store().append(); }
+        if (i != NUM_DIMENSIONS) {
+            from << ", " << name;
+            where << (i ? " AND " : " WHERE ") << "F.id = " << name << ".id";
+        }
+    }
+    const std::string query = from.str() + where.str() + ';';
+
+    auto stmt = m::statement_from_string(diag, query);
+    REQUIRE(not diag.num_errors());
+    auto query_graph = QueryGraph::Build(*stmt);
+    auto &G = *query_graph.get();
+    REQUIRE(G.num_sources() == NUM_DIMENSIONS + 1);
+
+    auto enumerate = [&](const char *name) {
+        PlanTable plan_table(G);
+        pe_test::init_PT_base_case(G, plan_table);
+        auto &PE = Cat.plan_enumerator(Cat.pool(name));
+        PE(G, C_out, plan_table);
+        return plan_table;
+    };
+
+    /* Solve the query with several threads, regardless of the number of hardware threads. */
+    const char *args[] = { "PlanEnumeratorTest", "--plan-enumerator-threads", "4", nullptr };
+    Cat.arg_parser().parse_args(3, args);
+
+    const PlanTable expected = enumerate("DPccp");
+    const PlanTable plan_table = enumerate("DPccpParallel");
+
+    /* Every subproblem must be solved at the same cost, in particular the final plan. */
+    const Subproblem All = Subproblem::All(G.num_sources());
+    CHECK(plan_table[All].cost == expected[All].cost);
+    std::size_t num_mismatches = 0;
+    for (uint64_t S = 1; S <= uint64_t(All); ++S)
+        num_mismatches += plan_table[Subproblem(S)].cost != expected[Subproblem(S)].cost;
+    CHECK(num_mismatches == 0);
+
+    const char *reset_args[] = { "PlanEnumeratorTest", "--plan-enumerator-threads", "0", nullptr };
+    Cat.arg_parser().parse_args(3, reset_args);
+}
+
+TEST_CASE("PlanEnumerator/Adaptive", "[core][IR]")
+{
+    using Subproblem = SmallBitset;
+    using PlanTable = PlanTableSmallOrDense;
+
+    /* Get Catalog and create new database to use for unit testing. */
+    Catalog::Clear();
+    Catalog &Cat = Catalog::Get();
+    auto &db = Cat.add_database(Cat.pool("db"));
+    Cat.set_database_in_use(db);
+
+    Diagnostic diag(false, std::cout, std::cerr);
+    CostFunctionCout C_out;
+
+    /* Define the fact table `F` and the dimension tables `T0`, ..., `T16`.  A star query of all dimensions has
+     * 2^17 + 17 connected subgraphs, exceeding the CSGs that `Adaptive` enumerates exhaustively. */
+    constexpr std::size_t NUM_DIMENSIONS = 17;
+    ThreadSafePooledString col_id = Cat.pool("id");
+    for (std::size_t i = 0; i <= NUM_DIMENSIONS; ++i) {
+        const std::string name = i == NUM_DIMENSIONS ? "F" : "T" + std::to_string(i);
+        Table &tbl = db.add_table(Cat.pool(name.c_str()));
+        tbl.push_back(col_id, Type::Get_Integer(Type::TY_Vector, 4));
+        tbl.store(Cat.create_store(tbl));
+        tbl.layout(Cat.data_layout());
+        const std::size_t num_rows = i == NUM_DIMENSIONS ? 100 : i + 2; // distinct cardinalities
+        for (std::size_t j = 0; j != num_rows; ++j) { tbl.store().append(); }
+    }
+
+    /* Returns the star query of `F` and the first \p num_dimensions dimensions, optionally closing a cycle. */
+    auto star_query = [](std::size_t num_dimensions, bool cyclic) {
+        std::ostringstream from, where;
+        from << "SELECT * FROM F";
+        for (std::size_t i = 0; i != num_dimensions; ++i) {
+            from << ", T" << i;
+            where << (i ? " AND " : " WHERE ") << "F.id = T" << i << ".id";
+        }
+        if (cyclic)
+            where << " AND T0.id = T1.id";
+        return from.str() + where.str() + ';';
+    };
+
+    auto set_options = [&Cat](const char *budget, const char *heuristic) {
+        const char *args[] = {
+            "PlanEnumeratorTest", "--adaptive-budget", budget, "--adaptive-heuristic", heuristic, nullptr
+        };
+        Cat.arg_parser().parse_args(5, args);
+    };
+
+    /* Enumerates the query graph of \p query with the plan enumerators \p name and `Adaptive` and checks that both find
+     * a final plan of equal cost. */
+    auto check_same_as = [&](const std::string &query, const char *name) {
+        auto stmt = m::statement_from_string(diag, query);
+        REQUIRE(not diag.num_errors());
+        auto query_graph = QueryGraph::Build(*stmt);
+        auto &G = *query_graph.get();
+
+        auto enumerate = [&](const char *pe_name) {
+            PlanTable plan_table(G);
+            pe_test::init_PT_base_case(G, plan_table);
+            auto &PE = Cat.plan_enumerator(Cat.pool(pe_name));
+            PE(G, C_out, plan_table);
+            return plan_table;
+        };
+
+        const PlanTable expected = enumerate(name);
+        const PlanTable plan_table = enumerate("Adaptive");
+        const Subproblem All = Subproblem::All(G.num_sources());
+        REQUIRE(plan_table.has_plan(All));
+        CHECK(plan_table[All].cost == expected[All].cost);
+    };
+
+    SECTION("exceeded budget completes plan greedily")
+    {
+        set_options("0", "LinearizedDP");
+        check_same_as(star_query(4, false), "GOO");
+    }
+
+    SECTION("too many CSGs uses heuristic")
+    {
+        set_options("60000", "DPccp");
+        check_same_as(star_query(NUM_DIMENSIONS, false), "DPccp");
+    }
+
+    SECTION("acyclic query graph after exceeded budget uses IKKBZ")
+    {
+        set_options("0", "LinearizedDP");
+        check_same_as(star_query(NUM_DIMENSIONS, false), "IKKBZ");
+    }
+
+    SECTION("cyclic query graph after exceeded budget uses GOO")
+    {
+        set_options("0", "LinearizedDP");
+        check_same_as(star_query(NUM_DIMENSIONS, true), "GOO");
+    }
+
+    set_options("100", "LinearizedDP");
+}
@@ -0,0 +1,112 @@
+#include "catch2/catch.hpp"
+
+#include <mutable/mutable.hpp>
+#include <sstream>
+#include <string>
+#include <vector>
+
+
+using namespace m;
+
+
+TEST_CASE("PreparedStatement", "[core][prepare]")
+{
+    Catalog::Clear();
+    Catalog &C = Catalog::Get();
+    auto &DB = C.add_database(C.pool("db"));
+    C.set_database_in_use(DB);
+
+    std::ostringstream out, err;
+    Diagnostic diag(false, out, err);
+
+    /* Create and fill a table. */
+    auto create = statement_from_string(diag, "CREATE TABLE T (a INT(4), b CHAR(8), c DOUBLE, d DATE);");
+    execute_statement(diag, *create);
+    std::ostringstream insert;
+    insert << "INSERT INTO T VALUES ";
+    for (unsigned i = 0; i != 100; ++i) {
+        if (i) insert << ", ";
+        insert << '(' << i << ", \"s" << i % 10 << "\", " << i << ".5, d'2000-01-" << (i % 28 + 1) / 10
+               << (i % 28 + 1) % 10 << "')";
+    }
+    insert << ';';
+    auto insert_stmt = statement_from_string(diag, insert.str());
+    execute_statement(diag, *insert_stmt);
+    REQUIRE(diag.num_errors() == 0);
+
+    std::vector<int64_t> result;
+    auto make_consumer = [&result]() {
+        return std::make_unique<CallbackOperator>([&result](const Schema&, const Tuple &tup) {
+            result.push_back(tup[0].as_i());
+        });
+    };
+
+    SECTION("parameters in a conjunction")
+    {
+        auto stmt = prepare(diag, "SELECT a FROM T WHERE a < ? AND b = ?;", make_consumer());
+        REQUIRE(diag.num_errors() == 0);
+        REQUIRE(stmt->num_parameters() == 2);
+        CHECK(stmt->parameter(0).index() == 0);
+        CHECK(stmt->parameter(0).type() == Type::Get_Integer(Type::TY_Scalar, 8));
+        CHECK(stmt->parameter(1).type() == Type::Get_Char(Type::TY_Scalar, 8));
+
+        execute(diag, *stmt, 50, "s3");
+        CHECK(result == std::vector<int64_t>{ 3, 13, 23, 33, 43 });
+
+        /* Execute again with different parameter values. */
+        result.clear();
+        execute(diag, *stmt, 100, "s7");
+        CHECK(result.size() == 10);
+        for (auto a : result)
+            CHECK(a % 10 == 7);
+
+        result.clear();
+        execute(diag, *stmt, std::vector<PreparedStatement::parameter_type>{ int64_t(10), std::string("s0") });
+        CHECK(result == std::vector<int64_t>{ 0 });
+    }
+
+    SECTION("floating-point, date, and pattern parameters")
+    {
+        auto stmt = prepare(diag, "SELECT a FROM T WHERE c > ? AND d = ? AND b LIKE ?;", make_consumer());
+        REQUIRE(diag.num_errors() == 0);
+        REQUIRE(stmt->num_parameters() == 3);
+        CHECK(stmt->parameter(0).type() == Type::Get_Double(Type::TY_Scalar));
+        CHECK(stmt->parameter(1).type() == Type::Get_Date(Type::TY_Scalar));
+
+        execute(diag, *stmt, 20.0, "2000-01-02", "s%");
+        CHECK(result == std::vector<int64_t>{ 29, 57, 85 });
+
+        result.clear();
+        execute(diag, *stmt, 0, "2000-01-02", "%5");
+        CHECK(result == std::vector<int64_t>{ 85 });
+    }
+
+    SECTION("parameters in the select clause")
+    {
+        auto stmt = prepare(diag, "SELECT a + ? FROM T WHERE a = 42;", make_consumer());
+        REQUIRE(diag.num_errors() == 0);
+        execute(diag, *stmt, 1);
+        CHECK(result == std::vector<int64_t>{ 43 });
+        result.clear();
+        execute(diag, *stmt, -42);
+        CHECK(result == std::vector<int64_t>{ 0 });
+    }
+
+    SECTION("invalid bindings")
+    {
+        auto stmt = prepare(diag, "SELECT a FROM T WHERE a < ? AND b = ?;", make_consumer());
+        REQUIRE(diag.num_errors() == 0);
+        CHECK_THROWS_AS(execute(diag, *stmt, 50), invalid_argument); // too few values
+        CHECK_THROWS_AS(execute(diag, *stmt, "50", "s3"), invalid_argument); // string for integer
+        CHECK_THROWS_AS(execute(diag, *stmt, 50.5, "s3"), invalid_argument); // double for integer
+        CHECK_THROWS_AS(execute(diag, *stmt, 50, "too long string"), invalid_argument); // exceeds CHAR(8)
+        CHECK(diag.num_errors() != 0);
+    }
+
+    SECTION("parameters whose type cannot be inferred")
+    {
+        CHECK_THROWS_AS(prepare(diag, "SELECT ? FROM T;", make_consumer()), frontend_exception);
+        diag.clear();
+        CHECK_THROWS_AS(prepare(diag, "SELECT a FROM T WHERE ? = ?;", make_consumer()), frontend_exception);
+    }
+}
@@ -0,0 +1,197 @@
+#include "catch2/catch.hpp"
+
+#include "backend/FlatHashTable.hpp"
+#include <cstring>
+#include <map>
+#include <mutable/catalog/Type.hpp>
+#include <string>
+#include <utility>
+
+
+using namespace m;
+
+
+TEST_CASE("FlatHashTable", "[core][backend]")
+{
+    auto i8 = Type::Get_Integer(Type::TY_Vector, 8);
+    auto c5 = Type::Get_Char(Type::TY_Vector, 5);
+    auto d  = Type::Get_Double(Type::TY_Vector);
+
+    SECTION("c'tor")
+    {
+        FlatHashTable ht({ i8, c5 }, { d }, 10);
+        CHECK(ht.size() == 0);
+        CHECK(ht.num_keys() == 0);
+        CHECK(ht.capacity() >= 16);
+        CHECK(ht.row_size() % 8 == 0);
+        CHECK(ht.num_key_attrs() == 2);
+        CHECK(ht.num_payload_attrs() == 1);
+    }
+
+    SECTION("insert with duplicates")
+    {
+        FlatHashTable ht({ i8, c5 }, { d, i8 }, 4); // small capacity to force rehashing
+        Tuple key({ i8, c5 });
+        Tuple payload({ d, i8 });
+        std::map<std::pair<int64_t, std::string>, unsigned> expected;
+
+        auto set_key = [&](int64_t i, const std::string &str) {
+            key.set(0, i);
+            if (i == 3)
+                key.null(0); // some NULL keys
+            key.not_null(1);
+            strcpy(reinterpret_cast<char*>(key[1].as_p()), str.c_str());
+        };
+
+        for (int64_t n = 0; n != 5000; ++n) {
+            const int64_t i = (n * 7919) % 100;
+            const std::string str = std::to_string(n % 7);
+            set_key(i, str);
+            payload.set(0, double(n));
+            payload.set(1, n);
+            ht.insert_with_duplicates(key, payload);
+            ++expected[{ i, str }];
+        }
+
+        CHECK(ht.size() == 5000);
+        CHECK(ht.num_keys() == expected.size());
+
+        Tuple row({ i8, c5, d, i8 });
+        for (auto &[k, count] : expected) {
+            set_key(k.first, k.second);
+            unsigned found = 0;
+            ht.for_each_in_equal_range(key, [&](std::size_t idx) {
+                ht.load(idx, row);
+                REQUIRE(row.is_null(0) == (k.first == 3));
+                if (not row.is_null(0))
+                    REQUIRE(row[0].as_i() == k.first);
+                REQUIRE(std::string(reinterpret_cast<char*>(row[1].as_p())) == k.second);
+                REQUIRE(row[2].as_d() == double(row[3].as_i()));
+                ++found;
+            });
+            REQUIRE(found == count);
+        }
+
+        SECTION("missing key")
+        {
+            set_key(1000, "x");
+            unsigned found = 0;
+            ht.for_each_in_equal_range(key, [&](std::size_t) { ++found; });
+            CHECK(found == 0);
+        }
+
+        SECTION("clear")
+        {
+            ht.clear();
+            CHECK(ht.size() == 0);
+            CHECK(ht.num_keys() == 0);
+            set_key(1, "1");
+            unsigned found = 0;
+            ht.for_each_in_equal_range(key, [&](std::size_t) { ++found; });
+            CHECK(found == 0);
+        }
+    }
+
+    SECTION("find or insert")
+    {
+        FlatHashTable ht({ i8 }, { i8 }, 1);
+        Tuple group({ i8, i8 });
+
+        for (int64_t n = 0; n != 1000; ++n) {
+            group.set(0, n % 37);
+            auto [row, inserted] = ht.find_or_insert(group);
+            ht.load_payload(row, group, 1);
+            if (inserted) {
+                REQUIRE(group.is_null(1));
+                REQUIRE(ht.count(row) == 0);
+                group.set(1, int64_t(0));
+            }
+            group[1].as_i() += n;
+            ++ht.count(row);
+            ht.store_payload(row, group, 1);
+        }
+
+        CHECK(ht.num_keys() == 37);
+        CHECK(ht.size() == 37);
+
+        int64_t sum = 0;
+        unsigned count = 0;
+        for (std::size_t row = 0; row != ht.size(); ++row) {
+            ht.load(row, group);
+            sum += group[1].as_i();
+            count += ht.count(row);
+        }
+        CHECK(sum == 999 * 1000 / 2);
+        CHECK(count == 1000);
+    }
+
+    SECTION("negative zero")
+    {
+        auto f = Type::Get_Float(Type::TY_Vector);
+        FlatHashTable ht({ d, f }, { i8 }, 4);
+        Tuple group({ d, f, i8 });
+
+        group.set(0, 0.);
+        group.set(1, 0.f);
+        auto [row, inserted] = ht.find_or_insert(group);
+        CHECK(inserted);
+
+        group.set(0, -0.);
+        group.set(1, -0.f);
+        auto [row_neg, inserted_neg] = ht.find_or_insert(group);
+        CHECK_FALSE(inserted_neg);
+        CHECK(row_neg == row);
+        CHECK(ht.num_keys() == 1);
+    }
+
+    SECTION("more than 64 attributes")
+    {
+        /* Every `Tuple` holds at most 64 attributes, but keys and payloads together may exceed 64 attributes. */
+        constexpr std::size_t NUM_PAYLOAD_ATTRS = 64;
+        const std::vector<const Type*> payload_types(NUM_PAYLOAD_ATTRS, i8);
+        FlatHashTable ht({ i8, d }, payload_types, 4);
+        Tuple key({ i8, d });
+        Tuple payload(payload_types);
+
+        auto is_null = [](int64_t n, std::size_t i) { return (n + i) % 5 == 0; };
+        for (int64_t n = 0; n != 1000; ++n) {
+            key.set(0, n % 10);
+            if (n % 7 == 0)
+                key.null(0); // some NULL keys
+            key.set(1, double(n % 3));
+            for (std::size_t i = 0; i != NUM_PAYLOAD_ATTRS; ++i) {
+                if (is_null(n, i))
+                    payload.null(i);
+                else
+                    payload.set(i, n * 100 + int64_t(i));
+            }
+            ht.insert_with_duplicates(key, payload);
+        }
+        CHECK(ht.num_keys() == 33);
+
+        std::size_t num_mismatches = 0;
+        for (std::size_t row = 0; row != ht.size(); ++row) {
+            ht.load_payload(row, payload);
+            const int64_t n = row;
+            for (std::size_t i = 0; i != NUM_PAYLOAD_ATTRS; ++i) {
+                if (is_null(n, i))
+                    num_mismatches += not payload.is_null(i);
+                else
+                    num_mismatches += payload.is_null(i) or payload[i].as_i() != n * 100 + int64_t(i);
+            }
+        }
+        CHECK(num_mismatches == 0);
+
+        auto count_equal = [&ht](const Tuple &key) {
+            std::size_t count = 0;
+            ht.for_each_in_equal_range(key, [&count](std::size_t) { ++count; });
+            return count;
+        };
+        key.set(0, int64_t(1));
+        key.set(1, 1.);
+        CHECK(count_equal(key) == 29); // n = 1 (mod 30), but not 0 (mod 7)
+        key.null(0);
+        key.set(1, 0.);
+        CHECK(count_equal(key) == 48); // n = 0 (mod 21)
+    }
+}
@@ -1,5 +1,6 @@
 #include "catch2/catch.hpp"
 
+#include "backend/Interpreter.hpp"
 #include "storage/RowStore.hpp"
 #include "storage/ColumnStore.hpp"
 #include "storage/PaxStore.hpp"
@@ -1107,3 +1108,74 @@ TEST_CASE("PaxStore/access", "[core][backend]")
         REQUIRE(num_tuples == 30);
     }
 }
+
+/*======================================================================================================================
+ * CallbackOperator.
+ *====================================================================================================================*/
+
+TEST_CASE("CallbackOperator/batch", "[core][backend]")
+{
+    Catalog::Clear();
+    auto &C = Catalog::Get();
+    C.default_backend(C.pool("Interpreter"));
+
+    auto &DB = C.add_database(C.pool("test_db"));
+    auto &table = DB.add_table(C.pool("test"));
+    C.set_database_in_use(DB);
+
+    std::ostringstream out, err;
+    Diagnostic diag(false, out, err);
+    RowLayoutFactory factory;
+
+    table.push_back(C.pool("a"), Type::Get_Integer(Type::TY_Vector, 4));
+    table.push_back(C.pool("b"), Type::Get_Integer(Type::TY_Vector, 4));
+    table.store(std::make_unique<RowStore>(table));
+    table.layout(factory);
+
+    /* Insert more tuples than fit into a single batch of the `Interpreter`. */
+    constexpr int32_t NUM_TUPLES = 2500;
+    std::ostringstream insert;
+    insert << "INSERT INTO test VALUES ";
+    for (int32_t i = 0; i != NUM_TUPLES; ++i)
+        insert << (i ? ", " : "") << '(' << i << ", " << (i % 3 ? std::to_string(i) : "NULL") << ')';
+    insert << ';';
+    auto insertions = statement_from_string(diag, insert.str());
+    execute_statement(diag, *insertions);
+    REQUIRE(diag.num_errors() == 0);
+
+    auto stmt = statement_from_string(diag, "SELECT a, 42, b, a FROM test;");
+    REQUIRE(diag.num_errors() == 0);
+
+    std::size_t num_batches = 0;
+    int32_t num_tuples = 0;
+    auto callback = std::make_unique<CallbackOperator>([&](const Schema &S, const CallbackOperator::batch_type &B) {
+        ++num_batches;
+        REQUIRE(S.num_entries() == 4);
+        REQUIRE(B.schema.num_entries() == 2); // w/o constants and duplicates
+        REQUIRE(B.num_tuples > 0);
+        CHECK(B.constants.get(1).as_i() == 42);
+
+        /* Load the tuples of the batch from the given memory. */
+        Tuple tup(B.schema);
+        Tuple *args[] = { &tup };
+        auto loader = Interpreter::compile_load(B.schema, const_cast<void*>(B.data), B.layout, B.schema);
+        const auto a_idx = B.schema[Schema::Identifier(table.name(), C.pool("a"))].first;
+        const auto b_idx = B.schema[Schema::Identifier(table.name(), C.pool("b"))].first;
+        for (std::size_t i = 0; i != B.num_tuples; ++i, ++num_tuples) {
+            loader(args);
+            REQUIRE(tup.get(a_idx).as_i() == num_tuples);
+            if (num_tuples % 3)
+                REQUIRE(tup.get(b_idx).as_i() == num_tuples);
+            else
+                REQUIRE(tup.is_null(b_idx));
+            tup.clear();
+        }
+    });
+
+    std::unique_ptr<SelectStmt> select_stmt(static_cast<SelectStmt*>(stmt.release()));
+    execute_query(diag, *select_stmt, std::move(callback));
+    REQUIRE(diag.num_errors() == 0);
+    REQUIRE(err.str().empty());
+    CHECK(num_tuples == NUM_TUPLES);
+    CHECK(num_batches > 1);
+}
@@ -3486,3 +3486,114 @@ TEST_CASE("StackMachine/Intrinsic/Cast_d_f", "[core][backend]")
     REQUIRE(not res.is_null(0));
     REQUIRE(res[0] == d);
 }
+
+
+/*======================================================================================================================
+ * Test batch mode.
+ *====================================================================================================================*/
+
+TEST_CASE("StackMachine/Batch/is_batchable", "[core][backend]")
+{
+    StackMachine SM;
+
+    SECTION("arithmetic and tuple access")
+    {
+        SM.emit_Ld_Tup(1, 0);
+        SM.add_and_emit_load(int64_t(2));
+        SM.emit_Mul_i();
+        SM.emit_St_Tup_i(0, 0);
+        REQUIRE(SM.is_batchable());
+    }
+
+    SECTION("context update")
+    {
+        auto idx = SM.add_and_emit_load(int64_t(0));
+        SM.emit_Inc();
+        SM.emit_Upd_Ctx(idx);
+        REQUIRE_FALSE(SM.is_batchable());
+    }
+
+    SECTION("conditional stop")
+    {
+        SM.add_and_emit_load(true);
+        SM.emit_Stop_True();
+        REQUIRE_FALSE(SM.is_batchable());
+    }
+}
+
+TEST_CASE("StackMachine/Batch/Evaluate", "[core][backend]")
+{
+    constexpr std::size_t NUM_ROWS = 10;
+    std::array<Tuple, NUM_ROWS> in;
+    std::array<Tuple, NUM_ROWS> out;
+    for (std::size_t i = 0; i != NUM_ROWS; ++i) {
+        in[i] = Tuple({ Type::Get_Integer(Type::TY_Vector, 8), Type::Get_Boolean(Type::TY_Vector) });
+        out[i] = Tuple({ Type::Get_Integer(Type::TY_Vector, 8), Type::Get_Boolean(Type::TY_Vector) });
+        in[i].set(0, int64_t(i));
+        if (i % 3 == 0)
+            in[i].null(0);
+        in[i].set(1, i % 2 == 0);
+    }
+    Tuple *args[] = { out.data(), in.data() };
+
+    /* out.0 <- 2 * in.0 + 1 */
+    StackMachine SM;
+    SM.emit_Ld_Tup(1, 0);
+    SM.add_and_emit_load(int64_t(2));
+    SM.emit_Mul_i();
+    SM.add_and_emit_load(int64_t(1));
+    SM.emit_Add_i();
+    SM.emit_St_Tup_i(0, 0);
+    SM.emit_Pop();
+    /* out.1 <- in.1 AND in.0 > 4 */
+    SM.emit_Ld_Tup(1, 1);
+    SM.emit_Ld_Tup(1, 0);
+    SM.add_and_emit_load(int64_t(4));
+    SM.emit_GT_i();
+    SM.emit_And_b();
+    SM.emit_St_Tup_b(0, 1);
+    REQUIRE(SM.is_batchable());
+
+    SECTION("all rows")
+    {
+        uint8_t sel[NUM_ROWS];
+        for (std::size_t i = 0; i != NUM_ROWS; ++i) sel[i] = i;
+        SM(args, sel, NUM_ROWS);
+
+        for (std::size_t i = 0; i != NUM_ROWS; ++i) {
+            /* Compare with tuple-at-a-time evaluation. */
+            Tuple expected({ Type::Get_Integer(Type::TY_Vector, 8), Type::Get_Boolean(Type::TY_Vector) });
+            Tuple *row_args[] = { &expected, &in[i] };
+            SM(row_args);
+            REQUIRE(out[i].is_null(0) == expected.is_null(0));
+            REQUIRE(out[i].is_null(1) == expected.is_null(1));
+            if (not expected.is_null(0))
+                REQUIRE(out[i][0] == expected[0]);
+            if (not expected.is_null(1))
+                REQUIRE(out[i][1] == expected[1]);
+        }
+
+        /* Spot-check some rows. */
+        REQUIRE(out[3].is_null(0));
+        REQUIRE(not out[3].is_null(1)); // FALSE AND NULL is FALSE
+        REQUIRE_FALSE(out[3][1].as_b());
+        REQUIRE(out[5][0] == int64_t(11));
+        REQUIRE(out[8][0] == int64_t(17));
+        REQUIRE(out[8][1].as_b());
+        REQUIRE(out[6].is_null(1)); // TRUE AND NULL is NULL
+    }
+
+    SECTION("selected rows only")
+    {
+        for (auto &t : out) t.set(0, int64_t(-1));
+        uint8_t sel[] = { 1, 4, 7 };
+        SM(args, sel, 3);
+
+        for (std::size_t i = 0; i != NUM_ROWS; ++i) {
+            if (i == 1 or i == 4 or i == 7)
+                REQUIRE(out[i][0] == int64_t(2 * i + 1));
+            else
+                REQUIRE(out[i][0] == int64_t(-1)); // untouched
+        }
+    }
+}
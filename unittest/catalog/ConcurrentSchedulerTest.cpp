@@ -0,0 +1,171 @@
+#include "catch2/catch.hpp"
+
+#include "catalog/ConcurrentScheduler.hpp"
+#include "parse/Parser.hpp"
+#include "testutil.hpp"
+#include <mutable/catalog/Catalog.hpp>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+
+using namespace m;
+
+
+TEST_CASE("ConcurrentScheduler/get_table_accesses", "[core][catalog][scheduler]")
+{
+    auto table_accesses = [](const char *sql) -> std::optional<std::map<std::string, bool>> {
+        LEXER(sql);
+        ast::Parser parser(lexer);
+        auto cmd = parser.parse();
+        REQUIRE(diag.num_errors() == 0);
+        std::map<std::string, bool> tables;
+        if (ConcurrentScheduler::get_table_accesses(*cmd, tables))
+            return tables;
+        return std::nullopt;
+    };
+    using map = std::map<std::string, bool>;
+
+    SECTION("query")
+    {
+        CHECK(table_accesses("SELECT * FROM R, S AS T WHERE R.x = T.y;") == map{ {"R", false}, {"S", false} });
+    }
+
+    SECTION("nested queries")
+    {
+        CHECK(table_accesses("SELECT * FROM (SELECT x FROM R) AS Q WHERE Q.x < (SELECT MIN(y) FROM S);") ==
+              map{ {"R", false}, {"S", false} });
+    }
+
+    SECTION("writes")
+    {
+        CHECK(table_accesses("INSERT INTO R VALUES (1), (2);") == map{ {"R", true} });
+        CHECK(table_accesses("UPDATE R SET x = 1 WHERE x < (SELECT MIN(y) FROM S);") ==
+              map{ {"R", true}, {"S", false} });
+        CHECK(table_accesses("DELETE FROM R;") == map{ {"R", true} });
+    }
+
+    SECTION("catalog changes")
+    {
+        CHECK_FALSE(table_accesses("CREATE TABLE R (x INT(4));").has_value());
+        CHECK_FALSE(table_accesses("DROP TABLE R;").has_value());
+        CHECK_FALSE(table_accesses("CREATE DATABASE db;").has_value());
+    }
+}
+
+TEST_CASE("ConcurrentScheduler/concurrent clients", "[core][catalog][scheduler]")
+{
+    Catalog::Clear();
+    Catalog &C = Catalog::Get();
+    auto &DB = C.add_database(C.pool("db"));
+    C.set_database_in_use(DB);
+
+    constexpr std::size_t NUM_CLIENTS = 4;
+    constexpr std::size_t NUM_INSERTS = 16;
+
+    ConcurrentScheduler S;
+    S.num_threads(NUM_CLIENTS);
+
+    /* Every client runs `statements` one after another, each in its own transaction. */
+    auto run = [&S](std::string statements) {
+        std::ostringstream out, err;
+        Diagnostic diag(false, out, err);
+        std::istringstream in(statements);
+        ast::Lexer lexer(diag, Catalog::Get().get_pool(), "-", in);
+        ast::Parser parser(lexer);
+        bool success = true;
+        while (parser.token()) {
+            diag.clear();
+            success &= S.autocommit(parser.parse(), diag);
+        }
+        return success;
+    };
+
+    /* Create one table per client, concurrently. */
+    {
+        std::vector<std::thread> clients;
+        bool success[NUM_CLIENTS];
+        for (std::size_t i = 0; i != NUM_CLIENTS; ++i) {
+            clients.emplace_back([&, i]() {
+                success[i] = run("CREATE TABLE T" + std::to_string(i) + " (x INT(4));");
+            });
+        }
+        for (auto &client : clients) client.join();
+        for (std::size_t i = 0; i != NUM_CLIENTS; ++i)
+            CHECK(success[i]);
+    }
+
+    /* Insert into the tables concurrently.  Every client inserts into its own table and into the shared table `T0`. */
+    {
+        std::vector<std::thread> clients;
+        bool success[NUM_CLIENTS];
+        for (std::size_t i = 0; i != NUM_CLIENTS; ++i) {
+            clients.emplace_back([&, i]() {
+                std::string statements;
+                for (std::size_t j = 0; j != NUM_INSERTS; ++j) {
+                    statements += "INSERT INTO T" + std::to_string(i) + " VALUES (" + std::to_string(j) + ");";
+                    statements += "INSERT INTO T0 VALUES (" + std::to_string(j) + ");";
+                }
+                success[i] = run(statements);
+            });
+        }
+        for (auto &client : clients) client.join();
+        for (std::size_t i = 0; i != NUM_CLIENTS; ++i)
+            CHECK(success[i]);
+    }
+
+    CHECK(DB.get_table(C.pool("T0")).store().num_rows() == (NUM_CLIENTS + 1) * NUM_INSERTS);
+    for (std::size_t i = 1; i != NUM_CLIENTS; ++i)
+        CHECK(DB.get_table(C.pool(("T" + std::to_string(i)).c_str())).store().num_rows() == NUM_INSERTS);
+}
+
+TEST_CASE("ConcurrentScheduler/concurrent readers", "[core][catalog][scheduler]")
+{
+    Catalog::Clear();
+    Catalog &C = Catalog::Get();
+    auto &DB = C.add_database(C.pool("db"));
+    C.set_database_in_use(DB);
+
+    constexpr std::size_t NUM_CLIENTS = 4;
+    constexpr std::size_t NUM_ROWS = 1000;
+    constexpr std::size_t NUM_QUERIES = 16;
+
+    ConcurrentScheduler S;
+    S.num_threads(NUM_CLIENTS);
+
+    auto run = [&S](std::string statements) {
+        std::ostringstream out, err;
+        Diagnostic diag(false, out, err);
+        std::istringstream in(statements);
+        ast::Lexer lexer(diag, Catalog::Get().get_pool(), "-", in);
+        ast::Parser parser(lexer);
+        bool success = true;
+        while (parser.token()) {
+            diag.clear();
+            success &= S.autocommit(parser.parse(), diag);
+        }
+        return success;
+    };
+
+    std::string insert = "CREATE TABLE T (x INT(4)); INSERT INTO T VALUES (0)";
+    for (std::size_t i = 1; i != NUM_ROWS; ++i)
+        insert += ", (" + std::to_string(i) + ")";
+    REQUIRE(run(insert + ";"));
+
+    /* All clients scan the same table with a filter concurrently.  The first scans share creating the table's zone
+     * map.  The filter matches no row, s.t. nothing is printed. */
+    std::vector<std::thread> clients;
+    bool success[NUM_CLIENTS];
+    for (std::size_t i = 0; i != NUM_CLIENTS; ++i) {
+        clients.emplace_back([&, i]() {
+            std::string statements;
+            for (std::size_t j = 0; j != NUM_QUERIES; ++j)
+                statements += "SELECT x FROM T WHERE x < 0;";
+            success[i] = run(statements);
+        });
+    }
+    for (auto &client : clients) client.join();
+    for (std::size_t i = 0; i != NUM_CLIENTS; ++i)
+        CHECK(success[i]);
+    CHECK(DB.get_table(C.pool("T")).store().num_rows() == NUM_ROWS);
+}
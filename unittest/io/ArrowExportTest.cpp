@@ -0,0 +1,159 @@
+#include "catch2/catch.hpp"
+
+#include "backend/Interpreter.hpp"
+#include <cstring>
+#include <mutable/catalog/Catalog.hpp>
+#include <mutable/io/ArrowExport.hpp>
+#include <mutable/storage/DataLayoutFactory.hpp>
+#include <string>
+
+
+using namespace m;
+using namespace m::storage;
+
+
+namespace {
+
+bool is_valid(const ArrowArray *array, std::size_t i)
+{
+    if (not array->buffers[0]) return true;
+    return (static_cast<const uint8_t*>(array->buffers[0])[i / 8] >> (i % 8)) & 0x1U;
+}
+
+template<typename T>
+T value(const ArrowArray *array, std::size_t i) { return static_cast<const T*>(array->buffers[1])[i]; }
+
+std::string string(const ArrowArray *array, std::size_t i)
+{
+    auto offsets = static_cast<const int32_t*>(array->buffers[1]);
+    return std::string(static_cast<const char*>(array->buffers[2]) + offsets[i], offsets[i + 1] - offsets[i]);
+}
+
+}
+
+
+TEST_CASE("ArrowExportOperator", "[core][io]")
+{
+    Catalog::Clear();
+    auto &C = Catalog::Get();
+
+    auto i4 = Type::Get_Integer(Type::TY_Vector, 4);
+    auto c5 = Type::Get_Char(Type::TY_Vector, 5);
+    auto d  = Type::Get_Double(Type::TY_Vector);
+    auto date = Type::Get_Date(Type::TY_Vector);
+
+    const Schema::Identifier a(C.pool("a")), b(C.pool("b")), c(C.pool("c")), e(C.pool("e"));
+
+    /* The schema of the consumer, with duplicates and constants. */
+    Schema S;
+    S.add(a, i4);
+    S.add(Schema::Identifier::GetConstant(), i4);
+    S.add(c, d, Schema::entry_type::NOT_NULLABLE);
+    S.add(b, c5);
+    S.add(a, i4);
+    S.add(e, date);
+
+    /* The schema of the materialized attributes. */
+    Schema layout_schema = S.deduplicate().drop_constants();
+    REQUIRE(layout_schema.num_entries() == 4);
+
+    Tuple constants(S);
+    constants.set(1, int64_t(42));
+
+    /* Materialize the tuples. */
+    constexpr std::size_t NUM_TUPLES = 100;
+    auto materialize = [&](const DataLayout &layout, uint8_t *memory) {
+        Tuple tup(layout_schema);
+        Tuple *args[] = { &tup };
+        auto store = Interpreter::compile_store(layout_schema, memory, layout, layout_schema);
+        for (std::size_t i = 0; i != NUM_TUPLES; ++i) {
+            tup.clear();
+            if (i % 3) tup.set(layout_schema[a].first, int64_t(i)); else tup.null(layout_schema[a].first);
+            auto &str = tup[layout_schema[b].first];
+            strcpy(reinterpret_cast<char*>(str.as_p()), std::to_string(i).c_str());
+            tup.not_null(layout_schema[b].first);
+            tup.set(layout_schema[c].first, double(i) / 2);
+            tup.set(layout_schema[e].first, int64_t(2000 << 9 | 1 << 5 | 1)); // 2000-01-01
+            store(args);
+        }
+    };
+
+    auto check = [&](const DataLayoutFactory &factory, std::size_t expected_num_batches, bool expect_hand_off) {
+        auto layout = factory.make(layout_schema, NUM_TUPLES);
+        const std::size_t num_blocks = (NUM_TUPLES + layout.child().num_tuples() - 1) / layout.child().num_tuples();
+        const std::size_t num_bytes = num_blocks * layout.stride_in_bits() / 8;
+        auto memory = std::make_unique<uint8_t[]>(num_bytes);
+        materialize(layout, memory.get());
+
+        std::size_t num_batches = 0;
+        std::size_t num_tuples = 0;
+        CallbackOperator::batch_type batch{ layout_schema, layout, memory.get(), NUM_TUPLES, constants };
+        ArrowExportOperator::export_batch(S, batch, [&](ArrowSchema *schema, ArrowArray *array) {
+            ++num_batches;
+            REQUIRE(std::string(schema->format) == "+s");
+            REQUIRE(schema->n_children == 6);
+            CHECK(std::string(schema->children[0]->format) == "i");
+            CHECK(std::string(schema->children[0]->name) == "a");
+            CHECK(std::string(schema->children[2]->format) == "g");
+            CHECK(schema->children[2]->flags == 0);
+            CHECK(std::string(schema->children[3]->format) == "u");
+            CHECK(std::string(schema->children[5]->format) == "tdD");
+
+            REQUIRE(array->n_children == 6);
+            for (int64_t i = 0; i != array->length; ++i, ++num_tuples) {
+                const auto A = array->children[0], K = array->children[1], D = array->children[2],
+                           B = array->children[3], A2 = array->children[4], E = array->children[5];
+                if (num_tuples % 3) {
+                    REQUIRE(is_valid(A, i));
+                    REQUIRE(value<int32_t>(A, i) == int32_t(num_tuples));
+                    REQUIRE(value<int32_t>(A2, i) == int32_t(num_tuples));
+                } else {
+                    REQUIRE_FALSE(is_valid(A, i));
+                    REQUIRE_FALSE(is_valid(A2, i));
+                }
+                REQUIRE(value<int32_t>(K, i) == 42);
+                REQUIRE(value<double>(D, i) == double(num_tuples) / 2);
+                REQUIRE(string(B, i) == std::to_string(num_tuples));
+                REQUIRE(value<int32_t>(E, i) == 10957);
+            }
+            CHECK(array->children[1]->null_count == 0);
+            CHECK(array->children[2]->buffers[0] == nullptr); // not nullable
+
+            /* Check whether the doubles are handed off rather than copied. */
+            auto doubles = static_cast<const uint8_t*>(array->children[2]->buffers[1]);
+            const bool handed_off = doubles >= memory.get() and doubles < memory.get() + num_bytes;
+            CHECK(handed_off == expect_hand_off);
+        });
+        CHECK(num_batches == expected_num_batches);
+        CHECK(num_tuples == NUM_TUPLES);
+    };
+
+    SECTION("row layout")
+    {
+        check(RowLayoutFactory(), 1, false);
+    }
+
+    SECTION("PAX layout")
+    {
+        check(PAXLayoutFactory(PAXLayoutFactory::NTuples, 16), (NUM_TUPLES + 15) / 16, true);
+    }
+
+    SECTION("only constants")
+    {
+        Schema S_const;
+        S_const.add(Schema::Identifier::GetConstant(), i4);
+        Schema empty;
+        Tuple constants(S_const);
+        constants.set(0, int64_t(7));
+        const DataLayout empty_layout;
+        CallbackOperator::batch_type batch{ empty, empty_layout, nullptr, 5, constants };
+        std::size_t num_batches = 0;
+        ArrowExportOperator::export_batch(S_const, batch, [&](ArrowSchema*, ArrowArray *array) {
+            ++num_batches;
+            REQUIRE(array->length == 5);
+            for (std::size_t i = 0; i != 5; ++i)
+                CHECK(value<int32_t>(array->children[0], i) == 7);
+        });
+        CHECK(num_batches == 1);
+    }
+}
@@ -3,6 +3,8 @@
 #include "backend/Interpreter.hpp"
 #include "storage/PaxStore.hpp"
 #include "storage/RowStore.hpp"
+#include <filesystem>
+#include <fstream>
 #include <mutable/io/Reader.hpp>
 #include <mutable/storage/Store.hpp>
 
@@ -856,3 +858,126 @@ TEST_CASE("DSVReader::operator() sanity tests", "[core][io][unit]")
         REQUIRE(tup.is_null(2));
     }
 }
+
+TEST_CASE("DSVReader::read_memory", "[core][io][unit]")
+{
+    DSVReader::Config cfg;
+    cfg.has_header = true;
+    cfg.chunk_size = 64; // many small chunks
+    cfg.num_threads = 4;
+
+    /* Construct the input, with quoted strings containing newlines and delimiters, and with malformed rows. */
+    std::ostringstream oss;
+    std::size_t num_valid_rows = 0;
+    oss << "i2,i4,f,char15\n";
+    for (unsigned i = 0; i != 2000; ++i) {
+        const bool is_quoted = i % 3 == 0;
+        const bool misses_delimiter = not is_quoted and i % 97 == 1;
+        const bool has_additional_column = i % 101 == 0;
+        num_valid_rows += not misses_delimiter and not has_additional_column;
+
+        oss << i % 1000 << ',' << 7 * i;
+        if (not misses_delimiter) oss << ',';
+        oss << i / 4.f << ',';
+        if (is_quoted)
+            oss << "\"s" << i << "\n,\\\"\"";
+        else
+            oss << 's' << i;
+        if (has_additional_column) oss << ",42";
+        oss << '\n';
+    }
+    oss << "1,2,3,no newline";
+    ++num_valid_rows;
+    std::string input = oss.str();
+
+    /* Reads the input either as a stream or from memory and returns the rows, the messages, and the number of
+     * errors. */
+    auto load = [&](bool is_pax, bool from_memory) {
+        auto &table = create_table();
+        if (is_pax) {
+            table.store(std::make_unique<PaxStore>(table));
+            PAXLayoutFactory factory(PAXLayoutFactory::NTuples, 37);
+            table.layout(factory);
+        }
+        std::ostringstream out, err;
+        Diagnostic diag(false, out, err);
+        DSVReader R(table, cfg, diag);
+        if (from_memory) {
+            R.read_memory(input.data(), input.size(), "input");
+        } else {
+            std::istringstream in(input);
+            R(in, "input");
+        }
+
+        Schema S = table.schema();
+        Tuple tup(S);
+        auto L = Interpreter::compile_load(S, table.store().memory().addr(), table.layout(), S);
+        std::vector<std::string> rows;
+        for (std::size_t i = 0; i != table.store().num_rows(); ++i) {
+            Tuple *args[] = { &tup };
+            L(args);
+            std::ostringstream row;
+            tup.print(row, S);
+            rows.push_back(row.str());
+        }
+        return std::make_tuple(rows, err.str(), diag.num_errors());
+    };
+
+    SECTION("row and PAX layout")
+    {
+        for (bool is_pax : { false, true }) {
+            auto [expected_rows, expected_err, expected_num_errors] = load(is_pax, false);
+            auto [rows, err, num_errors] = load(is_pax, true);
+            CHECK(expected_rows.size() == num_valid_rows); // malformed rows are dropped
+            CHECK(rows == expected_rows);
+            CHECK(err == expected_err);
+            CHECK(num_errors == expected_num_errors);
+        }
+    }
+
+    SECTION("limit number of rows")
+    {
+        cfg.num_rows = 500;
+        auto [expected_rows, expected_err, expected_num_errors] = load(false, false);
+        auto [rows, err, num_errors] = load(false, true);
+        CHECK(rows.size() < 500);
+        CHECK(rows == expected_rows);
+        CHECK(err == expected_err);
+    }
+
+    SECTION("malformed quoting")
+    {
+        /* Unlike the search for row boundaries, the parser does not consider a quote within an unquoted cell as the
+         * beginning of a quoted string.  The input must nonetheless be read as if read sequentially. */
+        input.insert(input.find("\n500,"), "\n5,6,7.5,ab\"c");
+        auto [expected_rows, expected_err, expected_num_errors] = load(false, false);
+        auto [rows, err, num_errors] = load(false, true);
+        CHECK(rows == expected_rows);
+        CHECK(err == expected_err);
+        CHECK(num_errors == expected_num_errors);
+    }
+}
+
+TEST_CASE("DSVReader::read_file", "[core][io][unit]")
+{
+    auto &table = create_table();
+    std::ostringstream out, err;
+    Diagnostic diag(false, out, err);
+    DSVReader R(table, DSVReader::Config(), diag);
+
+    const auto path = std::filesystem::temp_directory_path() / "mutable_DSVReader_read_file.csv";
+    {
+        std::ofstream file(path);
+        file << "1,2,3.5,abc\n4,5,6.5,\"d,e\"\n";
+    }
+    REQUIRE(R.read_file(path));
+    std::filesystem::remove(path);
+
+    CHECK(diag.num_errors() == 0);
+    REQUIRE(table.store().num_rows() == 2);
+    test_table_imports(table, { { 1, 2, 3.5, "abc" }, { 4, 5, 6.5, "d,e" } });
+
+    errno = 0;
+    CHECK_FALSE(R.read_file(path));
+    CHECK(errno == ENOENT);
+}
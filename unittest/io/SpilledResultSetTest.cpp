@@ -0,0 +1,84 @@
+#include "catch2/catch.hpp"
+
+#include "backend/Interpreter.hpp"
+#include "storage/RowStore.hpp"
+#include <mutable/catalog/Catalog.hpp>
+#include <mutable/io/SpilledResultSet.hpp>
+#include <mutable/mutable.hpp>
+#include <mutable/storage/DataLayoutFactory.hpp>
+
+
+using namespace m;
+using namespace m::ast;
+using namespace m::storage;
+
+
+TEST_CASE("SpilledResultSet", "[core][io]")
+{
+    Catalog::Clear();
+    auto &C = Catalog::Get();
+    C.default_backend(C.pool("Interpreter"));
+
+    auto &DB = C.add_database(C.pool("spill_db"));
+    auto &table = DB.add_table(C.pool("test"));
+    C.set_database_in_use(DB);
+
+    std::ostringstream out, err;
+    Diagnostic diag(false, out, err);
+    RowLayoutFactory factory;
+
+    table.push_back(C.pool("a"), Type::Get_Integer(Type::TY_Vector, 4));
+    table.push_back(C.pool("b"), Type::Get_Integer(Type::TY_Vector, 4));
+    table.store(std::make_unique<RowStore>(table));
+    table.layout(factory);
+
+    /* Insert more tuples than fit into a single batch of the `Interpreter`. */
+    constexpr int32_t NUM_TUPLES = 2500;
+    std::ostringstream insert;
+    insert << "INSERT INTO test VALUES ";
+    for (int32_t i = 0; i != NUM_TUPLES; ++i)
+        insert << (i ? ", " : "") << '(' << i << ", " << (i % 3 ? std::to_string(i) : "NULL") << ')';
+    insert << ';';
+    execute_statement(diag, *statement_from_string(diag, insert.str()));
+    REQUIRE(diag.num_errors() == 0);
+
+    /* Spill the result set. */
+    SpilledResultSet spill;
+    CHECK(spill.num_tuples() == 0);
+    auto stmt = statement_from_string(diag, "SELECT a, 42, b, a FROM test;");
+    REQUIRE(diag.num_errors() == 0);
+    std::unique_ptr<SelectStmt> select_stmt(static_cast<SelectStmt*>(stmt.release()));
+    execute_query(diag, *select_stmt, std::make_unique<CallbackOperator>(spill.batch_callback()));
+    REQUIRE(diag.num_errors() == 0);
+    REQUIRE(err.str().empty());
+    CHECK(spill.num_tuples() == NUM_TUPLES);
+    CHECK(spill.num_batches() > 1);
+    CHECK(spill.size_in_bytes() > 0);
+
+    /* Map the spilled batches back and check their tuples. */
+    std::size_t num_batches = 0;
+    int32_t num_tuples = 0;
+    spill.for_each_batch([&](const Schema &S, const CallbackOperator::batch_type &B) {
+        ++num_batches;
+        REQUIRE(S.num_entries() == 4);
+        REQUIRE(B.schema.num_entries() == 2); // w/o constants and duplicates
+        CHECK(B.constants.get(1).as_i() == 42);
+
+        Tuple tup(B.schema);
+        Tuple *args[] = { &tup };
+        auto loader = Interpreter::compile_load(B.schema, const_cast<void*>(B.data), B.layout, B.schema);
+        const auto a_idx = B.schema[Schema::Identifier(table.name(), C.pool("a"))].first;
+        const auto b_idx = B.schema[Schema::Identifier(table.name(), C.pool("b"))].first;
+        for (std::size_t i = 0; i != B.num_tuples; ++i, ++num_tuples) {
+            loader(args);
+            REQUIRE(tup.get(a_idx).as_i() == num_tuples);
+            if (num_tuples % 3)
+                REQUIRE(tup.get(b_idx).as_i() == num_tuples);
+            else
+                REQUIRE(tup.is_null(b_idx));
+            tup.clear();
+        }
+    });
+    CHECK(num_batches == spill.num_batches());
+    CHECK(num_tuples == NUM_TUPLES);
+}
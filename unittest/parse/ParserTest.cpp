@@ -272,6 +272,19 @@ TEST_CASE("Parser::parse_Expr()", "[core][parse][unit]")
             test_parse_positive<ast::Constant, ast::Expr>(triple, parse);
     }
 
+    SECTION("Parameter")
+    {
+        test_triple_t triples[] = {
+            /* { expression , fully-parenthesized-expression, next token } */
+
+            { "?", "?1", TK_EOF },
+            { "(?)", "?1", TK_EOF },
+        };
+
+        for (auto triple : triples)
+            test_parse_positive<ast::Parameter, ast::Expr>(triple, parse);
+    }
+
     SECTION("FnApllicationExpr")
     {
         test_triple_t triples[] = {
@@ -323,6 +336,7 @@ TEST_CASE("Parser::parse_Expr()", "[core][parse][unit]")
             { "a*b*c", "((a * b) * c)", TK_EOF },
             { "a*(b*c)", "(a * (b * c))", TK_EOF },
             { "-a*+b", "((-a) * (+b))", TK_EOF },
+            { "?*b+?", "((?1 * b) + ?2)", TK_EOF },
             /* additive expression */
             { "a+b", "(a + b)", TK_EOF },
             { "a-b", "(a - b)", TK_EOF },
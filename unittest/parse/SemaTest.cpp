@@ -1569,6 +1569,47 @@ TEST_CASE("Sema/Clauses/Where", "[core][parse][sema]")
         REQUIRE(not err.str().empty());
     }
 
+    SECTION("WHERE condition with parameter")
+    {
+        LEXER("SELECT * FROM mytable WHERE v > ?;");
+        Parser parser(lexer);
+        auto stmt = as<SelectStmt>(parser.parse());
+        REQUIRE(diag.num_errors() == 0);
+        REQUIRE(parser.parameters().size() == 1);
+        Sema sema(diag, /* allow_parameters= */ true);
+        sema(*stmt);
+
+        REQUIRE(diag.num_errors() == 0);
+        REQUIRE(err.str().empty());
+        CHECK(parser.parameters()[0]->type() == Type::Get_Integer(Type::TY_Scalar, 8));
+    }
+
+    SECTION("WHERE condition with parameter outside of prepared statement")
+    {
+        LEXER("SELECT * FROM mytable WHERE v > ?;");
+        Parser parser(lexer);
+        auto stmt = as<SelectStmt>(parser.parse());
+        REQUIRE(diag.num_errors() == 0);
+        Sema sema(diag);
+        sema(*stmt);
+
+        REQUIRE(diag.num_errors() == 1);
+        REQUIRE(not err.str().empty());
+    }
+
+    SECTION("WHERE condition compares parameters")
+    {
+        LEXER("SELECT * FROM mytable WHERE ? = ?;");
+        Parser parser(lexer);
+        auto stmt = as<SelectStmt>(parser.parse());
+        REQUIRE(diag.num_errors() == 0);
+        Sema sema(diag, /* allow_parameters= */ true);
+        sema(*stmt);
+
+        REQUIRE(diag.num_errors() == 1);
+        REQUIRE(not err.str().empty());
+    }
+
 }
 
 TEST_CASE("Sema/Clauses/GroupBy", "[core][parse][sema]")
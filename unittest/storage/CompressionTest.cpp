@@ -0,0 +1,143 @@
+#include "catch2/catch.hpp"
+
+#include "testutil.hpp"
+#include <filesystem>
+#include <map>
+#include <mutable/mutable.hpp>
+#include <sstream>
+#include <string>
+#include <vector>
+
+
+using namespace m;
+using namespace m::storage;
+
+
+namespace {
+
+/** Returns the encoding of every leaf of \p layout by the leaf's index. */
+std::map<std::size_t, DataLayout::encoding_t> encodings(const DataLayout &layout)
+{
+    std::map<std::size_t, DataLayout::encoding_t> result;
+    layout.for_sibling_leaves([&](const std::vector<DataLayout::leaf_info_t> &leaves,
+                                  const DataLayout::level_info_stack_t&, uint64_t)
+    {
+        for (auto &leaf_info : leaves)
+            result.emplace(leaf_info.leaf.index(), leaf_info.leaf.encoding());
+    });
+    return result;
+}
+
+/** Returns the number of bits occupied by a single row laid out by \p layout. */
+double bits_per_row(const DataLayout &layout) { return double(layout.stride_in_bits()) / layout.child().num_tuples(); }
+
+}
+
+TEST_CASE("Compression", "[core][storage][compression]")
+{
+    Catalog &C = Catalog::Get();
+    const auto old_data_layout = C.default_data_layout_name();
+    auto data_layout = GENERATE(Catch::Generators::as<const char*>{}, "Row", "PAX4K", "PAX16Tup");
+    Catalog::Clear();
+    C.default_data_layout(C.pool(data_layout));
+    auto &DB = C.add_database(C.pool("compressdb"));
+    C.set_database_in_use(DB);
+
+    std::ostringstream out, err;
+    Diagnostic diag(false, out, err);
+
+    /* Create and fill the table. */
+    execute_statement(diag, *statement_from_string(diag,
+        "CREATE TABLE R (id INT(4), big INT(8) NOT NULL, name CHAR(10), day DATE, price DECIMAL(10, 2), "
+        "val DOUBLE, flag BOOL);"));
+    constexpr unsigned NUM_ROWS = 3000;
+    std::ostringstream insert;
+    insert << "INSERT INTO R VALUES ";
+    for (unsigned i = 0; i != NUM_ROWS; ++i) {
+        if (i) insert << ", ";
+        insert << '(' << i << ", " << 1000000000000LL - i * 7 << ", "
+               << (i % 7 ? "\"n" + std::to_string(i % 100) + '"' : "NULL") << ", d'2000-01-"
+               << (i % 28 + 1) / 10 << (i % 28 + 1) % 10 << "', " << i % 500 << '.' << i % 100 << ", "
+               << i << ".5, " << (i % 3 ? "TRUE" : "FALSE") << ')';
+    }
+    insert << ';';
+    execute_statement(diag, *statement_from_string(diag, insert.str()));
+    REQUIRE(diag.num_errors() == 0);
+
+    auto &R = DB.get_table(C.pool("R"));
+    const auto expected = testutil::query(diag, "SELECT * FROM R;");
+    const auto expected_filtered =
+        testutil::query(diag, "SELECT id, day FROM R WHERE name = \"n42\" AND big < 999999990000;");
+    const auto expected_aggregate = testutil::query(diag, "SELECT name, COUNT(*), MIN(price) FROM R GROUP BY name;");
+    REQUIRE(expected.size() == NUM_ROWS);
+    REQUIRE(not expected_filtered.empty());
+    const double bits_per_row_uncompressed = bits_per_row(R.layout());
+
+    REQUIRE(compress_table(R));
+    REQUIRE(R.layout().is_encoded());
+    CHECK(R.store().num_rows() == NUM_ROWS);
+
+    SECTION("encodings")
+    {
+        auto encs = encodings(R.layout());
+        CHECK(encs[0].kind == DataLayout::encoding_t::E_FrameOfReference); // id
+        CHECK(encs[0].stored_type->size() == 16);
+        CHECK(encs[0].reference == 0);
+        CHECK(encs[1].kind == DataLayout::encoding_t::E_FrameOfReference); // big
+        CHECK(encs[1].stored_type->size() == 16);
+        CHECK(encs[1].reference == 1000000000000LL - (NUM_ROWS - 1) * 7);
+        CHECK(encs[2].kind == DataLayout::encoding_t::E_Dictionary); // name
+        CHECK(encs[2].stored_type->size() == 8);
+        CHECK(encs[2].num_entries() == 100);
+        CHECK(encs[3].kind == DataLayout::encoding_t::E_FrameOfReference); // day
+        CHECK(encs[3].stored_type->size() == 8);
+        CHECK(encs[4].kind == DataLayout::encoding_t::E_FrameOfReference); // price
+        CHECK(encs[5].kind == DataLayout::encoding_t::E_None); // val
+        CHECK(encs[6].kind == DataLayout::encoding_t::E_None); // flag
+        CHECK(bits_per_row(R.layout()) <= bits_per_row_uncompressed / 2);
+
+        /* An already compressed table is not compressed again. */
+        CHECK_FALSE(compress_table(R));
+    }
+
+    SECTION("scans decode values")
+    {
+        CHECK(testutil::query(diag, "SELECT * FROM R;") == expected);
+        CHECK(testutil::query(diag, "SELECT id, day FROM R WHERE name = \"n42\" AND big < 999999990000;") ==
+              expected_filtered);
+        CHECK(testutil::query(diag, "SELECT name, COUNT(*), MIN(price) FROM R GROUP BY name;") == expected_aggregate);
+        CHECK(diag.num_errors() == 0);
+    }
+
+    SECTION("appending decompresses")
+    {
+        execute_statement(diag, *statement_from_string(diag,
+            "INSERT INTO R VALUES (-5, 1, \"new\", d'1970-01-01', 1.25, 0.5, TRUE);"));
+        REQUIRE(diag.num_errors() == 0);
+        CHECK_FALSE(R.layout().is_encoded());
+        CHECK(bits_per_row(R.layout()) == bits_per_row_uncompressed);
+        auto result = testutil::query(diag, "SELECT * FROM R;");
+        REQUIRE(result.size() == NUM_ROWS + 1);
+        CHECK(std::equal(expected.begin(), expected.end(), result.begin()));
+        CHECK(testutil::query(diag, "SELECT id FROM R WHERE name = \"new\" AND big = 1;").size() == 1);
+    }
+
+    SECTION("snapshot")
+    {
+        const auto path = std::filesystem::temp_directory_path() / "mutable_CompressionTest.snapshot";
+        write_snapshot(DB, path);
+        C.unset_database_in_use();
+        C.drop_database(DB);
+
+        auto &restored = read_snapshot(path);
+        C.set_database_in_use(restored);
+        auto &restored_R = restored.get_table(C.pool("R"));
+        CHECK(restored_R.layout().is_encoded());
+        CHECK(encodings(restored_R.layout())[2].num_entries() == 100);
+        CHECK(testutil::query(diag, "SELECT * FROM R;") == expected);
+        std::filesystem::remove(path);
+    }
+
+    C.unset_database_in_use();
+    C.default_data_layout(old_data_layout);
+}
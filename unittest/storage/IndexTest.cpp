@@ -1,5 +1,6 @@
 #include "catch2/catch.hpp"
 
+#include <algorithm>
 #include <mutable/catalog/Catalog.hpp>
 #include <mutable/mutable.hpp>
 #include <mutable/storage/Index.hpp>
@@ -119,3 +120,396 @@ TEMPLATE_TEST_CASE("ArrayIndex::bulkload() with Numeric types", "[core][storage]
     /* Index should not contain NULL. */
     REQUIRE(idx.num_entries() == keys.size());
 }
+
+TEMPLATE_TEST_CASE("RecursiveModelIndex batched lookups", "[core][storage][index]",
+                    int8_t, int16_t, int32_t, int64_t, float, double)
+{
+    using index_type = RecursiveModelIndex<TestType>;
+    using entry_type = typename index_type::entry_type;
+    using const_iterator = typename index_type::const_iterator;
+
+    /* Create empty index. */
+    index_type idx;
+    const TestType key = 13;
+    const_iterator result;
+    REQUIRE_THROWS(idx.lower_bound_batch(&key, 1, &result));
+    REQUIRE_THROWS(idx.upper_bound_batch(&key, 1, &result));
+    idx.finalize();
+    idx.lower_bound_batch(&key, 1, &result);
+    REQUIRE(result == idx.begin());
+
+    /* Add skewed keys with duplicates. */
+    for (std::size_t i = 0; i != 1000; ++i)
+        idx.add(TestType(int((i * i) % 97) - 48), i);
+    idx.finalize();
+
+    /* Probe keys inside and outside the range of keys.  The number of probes is not a multiple of the batch size. */
+    std::vector<TestType> probes;
+    for (int i = -100; i <= 100; i += 3)
+        probes.push_back(TestType(i));
+    REQUIRE(probes.size() % index_type::BATCH_SIZE != 0);
+
+    /* Results must equal those of binary search. */
+    auto less = [](const entry_type &e, const TestType k) { return e.first < k; };
+    auto greater = [](const TestType k, const entry_type &e) { return k < e.first; };
+    std::vector<const_iterator> lower(probes.size()), upper(probes.size());
+    idx.lower_bound_batch(probes.data(), probes.size(), lower.data());
+    idx.upper_bound_batch(probes.data(), probes.size(), upper.data());
+    for (std::size_t i = 0; i != probes.size(); ++i) {
+        REQUIRE(lower[i] == std::lower_bound(idx.begin(), idx.end(), probes[i], less));
+        REQUIRE(upper[i] == std::upper_bound(idx.begin(), idx.end(), probes[i], greater));
+    }
+}
+
+TEMPLATE_TEST_CASE("BPlusTreeIndex::add()", "[core][storage][index]",
+                    int8_t, int16_t, int32_t, int64_t, float, double)
+{
+    using index_type = BPlusTreeIndex<TestType>;
+    static_assert(index_type::VALUES_OFFSET + index_type::LEAF_CAPACITY * sizeof(uint32_t) <= index_type::NODE_SIZE);
+    static_assert(index_type::CHILDREN_OFFSET + (index_type::INNER_CAPACITY + 1) * sizeof(uint32_t) <=
+                  index_type::NODE_SIZE);
+
+    /* Create empty index. */
+    index_type idx;
+    REQUIRE(idx.num_entries() == 0);
+    REQUIRE(idx.height() == 1);
+    REQUIRE(idx.begin() == idx.end());
+    REQUIRE(idx.lower_bound(0) == idx.end());
+
+    /* Add keys in scrambled order, each key twice, s.t. nodes are split on all levels. */
+    constexpr std::size_t NUM_KEYS = 100;
+    std::vector<std::pair<TestType, std::size_t>> entries;
+    for (std::size_t i = 0; i != 2 * NUM_KEYS; ++i) {
+        const TestType key = TestType(int((i * 37) % NUM_KEYS) - 50);
+        idx.add(key, i);
+        entries.emplace_back(key, i);
+    }
+    REQUIRE(idx.num_entries() == entries.size());
+    REQUIRE(idx.height() > 2);
+    REQUIRE(idx.exposed_memory_size() == idx.num_nodes() * index_type::NODE_SIZE);
+
+    /* Entries are iterated in ascending order of their keys and equal keys in the order they were added. */
+    std::stable_sort(entries.begin(), entries.end(), [](auto &lhs, auto &rhs) { return lhs.first < rhs.first; });
+    auto expected = entries.begin();
+    for (auto it = idx.begin(); it != idx.end(); ++it, ++expected) {
+        REQUIRE(expected != entries.end());
+        REQUIRE(it->first == expected->first);
+        REQUIRE(it->second == expected->second);
+    }
+    REQUIRE(expected == entries.end());
+
+    /* Check bounds. */
+    auto lo = idx.lower_bound(TestType(-10));
+    REQUIRE(lo != idx.end());
+    REQUIRE(lo->first == TestType(-10));
+    REQUIRE(std::distance(idx.begin(), lo) == 2 * 40);
+    auto hi = idx.upper_bound(TestType(-10));
+    REQUIRE(hi->first == TestType(-9));
+    REQUIRE(std::distance(lo, hi) == 2);
+    REQUIRE(idx.lower_bound(TestType(-100)) == idx.begin());
+    REQUIRE(idx.upper_bound(TestType(49)) == idx.end());
+    REQUIRE(idx.lower_bound(TestType(50)) == idx.end());
+}
+
+TEMPLATE_TEST_CASE("BPlusTreeIndex::bulkload() with Numeric types", "[core][storage][index]",
+                    int8_t, int16_t, int32_t, int64_t, float, double)
+{
+    Catalog::Clear();
+    Diagnostic diag(false, std::cout, std::cerr);
+
+    /* Create and use a DB. */
+    Catalog &C = Catalog::Get();
+    ThreadSafePooledString db_name = C.pool("db");
+    auto &DB = C.add_database(db_name);
+    C.set_database_in_use(DB);
+    auto &table = DB.add_table(C.pool("t"));
+
+    /* Create a table with a single attribute. */
+    table.push_back(C.pool("val"), []() {
+        if constexpr(integral<TestType>)
+            return Type::Get_Integer(Type::TY_Vector, sizeof(TestType));
+        else if constexpr(std::same_as<TestType, float>)
+            return Type::Get_Float(Type::TY_Vector);
+        else // double
+            return Type::Get_Double(Type::TY_Vector);
+    }());
+    table.layout(C.data_layout());
+    table.store(C.create_store(table));
+
+    /* Build and execute insert statement with `NUM_KEYS` distinct keys in descending order and `NULL`. */
+    constexpr int NUM_KEYS = 100;
+    std::ostringstream oss;
+    oss << "INSERT INTO t VALUES ";
+    for (int i = 0; i != NUM_KEYS; ++i)
+        oss << "(" << NUM_KEYS - 1 - i << "), ";
+    oss << " (NULL);";
+    auto insert_stmt = statement_from_string(diag, oss.str());
+    execute_statement(diag, *insert_stmt);
+
+    /* Bulkload index from table. */
+    BPlusTreeIndex<TestType> idx;
+    idx.bulkload(table, table.schema());
+    REQUIRE(idx.num_entries() == NUM_KEYS); // index should not contain NULL
+    REQUIRE(idx.height() > 1);
+
+    /* Check contents of index. */
+    for (int i = 0; i != NUM_KEYS; ++i) {
+        auto it = idx.lower_bound(TestType(i));
+        REQUIRE(it != idx.end());
+        REQUIRE(it->first == TestType(i));
+        REQUIRE(it->second == std::size_t(NUM_KEYS - 1 - i));
+    }
+
+    /* Entries can be added after bulkloading. */
+    idx.add(TestType(-1), NUM_KEYS + 1);
+    idx.add(TestType(50), NUM_KEYS + 2);
+    REQUIRE(idx.num_entries() == NUM_KEYS + 2);
+    REQUIRE(idx.begin()->second == NUM_KEYS + 1);
+    auto it = idx.lower_bound(TestType(50));
+    REQUIRE((it++)->second == std::size_t(NUM_KEYS - 1 - 50));
+    REQUIRE(it->second == NUM_KEYS + 2);
+    REQUIRE(std::is_sorted(idx.begin(), idx.end(), [](auto &lhs, auto &rhs) { return lhs.first < rhs.first; }));
+}
+
+TEMPLATE_TEST_CASE("HashIndex::add()", "[core][storage][index]",
+                    int8_t, int16_t, int32_t, int64_t, float, double)
+{
+    using index_type = HashIndex<TestType>;
+
+    /* Create empty index. */
+    index_type idx;
+    REQUIRE(idx.num_entries() == 0);
+    REQUIRE(idx.capacity() == index_type::INITIAL_CAPACITY);
+    REQUIRE(idx.count(0) == 0);
+
+    /* Add keys in scrambled order, each key twice, s.t. the index grows several times. */
+    constexpr std::size_t NUM_KEYS = 100;
+    for (std::size_t i = 0; i != 2 * NUM_KEYS; ++i)
+        idx.add(TestType(int((i * 37) % NUM_KEYS) - 50), i);
+    REQUIRE(idx.num_entries() == 2 * NUM_KEYS);
+    REQUIRE(idx.capacity() == 512);
+    REQUIRE(idx.exposed_memory_size() == idx.capacity() * sizeof(typename index_type::slot_t));
+
+    /* Every key is found with both of its `tuple_id`s. */
+    for (std::size_t i = 0; i != NUM_KEYS; ++i) {
+        const TestType key = TestType(int((i * 37) % NUM_KEYS) - 50);
+        std::vector<uint32_t> tuple_ids;
+        idx.for_each_in_equal_range(key, [&tuple_ids](uint32_t tuple_id) { tuple_ids.push_back(tuple_id); });
+        std::sort(tuple_ids.begin(), tuple_ids.end());
+        REQUIRE(tuple_ids == std::vector<uint32_t>{ uint32_t(i), uint32_t(i + NUM_KEYS) });
+    }
+    REQUIRE(idx.count(TestType(-51)) == 0);
+    REQUIRE(idx.count(TestType(50)) == 0);
+
+    /* The first slot to probe is given by the most significant bits of the hash. */
+    REQUIRE(idx.first_slot(TestType(42)) ==
+            (index_type::hash(TestType(42)) * index_type::HASH_FACTOR) >> (64 - idx.log2_capacity()));
+    if constexpr (std::floating_point<TestType>) {
+        REQUIRE(index_type::hash(TestType(-0.)) == index_type::hash(TestType(0.)));
+        REQUIRE(idx.count(TestType(-0.)) == 2);
+    }
+}
+
+TEMPLATE_TEST_CASE("HashIndex::bulkload() with Numeric types", "[core][storage][index]",
+                    int8_t, int16_t, int32_t, int64_t, float, double)
+{
+    Catalog::Clear();
+    Diagnostic diag(false, std::cout, std::cerr);
+
+    /* Create and use a DB. */
+    Catalog &C = Catalog::Get();
+    ThreadSafePooledString db_name = C.pool("db");
+    auto &DB = C.add_database(db_name);
+    C.set_database_in_use(DB);
+    auto &table = DB.add_table(C.pool("t"));
+
+    /* Create a table with a single attribute. */
+    table.push_back(C.pool("val"), []() {
+        if constexpr(integral<TestType>)
+            return Type::Get_Integer(Type::TY_Vector, sizeof(TestType));
+        else if constexpr(std::same_as<TestType, float>)
+            return Type::Get_Float(Type::TY_Vector);
+        else // double
+            return Type::Get_Double(Type::TY_Vector);
+    }());
+    table.layout(C.data_layout());
+    table.store(C.create_store(table));
+
+    /* Build and execute insert statement with `NUM_KEYS` distinct keys in descending order and `NULL`. */
+    constexpr int NUM_KEYS = 100;
+    std::ostringstream oss;
+    oss << "INSERT INTO t VALUES ";
+    for (int i = 0; i != NUM_KEYS; ++i)
+        oss << "(" << NUM_KEYS - 1 - i << "), ";
+    oss << " (NULL);";
+    auto insert_stmt = statement_from_string(diag, oss.str());
+    execute_statement(diag, *insert_stmt);
+
+    /* Bulkload index from table. */
+    HashIndex<TestType> idx;
+    idx.bulkload(table, table.schema());
+    REQUIRE(idx.num_entries() == NUM_KEYS); // index should not contain NULL
+    REQUIRE(idx.num_entries() <= idx.capacity() * HashIndex<TestType>::MAX_LOAD_FACTOR);
+
+    /* Check contents of index. */
+    for (int i = 0; i != NUM_KEYS; ++i) {
+        std::vector<uint32_t> tuple_ids;
+        idx.for_each_in_equal_range(TestType(i), [&tuple_ids](uint32_t tuple_id) { tuple_ids.push_back(tuple_id); });
+        REQUIRE(tuple_ids == std::vector<uint32_t>{ uint32_t(NUM_KEYS - 1 - i) });
+    }
+}
+
+TEST_CASE("HashIndex index nested-loops join", "[core][storage][index]")
+{
+    Catalog &C = Catalog::Get();
+    const auto old_data_layout = C.default_data_layout_name();
+    auto data_layout = GENERATE(Catch::Generators::as<const char*>{}, "Row", "PAX4K", "PAX16Tup");
+    Catalog::Clear();
+    C.default_data_layout(C.pool(data_layout));
+    auto &DB = C.add_database(C.pool("joindb"));
+    C.set_database_in_use(DB);
+
+    std::ostringstream out, err;
+    Diagnostic diag(false, out, err);
+
+    /* Executes the query `sql` and returns the printed result tuples in sorted order. */
+    auto query = [&diag](const std::string &sql) {
+        std::vector<std::string> result;
+        auto stmt = statement_from_string(diag, sql);
+        auto consumer = std::make_unique<CallbackOperator>([&result](const Schema &S, const Tuple &tup) {
+            std::ostringstream oss;
+            tup.print(oss, S);
+            result.push_back(oss.str());
+        });
+        auto logical_plan = logical_plan_from_statement(diag, as<const ast::SelectStmt>(*stmt), std::move(consumer));
+        auto physical_plan = physical_plan_from_logical_plan(diag, *logical_plan);
+        execute_physical_plan(diag, *physical_plan);
+        std::sort(result.begin(), result.end());
+        return result;
+    };
+
+    /* Create and fill the tables.  Keys of `R` are unique except for a few duplicates and `NULL`s. */
+    execute_statement(diag, *statement_from_string(diag,
+        "CREATE TABLE R (id INT(4), name CHAR(8), flag BOOL, val DOUBLE, day DATE);"));
+    execute_statement(diag, *statement_from_string(diag, "CREATE TABLE S (rid INT(4), x INT(2));"));
+    constexpr unsigned NUM_ROWS = 1000;
+    std::ostringstream insert_R, insert_S;
+    insert_R << "INSERT INTO R VALUES ";
+    for (unsigned i = 0; i != NUM_ROWS; ++i) {
+        if (i) insert_R << ", ";
+        insert_R << '(' << (i % 97 == 0 ? "NULL" : std::to_string(i % 990)) << ", "
+                 << (i % 5 ? "\"r" + std::to_string(i) + '"' : "NULL") << ", " << (i % 3 ? "TRUE" : "FALSE") << ", "
+                 << (i % 7 ? std::to_string(i) + ".5" : "NULL") << ", d'2000-01-" << (i % 28 + 1) / 10
+                 << (i % 28 + 1) % 10 << "')";
+    }
+    insert_R << ';';
+    insert_S << "INSERT INTO S VALUES ";
+    for (unsigned i = 0; i != 100; ++i)
+        insert_S << (i ? ", (" : "(") << i * 13 % 1100 << ", " << i << ')';
+    insert_S << ';';
+    execute_statement(diag, *statement_from_string(diag, insert_R.str()));
+    execute_statement(diag, *statement_from_string(diag, insert_S.str()));
+    REQUIRE(diag.num_errors() == 0);
+
+    const char *sql = "SELECT S.x, R.id, R.name, R.flag, R.val, R.day FROM S, R WHERE S.rid = R.id;";
+    const char *sql_swapped = "SELECT S.x, R.id, R.name, R.flag, R.val, R.day FROM R, S WHERE R.id = S.rid;";
+    const auto expected = query(sql);
+    REQUIRE(expected.size() > 90);
+
+    /* Create the hash index and join by probing it. */
+    command_from_string(diag, "CREATE INDEX idx_R ON R USING hash (id);")->execute(diag);
+    REQUIRE(diag.num_errors() == 0);
+    REQUIRE(DB.has_index(C.pool("R"), C.pool("id"), IndexMethod::Hash));
+    CHECK(query(sql) == expected);
+    CHECK(query(sql_swapped) == expected);
+
+    SECTION("compressed")
+    {
+        auto &R = DB.get_table(C.pool("R"));
+        REQUIRE(compress_table(R));
+        CHECK(query(sql) == expected);
+    }
+
+    CHECK(diag.num_errors() == 0);
+    C.unset_database_in_use();
+    C.default_data_layout(old_data_layout);
+}
+
+TEST_CASE("Index maintenance on INSERT", "[core][storage][index]")
+{
+    Catalog::Clear();
+    Catalog &C = Catalog::Get();
+    auto &DB = C.add_database(C.pool("insertdb"));
+    C.set_database_in_use(DB);
+
+    std::ostringstream out, err;
+    Diagnostic diag(false, out, err);
+
+    /* Create and fill the table, then create an index of every method. */
+    execute_statement(diag, *statement_from_string(diag, "CREATE TABLE R (id INT(4), name CHAR(8));"));
+    std::ostringstream insert;
+    insert << "INSERT INTO R VALUES ";
+    for (unsigned i = 0; i != 200; ++i)
+        insert << (i ? ", (" : "(") << 2 * i << ", \"r" << i << "\")";
+    insert << ';';
+    execute_statement(diag, *statement_from_string(diag, insert.str()));
+    for (auto method : { "array", "rmi", "bplustree", "hash" }) {
+        command_from_string(diag, std::string("CREATE INDEX idx_") + method + " ON R USING " + method + " (id);")
+            ->execute(diag);
+    }
+    command_from_string(diag, "CREATE INDEX idx_name ON R (name);")->execute(diag);
+    REQUIRE(diag.num_errors() == 0);
+
+    /* Insert odd keys, a duplicate, and `NULL`. */
+    execute_statement(diag, *statement_from_string(diag,
+        "INSERT INTO R VALUES (7, \"new7\"), (399, \"new399\"), (-1, \"neg\"), (20, \"dup\"), (NULL, NULL);"));
+    REQUIRE(diag.num_errors() == 0);
+    constexpr std::size_t NUM_KEYS = 204; // `NULL` is not indexed
+
+    /* Sorted arrays keep new entries pending until they are used. */
+    auto &array = as<const ArrayIndex<int32_t>>(DB.get_index(C.pool("idx_array")));
+    CHECK_FALSE(array.has_pending());
+    CHECK(std::is_sorted(array.begin(), array.end(), [](auto &lhs, auto &rhs) { return lhs.first < rhs.first; }));
+
+    /* Every index remains valid and contains the new entries. */
+    auto check_key = [&](auto &idx, int32_t key, std::vector<std::size_t> expected) {
+        std::vector<std::size_t> tuple_ids;
+        for (auto it = idx.lower_bound(key); it != idx.upper_bound(key); ++it)
+            tuple_ids.push_back(it->second);
+        std::sort(tuple_ids.begin(), tuple_ids.end());
+        CHECK(tuple_ids == expected);
+    };
+    for (auto method : { IndexMethod::Array, IndexMethod::Rmi, IndexMethod::BPlusTree }) {
+        REQUIRE(DB.has_index(C.pool("R"), C.pool("id"), method));
+        auto &index = DB.get_index(C.pool("R"), C.pool("id"), method);
+        CHECK(index.num_entries() == NUM_KEYS);
+        if (method == IndexMethod::BPlusTree) {
+            auto &idx = as<const BPlusTreeIndex<int32_t>>(index);
+            check_key(idx, 7, { 200 });
+            check_key(idx, 20, { 10, 203 });
+            CHECK(idx.begin()->first == -1);
+        } else {
+            auto &idx = as<const ArrayIndex<int32_t>>(index);
+            check_key(idx, 7, { 200 });
+            check_key(idx, 399, { 201 });
+            check_key(idx, 20, { 10, 203 });
+            CHECK(idx.begin()->first == -1);
+        }
+    }
+    REQUIRE(DB.has_index(C.pool("R"), C.pool("id"), IndexMethod::Hash));
+    auto &hash = as<const HashIndex<int32_t>>(DB.get_index(C.pool("R"), C.pool("id"), IndexMethod::Hash));
+    CHECK(hash.num_entries() == NUM_KEYS);
+    std::vector<std::size_t> tuple_ids;
+    hash.for_each_in_equal_range(20, [&](std::size_t tuple_id) { tuple_ids.push_back(tuple_id); });
+    std::sort(tuple_ids.begin(), tuple_ids.end());
+    CHECK(tuple_ids == std::vector<std::size_t>{ 10, 203 });
+
+    auto &names = as<const ArrayIndex<const char*>>(DB.get_index(C.pool("idx_name")));
+    CHECK(names.num_entries() == NUM_KEYS);
+    auto it = names.lower_bound("neg");
+    REQUIRE(it != names.end());
+    CHECK(std::strcmp(it->first, "neg") == 0);
+    CHECK(it->second == 202);
+
+    C.unset_database_in_use();
+}
@@ -0,0 +1,133 @@
+#include "catch2/catch.hpp"
+
+#include "testutil.hpp"
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <mutable/mutable.hpp>
+#include <mutable/storage/Versioning.hpp>
+#include <sstream>
+#include <string>
+#include <vector>
+
+
+using namespace m;
+
+
+TEST_CASE("Snapshot", "[core][storage][snapshot]")
+{
+    Catalog &C = Catalog::Get();
+    const auto old_data_layout = C.default_data_layout_name();
+    auto data_layout = GENERATE(Catch::Generators::as<const char*>{}, "Row", "PAX4K", "PAX16Tup");
+    Catalog::Clear();
+    C.default_data_layout(C.pool(data_layout));
+    auto &DB = C.add_database(C.pool("snapdb"));
+    C.set_database_in_use(DB);
+
+    std::ostringstream out, err;
+    Diagnostic diag(false, out, err);
+
+    /* Create and fill the tables. */
+    execute_statement(diag, *statement_from_string(diag,
+        "CREATE TABLE R (id INT(4) PRIMARY KEY, name CHAR(6), val DOUBLE NOT NULL, day DATE);"));
+    execute_statement(diag, *statement_from_string(diag, "CREATE TABLE S (rid INT(4), x INT(8));"));
+    DB.get_table(C.pool("S")).at(C.pool("rid")).reference = &DB.get_table(C.pool("R")).at(C.pool("id"));
+    constexpr unsigned NUM_ROWS = 3000;
+    std::ostringstream insert;
+    insert << "INSERT INTO R VALUES ";
+    for (unsigned i = 0; i != NUM_ROWS; ++i) {
+        if (i) insert << ", ";
+        insert << '(' << i << ", " << (i % 7 ? "\"n" + std::to_string(i % 1000) + '"' : "NULL") << ", " << i
+               << ".25, d'2000-01-" << (i % 28 + 1) / 10 << (i % 28 + 1) % 10 << "')";
+    }
+    insert << ';';
+    execute_statement(diag, *statement_from_string(diag, insert.str()));
+    execute_statement(diag, *statement_from_string(diag, "INSERT INTO S VALUES (1, 10), (2, 20), (NULL, 30);"));
+    REQUIRE(diag.num_errors() == 0);
+
+    const auto expected_R = testutil::query(diag, "SELECT * FROM R;");
+    const auto expected_S = testutil::query(diag, "SELECT * FROM S;");
+    REQUIRE(expected_R.size() == NUM_ROWS);
+
+    const auto path = std::filesystem::temp_directory_path() / "mutable_SnapshotTest.snapshot";
+    write_snapshot(DB, path);
+    C.unset_database_in_use();
+    C.drop_database(DB);
+
+    SECTION("round-trip")
+    {
+        auto &restored = read_snapshot(path);
+        CHECK(restored.name == C.pool("snapdb"));
+        REQUIRE(restored.size() == 2);
+        C.set_database_in_use(restored);
+
+        /* Check schema and constraints. */
+        auto &R = restored.get_table(C.pool("R"));
+        auto &S = restored.get_table(C.pool("S"));
+        CHECK(R.at(C.pool("name")).type == Type::Get_Char(Type::TY_Vector, 6));
+        CHECK(R.at(C.pool("day")).type == Type::Get_Date(Type::TY_Vector));
+        CHECK(R.at(C.pool("val")).not_nullable);
+        REQUIRE(R.primary_key().size() == 1);
+        CHECK(R.primary_key()[0].get().name == C.pool("id"));
+        CHECK(S.at(C.pool("rid")).reference == &R.at(C.pool("id")));
+        CHECK(R.layout().stride_in_bits() != 0);
+
+        /* Check the data.  All but the last stride are mapped from the snapshot. */
+        CHECK(R.store().num_rows() == NUM_ROWS);
+        CHECK(R.store().memory().file_size() != 0);
+        CHECK(testutil::query(diag, "SELECT * FROM R;") == expected_R);
+        CHECK(testutil::query(diag, "SELECT * FROM S;") == expected_S);
+        CHECK(diag.num_errors() == 0);
+
+        /* Mapping the store's memory into an address space, as done by the WebAssembly backend, preserves the data. */
+        const auto &mem = R.store().memory();
+        const std::size_t size = Ceil_To_Next_Page(mem.file_size() + 1);
+        memory::AddressSpace vm(size);
+        mem.map(size, 0, vm, 0);
+        CHECK(std::memcmp(vm.addr(), mem.addr(), size) == 0);
+
+        /* Append rows after restoring. */
+        execute_statement(diag, *statement_from_string(diag, "INSERT INTO R VALUES (3000, \"new\", 1.5, NULL);"));
+        REQUIRE(diag.num_errors() == 0);
+        auto result = testutil::query(diag, "SELECT * FROM R;");
+        REQUIRE(result.size() == NUM_ROWS + 1);
+        CHECK(std::equal(expected_R.begin(), expected_R.end(), result.begin()));
+        CHECK(testutil::query(diag, "SELECT id FROM R WHERE name = \"new\";").size() == 1);
+
+        /* Update and remove rows after restoring, which writes to the strides mapped from the snapshot. */
+        const auto id = R[C.pool("id")].id;
+        const auto val = R[C.pool("val")].id;
+        CHECK(update_rows(R, [&](Tuple &tup) {
+            if (tup[id].as_i() >= 10) return false;
+            tup.set(val, 0.5);
+            return true;
+        }) == 10);
+        CHECK(R.store().memory().file_size() == 0);
+        CHECK(testutil::query(diag, "SELECT id FROM R WHERE val = 0.5;").size() == 10);
+        CHECK(remove_rows(R, [&](Tuple &tup) { return tup[id].as_i() >= 1000; }) == NUM_ROWS + 1 - 1000);
+        CHECK(testutil::query(diag, "SELECT * FROM R;").size() == 1000);
+        CHECK(testutil::query(diag, "SELECT id FROM R WHERE val = 0.5;").size() == 10);
+
+        /* The database cannot be restored twice. */
+        CHECK_THROWS_AS(read_snapshot(path), invalid_argument);
+    }
+
+    SECTION("invalid snapshots")
+    {
+        CHECK_THROWS_AS(read_snapshot(path.string() + ".missing"), runtime_error);
+
+        const auto other = std::filesystem::temp_directory_path() / "mutable_SnapshotTest.txt";
+        std::ofstream(other) << "this is not a snapshot, but it is long enough to contain a snapshot header";
+        CHECK_THROWS_AS(read_snapshot(other), invalid_argument);
+        std::filesystem::remove(other);
+
+        /* A truncated snapshot is rejected and does not leave a database behind. */
+        std::filesystem::resize_file(path, std::filesystem::file_size(path) - 1);
+        CHECK_THROWS_AS(read_snapshot(path), invalid_argument);
+        CHECK_FALSE(C.has_database(C.pool("snapdb")));
+    }
+
+    std::filesystem::remove(path);
+    C.unset_database_in_use();
+    C.default_data_layout(old_data_layout);
+}
@@ -0,0 +1,134 @@
+#include "catch2/catch.hpp"
+
+#include "catalog/ConcurrentScheduler.hpp"
+#include "parse/Parser.hpp"
+#include <algorithm>
+#include <limits>
+#include <mutable/catalog/Catalog.hpp>
+#include <mutable/catalog/TableFactory.hpp>
+#include <mutable/storage/Versioning.hpp>
+#include <sstream>
+#include <vector>
+
+
+using namespace m;
+
+
+namespace {
+
+/** Parses \p statements and returns the first statement. */
+std::unique_ptr<ast::Command> parse(Diagnostic &diag, const char *statements)
+{
+    std::istringstream in(statements);
+    ast::Lexer lexer(diag, Catalog::Get().get_pool(), "-", in);
+    ast::Parser parser(lexer);
+    return parser.parse();
+}
+
+/** Returns the values of attribute `x` of all versions of rows of \p table that are visible to \p snapshot, in
+ * ascending order. */
+std::vector<int64_t> visible_values(Table &table, int64_t snapshot)
+{
+    const auto ts = get_timestamp_attributes(table);
+    REQUIRE(ts.has_value());
+    const auto x = table[Catalog::Get().pool("x")].id;
+
+    std::vector<int64_t> values;
+    update_rows(table, [&](Tuple &tup) {
+        if (is_visible(tup[ts->begin].as_i(), tup[ts->end].as_i(), snapshot))
+            values.push_back(tup[x].as_i());
+        return false;
+    });
+    std::sort(values.begin(), values.end());
+    return values;
+}
+
+}
+
+TEST_CASE("Versioning/is_visible", "[core][storage][versioning]")
+{
+    CHECK(is_visible(0, -1, 0));
+    CHECK(is_visible(0, -1, 42));
+    CHECK_FALSE(is_visible(1, -1, 0));
+    CHECK(is_visible(0, 2, 1));
+    CHECK_FALSE(is_visible(0, 2, 2));
+    CHECK_FALSE(is_visible(0, 2, 3));
+}
+
+TEST_CASE("Versioning/remove_rows", "[core][storage][versioning]")
+{
+    Catalog::Clear();
+    Catalog &C = Catalog::Get();
+    auto &DB = C.add_database(C.pool("db"));
+    C.set_database_in_use(DB);
+
+    std::ostringstream out, err;
+    Diagnostic diag(false, out, err);
+    ConcurrentScheduler S;
+    REQUIRE(S.autocommit(parse(diag, "CREATE TABLE R (x INT(4));"), diag));
+    REQUIRE(S.autocommit(parse(diag, "INSERT INTO R VALUES (1), (2), (3), (4), (5);"), diag));
+
+    auto &R = DB.get_table(C.pool("R"));
+    CHECK_FALSE(get_timestamp_attributes(R).has_value());
+    REQUIRE(R.store().num_rows() == 5);
+
+    const auto x = R[C.pool("x")].id;
+    CHECK(remove_rows(R, [x](Tuple &tup) { return tup[x].as_i() % 2 == 0; }) == 2);
+    REQUIRE(R.store().num_rows() == 3);
+
+    std::vector<int64_t> values;
+    update_rows(R, [&](Tuple &tup) { values.push_back(tup[x].as_i()); return false; });
+    CHECK(values == std::vector<int64_t>{ 1, 3, 5 });
+}
+
+TEST_CASE("Versioning/snapshot isolation", "[core][storage][versioning]")
+{
+    Catalog::Clear();
+    Catalog &C = Catalog::Get();
+    auto old_table_factory = C.table_factory(std::make_unique<ConcreteTableFactoryDecorator<MultiVersioningTable>>(
+        std::make_unique<ConcreteTableFactory>()
+    ));
+    auto &DB = C.add_database(C.pool("db"));
+    C.set_database_in_use(DB);
+
+    std::ostringstream out, err;
+    Diagnostic diag(false, out, err);
+    ConcurrentScheduler S;
+    auto run = [&](const char *statement) { diag.clear(); return S.autocommit(parse(diag, statement), diag); };
+
+    REQUIRE(run("CREATE TABLE R (x INT(4));"));
+    REQUIRE(run("INSERT INTO R VALUES (1), (2), (3);"));
+    auto &R = DB.get_table(C.pool("R"));
+    REQUIRE(get_timestamp_attributes(R).has_value());
+    REQUIRE(R.store().num_rows() == 3);
+
+    /* An UPDATE appends new versions of the updated rows, a DELETE only ends the lifetime of the deleted rows. */
+    REQUIRE(run("UPDATE R SET x = 4 WHERE x = 1;"));
+    CHECK(R.store().num_rows() == 4);
+    REQUIRE(run("DELETE FROM R WHERE x = 2;"));
+    CHECK(R.store().num_rows() == 4);
+    CHECK(visible_values(R, std::numeric_limits<int64_t>::max()) == std::vector<int64_t>{ 3, 4 });
+
+    /* Open a transaction that keeps its snapshot while another transaction updates the table. */
+    auto t = S.begin_transaction();
+    REQUIRE(S.schedule_command(*t, parse(diag, "INSERT INTO R VALUES (5);"), diag).get());
+    const int64_t snapshot = t->start_time();
+    REQUIRE(Scheduler::Transaction::Oldest_Active_Start_Time() == snapshot);
+    REQUIRE(run("UPDATE R SET x = 6 WHERE x = 3;"));
+    CHECK(R.store().num_rows() == 6);
+    CHECK(visible_values(R, snapshot) == std::vector<int64_t>{ 3, 4, 5 });
+    CHECK(visible_values(R, std::numeric_limits<int64_t>::max()) == std::vector<int64_t>{ 4, 5, 6 });
+
+    /* Garbage collection must keep the versions that are still visible to the open transaction. */
+    REQUIRE(run("\\vacuum;"));
+    CHECK(R.store().num_rows() == 4);
+    CHECK(visible_values(R, snapshot) == std::vector<int64_t>{ 3, 4, 5 });
+
+    REQUIRE(S.commit(std::move(t)));
+    CHECK_FALSE(Scheduler::Transaction::Oldest_Active_Start_Time().has_value());
+    REQUIRE(run("\\vacuum;"));
+    CHECK(R.store().num_rows() == 3);
+    CHECK(visible_values(R, std::numeric_limits<int64_t>::max()) == std::vector<int64_t>{ 4, 5, 6 });
+
+    C.table_factory(std::move(old_table_factory));
+}
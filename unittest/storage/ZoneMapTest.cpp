@@ -0,0 +1,129 @@
+#include "catch2/catch.hpp"
+
+#include "testutil.hpp"
+#include <mutable/mutable.hpp>
+#include <sstream>
+#include <string>
+#include <vector>
+
+
+using namespace m;
+
+
+namespace {
+
+/** Executes the query \p sql and returns the number of result tuples and the number of zones skipped. */
+std::pair<std::size_t, uint64_t> count_and_skipped(Diagnostic &diag, const std::string &sql)
+{
+    auto &timer = Catalog::Get().timer();
+    timer.clear();
+    const auto num_results = testutil::query(diag, sql).size();
+    return { num_results, timer.counter("Zones skipped by zone maps") };
+}
+
+}
+
+TEST_CASE("ZoneMap", "[core][storage][zonemap]")
+{
+    Catalog &C = Catalog::Get();
+    const auto old_data_layout = C.default_data_layout_name();
+    auto data_layout = GENERATE(Catch::Generators::as<const char*>{}, "Row", "PAX4K", "PAX16Tup");
+    Catalog::Clear();
+    C.default_data_layout(C.pool(data_layout));
+    auto &DB = C.add_database(C.pool("zonedb"));
+    C.set_database_in_use(DB);
+
+    std::ostringstream out, err;
+    Diagnostic diag(false, out, err);
+
+    /* Create and fill the table.  `id` and `day` ascend, s.t. every zone covers a distinct range of values. */
+    execute_statement(diag, *statement_from_string(diag,
+        "CREATE TABLE R (id INT(4), day DATE, price DECIMAL(10, 2), val FLOAT, opt INT(2), name CHAR(4));"));
+    constexpr unsigned NUM_ROWS = 5000;
+    std::ostringstream insert;
+    insert << "INSERT INTO R VALUES ";
+    for (unsigned i = 0; i != NUM_ROWS; ++i) {
+        if (i) insert << ", ";
+        insert << '(' << i << ", d'" << 2000 + i / 365 << "-01-01', " << i / 100 << '.' << i % 100 / 10 << i % 10
+               << ", " << i << ".5, " << (i < ZoneMap::ZONE_SIZE ? "NULL" : std::to_string(i % 7)) << ", \"n"
+               << i % 10 << "\")";
+    }
+    insert << ';';
+    execute_statement(diag, *statement_from_string(diag, insert.str()));
+    REQUIRE(diag.num_errors() == 0);
+
+    auto &R = DB.get_table(C.pool("R"));
+    auto &zone_map = R.store().zone_map();
+    constexpr std::size_t NUM_ZONES = (NUM_ROWS + ZoneMap::ZONE_SIZE - 1) / ZoneMap::ZONE_SIZE;
+
+    SECTION("summaries")
+    {
+        REQUIRE(zone_map.num_rows() == NUM_ROWS);
+        REQUIRE(zone_map.num_zones() == NUM_ZONES);
+        REQUIRE(zone_map.num_attributes() == 6);
+        CHECK(zone_map.is_summarized(0));
+        CHECK(zone_map.is_summarized(1));
+        CHECK(zone_map.is_summarized(2));
+        CHECK(zone_map.is_summarized(3));
+        CHECK(zone_map.is_summarized(4));
+        CHECK_FALSE(zone_map.is_summarized(5)); // character sequences are not summarized
+
+        for (std::size_t zone = 0; zone != NUM_ZONES; ++zone) {
+            auto &id = zone_map.summary(zone, 0);
+            const auto first = zone * ZoneMap::ZONE_SIZE;
+            const auto last = std::min<std::size_t>(first + ZoneMap::ZONE_SIZE, NUM_ROWS) - 1;
+            CHECK(id.min.as_i() == int64_t(first));
+            CHECK(id.max.as_i() == int64_t(last));
+            CHECK(id.num_values == last - first + 1);
+            CHECK(id.num_nulls == 0);
+            CHECK(zone_map.summary(zone, 2).min.as_i() == int64_t(first)); // decimals are scaled
+            CHECK(zone_map.summary(zone, 3).max.as_f() == float(last) + .5f);
+        }
+        CHECK(zone_map.summary(0, 4).num_values == 0);
+        CHECK(zone_map.summary(0, 4).num_nulls == ZoneMap::ZONE_SIZE);
+        CHECK(zone_map.summary(1, 4).min.as_i() == 0);
+        CHECK(zone_map.summary(1, 4).max.as_i() == 6);
+    }
+
+    SECTION("appending rows updates the zone map")
+    {
+        execute_statement(diag, *statement_from_string(diag,
+            "INSERT INTO R VALUES (-1, d'1999-01-01', 0.5, 0.5, 42, \"new\");"));
+        REQUIRE(diag.num_errors() == 0);
+        auto &updated = R.store().zone_map();
+        REQUIRE(updated.num_rows() == NUM_ROWS + 1);
+        CHECK(updated.summary(NUM_ZONES - 1, 0).min.as_i() == -1);
+        CHECK(updated.summary(NUM_ZONES - 1, 4).max.as_i() == 42);
+        CHECK(updated.summary(0, 0).min.as_i() == 0); // zones that were covered completely are unaltered
+    }
+
+    SECTION("scans skip zones")
+    {
+        /* Range predicates on ascending attributes skip all zones outside the range. */
+        CHECK(count_and_skipped(diag, "SELECT id FROM R WHERE id < 1500;") == std::make_pair(1500UL, 3UL));
+        CHECK(count_and_skipped(diag, "SELECT id FROM R WHERE 1500 > id;") == std::make_pair(1500UL, 3UL));
+        CHECK(count_and_skipped(diag, "SELECT id FROM R WHERE id >= 2048 AND id <= 2050;") ==
+              std::make_pair(3UL, 4UL));
+        CHECK(count_and_skipped(diag, "SELECT id FROM R WHERE id = 4999;") == std::make_pair(1UL, 4UL));
+        CHECK(count_and_skipped(diag, "SELECT id FROM R WHERE NOT (id >= 10);") == std::make_pair(10UL, 4UL));
+        CHECK(count_and_skipped(diag, "SELECT id FROM R WHERE id < -5;") == std::make_pair(0UL, NUM_ZONES));
+        CHECK(count_and_skipped(diag, "SELECT id FROM R WHERE day < d'2001-01-01';") == std::make_pair(365UL, 4UL));
+        CHECK(count_and_skipped(diag, "SELECT id FROM R WHERE price >= 45.5;") == std::make_pair(450UL, 4UL));
+        CHECK(count_and_skipped(diag, "SELECT id FROM R WHERE val < 10.5;") == std::make_pair(10UL, 4UL));
+
+        /* A clause is only unsatisfiable if all of its predicates are. */
+        CHECK(count_and_skipped(diag, "SELECT id FROM R WHERE id < 10 OR id > 4990;") == std::make_pair(19UL, 3UL));
+        CHECK(count_and_skipped(diag, "SELECT id FROM R WHERE id < 10 OR name = \"n1\";").second == 0);
+
+        /* Zones without any value are skipped by any comparison. */
+        CHECK(count_and_skipped(diag, "SELECT id FROM R WHERE opt != 3;").second == 1);
+
+        /* Predicates that cannot be decided by the zone map do not skip any zone. */
+        CHECK(count_and_skipped(diag, "SELECT id FROM R WHERE id + 1 < 10;") == std::make_pair(9UL, 0UL));
+        CHECK(count_and_skipped(diag, "SELECT id FROM R WHERE id != 3000;") == std::make_pair(4999UL, 0UL));
+        CHECK(diag.num_errors() == 0);
+    }
+
+    C.unset_database_in_use();
+    C.default_data_layout(old_data_layout);
+}
@@ -2,9 +2,11 @@
 
 #include "lex/Lexer.hpp"
 #include <mutable/catalog/Catalog.hpp>
+#include <mutable/mutable.hpp>
 #include <mutable/util/Diagnostic.hpp>
 #include <sstream>
 #include <string>
+#include <vector>
 
 #define LEXER(STR) \
     Catalog &C = Catalog::Get(); \
@@ -36,6 +38,22 @@ struct Approx
     bool operator!=(const std::array<double, L> &other) const { return not operator==(other); }
 };
 
+/** Executes the query \p sql and returns the printed result tuples. */
+inline std::vector<std::string> query(Diagnostic &diag, const std::string &sql)
+{
+    std::vector<std::string> result;
+    auto stmt = statement_from_string(diag, sql);
+    auto consumer = std::make_unique<CallbackOperator>([&result](const Schema &S, const Tuple &tup) {
+        std::ostringstream oss;
+        tup.print(oss, S);
+        result.push_back(oss.str());
+    });
+    auto logical_plan = logical_plan_from_statement(diag, as<const ast::SelectStmt>(*stmt), std::move(consumer));
+    auto physical_plan = physical_plan_from_logical_plan(diag, *logical_plan);
+    execute_physical_plan(diag, *physical_plan);
+    return result;
+}
+
 }
 
 }
@@ -962,6 +962,51 @@ TEST_CASE("AdjacencyMatrix/for_each_CSG_undirected", "[core][util][unit]")
     }
 }
 
+TEST_CASE("AdjacencyMatrix/for_each_CSG_undirected_while", "[core][util][unit]")
+{
+    const SmallBitset A = SmallBitset::Singleton(0);
+    const SmallBitset B = SmallBitset::Singleton(1);
+    const SmallBitset C = SmallBitset::Singleton(2);
+    const SmallBitset D = SmallBitset::Singleton(3);
+
+    /*  A ↔  B
+     *  ↕
+     *  C ↔  D
+     */
+    AdjacencyMatrix M(4);
+    M(0, 1) = M(1, 0) = true;
+    M(0, 2) = M(2, 0) = true;
+    M(2, 3) = M(3, 2) = true;
+
+    /* The CSGs enumerated by `for_each_CSG_undirected()`. */
+    std::vector<SmallBitset> expected;
+    M.for_each_CSG_undirected(A|B|C|D, [&expected](SmallBitset S) { expected.emplace_back(S); });
+    REQUIRE(expected.size() == 10);
+
+    std::vector<SmallBitset> CSGs;
+
+    SECTION("all")
+    {
+        const bool complete = M.for_each_CSG_undirected_while(A|B|C|D, [&CSGs](SmallBitset S) {
+            CSGs.emplace_back(S);
+            return true;
+        });
+        CHECK(complete);
+        CHECK(CSGs == expected);
+    }
+
+    SECTION("stop early")
+    {
+        const bool complete = M.for_each_CSG_undirected_while(A|B|C|D, [&CSGs](SmallBitset S) {
+            CSGs.emplace_back(S);
+            return CSGs.size() != 4;
+        });
+        CHECK_FALSE(complete);
+        REQUIRE(CSGs.size() == 4);
+        CHECK(std::equal(CSGs.begin(), CSGs.end(), expected.begin()));
+    }
+}
+
 TEST_CASE("AdjacencyMatrix/for_each_CSG_pair_undirected", "[core][util][unit]")
 {
     AdjacencyMatrix M;
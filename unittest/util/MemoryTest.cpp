@@ -1,7 +1,10 @@
 #include "catch2/catch.hpp"
 
+#include <cstdio>
+#include <fstream>
 #include <mutable/util/memory.hpp>
 #include <memory>
+#include <unistd.h>
 
 
 using namespace m;
@@ -116,3 +119,86 @@ TEST_CASE("memory::LinearAllocator", "[core][util][memory]")
         }
     }
 }
+
+TEST_CASE("memory::LinearAllocator/placement", "[core][util][memory]")
+{
+    const std::size_t PAGE_SIZE = get_pagesize();
+
+    Placement P;
+    P.huge_pages = Placement::HP_Transparent;
+    LinearAllocator A(P);
+    REQUIRE(A.placement().huge_pages == Placement::HP_Transparent);
+    CHECK(A.page_size() == PAGE_SIZE);
+
+    /* Allocate more than a huge page. */
+    const std::size_t SIZE = 3 * (1UL << 20);
+    auto mem = A.allocate(SIZE);
+    CHECK(A.offset() == SIZE);
+    auto p_mem = mem.as<uint64_t*>();
+    for (std::size_t i = 0; i != SIZE / sizeof(uint64_t); ++i)
+        p_mem[i] = i;
+
+    /* Map into an address space, which is aligned to huge pages. */
+    AddressSpace vm(SIZE);
+    CHECK(vm.as<uintptr_t>() % (2UL << 20) == 0);
+    mem.map(SIZE, 0, vm, 0);
+    auto p_vm = vm.as<const uint64_t*>();
+    for (std::size_t i = 0; i != SIZE / sizeof(uint64_t); ++i)
+        REQUIRE(p_vm[i] == i);
+
+    /* Changing the placement later applies to subsequent allocations. */
+    P.huge_pages = Placement::HP_None;
+    A.placement(P);
+    auto mem1 = A.allocate(PAGE_SIZE);
+    *mem1.as<int*>() = 42;
+    CHECK(*mem1.as<int*>() == 42);
+}
+
+TEST_CASE("memory::Memory/map_file", "[core][util][memory]")
+{
+    Placement P;
+    P.huge_pages = GENERATE(Placement::HP_None, Placement::HP_Explicit);
+    if (P.huge_pages == Placement::HP_Explicit) {
+        /* Explicit huge pages must be reserved in the huge page pool of the system. */
+        std::size_t num_free_huge_pages = 0;
+        std::ifstream("/sys/kernel/mm/hugepages/hugepages-2048kB/free_hugepages") >> num_free_huge_pages;
+        if (num_free_huge_pages < 2)
+            return;
+    }
+    LinearAllocator A(P);
+    const std::size_t PAGE_SIZE = A.page_size();
+
+    /* Write a file of one and a half pages of the allocator. */
+    const std::size_t NUM_INTS = 3 * PAGE_SIZE / 2 / sizeof(unsigned);
+    FILE *file = std::tmpfile();
+    REQUIRE(file);
+    for (unsigned i = 0; i != NUM_INTS; ++i)
+        REQUIRE(std::fwrite(&i, sizeof(i), 1, file) == 1);
+    REQUIRE(std::fflush(file) == 0);
+
+    /* Map the first, completely filled page of the file over the memory and read the rest. */
+    auto mem = A.allocate(2 * PAGE_SIZE);
+    mem.map_file(fileno(file), 0, PAGE_SIZE);
+    CHECK(mem.file_size() == PAGE_SIZE);
+    REQUIRE(pread(fileno(file), mem.as<uint8_t*>() + PAGE_SIZE, NUM_INTS * sizeof(unsigned) - PAGE_SIZE, PAGE_SIZE) ==
+            ssize_t(NUM_INTS * sizeof(unsigned) - PAGE_SIZE));
+    std::fclose(file);
+
+    /* Mapping the memory into an address space maps the file range as well. */
+    AddressSpace vm(2 * PAGE_SIZE);
+    mem.map(2 * PAGE_SIZE, 0, vm, 0);
+    auto p_vm = vm.as<const unsigned*>();
+    for (unsigned i = 0; i != NUM_INTS; ++i)
+        REQUIRE(p_vm[i] == i);
+
+    /* Replacing the file range by a copy makes the memory writable. */
+    mem.unmap_file();
+    CHECK(mem.file_size() == 0);
+    auto p_mem = mem.as<unsigned*>();
+    for (unsigned i = 0; i != NUM_INTS; ++i)
+        REQUIRE(p_mem[i] == i);
+    p_mem[0] = 42;
+    mem.map(2 * PAGE_SIZE, 0, vm, 0);
+    CHECK(p_vm[0] == 42);
+    CHECK(p_vm[NUM_INTS - 1] == NUM_INTS - 1);
+}
@@ -2,8 +2,11 @@
 
 #include <functional>
 #include <mutable/util/Pool.hpp>
+#include <set>
+#include <string>
 #include <string_view>
 #include <thread>
+#include <vector>
 
 
 using namespace m;
@@ -358,3 +361,44 @@ TEST_CASE("Thread-safe concurrent Pool", "[core][util][pool]")
     validate(values_t2, refs_t2);
     validate(values_t3, refs_t3);
 }
+
+TEST_CASE("Thread-safe concurrent StringPool", "[core][util][pool]")
+{
+    ThreadSafeStringPool pool;
+    REQUIRE(pool.num_shards > 1);
+
+    constexpr std::size_t NUM_THREADS = 4;
+    constexpr std::size_t NUM_STRINGS = 1000;
+    std::vector<std::string> strings;
+    for (std::size_t i = 0; i != NUM_STRINGS; ++i)
+        strings.emplace_back("str" + std::to_string(i));
+
+    /* Every thread internalizes all strings, starting at a different string. */
+    std::vector<std::vector<ThreadSafePooledString>> refs(NUM_THREADS);
+    std::vector<std::thread> threads;
+    for (std::size_t t = 0; t != NUM_THREADS; ++t) {
+        threads.emplace_back([&, t]() {
+            for (std::size_t i = 0; i != NUM_STRINGS; ++i)
+                refs[t].emplace_back(pool(strings[(i + t * NUM_STRINGS / NUM_THREADS) % NUM_STRINGS].c_str()));
+        });
+    }
+    for (auto &thread : threads)
+        thread.join();
+
+    REQUIRE(pool.size() == NUM_STRINGS);
+    for (std::size_t t = 0; t != NUM_THREADS; ++t) {
+        for (std::size_t i = 0; i != NUM_STRINGS; ++i) {
+            auto &ref = refs[t][i];
+            CHECK(ref == refs[0][(i + t * NUM_STRINGS / NUM_THREADS) % NUM_STRINGS]);
+            CHECK(ref.count() == NUM_THREADS);
+        }
+    }
+
+    /* Iterating the pool visits every string of every shard exactly once. */
+    std::set<std::string_view> visited;
+    for (auto &[str, count] : pool) {
+        CHECK(count == NUM_THREADS);
+        CHECK(visited.emplace(str).second);
+    }
+    CHECK(visited.size() == NUM_STRINGS);
+}
@@ -84,3 +84,44 @@ TEST_CASE("Timer", "[core][util][timer]")
         REQUIRE_THROWS_AS(T.get("m0"), m::out_of_range);
     }
 }
+
+TEST_CASE("Timer/counters", "[core][util][timer]")
+{
+    Timer T;
+    REQUIRE(T.counters().empty());
+    REQUIRE_THROWS_AS(T.counter("c0"), m::out_of_range);
+
+    T.increment("c0");
+    T.increment("c1", 41);
+    T.increment("c1");
+    REQUIRE(T.counters().size() == 2);
+    REQUIRE(T.counter("c0") == 1);
+    REQUIRE(T.counter("c1") == 42);
+    REQUIRE(T.counters()[0].first == "c0");
+    REQUIRE(T.counters()[1].first == "c1");
+
+    T.clear();
+    REQUIRE(T.counters().empty());
+    REQUIRE_THROWS_AS(T.counter("c0"), m::out_of_range);
+}
+
+TEST_CASE("Timer/add", "[core][util][timer]")
+{
+    Timer T;
+    const auto begin = Timer::clock::now();
+    const auto end = begin + std::chrono::milliseconds(42);
+
+    T.add("m0", begin, end);
+    REQUIRE(T.measurements().size() == 1);
+    REQUIRE(T.get("m0").is_finished());
+    REQUIRE(T.get("m0").duration() == std::chrono::milliseconds(42));
+
+    T.add("m0", begin, begin + std::chrono::milliseconds(1));
+    REQUIRE(T.measurements().size() == 1);
+    REQUIRE(T.get("m0").duration() == std::chrono::milliseconds(1));
+
+    {
+        auto tp = T.create_timing("m1");
+        REQUIRE_THROWS_AS(T.add("m1", begin, end), m::invalid_argument);
+    }
+}